@@ -37,6 +37,7 @@
 #include "abstractevaluateclipanimatorjob_p.h"
 #include <Qt3DCore/private/qaspectjob_p.h>
 #include <Qt3DCore/private/qaspectmanager_p.h>
+#include <Qt3DCore/private/qnodebatchlookup_p.h>
 #include <Qt3DCore/private/qskeleton_p.h>
 #include <Qt3DAnimation/qabstractclipanimator.h>
 
@@ -53,7 +54,7 @@ public:
 
     void postFrame(Qt3DCore::QAspectManager *manager) override;
 
-    AnimationRecord m_record;
+    QVector<AnimationRecord> m_records;
     QVector<AnimationCallbackAndValue> m_callbacks;
 };
 
@@ -64,48 +65,80 @@ AbstractEvaluateClipAnimatorJob::AbstractEvaluateClipAnimatorJob()
 
 void AbstractEvaluateClipAnimatorJob::setPostFrameData(const AnimationRecord &record, const QVector<AnimationCallbackAndValue> &callbacks)
 {
-    auto mainThreadCB = callbacks;
-    mainThreadCB.erase(std::remove_if(mainThreadCB.begin(), mainThreadCB.end(), [](const AnimationCallbackAndValue &callback) {
-                        if (callback.flags.testFlag(QAnimationCallback::OnThreadPool)) {
-                            // call these now and remove them from the list
-                            callback.callback->valueChanged(callback.value);
-                            return true;
-                        }
-                        return false;
-                    }), mainThreadCB.end());
-    // Should now only have callbacks to be called on main thread
+    clearPostFrameData();
+    addPostFrameData(record, callbacks);
+}
 
+void AbstractEvaluateClipAnimatorJob::addPostFrameData(const AnimationRecord &record, const QVector<AnimationCallbackAndValue> &callbacks)
+{
     Q_D(AbstractEvaluateClipAnimatorJob);
-    d->m_record = record;
-    d->m_callbacks = mainThreadCB;
+    d->m_records.push_back(record);
+
+    for (const AnimationCallbackAndValue &callback : callbacks) {
+        if (callback.flags.testFlag(QAnimationCallback::OnThreadPool)) {
+            // call these now
+            callback.callback->valueChanged(callback.value);
+        } else {
+            // keep the ones to be called on main thread
+            d->m_callbacks.push_back(callback);
+        }
+    }
 }
 
-void AbstractEvaluateClipAnimatorJobPrivate::postFrame(Qt3DCore::QAspectManager *manager)
+void AbstractEvaluateClipAnimatorJob::clearPostFrameData()
 {
-    if (m_record.animatorId.isNull())
-        return;
+    Q_D(AbstractEvaluateClipAnimatorJob);
+    d->m_records.clear();
+    d->m_callbacks.clear();
+}
 
-    for (auto targetData : qAsConst(m_record.targetChanges)) {
-        Qt3DCore::QNode *node = manager->lookupNode(targetData.targetId);
-        if (node)
-            node->setProperty(targetData.propertyName, targetData.value);
+void AbstractEvaluateClipAnimatorJobPrivate::postFrame(Qt3DCore::QAspectManager *manager)
+{
+    // Gather the ids of all the nodes we are about to update, in the order
+    // they are visited below, so that they can be resolved with one lookup
+    QVector<Qt3DCore::QNodeId> ids;
+    for (const AnimationRecord &record : qAsConst(m_records)) {
+        if (record.animatorId.isNull())
+            continue;
+        for (const auto &targetData : record.targetChanges)
+            ids.push_back(targetData.targetId);
+        for (const auto &skeletonData : record.skeletonChanges)
+            ids.push_back(skeletonData.first);
+        ids.push_back(record.animatorId);
     }
+    // Setting a property notifies the application, which may delete nodes of
+    // later records. These are then resolved again by the batch lookup
+    Qt3DCore::QNodeBatchLookup nodes(ids.isEmpty() ? nullptr : manager, ids);
+    int nodeIndex = 0;
+
+    for (const AnimationRecord &record : qAsConst(m_records)) {
+        if (record.animatorId.isNull())
+            continue;
+
+        for (auto targetData : qAsConst(record.targetChanges)) {
+            Qt3DCore::QNode *node = nodes.node(nodeIndex++);
+            if (node)
+                node->setProperty(targetData.propertyName, targetData.value);
+        }
 
-    for (auto skeletonData : qAsConst(m_record.skeletonChanges)) {
-        Qt3DCore::QAbstractSkeleton *node = qobject_cast<Qt3DCore::QAbstractSkeleton *>(manager->lookupNode(skeletonData.first));
-        if (node) {
-            auto d = Qt3DCore::QAbstractSkeletonPrivate::get(node);
-            d->m_localPoses = skeletonData.second;
-            d->update();
+        for (auto skeletonData : qAsConst(record.skeletonChanges)) {
+            Qt3DCore::QAbstractSkeleton *node = qobject_cast<Qt3DCore::QAbstractSkeleton *>(nodes.node(nodeIndex++));
+            if (node) {
+                auto d = Qt3DCore::QAbstractSkeletonPrivate::get(node);
+                d->m_localPoses = skeletonData.second;
+                d->update();
+            }
         }
-    }
 
-    QAbstractClipAnimator *animator = qobject_cast<QAbstractClipAnimator *>(manager->lookupNode(m_record.animatorId));
-    if (animator) {
-        if (isValidNormalizedTime(m_record.normalizedTime))
-            animator->setNormalizedTime(m_record.normalizedTime);
-        if (m_record.finalFrame)
-            animator->setRunning(false);
+        const int animatorIndex = nodeIndex++;
+        QAbstractClipAnimator *animator = qobject_cast<QAbstractClipAnimator *>(nodes.node(animatorIndex));
+        if (animator) {
+            if (isValidNormalizedTime(record.normalizedTime))
+                animator->setNormalizedTime(record.normalizedTime);
+            // normalizedTimeChanged handlers may have destroyed the animator
+            if (record.finalFrame && nodes.node(animatorIndex))
+                animator->setRunning(false);
+        }
     }
 
     for (const AnimationCallbackAndValue &callback: qAsConst(m_callbacks)) {
@@ -113,7 +146,8 @@ void AbstractEvaluateClipAnimatorJobPrivate::postFrame(Qt3DCore::QAspectManager
             callback.callback->valueChanged(callback.value);
     }
 
-    m_record = {};
+    m_records.clear();
+    m_callbacks.clear();
 }
 
 } // Animation
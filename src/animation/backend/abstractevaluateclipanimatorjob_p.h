@@ -64,6 +64,9 @@ protected:
     AbstractEvaluateClipAnimatorJob();
 
     void setPostFrameData(const AnimationRecord &record, const QVector<AnimationCallbackAndValue> &callbacks);
+    // Used by jobs evaluating several animators
+    void addPostFrameData(const AnimationRecord &record, const QVector<AnimationCallbackAndValue> &callbacks);
+    void clearPostFrameData();
 
 private:
     Q_DECLARE_PRIVATE(AbstractEvaluateClipAnimatorJob)
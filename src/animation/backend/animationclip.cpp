@@ -65,6 +65,7 @@ AnimationClip::AnimationClip()
     , m_status(QAnimationClipLoader::NotReady)
     , m_clipData()
     , m_dataType(Unknown)
+    , m_loadPending(false)
     , m_name()
     , m_channels()
     , m_duration(0.0f)
@@ -80,6 +81,7 @@ void AnimationClip::cleanup()
     m_clipData.clearChannels();
     m_status = QAnimationClipLoader::NotReady;
     m_dataType = Unknown;
+    m_loadPending = false;
     m_channels.clear();
     m_duration = 0.0f;
     m_channelComponentCount = 0;
@@ -138,7 +140,7 @@ void AnimationClip::loadAnimation()
     // Load the data
     switch (m_dataType) {
     case File:
-        loadAnimationFromUrl();
+        applyFileData(loadAnimationFile(m_source));
         break;
 
     case Data:
@@ -149,6 +151,33 @@ void AnimationClip::loadAnimation()
         Q_UNREACHABLE();
     }
 
+    animationLoaded();
+}
+
+/*!
+    \internal
+    Called by LoadAnimationClipJob in postFrame with the content of the file
+    of the clip, loaded in the background
+ */
+void AnimationClip::setAnimationFileData(const AnimationFileData &fileData)
+{
+    qCDebug(Jobs) << Q_FUNC_INFO << m_source;
+    m_loadPending = false;
+    clearData();
+    applyFileData(fileData);
+    animationLoaded();
+}
+
+void AnimationClip::applyFileData(const AnimationFileData &fileData)
+{
+    m_name = fileData.name;
+    m_channels = fileData.channels;
+    if (fileData.error)
+        setStatus(QAnimationClipLoader::Error);
+}
+
+void AnimationClip::animationLoaded()
+{
     // Update the duration
     const float t = findDuration();
     setDuration(t);
@@ -184,23 +213,30 @@ void AnimationClip::loadAnimation()
     qCDebug(Jobs) << "Loaded animation data:" << *this;
 }
 
-void AnimationClip::loadAnimationFromUrl()
+/*!
+    \internal
+    Reads the animation clip file at \a source. Doesn't access any clip so
+    that it can run in the background.
+ */
+AnimationClip::AnimationFileData AnimationClip::loadAnimationFile(const QUrl &source)
 {
+    AnimationFileData fileData;
+
     // TODO: Handle remote files
-    QString filePath = Qt3DCore::QUrlHelper::urlToLocalFileOrQrc(m_source);
+    QString filePath = Qt3DCore::QUrlHelper::urlToLocalFileOrQrc(source);
     QFile file(filePath);
     if (!file.open(QIODevice::ReadOnly)) {
         qWarning() << "Could not find animation clip:" << filePath;
-        setStatus(QAnimationClipLoader::Error);
-        return;
+        fileData.error = true;
+        return fileData;
     }
 
     // Extract the animationName or animationIndex from the url query parameters.
     // If both present, animationIndex wins.
     int animationIndex = -1;
     QString animationName;
-    if (m_source.hasQuery()) {
-        QUrlQuery query(m_source);
+    if (source.hasQuery()) {
+        QUrlQuery query(source);
         if (query.hasQueryItem(ANIMATION_INDEX_KEY)) {
             bool ok = false;
             int i = query.queryItemValue(ANIMATION_INDEX_KEY).toInt(&ok);
@@ -218,13 +254,13 @@ void AnimationClip::loadAnimationFromUrl()
 
     // TODO: Convert to plugins
     // Load glTF or "native"
-    if (filePath.endsWith(QLatin1String("gltf"))) {
+    if (filePath.endsWith(QLatin1String("gltf")) || filePath.endsWith(QLatin1String("glb"))) {
         qCDebug(Jobs) << "Loading glTF animation from" << filePath;
         GLTFImporter gltf;
         gltf.load(&file);
         auto nameAndChannels = gltf.createAnimationData(animationIndex, animationName);
-        m_name = nameAndChannels.name;
-        m_channels = nameAndChannels.channels;
+        fileData.name = nameAndChannels.name;
+        fileData.channels = nameAndChannels.channels;
     } else if (filePath.endsWith(QLatin1String("json"))) {
         // Native format
         QByteArray animationData = file.readAll();
@@ -243,7 +279,7 @@ void AnimationClip::loadAnimationFromUrl()
         // Give priority to animationIndex over animationName
         if (animationIndex >= animationsArray.size()) {
             qCWarning(Jobs) << "Invalid animation index. Skipping.";
-            return;
+            return fileData;
         }
 
         if (animationsArray.size() == 1) {
@@ -261,29 +297,31 @@ void AnimationClip::loadAnimationFromUrl()
 
             if (!foundAnimation) {
                 qCWarning(Jobs) << "Invalid animation name. Skipping.";
-                return;
+                return fileData;
             }
         }
 
         if (animationIndex < 0 || animationIndex >= animationsArray.size()) {
             qCWarning(Jobs) << "Failed to find animation. Skipping.";
-            return;
+            return fileData;
         }
 
         QJsonObject animation = animationsArray.at(animationIndex).toObject();
-        m_name = animation[QLatin1String("animationName")].toString();
+        fileData.name = animation[QLatin1String("animationName")].toString();
 
         QJsonArray channelsArray = animation[QLatin1String("channels")].toArray();
         const int channelCount = channelsArray.size();
-        m_channels.resize(channelCount);
+        fileData.channels.resize(channelCount);
         for (int i = 0; i < channelCount; ++i) {
             const QJsonObject group = channelsArray.at(i).toObject();
-            m_channels[i].read(group);
+            fileData.channels[i].read(group);
         }
     } else {
         qWarning() << "Unknown animation clip type. Please use json or glTF 2.0";
-        setStatus(QAnimationClipLoader::Error);
+        fileData.error = true;
     }
+
+    return fileData;
 }
 
 void AnimationClip::loadAnimationFromData()
@@ -298,13 +336,15 @@ void AnimationClip::loadAnimationFromData()
 void AnimationClip::addDependingClipAnimator(const Qt3DCore::QNodeId &id)
 {
     QMutexLocker lock(&m_mutex);
-    m_dependingAnimators.push_back(id);
+    if (!m_dependingAnimators.contains(id))
+        m_dependingAnimators.push_back(id);
 }
 
 void AnimationClip::addDependingBlendedClipAnimator(const Qt3DCore::QNodeId &id)
 {
     QMutexLocker lock(&m_mutex);
-    m_dependingBlendedAnimators.push_back(id);
+    if (!m_dependingBlendedAnimators.contains(id))
+        m_dependingBlendedAnimators.push_back(id);
 }
 
 void AnimationClip::setDuration(float duration)
@@ -79,9 +79,22 @@ public:
 
     QString name() const { return m_name; }
     const QVector<Channel> &channels() const { return m_channels; }
+    bool isLoadedFromFile() const { return m_dataType == File; }
+    // Whether the file of the clip is being loaded in the background
+    bool isLoadPending() const { return m_loadPending; }
+    void setLoadPending(bool loadPending) { m_loadPending = loadPending; }
+
+    struct AnimationFileData
+    {
+        QString name;
+        QVector<Channel> channels;
+        bool error = false;
+    };
+    static AnimationFileData loadAnimationFile(const QUrl &source);
 
     // Called from jobs
     void loadAnimation();
+    void setAnimationFileData(const AnimationFileData &fileData);
     void setDuration(float duration);
     float duration() const { return m_duration; }
     int channelIndex(const QString &channelName, int jointIndex) const;
@@ -103,8 +116,9 @@ public:
 #endif
 
 private:
-    void loadAnimationFromUrl();
+    void applyFileData(const AnimationFileData &fileData);
     void loadAnimationFromData();
+    void animationLoaded();
     void clearData();
     float findDuration();
     int findChannelComponentCount();
@@ -115,6 +129,7 @@ private:
     QAnimationClipLoader::Status m_status;
     QAnimationClipData m_clipData;
     ClipDataType m_dataType;
+    bool m_loadPending;
 
     QString m_name;
     QVector<Channel> m_channels;
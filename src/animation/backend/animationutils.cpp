@@ -234,12 +234,29 @@ ComponentIndices channelComponentsToIndicesHelper(const Channel &channel,
 
 ClipResults evaluateClipAtLocalTime(AnimationClip *clip, float localTime)
 {
-    QVector<float> channelResults;
+    ClipResults channelResults;
+    KeyframeCursors keyframeCursors;
+    evaluateClipAtLocalTime(clip, localTime, channelResults, keyframeCursors);
+    return channelResults;
+}
+
+void evaluateClipAtLocalTime(AnimationClip *clip, float localTime,
+                             ClipResults &channelResults,
+                             KeyframeCursors &keyframeCursors)
+{
     Q_ASSERT(clip);
 
-    // Ensure we have enough storage to hold the evaluations
+    // Ensure we have enough storage to hold the evaluations. This is a no-op
+    // when channelResults is reused for the same clip.
     channelResults.resize(clip->channelCount());
 
+    // The cursors only speed up the keyframe lookups, if they were used with
+    // another clip they are simply reset
+    if (keyframeCursors.size() != clip->channelCount()) {
+        keyframeCursors.clear();
+        keyframeCursors.resize(clip->channelCount());
+    }
+
     // Iterate over channels and evaluate the fcurves
     const QVector<Channel> &channels = clip->channels();
     int i = 0;
@@ -258,7 +275,7 @@ ClipResults evaluateClipAtLocalTime(AnimationClip *clip, float localTime)
             if (!canSlerp) {
                 // Interpolate per component
                 for (const auto &channelComponent : qAsConst(channel.channelComponents)) {
-                    const int lowerKeyframeBound = channelComponent.fcurve.lowerKeyframeBound(localTime);
+                    const int lowerKeyframeBound = channelComponent.fcurve.lowerKeyframeBound(localTime, keyframeCursors[i]);
                     channelResults[i++] = channelComponent.fcurve.evaluateAtTime(localTime, lowerKeyframeBound);
                 }
             } else {
@@ -277,7 +294,7 @@ ClipResults evaluateClipAtLocalTime(AnimationClip *clip, float localTime)
                         return quat;
                     };
 
-                    const int lowerKeyframeBound = channel.channelComponents[0].fcurve.lowerKeyframeBound(localTime);
+                    const int lowerKeyframeBound = channel.channelComponents[0].fcurve.lowerKeyframeBound(localTime, keyframeCursors[i]);
                     const auto lowerQuat = quaternionFromChannel(lowerKeyframeBound);
                     const auto higherQuat = quaternionFromChannel(lowerKeyframeBound + 1);
                     auto cosHalfTheta = QQuaternion::dotProduct(lowerQuat, higherQuat);
@@ -320,12 +337,11 @@ ClipResults evaluateClipAtLocalTime(AnimationClip *clip, float localTime)
             // TODO How do we handle other interpolations. For exammple, color interpolation
             // in a linear perceptual way or other non linear spaces?
             for (const auto &channelComponent : qAsConst(channel.channelComponents)) {
-                const int lowerKeyframeBound = channelComponent.fcurve.lowerKeyframeBound(localTime);
+                const int lowerKeyframeBound = channelComponent.fcurve.lowerKeyframeBound(localTime, keyframeCursors[i]);
                 channelResults[i++] = channelComponent.fcurve.evaluateAtTime(localTime, lowerKeyframeBound);
             }
         }
     }
-    return channelResults;
 }
 
 ClipResults evaluateClipAtPhase(AnimationClip *clip, float phase)
@@ -335,6 +351,14 @@ ClipResults evaluateClipAtPhase(AnimationClip *clip, float phase)
     return evaluateClipAtLocalTime(clip, localTime);
 }
 
+void evaluateClipAtPhase(AnimationClip *clip, float phase,
+                         ClipResults &channelResults,
+                         KeyframeCursors &keyframeCursors)
+{
+    const double localTime = phase * clip->duration();
+    evaluateClipAtLocalTime(clip, localTime, channelResults, keyframeCursors);
+}
+
 template<typename Container>
 Container mapChannelResultsToContainer(const MappingData &mappingData,
                                        const QVector<float> &channelResults)
@@ -835,6 +859,19 @@ ClipResults formatClipResults(const ClipResults &rawClipResults,
     return formattedClipResults;
 }
 
+void formatClipResults(const ClipResults &rawClipResults,
+                       const ComponentIndices &format,
+                       ClipResults &formattedClipResults)
+{
+    const int elementCount = format.size();
+    formattedClipResults.resize(elementCount);
+
+    // Unlike above, formattedClipResults may hold values from a previous
+    // evaluation so the holes have to be reset
+    for (int i = 0; i < elementCount; ++i)
+        formattedClipResults[i] = format[i] == -1 ? 0.0f : rawClipResults[format[i]];
+}
+
 ClipResults evaluateBlendTree(Handler *handler,
                               BlendedClipAnimator *animator,
                               Qt3DCore::QNodeId blendTreeRootId)
@@ -50,6 +50,7 @@
 
 #include <Qt3DAnimation/private/qt3danimation_global_p.h>
 #include <Qt3DAnimation/private/clock_p.h>
+#include <Qt3DAnimation/private/fcurve_p.h>
 #include <Qt3DAnimation/qanimationcallback.h>
 #include <Qt3DCore/qnodeid.h>
 #include <Qt3DCore/private/sqt_p.h>
@@ -125,6 +126,8 @@ struct ClipEvaluationData
 };
 
 typedef QVector<float> ClipResults;
+// One cursor per channel component of a clip, owned by each animator
+typedef QVector<KeyframeCursor> KeyframeCursors;
 
 struct ChannelNameAndType
 {
@@ -353,10 +356,22 @@ Q_AUTOTEST_EXPORT
 ClipResults evaluateClipAtLocalTime(AnimationClip *clip,
                                     float localTime);
 
+Q_AUTOTEST_EXPORT
+void evaluateClipAtLocalTime(AnimationClip *clip,
+                             float localTime,
+                             ClipResults &channelResults,
+                             KeyframeCursors &keyframeCursors);
+
 Q_AUTOTEST_EXPORT
 ClipResults evaluateClipAtPhase(AnimationClip *clip,
                                 float phase);
 
+Q_AUTOTEST_EXPORT
+void evaluateClipAtPhase(AnimationClip *clip,
+                         float phase,
+                         ClipResults &channelResults,
+                         KeyframeCursors &keyframeCursors);
+
 Q_AUTOTEST_EXPORT
 QVector<AnimationCallbackAndValue> prepareCallbacks(const QVector<MappingData> &mappingDataVec,
                                                     const QVector<float> &channelResults);
@@ -397,6 +412,11 @@ Q_AUTOTEST_EXPORT
 ClipResults formatClipResults(const ClipResults &rawClipResults,
                               const ComponentIndices &format);
 
+Q_AUTOTEST_EXPORT
+void formatClipResults(const ClipResults &rawClipResults,
+                       const ComponentIndices &format,
+                       ClipResults &formattedClipResults);
+
 Q_AUTOTEST_EXPORT
 ClipResults evaluateBlendTree(Handler *handler,
                               BlendedClipAnimator *animator,
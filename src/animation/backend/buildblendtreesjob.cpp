@@ -79,9 +79,31 @@ void BuildBlendTreesJob::run()
         const bool canRun = blendClipAnimator->canRun();
         const bool running = blendClipAnimator->isRunning();
         const bool seeking = blendClipAnimator->isSeeking();
-        m_handler->setBlendedClipAnimatorRunning(blendedClipAnimatorHandle, canRun && (seeking || running));
 
-        if (!canRun && !(seeking || running))
+        // Clips still loading are empty, which would stop the animator on its
+        // first frame. Leave the animator out, without changing its running
+        // state, until its clips mark it dirty once loaded.
+        bool clipsLoaded = true;
+        if (canRun && (seeking || running)) {
+            const QVector<Qt3DCore::QNodeId> valueNodeIds
+                    = gatherValueNodesToEvaluate(m_handler, blendClipAnimator->blendTreeRootId());
+            for (const auto valueNodeId : valueNodeIds) {
+                const ClipBlendValue *valueNode
+                        = static_cast<ClipBlendValue *>(m_handler->clipBlendNodeManager()->lookupNode(valueNodeId));
+                Q_ASSERT(valueNode);
+                AnimationClip *clip = m_handler->animationClipLoaderManager()->lookupResource(valueNode->clipId());
+                if (clip && !clip->isLoadPending())
+                    continue;
+                clipsLoaded = false;
+                if (clip)
+                    clip->addDependingBlendedClipAnimator(blendClipAnimator->peerId());
+            }
+        }
+
+        m_handler->setBlendedClipAnimatorRunning(blendedClipAnimatorHandle,
+                                                 canRun && clipsLoaded && (seeking || running));
+
+        if ((!canRun && !(seeking || running)) || !clipsLoaded)
             continue;
 
         // Build the format for clip results that should be used by nodes in the blend
@@ -67,6 +67,7 @@ ClipAnimator::ClipAnimator()
 void ClipAnimator::setClipId(Qt3DCore::QNodeId clipId)
 {
     m_clipId = clipId;
+    m_keyframeCursors.clear();
     setDirty(Handler::ClipAnimatorDirty);
 
     // register at the clip to make sure we are marked dirty when the clip finished loading
@@ -112,6 +113,7 @@ void ClipAnimator::cleanup()
     m_running = false;
     m_loops = 1;
     m_clipFormat = ClipFormat();
+    m_keyframeCursors.clear();
     m_normalizedLocalTime = m_lastNormalizedLocalTime = -1.0f;
 }
 
@@ -98,6 +98,10 @@ public:
     void setClipFormat(const ClipFormat &clipFormat) { m_clipFormat = clipFormat; }
     ClipFormat clipFormat() const { return m_clipFormat; }
 
+    // Position of the previous keyframe lookups in the clip, only accessed by
+    // the job evaluating this animator
+    KeyframeCursors &keyframeCursors() { return m_keyframeCursors; }
+
     qint64 nsSincePreviousFrame(qint64 currentGlobalTimeNS);
     void setLastGlobalTimeNS(qint64 lastGlobalTimeNS);
 
@@ -126,6 +130,7 @@ private:
 
     int m_currentLoop;
     ClipFormat m_clipFormat;
+    KeyframeCursors m_keyframeCursors;
 
     float m_normalizedLocalTime;
     float m_lastNormalizedLocalTime;
@@ -87,6 +87,7 @@ void ClipBlendValue::setClipFormat(Qt3DCore::QNodeId animatorId, const ClipForma
         // Nope, add it
         m_animatorIds.push_back(animatorId);
         m_clipFormats.push_back(formatIndices);
+        m_keyframeCursors.push_back({});
     } else {
         m_clipFormats[animatorIndex] = formatIndices;
     }
@@ -104,6 +105,12 @@ const ClipFormat &ClipBlendValue::clipFormat(Qt3DCore::QNodeId animatorId) const
     return m_clipFormats[animatorIndex];
 }
 
+KeyframeCursors &ClipBlendValue::keyframeCursors(Qt3DCore::QNodeId animatorId)
+{
+    const int animatorIndex = m_animatorIds.indexOf(animatorId);
+    return m_keyframeCursors[animatorIndex];
+}
+
 } // namespace Animation
 } // namespace Qt3DAnimation
 
@@ -82,6 +82,9 @@ public:
     ClipFormat &clipFormat(Qt3DCore::QNodeId animatorId);
     const ClipFormat &clipFormat(Qt3DCore::QNodeId animatorId) const;
 
+    // Only valid for animators with a ClipFormat
+    KeyframeCursors &keyframeCursors(Qt3DCore::QNodeId animatorId);
+
 protected:
     ClipResults doBlend(const QVector<ClipResults> &blendData) const override;
 
@@ -90,6 +93,7 @@ private:
 
     QVector<Qt3DCore::QNodeId> m_animatorIds;
     QVector<ClipFormat> m_clipFormats;
+    QVector<KeyframeCursors> m_keyframeCursors;
 };
 
 } // namespace Animation
@@ -61,12 +61,19 @@ void EvaluateClipAnimatorJob::run()
 {
     Q_ASSERT(m_handler);
 
-    ClipAnimator *clipAnimator = m_handler->clipAnimatorManager()->data(m_clipAnimatorHandle);
+    clearPostFrameData();
+    for (const HClipAnimator &clipAnimatorHandle : qAsConst(m_clipAnimatorHandles))
+        evaluateClipAnimator(clipAnimatorHandle);
+}
+
+void EvaluateClipAnimatorJob::evaluateClipAnimator(const HClipAnimator &clipAnimatorHandle)
+{
+    ClipAnimator *clipAnimator = m_handler->clipAnimatorManager()->data(clipAnimatorHandle);
     Q_ASSERT(clipAnimator);
     const bool running = clipAnimator->isRunning();
     const bool seeking = clipAnimator->isSeeking();
     if (!running && !seeking) {
-        m_handler->setClipAnimatorRunning(m_clipAnimatorHandle, false);
+        m_handler->setClipAnimatorRunning(clipAnimatorHandle, false);
         return;
     }
 
@@ -87,11 +94,12 @@ void EvaluateClipAnimatorJob::run()
                                                                                     nsSincePreviousFrame);
 
     const ClipEvaluationData preEvaluationDataForClip = evaluationDataForClip(clip, animatorEvaluationData);
-    const ClipResults rawClipResults = evaluateClipAtPhase(clip, preEvaluationDataForClip.normalizedLocalTime);
+    evaluateClipAtPhase(clip, preEvaluationDataForClip.normalizedLocalTime,
+                        m_rawClipResults, clipAnimator->keyframeCursors());
 
     // Reformat the clip results into the layout used by this animator/blend tree
     const ClipFormat clipFormat = clipAnimator->clipFormat();
-    ClipResults formattedClipResults = formatClipResults(rawClipResults, clipFormat.sourceClipIndices);
+    formatClipResults(m_rawClipResults, clipFormat.sourceClipIndices, m_formattedClipResults);
 
     if (preEvaluationDataForClip.isFinalFrame)
         clipAnimator->setRunning(false);
@@ -104,19 +112,19 @@ void EvaluateClipAnimatorJob::run()
     // Prepare property changes (if finalFrame it also prepares the change for the running property for the frontend)
     auto record = prepareAnimationRecord(clipAnimator->peerId(),
                                          clipAnimator->mappingData(),
-                                         formattedClipResults,
+                                         m_formattedClipResults,
                                          preEvaluationDataForClip.isFinalFrame,
                                          preEvaluationDataForClip.normalizedLocalTime);
 
     // Trigger callbacks either on this thread or by notifying the gui thread.
-    auto callbacks = prepareCallbacks(clipAnimator->mappingData(), formattedClipResults);
+    auto callbacks = prepareCallbacks(clipAnimator->mappingData(), m_formattedClipResults);
 
     // Update the normalized time on the backend node so that
     // frontend <-> backend sync will not mark things dirty
     // unless the frontend normalized time really is different
     clipAnimator->setNormalizedLocalTime(record.normalizedTime, false);
 
-    setPostFrameData(record, callbacks);
+    addPostFrameData(record, callbacks);
 }
 
 } // namespace Animation
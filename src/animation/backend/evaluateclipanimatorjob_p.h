@@ -68,20 +68,35 @@ public:
 
     void setClipAnimator(const HClipAnimator &clipAnimatorHandle)
     {
-        m_clipAnimatorHandle = clipAnimatorHandle;
+        m_clipAnimatorHandles = { clipAnimatorHandle };
     }
 
+    // Animators are best grouped by AnimationClip, the evaluation buffers are
+    // then reused as is from one animator to the next
+    void setClipAnimators(const QVector<HClipAnimator> &clipAnimatorHandles)
+    {
+        m_clipAnimatorHandles = clipAnimatorHandles;
+    }
+
+    QVector<HClipAnimator> clipAnimators() const { return m_clipAnimatorHandles; }
+
     void clearClipAnimator()
     {
-        m_clipAnimatorHandle = HClipAnimator();
+        m_clipAnimatorHandles.clear();
     }
 
 protected:
     void run() override;
 
 private:
-    HClipAnimator m_clipAnimatorHandle;
+    void evaluateClipAnimator(const HClipAnimator &clipAnimatorHandle);
+
+    QVector<HClipAnimator> m_clipAnimatorHandles;
     Handler *m_handler;
+
+    // Kept across frames to avoid reallocating them
+    ClipResults m_rawClipResults;
+    ClipResults m_formattedClipResults;
 };
 
 } // namespace Animation
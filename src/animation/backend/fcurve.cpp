@@ -144,6 +144,17 @@ int FCurve::lowerKeyframeBound(float localTime) const
     return m_rangeFinder.findLowerBound(localTime);
 }
 
+// Same as above but starts searching from the result of the previous search
+// with the same cursor, which is O(1) when playing forward
+int FCurve::lowerKeyframeBound(float localTime, KeyframeCursor &cursor) const
+{
+    if (localTime < m_localTimes.first())
+        return 0;
+    if (localTime > m_localTimes.last())
+        return 0;
+    return m_rangeFinder.findLowerBound(localTime, cursor);
+}
+
 float FCurve::startTime() const
 {
     if (!m_localTimes.isEmpty())
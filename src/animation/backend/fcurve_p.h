@@ -65,6 +65,8 @@ QT_BEGIN_NAMESPACE
 namespace Qt3DAnimation {
 namespace Animation {
 
+using KeyframeCursor = FunctionRangeFinder::Cursor;
+
 class Q_AUTOTEST_EXPORT FCurve
 {
 public:
@@ -86,6 +88,7 @@ public:
     float evaluateAtTime(float localTime, int lowerBound) const;
     float evaluateAtTimeAsSlerp(float localTime, int lowerBound, float halfTheta, float sinHalfTheta, float reverseQ1) const;
     int lowerKeyframeBound(float localTime) const;
+    int lowerKeyframeBound(float localTime, KeyframeCursor &cursor) const;
 
     void read(const QJsonObject &json);
     void setFromQChannelComponent(const QChannelComponent &qcc);
@@ -72,11 +72,20 @@ void FindRunningClipAnimatorsJob::run()
         const bool canRun = clipAnimator->canRun();
         const bool running = clipAnimator->isRunning();
         const bool seeking = clipAnimator->isSeeking();
-        m_handler->setClipAnimatorRunning(clipAnimatorHandle, canRun && (seeking || running));
+
+        // A clip still loading is empty, which would stop the animator on its
+        // first frame. Leave the animator out, without changing its running
+        // state, until the clip marks it dirty once loaded.
+        AnimationClip *clip = m_handler->animationClipLoaderManager()->lookupResource(clipAnimator->clipId());
+        const bool clipLoaded = clip && !clip->isLoadPending();
+        if (clip && !clipLoaded && canRun && (seeking || running))
+            clip->addDependingClipAnimator(clipAnimator->peerId());
+
+        m_handler->setClipAnimatorRunning(clipAnimatorHandle, canRun && clipLoaded && (seeking || running));
 
         // TODO: Actually check if this is needed first, currently we re-build this every time
         // canRun (or the normalized time) is true.
-        if (!canRun || !(seeking || running))
+        if (!canRun || !clipLoaded || !(seeking || running))
             continue;
 
         // The clip animator needs to know how to map fcurve values through to properties on QNodes.
@@ -92,8 +101,6 @@ void FindRunningClipAnimatorsJob::run()
         const QVector<ComponentIndices> channelComponentIndices
                 = assignChannelComponentIndices(channelNamesAndTypes);
 
-        const AnimationClip *clip = m_handler->animationClipLoaderManager()->lookupResource(clipAnimator->clipId());
-        Q_ASSERT(clip);
         const ClipFormat format = generateClipFormatIndices(channelNamesAndTypes,
                                                             channelComponentIndices,
                                                             clip);
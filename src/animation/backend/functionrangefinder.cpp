@@ -67,12 +67,16 @@ namespace Animation {
     is then used to refine this result.
 
     If the previous results are uncorrelated, a simple bisection is used.
+
+    The previous result and whether it was correlated are stored in the
+    \a cursor passed by the caller rather than in the FunctionRangeFinder.
+    This keeps the search const and lets every user evaluating the function
+    (e.g. every animator playing a clip) hunt from its own previous position.
+    The overload without a cursor always performs a bisection.
  */
 
 FunctionRangeFinder::FunctionRangeFinder(const QVector<float> &x)
     : m_x(x)
-    , m_previousLowerBound(0)
-    , m_correlated(0)
     , m_rangeSize(2)
     , m_correlationThreshold(1)
     , m_ascending(true)
@@ -86,7 +90,7 @@ FunctionRangeFinder::FunctionRangeFinder(const QVector<float> &x)
     \internal
     Locates the lower bound of a range that encloses \a x by a bisection method.
 */
-int FunctionRangeFinder::locate(float x) const
+int FunctionRangeFinder::locate(float x, Cursor &cursor) const
 {
     if (m_x.size() < 2 || m_rangeSize < 2 || m_rangeSize > m_x.size())
         return -1;
@@ -101,8 +105,8 @@ int FunctionRangeFinder::locate(float x) const
             jUpper = jMid;
     }
 
-    m_correlated = std::abs(jLower - m_previousLowerBound) <= m_correlationThreshold;
-    m_previousLowerBound = jLower;
+    cursor.correlated = std::abs(jLower - cursor.previousLowerBound) <= m_correlationThreshold;
+    cursor.previousLowerBound = jLower;
 
     return std::max(0, std::min(m_x.size() - m_rangeSize, jLower - ((m_rangeSize - 2) >> 1)));
 }
@@ -111,12 +115,12 @@ int FunctionRangeFinder::locate(float x) const
     \internal
     Hunts outward from the previous result in increasing step sizes then refines via bisection.
  */
-int FunctionRangeFinder::hunt(float x) const
+int FunctionRangeFinder::hunt(float x, Cursor &cursor) const
 {
     if (m_x.size() < 2 || m_rangeSize < 2 || m_rangeSize > m_x.size())
         return -1;
 
-    int jLower = m_previousLowerBound;
+    int jLower = cursor.previousLowerBound;
     int jMid;
     int jUpper;
     if (jLower < 0 || jLower > (m_x.size() - 1)) {
@@ -162,8 +166,8 @@ int FunctionRangeFinder::hunt(float x) const
             jUpper = jMid;
     }
 
-    m_correlated = std::abs(jLower - m_previousLowerBound) <= m_correlationThreshold;
-    m_previousLowerBound = jLower;
+    cursor.correlated = std::abs(jLower - cursor.previousLowerBound) <= m_correlationThreshold;
+    cursor.previousLowerBound = jLower;
 
     return std::max(0, std::min(m_x.size() - m_rangeSize, jLower - ((m_rangeSize - 2) >> 1)));
 }
@@ -63,7 +63,24 @@ class Q_AUTOTEST_EXPORT FunctionRangeFinder
 public:
     FunctionRangeFinder(const QVector<float> &x);
 
-    inline int findLowerBound(float x) const { return m_correlated ? hunt(x) : locate(x); }
+    // Result of the previous search, kept by the caller so that several
+    // evaluations of the same function at unrelated values don't interfere
+    struct Cursor
+    {
+        int previousLowerBound = 0;
+        bool correlated = false;
+    };
+
+    inline int findLowerBound(float x) const
+    {
+        Cursor cursor;
+        return locate(x, cursor);
+    }
+
+    inline int findLowerBound(float x, Cursor &cursor) const
+    {
+        return cursor.correlated ? hunt(x, cursor) : locate(x, cursor);
+    }
 
     int rangeSize() const { return m_rangeSize; }
     void setRangeSize(int rangeSize) { m_rangeSize = rangeSize; }
@@ -78,12 +95,10 @@ public:
     }
 
 private:
-    int locate(float x) const;
-    int hunt(float x) const;
+    int locate(float x, Cursor &cursor) const;
+    int hunt(float x, Cursor &cursor) const;
 
     const QVector<float> &m_x;
-    mutable int m_previousLowerBound;
-    mutable bool m_correlated;
     int m_rangeSize;
     int m_correlationThreshold;
     bool m_ascending;
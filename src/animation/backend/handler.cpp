@@ -46,6 +46,8 @@
 #include <Qt3DAnimation/private/evaluateblendclipanimatorjob_p.h>
 #include <Qt3DCore/private/qaspectjob_p.h>
 
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
 namespace Qt3DAnimation {
@@ -63,8 +65,12 @@ Handler::Handler()
     , m_loadAnimationClipJob(new LoadAnimationClipJob)
     , m_findRunningClipAnimatorsJob(new FindRunningClipAnimatorsJob)
     , m_buildBlendTreesJob(new BuildBlendTreesJob)
+    , m_clipAnimatorBatchSize(64)
     , m_simulationTime(0)
 {
+    if (qEnvironmentVariableIsSet("QT3D_ANIMATION_CLIP_BATCH_SIZE"))
+        setClipAnimatorBatchSize(qEnvironmentVariableIntValue("QT3D_ANIMATION_CLIP_BATCH_SIZE"));
+
     m_loadAnimationClipJob->setHandler(this);
     m_findRunningClipAnimatorsJob->setHandler(this);
     m_buildBlendTreesJob->setHandler(this);
@@ -140,6 +146,44 @@ void Handler::setBlendedClipAnimatorRunning(const HBlendedClipAnimator &handle,
     }
 }
 
+// Splits the running ClipAnimators in batches of animators playing the same
+// AnimationClip, each batch being evaluated by a single job
+void Handler::batchRunningClipAnimators()
+{
+    m_clipAnimatorBatches.clear();
+
+    if (m_clipAnimatorBatchSize == 1) {
+        m_clipAnimatorBatches.reserve(m_runningClipAnimators.size());
+        for (const HClipAnimator &handle : qAsConst(m_runningClipAnimators))
+            m_clipAnimatorBatches.push_back({ handle });
+        return;
+    }
+
+    QVector<QPair<Qt3DCore::QNodeId, HClipAnimator>> animatorsByClip;
+    animatorsByClip.reserve(m_runningClipAnimators.size());
+    for (const HClipAnimator &handle : qAsConst(m_runningClipAnimators)) {
+        const ClipAnimator *clipAnimator = m_clipAnimatorManager->data(handle);
+        animatorsByClip.push_back({ clipAnimator->clipId(), handle });
+    }
+    std::stable_sort(animatorsByClip.begin(), animatorsByClip.end(),
+                     [] (const QPair<Qt3DCore::QNodeId, HClipAnimator> &a,
+                         const QPair<Qt3DCore::QNodeId, HClipAnimator> &b) {
+        return a.first < b.first;
+    });
+
+    Qt3DCore::QNodeId batchClipId;
+    for (const auto &animatorAndClip : qAsConst(animatorsByClip)) {
+        if (m_clipAnimatorBatches.isEmpty()
+                || animatorAndClip.first != batchClipId
+                || m_clipAnimatorBatches.last().size() == m_clipAnimatorBatchSize) {
+            m_clipAnimatorBatches.push_back({});
+            m_clipAnimatorBatches.last().reserve(m_clipAnimatorBatchSize);
+            batchClipId = animatorAndClip.first;
+        }
+        m_clipAnimatorBatches.last().push_back(animatorAndClip.second);
+    }
+}
+
 // The vectors may get outdated when the application removes/deletes an
 // animator component in the meantime. Recognize this. This should be
 // relatively infrequent so in most cases the vectors will not change at all.
@@ -190,8 +234,31 @@ QVector<Qt3DCore::QAspectJobPtr> Handler::jobsToExecute(qint64 time)
     if (hasLoadAnimationClipJob) {
         qCDebug(HandlerLogic) << "Added LoadAnimationClipJob";
         cleanupHandleList(&m_dirtyAnimationClips);
-        m_loadAnimationClipJob->addDirtyAnimationClips(m_dirtyAnimationClips);
-        jobs.push_back(m_loadAnimationClipJob);
+
+        // Clip files are read in the background by a job of their own. The
+        // animators of the clips get dirty again once the clips are set.
+        QVector<HAnimationClip> dataClips;
+        QSharedPointer<LoadAnimationClipJob> loadAnimationClipFilesJob;
+        for (const HAnimationClip &handle : qAsConst(m_dirtyAnimationClips)) {
+            AnimationClip *clip = m_animationClipLoaderManager->data(handle);
+            if (clip->isLoadedFromFile()) {
+                clip->setLoadPending(true);
+                if (!loadAnimationClipFilesJob) {
+                    loadAnimationClipFilesJob.reset(new LoadAnimationClipJob);
+                    loadAnimationClipFilesJob->setHandler(this);
+                }
+                loadAnimationClipFilesJob->addAnimationClipFile(clip);
+            } else {
+                dataClips.push_back(handle);
+            }
+        }
+
+        if (loadAnimationClipFilesJob)
+            jobs.push_back(loadAnimationClipFilesJob);
+        if (!dataClips.isEmpty()) {
+            m_loadAnimationClipJob->addDirtyAnimationClips(dataClips);
+            jobs.push_back(m_loadAnimationClipJob);
+        }
         m_dirtyAnimationClips.clear();
     }
 
@@ -228,9 +295,11 @@ QVector<Qt3DCore::QAspectJobPtr> Handler::jobsToExecute(qint64 time)
     if (!m_runningClipAnimators.isEmpty()) {
         qCDebug(HandlerLogic) << "Added EvaluateClipAnimatorJobs";
 
-        // Ensure we have a job per clip animator
+        batchRunningClipAnimators();
+
+        // Ensure we have a job per batch of clip animators
         const int oldSize = m_evaluateClipAnimatorJobs.size();
-        const int newSize = m_runningClipAnimators.size();
+        const int newSize = m_clipAnimatorBatches.size();
         if (oldSize < newSize) {
             m_evaluateClipAnimatorJobs.resize(newSize);
             for (int i = oldSize; i < newSize; ++i) {
@@ -239,9 +308,9 @@ QVector<Qt3DCore::QAspectJobPtr> Handler::jobsToExecute(qint64 time)
             }
         }
 
-        // Set each job up with an animator to process and set dependencies
+        // Set each job up with the animators to process and set dependencies
         for (int i = 0; i < newSize; ++i) {
-            m_evaluateClipAnimatorJobs[i]->setClipAnimator(m_runningClipAnimators[i]);
+            m_evaluateClipAnimatorJobs[i]->setClipAnimators(m_clipAnimatorBatches[i]);
             Qt3DCore::QAspectJobPrivate::get(m_evaluateClipAnimatorJobs[i].data())->clearDependencies();
             if (hasLoadAnimationClipJob)
                 m_evaluateClipAnimatorJobs[i]->addDependency(m_loadAnimationClipJob);
@@ -110,6 +110,11 @@ public:
     void setBlendedClipAnimatorRunning(const HBlendedClipAnimator &handle, bool running);
     QVector<HBlendedClipAnimator> runningBlenndedClipAnimators() const { return m_runningBlendedClipAnimators; }
 
+    // Maximum number of running ClipAnimators sharing an AnimationClip that
+    // are evaluated by the same job. 1 means one job per animator.
+    void setClipAnimatorBatchSize(int batchSize) { m_clipAnimatorBatchSize = qMax(1, batchSize); }
+    int clipAnimatorBatchSize() const { return m_clipAnimatorBatchSize; }
+
     AnimationClipLoaderManager *animationClipLoaderManager() const Q_DECL_NOTHROW { return m_animationClipLoaderManager.data(); }
     ClockManager *clockManager() const Q_DECL_NOTHROW { return m_clockManager.data(); }
     ClipAnimatorManager *clipAnimatorManager() const Q_DECL_NOTHROW { return m_clipAnimatorManager.data(); }
@@ -126,6 +131,8 @@ public:
     void cleanupHandleList(QVector<HBlendedClipAnimator> *animators);
 
 private:
+    void batchRunningClipAnimators();
+
     QMutex m_mutex;
     QScopedPointer<AnimationClipLoaderManager> m_animationClipLoaderManager;
     QScopedPointer<ClockManager> m_clockManager;
@@ -146,8 +153,10 @@ private:
     QSharedPointer<LoadAnimationClipJob> m_loadAnimationClipJob;
     QSharedPointer<FindRunningClipAnimatorsJob> m_findRunningClipAnimatorsJob;
     QVector<QSharedPointer<EvaluateClipAnimatorJob>> m_evaluateClipAnimatorJobs;
+    QVector<QVector<HClipAnimator>> m_clipAnimatorBatches;
     QVector<EvaluateBlendClipAnimatorJobPtr> m_evaluateBlendClipAnimatorJobs;
     BuildBlendTreesJobPtr m_buildBlendTreesJob;
+    int m_clipAnimatorBatchSize;
 
     qint64 m_simulationTime;
 
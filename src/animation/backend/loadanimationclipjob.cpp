@@ -37,6 +37,7 @@
 #include "loadanimationclipjob_p.h"
 
 #include <Qt3DCore/private/qaspectmanager_p.h>
+#include <Qt3DCore/private/qnodebatchlookup_p.h>
 #include <Qt3DAnimation/qanimationcliploader.h>
 #include <Qt3DAnimation/private/qanimationcliploader_p.h>
 #include <Qt3DAnimation/private/animationclip_p.h>
@@ -53,16 +54,29 @@ namespace Animation {
 class LoadAnimationClipJobPrivate : public Qt3DCore::QAspectJobPrivate
 {
 public:
-    LoadAnimationClipJobPrivate() { }
+    explicit LoadAnimationClipJobPrivate(LoadAnimationClipJob *q) : q_ptr(q) { }
     ~LoadAnimationClipJobPrivate() override { }
 
+    bool isBackground() const override { return !m_clipFiles.isEmpty(); }
     void postFrame(Qt3DCore::QAspectManager *manager) override;
 
+    struct ClipFile
+    {
+        Qt3DCore::QNodeId clipId;
+        QUrl source;
+        AnimationClip::AnimationFileData data;
+    };
+    // Files loaded in the background, set on the clips in postFrame
+    QVector<ClipFile> m_clipFiles;
     QVector<AnimationClip *> m_updatedNodes;
+
+    Q_DECLARE_PUBLIC(LoadAnimationClipJob)
+private:
+    LoadAnimationClipJob *q_ptr;
 };
 
 LoadAnimationClipJob::LoadAnimationClipJob()
-    : Qt3DCore::QAspectJob(*new LoadAnimationClipJobPrivate)
+    : Qt3DCore::QAspectJob(*new LoadAnimationClipJobPrivate(this))
     , m_animationClipHandles()
     , m_handler(nullptr)
 {
@@ -82,11 +96,22 @@ void LoadAnimationClipJob::clearDirtyAnimationClips()
     m_animationClipHandles.clear();
 }
 
+// Captures the file of a QAnimationClipLoader, on the aspect thread, so that
+// the job reads it in the background without accessing the clip
+void LoadAnimationClipJob::addAnimationClipFile(const AnimationClip *animationClip)
+{
+    Q_D(LoadAnimationClipJob);
+    d->m_clipFiles.push_back({ animationClip->peerId(), animationClip->source(), {} });
+}
+
 void LoadAnimationClipJob::run()
 {
     Q_ASSERT(m_handler);
     Q_D(LoadAnimationClipJob);
 
+    for (LoadAnimationClipJobPrivate::ClipFile &clipFile : d->m_clipFiles)
+        clipFile.data = AnimationClip::loadAnimationFile(clipFile.source);
+
     d->m_updatedNodes.reserve(m_animationClipHandles.size());
     AnimationClipLoaderManager *animationClipManager = m_handler->animationClipLoaderManager();
     for (const auto &animationClipHandle : qAsConst(m_animationClipHandles)) {
@@ -101,15 +126,35 @@ void LoadAnimationClipJob::run()
 
 void LoadAnimationClipJobPrivate::postFrame(Qt3DCore::QAspectManager *manager)
 {
-    for (AnimationClip *clip: qAsConst(m_updatedNodes)) {
-        QAbstractAnimationClip *node = qobject_cast<QAbstractAnimationClip *>(manager->lookupNode(clip->peerId()));
+    Q_Q(LoadAnimationClipJob);
+    AnimationClipLoaderManager *animationClipManager = q->handler()->animationClipLoaderManager();
+    const QVector<ClipFile> clipFiles = std::move(m_clipFiles);
+    for (const ClipFile &clipFile : clipFiles) {
+        // Skip the clips destroyed or given a new source while loading
+        AnimationClip *animationClip = animationClipManager->lookupResource(clipFile.clipId);
+        if (!animationClip || animationClip->source() != clipFile.source)
+            continue;
+        animationClip->setAnimationFileData(clipFile.data);
+        m_updatedNodes.push_back(animationClip);
+    }
+
+    QVector<Qt3DCore::QNodeId> ids;
+    ids.reserve(m_updatedNodes.size());
+    for (AnimationClip *clip: qAsConst(m_updatedNodes))
+        ids.push_back(clip->peerId());
+    // durationChanged handlers may delete the clips that follow
+    Qt3DCore::QNodeBatchLookup nodes(ids.isEmpty() ? nullptr : manager, ids);
+
+    for (int i = 0, m = m_updatedNodes.size(); i < m; ++i) {
+        AnimationClip *clip = m_updatedNodes.at(i);
+        QAbstractAnimationClip *node = qobject_cast<QAbstractAnimationClip *>(nodes.node(i));
         if (!node)
             continue;
 
         QAbstractAnimationClipPrivate *dnode = static_cast<QAbstractAnimationClipPrivate *>(Qt3DCore::QNodePrivate::get(node));
         dnode->setDuration(clip->duration());
 
-        QAnimationClipLoader *loader = qobject_cast<QAnimationClipLoader *>(node);
+        QAnimationClipLoader *loader = qobject_cast<QAnimationClipLoader *>(nodes.node(i));
         if (loader) {
             QAnimationClipLoaderPrivate *dloader = static_cast<QAnimationClipLoaderPrivate *>(dnode);
             dloader->setStatus(clip->status());
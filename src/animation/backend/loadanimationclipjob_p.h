@@ -58,6 +58,7 @@ namespace Qt3DAnimation {
 namespace Animation {
 
 class Handler;
+class AnimationClip;
 class FindGraphJob;
 class LoadAnimationClipJobPrivate;
 
@@ -71,6 +72,7 @@ public:
 
     void addDirtyAnimationClips(const QVector<HAnimationClip> &animationClipHandles);
     void clearDirtyAnimationClips();
+    void addAnimationClipFile(const AnimationClip *animationClip);
 
 protected:
     void run() override;
@@ -42,6 +42,10 @@
 
 #include <QMetaObject>
 #include <QMetaProperty>
+#if QT_CONFIG(concurrent)
+#include <QtConcurrent/QtConcurrent>
+#endif
+#include <limits>
 
 #include <Qt3DCore/qcomponent.h>
 #include <Qt3DCore/qentity.h>
@@ -89,6 +93,12 @@ void QAbstractAspectPrivate::onEngineAboutToShutdown()
 void QAbstractAspectPrivate::unregisterBackendType(const QMetaObject &mo)
 {
     m_backendCreatorFunctors.remove(&mo);
+    m_threadSafeSyncTypes.remove(&mo);
+}
+
+void QAbstractAspectPrivate::registerThreadSafeBackendSync(const QMetaObject &mo)
+{
+    m_threadSafeSyncTypes.insert(&mo);
 }
 
 /*!
@@ -181,6 +191,7 @@ void QAbstractAspect::unregisterBackendType(const QMetaObject &obj)
 {
     Q_D(QAbstractAspect);
     d->m_backendCreatorFunctors.remove(&obj);
+    d->m_threadSafeSyncTypes.remove(&obj);
 }
 
 QVariant QAbstractAspect::executeCommand(const QStringList &args)
@@ -195,23 +206,58 @@ QVector<QAspectJobPtr> QAbstractAspect::jobsToExecute(qint64 time)
     return QVector<QAspectJobPtr>();
 }
 
-QBackendNodeMapperPtr QAbstractAspectPrivate::mapperForNode(const QMetaObject *metaObj) const
+QBackendNodeMapperPtr QAbstractAspectPrivate::mapperForNode(const QMetaObject *metaObj,
+                                                            const QMetaObject **registeredMetaObj) const
 {
     Q_ASSERT(metaObj);
     QBackendNodeMapperPtr mapper;
 
     while (metaObj != nullptr && mapper.isNull()) {
         mapper = m_backendCreatorFunctors.value(metaObj);
+        if (registeredMetaObj)
+            *registeredMetaObj = metaObj;
         metaObj = metaObj->superClass();
     }
     return mapper;
 }
 
+namespace {
+
+#if QT_CONFIG(concurrent)
+const int ConcurrentSyncThreshold = 256;
+
+struct SyncFrontEndNodeFunctor
+{
+    const QAbstractAspectPrivate *aspect;
+
+    void operator ()(const QPair<QNode *, QBackendNode *> &nodeBackend) const
+    {
+        aspect->syncDirtyFrontEndNode(nodeBackend.first, nodeBackend.second, false);
+    }
+};
+#else
+const int ConcurrentSyncThreshold = std::numeric_limits<int>::max();
+#endif
+
+struct DirtyNodeBackend
+{
+    QNode *node;
+    QBackendNode *backend;
+    const QMetaObject *threadSafeType; // nullptr unless its syncs can run concurrently
+};
+
+} // anonymous
+
 void QAbstractAspectPrivate::syncDirtyFrontEndNodes(const QVector<QNode *> &nodes)
 {
+    QVector<DirtyNodeBackend> dirtyNodes;
+    dirtyNodes.reserve(nodes.size());
+    QHash<const QMetaObject *, int> threadSafeTypeCounts;
+
     for (auto node: qAsConst(nodes)) {
         const QMetaObject *metaObj = QNodePrivate::get(node)->m_typeInfo;
-        const QBackendNodeMapperPtr backendNodeMapper = mapperForNode(metaObj);
+        const QMetaObject *registeredMetaObj = nullptr;
+        const QBackendNodeMapperPtr backendNodeMapper = mapperForNode(metaObj, &registeredMetaObj);
 
         if (!backendNodeMapper)
             continue;
@@ -220,8 +266,41 @@ void QAbstractAspectPrivate::syncDirtyFrontEndNodes(const QVector<QNode *> &node
         if (!backend)
             continue;
 
-        syncDirtyFrontEndNode(node, backend, false);
+        const QMetaObject *threadSafeType = nullptr;
+        if (m_threadSafeSyncTypes.contains(registeredMetaObj)) {
+            threadSafeType = registeredMetaObj;
+            ++threadSafeTypeCounts[threadSafeType];
+        }
+        dirtyNodes.push_back({ node, backend, threadSafeType });
+    }
+
+    // Only types with enough dirty nodes to be worth a concurrent sync are
+    // grouped and synced after the others, every other node is synced in order
+    QHash<const QMetaObject *, QVector<QPair<QNode *, QBackendNode *>>> concurrentSyncs;
+    for (const DirtyNodeBackend &dirtyNode : qAsConst(dirtyNodes)) {
+        if (dirtyNode.threadSafeType != nullptr
+                && threadSafeTypeCounts.value(dirtyNode.threadSafeType) >= ConcurrentSyncThreshold)
+            concurrentSyncs[dirtyNode.threadSafeType].push_back({ dirtyNode.node, dirtyNode.backend });
+        else
+            syncDirtyFrontEndNode(dirtyNode.node, dirtyNode.backend, false);
+    }
+
+    for (const auto &typeNodes : qAsConst(concurrentSyncs))
+        syncDirtyFrontEndNodesConcurrently(typeNodes);
+}
+
+void QAbstractAspectPrivate::syncDirtyFrontEndNodesConcurrently(const QVector<QPair<QNode *, QBackendNode *>> &nodes)
+{
+#if QT_CONFIG(concurrent)
+    // The frontend is only read and the main thread waits, below the
+    // threshold the dispatch costs more than it saves
+    if (nodes.size() >= ConcurrentSyncThreshold) {
+        QtConcurrent::blockingMap(nodes.cbegin(), nodes.cend(), SyncFrontEndNodeFunctor { this });
+        return;
     }
+#endif
+    for (const auto &nodeBackend : nodes)
+        syncDirtyFrontEndNode(nodeBackend.first, nodeBackend.second, false);
 }
 
 void QAbstractAspectPrivate::syncDirtyFrontEndNode(QNode *node, QBackendNode *backend, bool firstTime) const
@@ -60,6 +60,7 @@
 #include <QtCore/private/qobject_p.h>
 
 #include <QMutex>
+#include <QSet>
 #include <QVector>
 
 QT_BEGIN_NAMESPACE
@@ -131,6 +132,7 @@ public:
     QBackendNode *createBackendNode(const NodeTreeChange &change) const;
     void clearBackendNode(const NodeTreeChange &change) const;
     void syncDirtyFrontEndNodes(const QVector<QNode *> &nodes);
+    void syncDirtyFrontEndNodesConcurrently(const QVector<QPair<QNode *, QBackendNode *>> &nodes);
     void syncDirtyEntityComponentNodes(const QVector<ComponentRelationshipChange> &nodes);
     virtual void syncDirtyFrontEndNode(QNode *node, QBackendNode *backend, bool firstTime) const;
     void sendPropertyMessages(QNode *node, QBackendNode *backend) const;
@@ -144,7 +146,12 @@ public:
 
     Q_DECLARE_PUBLIC(QAbstractAspect)
 
-    QBackendNodeMapperPtr mapperForNode(const QMetaObject *metaObj) const;
+    QBackendNodeMapperPtr mapperForNode(const QMetaObject *metaObj,
+                                        const QMetaObject **registeredMetaObj = nullptr) const;
+
+    // The backends of that type only modify themselves and call thread-safe
+    // methods from syncFromFrontEnd, so different nodes can be synced in parallel
+    void registerThreadSafeBackendSync(const QMetaObject &mo);
 
     QEntity *m_root;
     QNodeId m_rootId;
@@ -152,6 +159,7 @@ public:
     QAbstractAspectJobManager *m_jobManager;
     QChangeArbiter *m_arbiter;
     QHash<const QMetaObject*, QBackendNodeMapperPtr> m_backendCreatorFunctors;
+    QSet<const QMetaObject*> m_threadSafeSyncTypes;
     QMutex m_singleShotMutex;
     QVector<QAspectJobPtr> m_singleShotJobs;
 
@@ -60,6 +60,7 @@
 #include <Qt3DCore/private/qservicelocator_p.h>
 #include <Qt3DCore/private/qsysteminformationservice_p_p.h>
 #include <Qt3DCore/private/qthreadpooler_p.h>
+#include <Qt3DCore/private/qworkstealingjobmanager_p.h>
 #include <Qt3DCore/private/qtickclock_p.h>
 #include <Qt3DCore/private/qtickclockservice_p.h>
 #include <Qt3DCore/private/qnodevisitor_p.h>
@@ -112,6 +113,19 @@ int RequestFrameEvent::requestEventType = QEvent::registerEventType();
 } // anonymous
 #endif
 
+namespace {
+
+QAbstractAspectJobManager *createJobManager(QAspectManager *manager)
+{
+    // QT3D_JOB_MANAGER=workstealing selects the work-stealing executor
+    // instead of the default QThreadPool based one
+    if (qgetenv("QT3D_JOB_MANAGER") == QByteArrayLiteral("workstealing"))
+        return new QWorkStealingJobManager(manager);
+    return new QAspectJobManager(manager);
+}
+
+} // anonymous
+
 /*!
     \class Qt3DCore::QAspectManager
     \internal
@@ -121,7 +135,7 @@ QAspectManager::QAspectManager(QAspectEngine *parent)
     , m_engine(parent)
     , m_root(nullptr)
     , m_scheduler(new QScheduler(this))
-    , m_jobManager(new QAspectJobManager(this))
+    , m_jobManager(createJobManager(this))
     , m_changeArbiter(new QChangeArbiter(this))
     , m_serviceLocator(new QServiceLocator(parent))
     , m_simulationLoopRunning(false)
@@ -209,6 +223,9 @@ void QAspectManager::exitSimulationLoop()
     if (frameAdvanceService)
         frameAdvanceService->stop();
 
+    // Background loading jobs reference backend nodes that are about to go
+    m_scheduler->cancelBackgroundJobs();
+
     // Give any aspects a chance to unqueue any asynchronous work they
     // may have scheduled that would otherwise potentially deadlock or
     // cause races. For example, the QLogicAspect queues up a vector of
@@ -383,6 +400,8 @@ void QAspectManager::unregisterAspect(Qt3DCore::QAbstractAspect *aspect)
 {
     qCDebug(Aspects) << "Unregistering aspect";
     Q_ASSERT(aspect);
+    // Other aspects keep loading, their nodes would stay Loading otherwise
+    m_scheduler->cancelBackgroundJobs(aspect);
     aspect->onUnregistered();
     QAbstractAspectPrivate::get(aspect)->m_arbiter = nullptr;
     QAbstractAspectPrivate::get(aspect)->m_jobManager = nullptr;
@@ -449,6 +468,16 @@ QVector<QNode *> QAspectManager::lookupNodes(const QVector<QNodeId> &ids) const
     return d->m_scene ? d->m_scene->lookupNodes(ids) : QVector<QNode *>{};
 }
 
+int QAspectManager::destructionGeneration() const
+{
+    // Without a scene lookupNodes() resolves nothing, there is nothing to track
+    if (!m_root)
+        return 0;
+
+    QNodePrivate *d = QNodePrivate::get(m_root);
+    return d->m_scene ? d->m_scene->destructionGeneration() : 0;
+}
+
 QScene *QAspectManager::scene() const
 {
     if (!m_root)
@@ -522,6 +551,7 @@ void QAspectManager::processFrame()
     {
         // scope for QTaskLogger
         QTaskLogger logger(m_serviceLocator->systemInformation(), 4096, 0, QTaskLogger::AspectJob);
+        logger.setName(QStringLiteral("SyncFrontEndChanges"));
 
         // Tell the NodePostConstructorInit to process any pending nodes which will add them to our list of
         // tree changes
@@ -553,9 +583,14 @@ void QAspectManager::processFrame()
 
         // Sync property updates
         const auto dirtyFrontEndNodes = m_changeArbiter->takeDirtyFrontEndNodes();
-        if (dirtyFrontEndNodes.size())
+        if (dirtyFrontEndNodes.size()) {
             for (QAbstractAspect *aspect : qAsConst(m_aspects))
                 QAbstractAspectPrivate::get(aspect)->syncDirtyFrontEndNodes(dirtyFrontEndNodes);
+
+            // Every aspect has seen the changed properties
+            for (QNode *node : dirtyFrontEndNodes)
+                QNodePrivate::get(node)->clearDirtyProperties();
+        }
     }
 
     // For each Aspect
@@ -121,6 +121,7 @@ public:
 
     QNode *lookupNode(QNodeId id) const override;
     QVector<QNode *> lookupNodes(const QVector<QNodeId> &ids) const override;
+    int destructionGeneration() const override;
     QScene *scene() const;
 
     int jobsInLastFrame() const { return m_jobsInLastFrame; }
@@ -9,7 +9,8 @@ HEADERS += \
     $$PWD/qt3dcore_global_p.h \
     $$PWD/qurlhelper_p.h \
     $$PWD/qscene_p.h \
-    $$PWD/qabstractfrontendnodemanager.h
+    $$PWD/qabstractfrontendnodemanager.h \
+    $$PWD/qnodebatchlookup_p.h
 
 SOURCES += \
     $$PWD/qtickclock.cpp \
@@ -18,4 +19,5 @@ SOURCES += \
     $$PWD/corelogging.cpp \
     $$PWD/qurlhelper.cpp \
     $$PWD/qscene.cpp \
-    $$PWD/qabstractfrontendnodemanager.cpp
+    $$PWD/qabstractfrontendnodemanager.cpp \
+    $$PWD/qnodebatchlookup.cpp
@@ -0,0 +1,309 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "boundingvolumekernels_p.h"
+
+#include <Qt3DCore/private/vector3d_p.h>
+#include <private/qsimd_p.h>
+
+#if QT_CONFIG(qt3d_simd_avx2) && defined(__AVX2__) && defined(QT_COMPILER_SUPPORTS_AVX2)
+#define QT3D_BOUNDINGVOLUME_AVX2
+#define QT3D_BOUNDINGVOLUME_SSE2
+
+// Some GCC versions don't have _mm256_set_m128 available
+#ifndef _mm256_set_m128
+#define _mm256_set_m128(va, vb) \
+        _mm256_insertf128_ps(_mm256_castps128_ps256(vb), va, 1)
+#endif
+#elif QT_CONFIG(qt3d_simd_sse2) && defined(__SSE2__) && defined(QT_COMPILER_SUPPORTS_SSE2)
+#define QT3D_BOUNDINGVOLUME_SSE2
+#endif
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DCore {
+
+namespace BoundingVolumeKernels {
+
+namespace {
+
+// The visitor based calculators compute (p - reference).lengthSquared(),
+// which sums the squared components as (x + y) + z with every SIMD flavor
+// of Vector3D as well as with QVector3D. The kernels below must perform the
+// same operations in the same order to return the same point.
+Q_ALWAYS_INLINE float distanceSquared(const float *p, const float *reference)
+{
+    const float dx = p[0] - reference[0];
+    const float dy = p[1] - reference[1];
+    const float dz = p[2] - reference[2];
+    return (dx * dx + dy * dy) + dz * dz;
+}
+
+#ifdef QT3D_BOUNDINGVOLUME_SSE2
+
+// Loads (x, y, z, 0) without reading past z, the last position
+// of a tightly packed buffer being at the very end of the buffer
+Q_ALWAYS_INLINE __m128 loadPoint(const float *p)
+{
+    const __m128 xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double *>(p)));
+    return _mm_movelh_ps(xy, _mm_load_ss(p + 2));
+}
+
+// Loads 4 positions and transposes them into x, y and z rows
+Q_ALWAYS_INLINE void loadPoints4(const float *p, uint stride, __m128 &x, __m128 &y, __m128 &z)
+{
+    __m128 p0 = loadPoint(p);
+    __m128 p1 = loadPoint(p + stride);
+    __m128 p2 = loadPoint(p + 2 * stride);
+    __m128 p3 = loadPoint(p + 3 * stride);
+    _MM_TRANSPOSE4_PS(p0, p1, p2, p3);
+    x = p0;
+    y = p1;
+    z = p2;
+}
+
+#endif
+
+} // anonymous
+
+void findExtents(const float *coordinates, uint stride, uint count,
+                 QVector3D &min, QVector3D &max)
+{
+    Q_ASSERT(count > 0);
+
+    // min/max are updated on strictly smaller/greater values only, like
+    // FindExtremePoints does. The components of each position are kept
+    // together in a register rather than spread over lanes so that they
+    // are visited in the same order, which also preserves the scalar
+    // handling of NaN and signed zeros. The loop is bound by memory
+    // bandwidth rather than by the min/max latency.
+#ifdef QT3D_BOUNDINGVOLUME_SSE2
+    __m128 vMin = loadPoint(coordinates);
+    __m128 vMax = vMin;
+    for (uint i = 1; i < count; ++i) {
+        coordinates += stride;
+        const __m128 p = loadPoint(coordinates);
+        // _mm_min_ps(a, b) returns a < b ? a : b
+        vMin = _mm_min_ps(p, vMin);
+        vMax = _mm_max_ps(p, vMax);
+    }
+
+    float minValues[4];
+    float maxValues[4];
+    _mm_storeu_ps(minValues, vMin);
+    _mm_storeu_ps(maxValues, vMax);
+    min = QVector3D(minValues[0], minValues[1], minValues[2]);
+    max = QVector3D(maxValues[0], maxValues[1], maxValues[2]);
+#else
+    float xMin = coordinates[0], yMin = coordinates[1], zMin = coordinates[2];
+    float xMax = xMin, yMax = yMin, zMax = zMin;
+    for (uint i = 1; i < count; ++i) {
+        coordinates += stride;
+        const float x = coordinates[0];
+        const float y = coordinates[1];
+        const float z = coordinates[2];
+        if (x < xMin)
+            xMin = x;
+        if (x > xMax)
+            xMax = x;
+        if (y < yMin)
+            yMin = y;
+        if (y > yMax)
+            yMax = y;
+        if (z < zMin)
+            zMin = z;
+        if (z > zMax)
+            zMax = z;
+    }
+    min = QVector3D(xMin, yMin, zMin);
+    max = QVector3D(xMax, yMax, zMax);
+#endif
+}
+
+int findFurthestPoint(const float *coordinates, uint stride, uint count,
+                      const QVector3D &reference)
+{
+    // FindMaxDistantPoint keeps the last point whose distance is >= to the
+    // largest distance seen so far, starting from 0. This is the last point
+    // at the largest distance, points with NaN distances never being picked.
+    // Each lane tracks the last point at its own largest distance, the lanes
+    // are then merged keeping the highest index amongst the furthest ones.
+    const float ref[3] = { reference.x(), reference.y(), reference.z() };
+    float maxDistance = 0.0f;
+    int furthest = -1;
+    uint i = 0;
+
+#if defined(QT3D_BOUNDINGVOLUME_AVX2)
+    if (count >= 8) {
+        const __m256 refX = _mm256_set1_ps(ref[0]);
+        const __m256 refY = _mm256_set1_ps(ref[1]);
+        const __m256 refZ = _mm256_set1_ps(ref[2]);
+        __m256 laneMax = _mm256_setzero_ps();
+        __m256i laneIndex = _mm256_set1_epi32(-1);
+        __m256i index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        const __m256i indexStep = _mm256_set1_epi32(8);
+
+        for (; i + 8 <= count; i += 8) {
+            const float *p = coordinates + size_t(i) * stride;
+            __m128 x0, y0, z0, x1, y1, z1;
+            loadPoints4(p, stride, x0, y0, z0);
+            loadPoints4(p + 4 * stride, stride, x1, y1, z1);
+            const __m256 dx = _mm256_sub_ps(_mm256_set_m128(x1, x0), refX);
+            const __m256 dy = _mm256_sub_ps(_mm256_set_m128(y1, y0), refY);
+            const __m256 dz = _mm256_sub_ps(_mm256_set_m128(z1, z0), refZ);
+            const __m256 distance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx),
+                                                                _mm256_mul_ps(dy, dy)),
+                                                  _mm256_mul_ps(dz, dz));
+            // Ordered comparison, false for NaN distances
+            const __m256 mask = _mm256_cmp_ps(distance, laneMax, _CMP_GE_OQ);
+            laneMax = _mm256_blendv_ps(laneMax, distance, mask);
+            laneIndex = _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(laneIndex),
+                                                             _mm256_castsi256_ps(index),
+                                                             mask));
+            index = _mm256_add_epi32(index, indexStep);
+        }
+
+        float maxValues[8];
+        int indices[8];
+        _mm256_storeu_ps(maxValues, laneMax);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(indices), laneIndex);
+        for (int lane = 0; lane < 8; ++lane) {
+            if (indices[lane] < 0)
+                continue;
+            if (maxValues[lane] > maxDistance
+                    || (maxValues[lane] == maxDistance && indices[lane] > furthest)) {
+                maxDistance = maxValues[lane];
+                furthest = indices[lane];
+            }
+        }
+    }
+#elif defined(QT3D_BOUNDINGVOLUME_SSE2)
+    if (count >= 4) {
+        const __m128 refX = _mm_set1_ps(ref[0]);
+        const __m128 refY = _mm_set1_ps(ref[1]);
+        const __m128 refZ = _mm_set1_ps(ref[2]);
+        __m128 laneMax = _mm_setzero_ps();
+        __m128i laneIndex = _mm_set1_epi32(-1);
+        __m128i index = _mm_setr_epi32(0, 1, 2, 3);
+        const __m128i indexStep = _mm_set1_epi32(4);
+
+        for (; i + 4 <= count; i += 4) {
+            __m128 x, y, z;
+            loadPoints4(coordinates + size_t(i) * stride, stride, x, y, z);
+            const __m128 dx = _mm_sub_ps(x, refX);
+            const __m128 dy = _mm_sub_ps(y, refY);
+            const __m128 dz = _mm_sub_ps(z, refZ);
+            const __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx),
+                                                          _mm_mul_ps(dy, dy)),
+                                               _mm_mul_ps(dz, dz));
+            // Ordered comparison, false for NaN distances
+            const __m128 mask = _mm_cmpge_ps(distance, laneMax);
+            const __m128i indexMask = _mm_castps_si128(mask);
+            laneMax = _mm_or_ps(_mm_and_ps(mask, distance), _mm_andnot_ps(mask, laneMax));
+            laneIndex = _mm_or_si128(_mm_and_si128(indexMask, index),
+                                     _mm_andnot_si128(indexMask, laneIndex));
+            index = _mm_add_epi32(index, indexStep);
+        }
+
+        float maxValues[4];
+        int indices[4];
+        _mm_storeu_ps(maxValues, laneMax);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(indices), laneIndex);
+        for (int lane = 0; lane < 4; ++lane) {
+            if (indices[lane] < 0)
+                continue;
+            if (maxValues[lane] > maxDistance
+                    || (maxValues[lane] == maxDistance && indices[lane] > furthest)) {
+                maxDistance = maxValues[lane];
+                furthest = indices[lane];
+            }
+        }
+    }
+#endif
+
+    // Remaining positions, all of them when no SIMD is available
+    for (; i < count; ++i) {
+        const float distance = distanceSquared(coordinates + size_t(i) * stride, ref);
+        if (distance >= maxDistance) {
+            maxDistance = distance;
+            furthest = int(i);
+        }
+    }
+
+    return furthest;
+}
+
+bool computeBoundingVolume(const float *coordinates, uint stride, uint count,
+                           QVector3D &min, QVector3D &max,
+                           QVector3D &center, float &radius)
+{
+    if (count == 0)
+        return false;
+
+    findExtents(coordinates, stride, count, min, max);
+
+    const auto pointAt = [coordinates, stride] (int index) {
+        // FindMaxDistantPoint leaves its default point if none was picked
+        if (index < 0)
+            return Vector3D();
+        const float *p = coordinates + size_t(index) * stride;
+        return Vector3D(p[0], p[1], p[2]);
+    };
+
+    // Same passes as the BoundingVolumeCalculators: furthest point y from the
+    // first position, furthest point z from y, then the furthest point from
+    // the middle of [y, z] gives the radius
+    const QVector3D first(coordinates[0], coordinates[1], coordinates[2]);
+    const Vector3D y = pointAt(findFurthestPoint(coordinates, stride, count, first));
+    const Vector3D z = pointAt(findFurthestPoint(coordinates, stride, count,
+                                                 QVector3D(y.x(), y.y(), y.z())));
+    const Vector3D c = (y + z) * 0.5f;
+    const Vector3D furthestFromCenter = pointAt(findFurthestPoint(coordinates, stride, count,
+                                                                  QVector3D(c.x(), c.y(), c.z())));
+
+    center = QVector3D(c.x(), c.y(), c.z());
+    radius = (c - furthestFromCenter).length();
+    return true;
+}
+
+} // namespace BoundingVolumeKernels
+
+} // namespace Qt3DCore
+
+QT_END_NAMESPACE
@@ -0,0 +1,90 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QT3DCORE_BOUNDINGVOLUMEKERNELS_P_H
+#define QT3DCORE_BOUNDINGVOLUMEKERNELS_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of other Qt classes.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <Qt3DCore/private/qt3dcore_global_p.h>
+#include <QtGui/qvector3d.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DCore {
+
+// Bounding volume computation over non indexed float positions.
+//
+// coordinates points to the x component of the first position, consecutive
+// positions being stride floats apart (3 for tightly packed positions).
+// These produce exactly the same results as visiting the positions one by one
+// with a Buffer3fVisitor, using SSE2 or AVX2 when Qt3D was built with it.
+namespace BoundingVolumeKernels {
+
+// Component wise min and max of the positions, count must be > 0
+Q_3DCORE_PRIVATE_EXPORT void findExtents(const float *coordinates, uint stride, uint count,
+                                         QVector3D &min, QVector3D &max);
+
+// Index of the last of the positions which are the furthest away from
+// reference, -1 if no position could be compared (NaN coordinates)
+Q_3DCORE_PRIVATE_EXPORT int findFurthestPoint(const float *coordinates, uint stride, uint count,
+                                              const QVector3D &reference);
+
+// Extents and bounding sphere, the sphere being fitted with the same
+// passes as the BoundingVolumeCalculators. Returns false if count is 0.
+Q_3DCORE_PRIVATE_EXPORT bool computeBoundingVolume(const float *coordinates, uint stride, uint count,
+                                                   QVector3D &min, QVector3D &max,
+                                                   QVector3D &center, float &radius);
+
+} // namespace BoundingVolumeKernels
+
+} // namespace Qt3DCore
+
+QT_END_NAMESPACE
+
+#endif // QT3DCORE_BOUNDINGVOLUMEKERNELS_P_H
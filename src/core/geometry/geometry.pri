@@ -14,7 +14,8 @@ HEADERS += \
     $$PWD/qgeometryview_p.h \
     $$PWD/qgeometryview.h \
     $$PWD/bufferutils_p.h \
-    $$PWD/buffervisitor_p.h
+    $$PWD/buffervisitor_p.h \
+    $$PWD/boundingvolumekernels_p.h
 
 SOURCES += \
     $$PWD/qabstractfunctor.cpp \
@@ -24,3 +25,14 @@ SOURCES += \
     $$PWD/qgeometry.cpp \
     $$PWD/qgeometryview.cpp
 
+
+# The bounding volume kernels use SSE2 or AVX2 intrinsics when enabled
+qtConfig(qt3d-simd-avx2) {
+    CONFIG += simd
+    AVX2_SOURCES += $$PWD/boundingvolumekernels.cpp
+} else: qtConfig(qt3d-simd-sse2) {
+    CONFIG += simd
+    SSE2_SOURCES += $$PWD/boundingvolumekernels.cpp
+} else {
+    SOURCES += $$PWD/boundingvolumekernels.cpp
+}
@@ -41,6 +41,7 @@
 #include "qgeometryview_p.h"
 #include "qgeometry_p.h"
 #include "buffervisitor_p.h"
+#include "boundingvolumekernels_p.h"
 
 #include <Qt3DCore/QAttribute>
 #include <Qt3DCore/QBuffer>
@@ -234,6 +235,29 @@ bool BoundingVolumeCalculator::apply(QAttribute *positionAttribute,
 {
     m_radius = -1.f;
 
+    if (!indexAttribute
+            && positionAttribute->vertexBaseType() == QAttribute::Float
+            && positionAttribute->vertexSize() >= 3) {
+        // Non indexed positions, point clouds in particular, are processed
+        // with kernels giving the same results as the visitors below
+        if (!positionAttribute->buffer())
+            return false;
+        const QByteArray data = positionAttribute->buffer()->data();
+        const uint byteStride = positionAttribute->byteStride();
+        const float *coordinates = BufferTypeInfo::castToType<QAttribute::Float>(data, positionAttribute->byteOffset());
+        QVector3D center;
+        float radius = -1.f;
+        if (!BoundingVolumeKernels::computeBoundingVolume(coordinates,
+                                                          byteStride ? byteStride / sizeof(float) : 3,
+                                                          uint(drawVertexCount),
+                                                          m_min, m_max, center, radius))
+            return false;
+
+        m_radius = radius;
+        m_center = center;
+        return true;
+    }
+
     FindExtremePoints findExtremePoints;
     if (!findExtremePoints.apply(positionAttribute, indexAttribute, drawVertexCount,
                                  primitiveRestartEnabled, primitiveRestartIndex)) {
@@ -89,7 +89,7 @@ public:
     bool m_dirty;
 };
 
-class BoundingVolumeCalculator
+class Q_AUTOTEST_EXPORT BoundingVolumeCalculator
 {
 public:
     BoundingVolumeCalculator() = default;
@@ -4,6 +4,8 @@ SOURCES += \
     $$PWD/qaspectjobmanager.cpp \
     $$PWD/qabstractaspectjobmanager.cpp \
     $$PWD/qthreadpooler.cpp \
+    $$PWD/qworkstealingexecutor.cpp \
+    $$PWD/qworkstealingjobmanager.cpp \
     $$PWD/task.cpp \
     $$PWD/calcboundingvolumejob.cpp
 
@@ -15,6 +17,8 @@ HEADERS += \
     $$PWD/qabstractaspectjobmanager_p.h \
     $$PWD/task_p.h \
     $$PWD/qthreadpooler_p.h \
+    $$PWD/qworkstealingexecutor_p.h \
+    $$PWD/qworkstealingjobmanager_p.h \
     $$PWD/calcboundingvolumejob_p.h \
     $$PWD/job_common_p.h
 
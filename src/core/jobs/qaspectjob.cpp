@@ -80,6 +80,11 @@ void QAspectJobPrivate::postFrame(QAspectManager *aspectManager)
     Q_UNUSED(aspectManager)
 }
 
+bool QAspectJobPrivate::isBackground() const
+{
+    return false;
+}
+
 QAspectJob::QAspectJob()
     : d_ptr(new QAspectJobPrivate)
 {
@@ -75,6 +75,10 @@ public:
     virtual bool isRequired() const;
     virtual void postFrame(QAspectManager *aspectManager);
 
+    // Background jobs span several frames: the scheduler runs them on the
+    // loader pool without waiting and calls postFrame once they completed
+    virtual bool isBackground() const;
+
     void clearDependencies() { m_dependencies.clear(); }
 
     QVector<QWeakPointer<QAspectJob> > m_dependencies;
@@ -101,7 +101,7 @@ void QAspectJobManager::enqueueJobs(const QVector<QAspectJobPtr> &jobQueue)
             }
         }
 
-        taskDepender->m_dependerCount += dependerCount;
+        taskDepender->m_dependerCount.fetchAndAddRelaxed(dependerCount);
     }
 
     m_threadPooler->mapDependables(taskList);
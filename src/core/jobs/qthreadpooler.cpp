@@ -83,7 +83,7 @@ void QThreadPooler::enqueueTasks(const QVector<RunnableInterface *> &tasks)
         // Only AspectTaskRunnables are checked for dependencies.
         static const auto hasDependencies = [](RunnableInterface *task) -> bool {
             return (task->type() == RunnableInterface::RunnableType::AspectTask)
-                    && (static_cast<AspectTaskRunnable *>(task)->m_dependerCount > 0);
+                    && (static_cast<AspectTaskRunnable *>(task)->m_dependerCount.loadAcquire() > 0);
         };
 
         if (!hasDependencies(*it) && !(*it)->reserved()) {
@@ -122,7 +122,7 @@ void QThreadPooler::enqueueDepencies(RunnableInterface *task)
         const auto &dependers = aspectTask->m_dependers;
         for (auto it = dependers.begin(); it != dependers.end(); ++it) {
             AspectTaskRunnable *dependerTask = static_cast<AspectTaskRunnable *>(*it);
-            if (--dependerTask->m_dependerCount == 0) {
+            if (!dependerTask->m_dependerCount.deref()) {
                 if (!dependerTask->reserved()) {
                     dependerTask->setReserved(true);
                     if ((*it)->isRequired()) {
@@ -0,0 +1,269 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qworkstealingexecutor_p.h"
+
+#include <Qt3DCore/private/task_p.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DCore {
+
+QWorkStealingWorker::QWorkStealingWorker(QWorkStealingExecutor *executor, int index)
+    : QThread()
+    , m_executor(executor)
+    , m_index(index)
+{
+    setObjectName(QStringLiteral("Qt3D WorkStealing Worker %1").arg(index));
+}
+
+void QWorkStealingWorker::run()
+{
+    m_executor->workerLoop(this);
+}
+
+void QWorkStealingWorker::push(RunnableInterface *task)
+{
+    const QMutexLocker locker(&m_dequeMutex);
+    m_deque.push_back(task);
+}
+
+RunnableInterface *QWorkStealingWorker::pop()
+{
+    const QMutexLocker locker(&m_dequeMutex);
+    if (m_deque.empty())
+        return nullptr;
+    RunnableInterface *task = m_deque.back();
+    m_deque.pop_back();
+    return task;
+}
+
+RunnableInterface *QWorkStealingWorker::steal()
+{
+    const QMutexLocker locker(&m_dequeMutex);
+    if (m_deque.empty())
+        return nullptr;
+    RunnableInterface *task = m_deque.front();
+    m_deque.pop_front();
+    return task;
+}
+
+/*!
+    \class Qt3DCore::QWorkStealingExecutor
+    \internal
+
+    Runs RunnableInterface task graphs on a dedicated set of worker threads,
+    each owning its own task deque. Workers take work from the back of their
+    own deque and steal from the front of the others' when they run dry.
+
+    Dependencies are resolved without any global lock: finishing a task
+    atomically decrements the pending dependency count of each depender and
+    the worker that brings a count to zero takes ownership of that depender.
+    The first ready depender is run inline on the finishing worker, the
+    others are pushed to its local deque where idle workers can steal them.
+*/
+QWorkStealingExecutor::QWorkStealingExecutor(int threadCount)
+    : m_queuedCount(0)
+    , m_pendingCount(0)
+    , m_sleepingCount(0)
+    , m_totalRunJobs(0)
+    , m_quit(false)
+    , m_nextWorker(0)
+{
+    if (threadCount <= 0) {
+        threadCount = QThread::idealThreadCount();
+        const QByteArray maxThreadCount = qgetenv("QT3D_MAX_THREAD_COUNT");
+        if (!maxThreadCount.isEmpty()) {
+            bool conversionOK = false;
+            const int maxThreadCountValue = maxThreadCount.toInt(&conversionOK);
+            if (conversionOK)
+                threadCount = maxThreadCountValue;
+        }
+    }
+    threadCount = qMax(1, threadCount);
+
+    m_workers.reserve(threadCount);
+    for (int i = 0; i < threadCount; ++i)
+        m_workers.push_back(new QWorkStealingWorker(this, i));
+    for (QWorkStealingWorker *worker : qAsConst(m_workers))
+        worker->start();
+}
+
+QWorkStealingExecutor::~QWorkStealingExecutor()
+{
+    waitForAllJobs();
+
+    {
+        const QMutexLocker locker(&m_sleepMutex);
+        m_quit.store(true);
+        m_workAvailable.wakeAll();
+    }
+
+    for (QWorkStealingWorker *worker : qAsConst(m_workers)) {
+        worker->wait();
+        delete worker;
+    }
+}
+
+// Main thread
+void QWorkStealingExecutor::submit(const QVector<RunnableInterface *> &tasks)
+{
+    // Account for the whole graph upfront so that the pending count can't
+    // reach zero while we are still enqueuing the roots
+    m_pendingCount.fetch_add(tasks.size());
+
+    for (RunnableInterface *task : tasks) {
+        // Only AspectTaskRunnables are checked for dependencies. Tasks with
+        // pending dependencies are enqueued by whoever completes the last one.
+        const bool hasDependencies = task->type() == RunnableInterface::RunnableType::AspectTask
+                && static_cast<AspectTaskRunnable *>(task)->m_dependerCount.loadAcquire() > 0;
+        if (hasDependencies || task->reserved())
+            continue;
+        task->setReserved(true);
+        enqueue(task, nullptr);
+    }
+}
+
+// Main thread
+int QWorkStealingExecutor::waitForAllJobs()
+{
+    QMutexLocker locker(&m_finishedMutex);
+    while (m_pendingCount.load() > 0)
+        m_allFinished.wait(&m_finishedMutex);
+    return m_totalRunJobs.exchange(0);
+}
+
+// Worker threads
+void QWorkStealingExecutor::workerLoop(QWorkStealingWorker *worker)
+{
+    while (!m_quit.load()) {
+        RunnableInterface *task = findWork(worker);
+
+        if (task == nullptr) {
+            QMutexLocker locker(&m_sleepMutex);
+            m_sleepingCount.fetch_add(1);
+            if (m_queuedCount.load() <= 0 && !m_quit.load())
+                m_workAvailable.wait(&m_sleepMutex);
+            m_sleepingCount.fetch_sub(1);
+            continue;
+        }
+
+        // Keep running continuations inline as long as completing a task
+        // makes one of its dependers ready
+        while (task != nullptr) {
+            if (task->isRequired()) {
+                if (task->type() == RunnableInterface::RunnableType::AspectTask)
+                    static_cast<AspectTaskRunnable *>(task)->runJob(true);
+                else
+                    task->run();
+                m_totalRunJobs.fetch_add(1);
+            }
+            task = complete(task, worker);
+        }
+    }
+}
+
+RunnableInterface *QWorkStealingExecutor::findWork(QWorkStealingWorker *worker)
+{
+    if (m_queuedCount.load() <= 0)
+        return nullptr;
+
+    RunnableInterface *task = worker->pop();
+    if (task == nullptr) {
+        const int workerCount = m_workers.size();
+        for (int i = 1; i < workerCount && task == nullptr; ++i)
+            task = m_workers.at((worker->index() + i) % workerCount)->steal();
+    }
+
+    if (task != nullptr)
+        m_queuedCount.fetch_sub(1);
+    return task;
+}
+
+// Returns the depender to run inline on the current worker, if any
+RunnableInterface *QWorkStealingExecutor::complete(RunnableInterface *task, QWorkStealingWorker *worker)
+{
+    RunnableInterface *continuation = nullptr;
+
+    if (task->type() == RunnableInterface::RunnableType::AspectTask) {
+        const auto &dependers = static_cast<AspectTaskRunnable *>(task)->m_dependers;
+        for (AspectTaskRunnable *depender : dependers) {
+            // Only the thread completing the last dependency gets to schedule the depender
+            if (depender->m_dependerCount.deref() || depender->reserved())
+                continue;
+            depender->setReserved(true);
+            if (continuation == nullptr)
+                continuation = depender;
+            else
+                enqueue(depender, worker);
+        }
+    }
+
+    delete task;
+
+    if (m_pendingCount.fetch_sub(1) == 1) {
+        const QMutexLocker locker(&m_finishedMutex);
+        m_allFinished.wakeAll();
+    }
+
+    return continuation;
+}
+
+void QWorkStealingExecutor::enqueue(RunnableInterface *task, QWorkStealingWorker *worker)
+{
+    if (worker == nullptr) {
+        worker = m_workers.at(m_nextWorker);
+        m_nextWorker = (m_nextWorker + 1) % m_workers.size();
+    }
+    worker->push(task);
+    m_queuedCount.fetch_add(1);
+    wakeSleepingWorker();
+}
+
+void QWorkStealingExecutor::wakeSleepingWorker()
+{
+    if (m_sleepingCount.load() == 0)
+        return;
+    const QMutexLocker locker(&m_sleepMutex);
+    m_workAvailable.wakeOne();
+}
+
+} // namespace Qt3DCore
+
+QT_END_NAMESPACE
@@ -0,0 +1,134 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QT3DCORE_QWORKSTEALINGEXECUTOR_P_H
+#define QT3DCORE_QWORKSTEALINGEXECUTOR_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of other Qt classes.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/QMutex>
+#include <QtCore/QThread>
+#include <QtCore/QVector>
+#include <QtCore/QWaitCondition>
+
+#include <Qt3DCore/private/qt3dcore_global_p.h>
+
+#include <atomic>
+#include <deque>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DCore {
+
+class RunnableInterface;
+class QWorkStealingExecutor;
+
+class QWorkStealingWorker : public QThread
+{
+public:
+    QWorkStealingWorker(QWorkStealingExecutor *executor, int index);
+
+    void run() override;
+
+    // Owner pushes and pops at the back, thieves take from the front
+    void push(RunnableInterface *task);
+    RunnableInterface *pop();
+    RunnableInterface *steal();
+
+    int index() const { return m_index; }
+
+private:
+    QWorkStealingExecutor *m_executor;
+    QMutex m_dequeMutex;
+    std::deque<RunnableInterface *> m_deque;
+    int m_index;
+};
+
+class Q_3DCORE_PRIVATE_EXPORT QWorkStealingExecutor
+{
+public:
+    explicit QWorkStealingExecutor(int threadCount = 0);
+    ~QWorkStealingExecutor();
+
+    void submit(const QVector<RunnableInterface *> &tasks);
+    int waitForAllJobs();
+
+    int maxThreadCount() const { return m_workers.size(); }
+
+private:
+    void workerLoop(QWorkStealingWorker *worker);
+    RunnableInterface *findWork(QWorkStealingWorker *worker);
+    RunnableInterface *complete(RunnableInterface *task, QWorkStealingWorker *worker);
+    void enqueue(RunnableInterface *task, QWorkStealingWorker *worker);
+    void wakeSleepingWorker();
+
+    QVector<QWorkStealingWorker *> m_workers;
+
+    // Number of tasks sitting in any of the deques
+    std::atomic<int> m_queuedCount;
+    // Number of submitted tasks which have not completed yet
+    std::atomic<int> m_pendingCount;
+    std::atomic<int> m_sleepingCount;
+    std::atomic<int> m_totalRunJobs;
+    std::atomic<bool> m_quit;
+    int m_nextWorker;
+
+    QMutex m_sleepMutex;
+    QWaitCondition m_workAvailable;
+
+    QMutex m_finishedMutex;
+    QWaitCondition m_allFinished;
+
+    friend class QWorkStealingWorker;
+};
+
+} // namespace Qt3DCore
+
+QT_END_NAMESPACE
+
+#endif // QT3DCORE_QWORKSTEALINGEXECUTOR_P_H
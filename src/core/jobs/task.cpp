@@ -75,11 +75,7 @@ bool AspectTaskRunnable::isRequired() const
 
 void AspectTaskRunnable::run()
 {
-    if (m_job) {
-        QAspectJobPrivate *jobD = QAspectJobPrivate::get(m_job.data());
-        QTaskLogger logger(m_pooler ? m_service : nullptr, jobD->m_jobId, QTaskLogger::AspectJob);
-        m_job->run();
-    }
+    runJob(m_pooler != nullptr);
 
     // We could have an append sub task or something in here
     // So that a job can post sub jobs ?
@@ -88,6 +84,16 @@ void AspectTaskRunnable::run()
         m_pooler->taskFinished(this);
 }
 
+void AspectTaskRunnable::runJob(bool traced)
+{
+    if (m_job) {
+        QAspectJobPrivate *jobD = QAspectJobPrivate::get(m_job.data());
+        QTaskLogger logger(traced ? m_service : nullptr, jobD->m_jobId, QTaskLogger::AspectJob);
+        logger.setName(jobD->m_jobName);
+        m_job->run();
+    }
+}
+
 // Synchronized task
 
 SyncTaskRunnable::SyncTaskRunnable(QAbstractAspectJobManager::JobFunction func,
@@ -51,6 +51,7 @@
 // We mean it.
 //
 
+#include <QtCore/QAtomicInt>
 #include <QtCore/QRunnable>
 #include <QtCore/QSharedPointer>
 #include <QtCore/QThread>
@@ -99,6 +100,7 @@ public:
 
     bool isRequired() const override;
     void run() override;
+    void runJob(bool traced);
 
     void setPooler(QThreadPooler *pooler) override { m_pooler = pooler; }
 
@@ -113,7 +115,9 @@ public:
 public:
     QSharedPointer<QAspectJob> m_job;
     QVector<AspectTaskRunnable *> m_dependers;
-    int m_dependerCount = 0;
+    // Number of dependencies not completed yet, decremented concurrently by
+    // the workers finishing them
+    QAtomicInt m_dependerCount = 0;
 
 private:
     QSystemInformationService *m_service;
@@ -71,6 +71,8 @@ QNodePrivate::QNodePrivate()
     , m_hasBackendNode(false)
     , m_enabled(true)
     , m_notifiedParent(false)
+    , m_dirtyProperties(0)
+    , m_changedPropertyBit(AllPropertiesDirty)
     , m_defaultPropertyTrackMode(QNode::TrackFinalValues)
     , m_propertyChangesSetup(false)
     , m_signals(this)
@@ -361,13 +363,14 @@ void QNodePrivate::unregisterNotifiedProperties()
 
 void QNodePrivate::propertyChanged(int propertyIndex)
 {
-    Q_UNUSED(propertyIndex)
-
     // Bail out early if we can to avoid the cost below
     if (m_blockNotifications)
         return;
 
+    // Let update() record which property changed
+    m_changedPropertyBit = propertyDirtyBit(propertyIndex);
     update();
+    m_changedPropertyBit = AllPropertiesDirty;
 }
 
 /*!
@@ -591,10 +594,41 @@ void QNodePrivate::update()
 {
     if (m_changeArbiter) {
         Q_Q(QNode);
+        m_dirtyProperties |= m_changedPropertyBit;
         m_changeArbiter->addDirtyFrontEndNode(q);
     }
 }
 
+/*!
+    \internal
+    Returns the bit of the dirty property mask used for the property at
+    \a propertyIndex.
+ */
+quint64 QNodePrivate::propertyDirtyBit(int propertyIndex)
+{
+    const int bit = propertyIndex - QNode::staticMetaObject.propertyOffset();
+    if (bit < 0)
+        return AllPropertiesDirty;
+    return quint64(1) << qMin(bit, 63);
+}
+
+/*!
+    \internal
+    Returns the dirty property mask covering \a propertyNames of \a metaObject.
+    Backends compute it once and test it with hasDirtyProperties() to skip
+    reading properties that didn't change.
+ */
+quint64 QNodePrivate::propertyDirtyMask(const QMetaObject &metaObject, std::initializer_list<const char *> propertyNames)
+{
+    quint64 mask = 0;
+    for (const char *name : propertyNames) {
+        const int propertyIndex = metaObject.indexOfProperty(name);
+        Q_ASSERT_X(propertyIndex >= 0, Q_FUNC_INFO, name);
+        mask |= propertyDirtyBit(propertyIndex);
+    }
+    return mask;
+}
+
 void QNodePrivate::markDirty(QScene::DirtyNodeSet changes)
 {
     if (m_scene)
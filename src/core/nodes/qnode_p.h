@@ -62,6 +62,8 @@
 #include <QtCore/private/qobject_p.h>
 #include <QQueue>
 
+#include <initializer_list>
+
 QT_BEGIN_NAMESPACE
 
 namespace Qt3DCore {
@@ -91,6 +93,17 @@ public:
     virtual void update();
     void markDirty(QScene::DirtyNodeSet changes);
 
+    // Bit i of the dirty property mask is set when the property at index
+    // QNode::staticMetaObject.propertyOffset() + i changed since the last
+    // sync. The last bit is shared by all higher indices and changes that
+    // aren't tied to a property set every bit.
+    static const quint64 AllPropertiesDirty = ~quint64(0);
+    static quint64 propertyDirtyBit(int propertyIndex);
+    static quint64 propertyDirtyMask(const QMetaObject &metaObject, std::initializer_list<const char *> propertyNames);
+    bool hasDirtyProperties(quint64 mask) const { return (m_dirtyProperties & mask) != 0; }
+    quint64 dirtyProperties() const { return m_dirtyProperties; }
+    void clearDirtyProperties() { m_dirtyProperties = 0; }
+
     Q_DECLARE_PUBLIC(QNode)
 
     // For now this just protects access to the m_changeArbiter.
@@ -104,6 +117,8 @@ public:
     bool m_hasBackendNode;
     bool m_enabled;
     bool m_notifiedParent;
+    quint64 m_dirtyProperties;
+    quint64 m_changedPropertyBit;
     QNode::PropertyTrackingMode m_defaultPropertyTrackMode;
     QHash<QString, QNode::PropertyTrackingMode> m_trackedPropertiesOverrides;
 
@@ -47,6 +47,11 @@ QAbstractFrontEndNodeManager::QAbstractFrontEndNodeManager() = default;
 
 QAbstractFrontEndNodeManager::~QAbstractFrontEndNodeManager() = default;
 
+int QAbstractFrontEndNodeManager::destructionGeneration() const
+{
+    return -1;
+}
+
 /*
 \fn QNode *Qt3DCore::QAbstractFrontEndNodeManager::lookupNode(QNodeId id) const
 
@@ -57,7 +62,21 @@ Returns the node instance matching the id, or nullptr if not found.
 /*
 \fn QVector<QNode *> Qt3DCore::QAbstractFrontEndNodeManager::lookupNodes(const QVector<QNodeId> &ids) const
 
-Returns the vector of node instance matching the ids.
+Returns the vector of node instance matching the ids. The returned vector has
+the same size as \a ids, entries for ids that cannot be resolved being nullptr.
+Implementations should resolve all ids in one go, which makes this the
+preferred way of looking up nodes when applying a batch of updates.
+
+*/
+
+/*
+\fn int Qt3DCore::QAbstractFrontEndNodeManager::destructionGeneration() const
+
+Returns a counter which changes each time a node stops being known to the
+manager, which lets callers holding pointers returned by lookupNodes() tell
+whether these may have been destroyed. The default implementation returns -1,
+meaning removals aren't tracked and nodes have to be looked up again before
+each use.
 
 */
 
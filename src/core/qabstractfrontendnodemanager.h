@@ -68,6 +68,7 @@ public:
 
     virtual QNode *lookupNode(QNodeId id) const = 0;
     virtual QVector<QNode *> lookupNodes(const QVector<QNodeId> &ids) const = 0;
+    virtual int destructionGeneration() const;
 
 protected:
     QAbstractFrontEndNodeManager();
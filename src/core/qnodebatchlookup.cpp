@@ -0,0 +1,71 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qnodebatchlookup_p.h"
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DCore {
+
+QNodeBatchLookup::QNodeBatchLookup(const QAbstractFrontEndNodeManager *manager,
+                                   const QVector<QNodeId> &ids)
+    : m_manager(manager)
+    , m_ids(ids)
+    , m_generation(manager ? manager->destructionGeneration() : 0)
+{
+    // Without tracking, each node has to be looked up right before its use
+    if (m_manager && m_generation >= 0)
+        m_nodes = m_manager->lookupNodes(m_ids);
+}
+
+QNode *QNodeBatchLookup::resolve(int i, int generation)
+{
+    m_generation = generation;
+    if (generation < 0)
+        return m_manager->lookupNode(m_ids.at(i));
+
+    // Nodes were destroyed since the last lookup, most likely by a slot
+    // connected to a signal emitted on a previous node of the batch
+    m_nodes = m_manager->lookupNodes(m_ids);
+    return i < m_nodes.size() ? m_nodes.at(i) : nullptr;
+}
+
+} // Qt3DCore
+
+QT_END_NAMESPACE
@@ -70,6 +70,7 @@ public:
     mutable QReadWriteLock m_nodePropertyTrackModeLock;
     QNode *m_rootNode;
     QScene::DirtyNodeSet m_dirtyBits;
+    QAtomicInt m_destructionGeneration;
 };
 
 
@@ -108,10 +109,18 @@ void QScene::removeObservable(QNode *observable)
         QWriteLocker lock(&d->m_lock);
         const QNodeId nodeUuid = observable->id();
         d->m_nodeLookupTable.remove(nodeUuid);
+        d->m_destructionGeneration.ref();
         observable->d_func()->setArbiter(nullptr);
     }
 }
 
+// Called by any thread
+int QScene::destructionGeneration() const
+{
+    Q_D(const QScene);
+    return d->m_destructionGeneration.loadRelaxed();
+}
+
 // Called by any thread
 QNode *QScene::lookupNode(QNodeId id) const
 {
@@ -120,14 +129,28 @@ QNode *QScene::lookupNode(QNodeId id) const
     return d->m_nodeLookupTable.value(id);
 }
 
+// Called by any thread
+// Resolves all ids under a single lock. The returned vector has the same
+// size as ids, nodes[i] being nullptr if ids[i] isn't known to the scene.
 QVector<QNode *> QScene::lookupNodes(const QVector<QNodeId> &ids) const
 {
     Q_D(const QScene);
-    QReadLocker lock(&d->m_lock);
     QVector<QNode *> nodes(ids.size());
-    int index = 0;
-    for (QNodeId id : ids)
-        nodes[index++] = d->m_nodeLookupTable.value(id);
+    QNodeId previousId;
+    QNode *previousNode = nullptr;
+    QNode **out = nodes.data();
+
+    QReadLocker lock(&d->m_lock);
+    const auto end = d->m_nodeLookupTable.cend();
+    for (const QNodeId id : ids) {
+        // Callers often batch several updates for the same node back to back
+        if (id != previousId) {
+            const auto it = d->m_nodeLookupTable.constFind(id);
+            previousNode = (it != end) ? it.value() : nullptr;
+            previousId = id;
+        }
+        *out++ = previousNode;
+    }
     return nodes;
 }
 
@@ -90,6 +90,7 @@ public:
 
     QNode *lookupNode(QNodeId id) const override;
     QVector<QNode *> lookupNodes(const QVector<QNodeId> &ids) const override;
+    int destructionGeneration() const override;
 
     QNode *rootNode() const;
 
@@ -49,6 +49,10 @@
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDateTime>
 #include <QtCore/QRegularExpression>
+#include <QtCore/QSemaphore>
+#include <QtCore/QSet>
+
+#include <algorithm>
 
 QT_BEGIN_NAMESPACE
 
@@ -90,14 +94,42 @@ void dumpJobs(QVector<Qt3DCore::QAspectJobPtr> jobs) {
 
 namespace Qt3DCore {
 
+struct QScheduler::BackgroundJob
+{
+    BackgroundJob(const QAspectJobPtr &aspectJob, QAbstractAspect *jobAspect)
+        : job(aspectJob), aspect(jobAspect) {}
+
+    enum RunState { Queued, Running, Cancelled };
+
+    QAspectJobPtr job;
+    QAbstractAspect *aspect;
+    bool started = false;
+    // Claimed by the loader thread before calling run(), unless cancelled first
+    QAtomicInt runState = Queued;
+    // Set by the loader thread once run() returned
+    QAtomicInt finished = 0;
+    QSemaphore done;
+};
+
 QScheduler::QScheduler(QObject *parent)
     : QObject(parent)
     , m_aspectManager(nullptr)
 {
+    // Bounds the number of assets loaded concurrently
+    int maxThreadCount = 2;
+    const QByteArray maxThreadCountEnv = qgetenv("QT3D_MAX_LOADER_THREAD_COUNT");
+    if (!maxThreadCountEnv.isEmpty()) {
+        bool conversionOK = false;
+        const int maxThreadCountValue = maxThreadCountEnv.toInt(&conversionOK);
+        if (conversionOK && maxThreadCountValue > 0)
+            maxThreadCount = maxThreadCountValue;
+    }
+    m_backgroundThreadPool.setMaxThreadCount(maxThreadCount);
 }
 
 QScheduler::~QScheduler()
 {
+    cancelBackgroundJobs();
 }
 
 void QScheduler::setAspectManager(QAspectManager *aspectManager)
@@ -123,7 +155,13 @@ int QScheduler::scheduleAndWaitForFrameAspectJobs(qint64 time, bool dumpJobs)
     const QVector<QAbstractAspect *> &aspects = m_aspectManager->aspects();
     for (QAbstractAspect *aspect : aspects) {
         const QVector<QAspectJobPtr> aspectJobs = QAbstractAspectPrivate::get(aspect)->jobsToExecute(time);
-        jobQueue << aspectJobs;
+        for (const QAspectJobPtr &job : aspectJobs) {
+            // Long running loading jobs don't hold up the frame
+            if (QAspectJobPrivate::get(job.data())->isBackground())
+                m_backgroundJobs.push_back(BackgroundJobPtr::create(job, aspect));
+            else
+                jobQueue.push_back(job);
+        }
     }
 
     if (dumpJobs)
@@ -136,12 +174,19 @@ int QScheduler::scheduleAndWaitForFrameAspectJobs(qint64 time, bool dumpJobs)
 
     int totalJobs = m_aspectManager->jobManager()->waitForAllJobs();
 
+    // Background jobs are started once the frame jobs they may depend on
+    // are done
+    startBackgroundJobs();
+
     {
         QTaskLogger logger(m_aspectManager->serviceLocator()->systemInformation(), 4097, 0, QTaskLogger::AspectJob);
+        logger.setName(QStringLiteral("PostFrame"));
 
         for (auto &job : qAsConst(jobQueue))
             job->postFrame(m_aspectManager->engine());
 
+        postFrameBackgroundJobs();
+
         for (QAbstractAspect *aspect : aspects)
             aspect->jobsDone();
     }
@@ -149,6 +194,105 @@ int QScheduler::scheduleAndWaitForFrameAspectJobs(qint64 time, bool dumpJobs)
     return totalJobs;
 }
 
+int QScheduler::maxBackgroundThreadCount() const
+{
+    return m_backgroundThreadPool.maxThreadCount();
+}
+
+void QScheduler::setMaxBackgroundThreadCount(int threadCount)
+{
+    m_backgroundThreadPool.setMaxThreadCount(qMax(1, threadCount));
+}
+
+// Number of background jobs whose results were not committed yet
+int QScheduler::pendingBackgroundJobCount() const
+{
+    return m_backgroundJobs.size();
+}
+
+// Drops the background jobs not started yet and waits for the running ones.
+// Their results are discarded, postFrame isn't called.
+void QScheduler::cancelBackgroundJobs()
+{
+    m_backgroundThreadPool.clear();
+    m_backgroundThreadPool.waitForDone();
+    m_backgroundJobs.clear();
+}
+
+// Cancels the background jobs of aspect only, the jobs of the other aspects
+// keep loading. Waits for the jobs of aspect already running.
+void QScheduler::cancelBackgroundJobs(QAbstractAspect *aspect)
+{
+    auto it = m_backgroundJobs.begin();
+    while (it != m_backgroundJobs.end()) {
+        const BackgroundJobPtr &backgroundJob = *it;
+        if (backgroundJob->aspect != aspect) {
+            ++it;
+            continue;
+        }
+
+        // A job still queued in the pool won't run, otherwise wait for it
+        if (backgroundJob->started
+                && !backgroundJob->runState.testAndSetOrdered(BackgroundJob::Queued, BackgroundJob::Cancelled)) {
+            backgroundJob->done.acquire();
+        }
+        it = m_backgroundJobs.erase(it);
+    }
+}
+
+void QScheduler::startBackgroundJobs()
+{
+    // A background job waits for the completion of the background jobs it
+    // depends on, even if they were queued in a previous frame
+    QSet<QAspectJob *> unfinishedJobs;
+    for (const BackgroundJobPtr &backgroundJob : qAsConst(m_backgroundJobs)) {
+        if (!backgroundJob->finished.loadAcquire())
+            unfinishedJobs.insert(backgroundJob->job.data());
+    }
+
+    for (const BackgroundJobPtr &backgroundJob : qAsConst(m_backgroundJobs)) {
+        if (backgroundJob->started)
+            continue;
+
+        const QVector<QWeakPointer<QAspectJob>> &dependencies = backgroundJob->job->dependencies();
+        const bool waitsForDependency = std::any_of(dependencies.cbegin(), dependencies.cend(),
+                                                    [&unfinishedJobs] (const QWeakPointer<QAspectJob> &dependency) {
+            return unfinishedJobs.contains(dependency.toStrongRef().data());
+        });
+        if (waitsForDependency)
+            continue;
+
+        backgroundJob->started = true;
+        if (!QAspectJobPrivate::get(backgroundJob->job.data())->isRequired()) {
+            backgroundJob->finished.storeRelease(1);
+            continue;
+        }
+
+        // The pool queues the jobs beyond its maximum thread count
+        m_backgroundThreadPool.start([backgroundJob] {
+            if (!backgroundJob->runState.testAndSetOrdered(BackgroundJob::Queued, BackgroundJob::Running))
+                return;
+            backgroundJob->job->run();
+            backgroundJob->finished.storeRelease(1);
+            backgroundJob->done.release();
+        });
+    }
+}
+
+void QScheduler::postFrameBackgroundJobs()
+{
+    // Commit the results of the completed jobs, in the order they were queued
+    auto it = m_backgroundJobs.begin();
+    while (it != m_backgroundJobs.end()) {
+        if ((*it)->finished.loadAcquire()) {
+            (*it)->job->postFrame(m_aspectManager->engine());
+            it = m_backgroundJobs.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
 } // namespace Qt3DCore
 
 QT_END_NAMESPACE
@@ -41,7 +41,10 @@
 #define QT3DCORE_QSCHEDULER_P_H
 
 #include <Qt3DCore/qt3dcore_global.h>
+#include <Qt3DCore/qaspectjob.h>
 #include <QtCore/QObject>
+#include <QtCore/QThreadPool>
+#include <QtCore/QVector>
 
 //
 //  W A R N I N G
@@ -59,6 +62,7 @@ QT_BEGIN_NAMESPACE
 namespace Qt3DCore {
 
 class QAspectManager;
+class QAbstractAspect;
 
 class Q_AUTOTEST_EXPORT QScheduler : public QObject
 {
@@ -72,8 +76,23 @@ public:
 
     virtual int scheduleAndWaitForFrameAspectJobs(qint64 time, bool dumpJobs);
 
+    int maxBackgroundThreadCount() const;
+    void setMaxBackgroundThreadCount(int threadCount);
+    int pendingBackgroundJobCount() const;
+    void cancelBackgroundJobs();
+    void cancelBackgroundJobs(QAbstractAspect *aspect);
+
 private:
+    struct BackgroundJob;
+    using BackgroundJobPtr = QSharedPointer<BackgroundJob>;
+
+    void startBackgroundJobs();
+    void postFrameBackgroundJobs();
+
     QAspectManager *m_aspectManager;
+    // Lane of the jobs loading assets over several frames
+    QThreadPool m_backgroundThreadPool;
+    QVector<BackgroundJobPtr> m_backgroundJobs;
 };
 
 } // namespace Qt3DCore
@@ -43,6 +43,7 @@
 #include <QtCore/qcborarray.h>
 #include <QtCore/qcbormap.h>
 #include <QtCore/qcborvalue.h>
+#include <QtCore/qendian.h>
 #include <QtCore/qjsonarray.h>
 #include <QtCore/qjsondocument.h>
 #include <QtCore/qjsonobject.h>
@@ -58,8 +59,67 @@
 // We mean it.
 //
 
+// Binary glTF 2.0 container (.glb): a 12 bytes header followed by a JSON
+// chunk and an optional BIN chunk holding the data of the first buffer, the
+// one without uri. Chunks are 4 bytes aligned.
+inline bool qIsGLB(const QByteArray &data)
+{
+    return data.size() >= 12 && qFromLittleEndian<quint32>(data.constData()) == 0x46546C67; // "glTF"
+}
+
+// Returns the JSON chunk of glbData as raw data referencing glbData, and
+// the position of the BIN chunk in glbData (binaryOffset is -1 without one)
+inline bool qParseGLB(const QByteArray &glbData, QByteArray *json,
+                      qsizetype *binaryOffset, qsizetype *binaryLength)
+{
+    *binaryOffset = -1;
+    *binaryLength = 0;
+    if (!qIsGLB(glbData))
+        return false;
+
+    const char *data = glbData.constData();
+    if (qFromLittleEndian<quint32>(data + 4) != 2)
+        return false;
+
+    // Lengths are read as quint32 and compared unsigned: stored in a 32 bit
+    // qsizetype, values above INT_MAX would turn negative
+    const quint32 declaredLength = qFromLittleEndian<quint32>(data + 8);
+    const qsizetype length = quint64(declaredLength) < quint64(glbData.size())
+            ? qsizetype(declaredLength) : glbData.size();
+    qsizetype offset = 12;
+    bool hasJson = false;
+    while (length - offset >= 8) {
+        const quint32 chunkLength = qFromLittleEndian<quint32>(data + offset);
+        const quint32 chunkType = qFromLittleEndian<quint32>(data + offset + 4);
+        offset += 8;
+        if (quint64(chunkLength) > quint64(length - offset))
+            return false;
+
+        if (!hasJson) {
+            // The JSON chunk comes first
+            if (chunkType != 0x4E4F534A) // "JSON"
+                return false;
+            *json = QByteArray::fromRawData(data + offset, qsizetype(chunkLength));
+            hasJson = true;
+        } else if (chunkType == 0x004E4942 && *binaryOffset == -1) { // "BIN\0"
+            *binaryOffset = offset;
+            *binaryLength = qsizetype(chunkLength);
+        }
+        offset += (qsizetype(chunkLength) + 3) & ~qsizetype(3);
+    }
+    return hasJson;
+}
+
 inline QJsonDocument qLoadGLTF(const QByteArray &gltfData)
 {
+    if (qIsGLB(gltfData)) {
+        QByteArray json;
+        qsizetype binaryOffset, binaryLength;
+        if (!qParseGLB(gltfData, &json, &binaryOffset, &binaryLength))
+            return QJsonDocument();
+        return qLoadGLTF(json);
+    }
+
     {
         const QCborValue cbor = QCborValue::fromCbor(gltfData);
         if (cbor.isMap())
@@ -70,4 +130,28 @@ inline QJsonDocument qLoadGLTF(const QByteArray &gltfData)
     return QJsonDocument::fromJson(gltfData);
 }
 
+// Also returns the BIN chunk of a .glb container in binaryChunk (empty for
+// other documents). The chunk reuses the memory of gltfData, so pass the
+// file content by rvalue to avoid copying the binary data.
+inline QJsonDocument qLoadGLTF(QByteArray gltfData, QByteArray *binaryChunk)
+{
+    binaryChunk->clear();
+    if (!qIsGLB(gltfData))
+        return qLoadGLTF(gltfData);
+
+    QByteArray json;
+    qsizetype binaryOffset, binaryLength;
+    if (!qParseGLB(gltfData, &json, &binaryOffset, &binaryLength))
+        return QJsonDocument();
+    const QJsonDocument document = qLoadGLTF(json);
+    json.clear();
+
+    if (binaryOffset != -1) {
+        *binaryChunk = std::move(gltfData);
+        binaryChunk->truncate(binaryOffset + binaryLength);
+        binaryChunk->remove(0, binaryOffset);
+    }
+    return document;
+}
+
 #endif // QT3DCORE_QLOADGLTF_P_H
@@ -201,6 +201,7 @@ class QHandleData : public QHandle<T>::Data
 {
 public:
     T data;
+    int activeIndex = -1; // Position in m_activeHandles, -1 while in the free list
 };
 
 template<typename T>
@@ -241,14 +242,28 @@ public:
         d->counter = allocCounter;
         allocCounter += 2; // ensure this will never clash with a pointer in nextFree by keeping the lowest bit set
         Handle handle(d);
+        static_cast<HandleData *>(d)->activeIndex = m_activeHandles.size();
         m_activeHandles.push_back(handle);
+        ++m_activeHandlesRevision;
         return handle;
     }
 
     void releaseResource(const Handle &handle)
     {
-        m_activeHandles.removeOne(handle);
         typename Handle::Data *d = handle.data_ptr();
+        HandleData *handleData = static_cast<HandleData *>(d);
+        const int activeIndex = handleData->activeIndex;
+        if (activeIndex < 0 || m_activeHandles.at(activeIndex) != handle)
+            return;
+
+        // Move the last active handle into the released slot
+        const Handle lastHandle = m_activeHandles.constLast();
+        m_activeHandles[activeIndex] = lastHandle;
+        static_cast<HandleData *>(lastHandle.data_ptr())->activeIndex = activeIndex;
+        m_activeHandles.removeLast();
+        handleData->activeIndex = -1;
+        ++m_activeHandlesRevision;
+
         d->nextFree = freeList;
         freeList = d;
         performCleanup(&static_cast<QHandleData<T> *>(d)->data, std::integral_constant<bool, QResourceInfo<T>::needsCleanup>{});
@@ -261,18 +276,15 @@ public:
 
     void for_each(std::function<void(T*)> f)
     {
-        Bucket *b = firstBucket;
-        while (b) {
-            for (int idx = 0; idx < Bucket::NumEntries; ++idx) {
-                T *t = &b->data[idx].data;
-                f(t);
-            }
-            b = b->header.next;
-        }
+        for (const Handle &handle : qAsConst(m_activeHandles))
+            f(&static_cast<HandleData *>(handle.data_ptr())->data);
     }
 
     int count() const { return m_activeHandles.size(); }
-    QVector<Handle> activeHandles() const { return m_activeHandles; }
+    // Only valid until the next allocation or release
+    const QVector<Handle> &activeHandles() const { return m_activeHandles; }
+    // Incremented on every allocation or release
+    quint64 activeHandlesRevision() const { return m_activeHandlesRevision; }
 
 private:
     Q_DISABLE_COPY(ArrayAllocatingPolicy)
@@ -291,6 +303,7 @@ private:
 
     Bucket *firstBucket = 0;
     QVector<Handle > m_activeHandles;
+    quint64 m_activeHandlesRevision = 0;
     typename Handle::Data *freeList = 0;
     int allocCounter = 1;
 
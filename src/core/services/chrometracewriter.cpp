@@ -0,0 +1,231 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "chrometracewriter_p.h"
+
+#include <QtCore/QCoreApplication>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DCore {
+
+namespace Debug {
+
+namespace {
+
+void appendJsonString(QByteArray &out, const QString &string)
+{
+    out += '"';
+    const QByteArray utf8 = string.toUtf8();
+    for (const char c : utf8) {
+        switch (c) {
+        case '"': out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n"; break;
+        case '\t': out += "\\t"; break;
+        default:
+            if (uchar(c) < 0x20)
+                out += "\\u00" + QByteArray::number(uchar(c), 16).rightJustified(2, '0');
+            else
+                out += c;
+        }
+    }
+    out += '"';
+}
+
+// Trace event timestamps and durations are in microseconds
+QByteArray microseconds(qint64 nsecs)
+{
+    return QByteArray::number(double(nsecs) / 1000.0, 'f', 3);
+}
+
+QString eventName(const QSystemInformationServicePrivate::JobRunStats &stats,
+                  const QStringList &names, const char *fallbackPrefix)
+{
+    if (stats.nameId > 0 && int(stats.nameId) < names.size())
+        return names.at(int(stats.nameId));
+    return QLatin1String(fallbackPrefix) + QString::number(stats.jobId.typeAndInstance[0]);
+}
+
+void appendEvent(QByteArray &out, const QSystemInformationServicePrivate::JobRunStats &stats,
+                 const QStringList &names, const char *category, const char *fallbackPrefix,
+                 quint32 frameId, const QByteArray &pid)
+{
+    out += "{\"name\":";
+    appendJsonString(out, eventName(stats, names, fallbackPrefix));
+    out += ",\"cat\":\"";
+    out += category;
+    out += "\",\"ph\":\"X\",\"ts\":";
+    out += microseconds(stats.startTime);
+    out += ",\"dur\":";
+    out += microseconds(qMax<qint64>(0, stats.endTime - stats.startTime));
+    out += ",\"pid\":";
+    out += pid;
+    out += ",\"tid\":";
+    out += QByteArray::number(stats.threadId);
+    out += ",\"args\":{\"type\":";
+    out += QByteArray::number(stats.jobId.typeAndInstance[0]);
+    out += ",\"instance\":";
+    out += QByteArray::number(stats.jobId.typeAndInstance[1]);
+    out += ",\"frame\":";
+    out += QByteArray::number(frameId);
+    out += "}}";
+}
+
+} // anonymous
+
+ChromeTraceWriter::ChromeTraceWriter(int ringFrameCount)
+    : m_ringFrameCount(qMax(0, ringFrameCount))
+    , m_ringNext(0)
+    , m_ringSize(0)
+    , m_firstEvent(true)
+    , m_streamedFrameCount(0)
+{
+    m_ring.resize(m_ringFrameCount);
+}
+
+ChromeTraceWriter::~ChromeTraceWriter()
+{
+    close();
+}
+
+bool ChromeTraceWriter::open(const QString &fileName)
+{
+    close();
+    m_file.setFileName(fileName);
+    if (!m_file.open(QFile::WriteOnly|QFile::Truncate))
+        return false;
+    m_file.write("[\n");
+    m_firstEvent = true;
+    return true;
+}
+
+void ChromeTraceWriter::close()
+{
+    if (!m_file.isOpen())
+        return;
+    m_file.write("\n]\n");
+    m_file.close();
+}
+
+void ChromeTraceWriter::addFrame(quint32 frameId, qint64 frameTime,
+                                 const QVector<JobRunStats> &jobs,
+                                 const QVector<JobRunStats> &submissions,
+                                 const QStringList &names)
+{
+    if (isRingBuffer()) {
+        // Overwrite the oldest frame, reusing its storage
+        Frame &frame = m_ring[m_ringNext];
+        frame.frameId = frameId;
+        frame.frameTime = frameTime;
+        frame.jobs.clear();
+        frame.jobs += jobs;
+        frame.submissions.clear();
+        frame.submissions += submissions;
+        m_ringNext = (m_ringNext + 1) % m_ringFrameCount;
+        m_ringSize = qMin(m_ringSize + 1, m_ringFrameCount);
+        return;
+    }
+
+    if (!m_file.isOpen())
+        return;
+
+    Frame frame;
+    frame.frameId = frameId;
+    frame.frameTime = frameTime;
+    frame.jobs = jobs;
+    frame.submissions = submissions;
+
+    QByteArray out;
+    appendFrameEvents(out, frame, names, m_firstEvent);
+    m_file.write(out);
+    m_file.flush();
+    ++m_streamedFrameCount;
+}
+
+bool ChromeTraceWriter::dump(QIODevice *device, const QStringList &names) const
+{
+    if (!device || !device->isWritable())
+        return false;
+
+    QByteArray out("[\n");
+    bool firstEvent = true;
+    const int oldest = m_ringSize < m_ringFrameCount ? 0 : m_ringNext;
+    for (int i = 0; i < m_ringSize; ++i)
+        appendFrameEvents(out, m_ring.at((oldest + i) % m_ringFrameCount), names, firstEvent);
+    out += "\n]\n";
+    return device->write(out) == out.size();
+}
+
+void ChromeTraceWriter::appendFrameEvents(QByteArray &out, const Frame &frame,
+                                          const QStringList &names, bool &firstEvent)
+{
+    static const QByteArray pid = QByteArray::number(QCoreApplication::applicationPid());
+
+    auto separate = [&] {
+        if (!firstEvent)
+            out += ",\n";
+        firstEvent = false;
+    };
+
+    // Global instant event marking where the frame's traces were collected
+    separate();
+    out += "{\"name\":\"Frame ";
+    out += QByteArray::number(frame.frameId);
+    out += "\",\"cat\":\"frame\",\"ph\":\"i\",\"s\":\"g\",\"ts\":";
+    out += microseconds(frame.frameTime);
+    out += ",\"pid\":";
+    out += pid;
+    out += ",\"tid\":0}";
+
+    for (const JobRunStats &stats : frame.jobs) {
+        separate();
+        appendEvent(out, stats, names, "job", "Job ", frame.frameId, pid);
+    }
+    for (const JobRunStats &stats : frame.submissions) {
+        separate();
+        appendEvent(out, stats, names, "submission", "Submission ", frame.frameId, pid);
+    }
+}
+
+} // Debug
+
+} // Qt3DCore
+
+QT_END_NAMESPACE
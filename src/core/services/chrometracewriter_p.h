@@ -0,0 +1,120 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QT3DCORE_CHROMETRACEWRITER_P_H
+#define QT3DCORE_CHROMETRACEWRITER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of other Qt classes.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/QFile>
+#include <QtCore/QStringList>
+#include <QtCore/QVector>
+
+#include <Qt3DCore/private/qsysteminformationservice_p_p.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DCore {
+
+namespace Debug {
+
+// Writes job traces in the Chrome Trace Event JSON array format, which
+// chrome://tracing and the Perfetto UI open directly. Frames are either
+// streamed to a file or kept in a ring buffer holding the last frames
+// until dump() is called.
+class Q_3DCORE_PRIVATE_EXPORT ChromeTraceWriter
+{
+public:
+    using JobRunStats = QSystemInformationServicePrivate::JobRunStats;
+
+    // ringFrameCount == 0 streams every frame to the file passed to open()
+    explicit ChromeTraceWriter(int ringFrameCount = 0);
+    ~ChromeTraceWriter();
+
+    bool isRingBuffer() const { return m_ringFrameCount > 0; }
+    int frameCount() const { return isRingBuffer() ? m_ringSize : m_streamedFrameCount; }
+
+    bool open(const QString &fileName);
+    void close();
+
+    // names maps JobRunStats::nameId to job names, 0 being unnamed
+    void addFrame(quint32 frameId, qint64 frameTime,
+                  const QVector<JobRunStats> &jobs,
+                  const QVector<JobRunStats> &submissions,
+                  const QStringList &names);
+    bool dump(QIODevice *device, const QStringList &names) const;
+
+private:
+    struct Frame
+    {
+        quint32 frameId = 0;
+        qint64 frameTime = 0;
+        QVector<JobRunStats> jobs;
+        QVector<JobRunStats> submissions;
+    };
+
+    static void appendFrameEvents(QByteArray &out, const Frame &frame, const QStringList &names,
+                                  bool &firstEvent);
+
+    int m_ringFrameCount;
+    QVector<Frame> m_ring;
+    int m_ringNext;
+    int m_ringSize;
+
+    QFile m_file;
+    bool m_firstEvent;
+    int m_streamedFrameCount;
+};
+
+} // Debug
+
+} // Qt3DCore
+
+QT_END_NAMESPACE
+
+#endif // QT3DCORE_CHROMETRACEWRITER_P_H
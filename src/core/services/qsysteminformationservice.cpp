@@ -57,6 +57,9 @@
 #include <Qt3DCore/private/qabstractaspect_p.h>
 #include <Qt3DCore/private/qaspectengine_p.h>
 #include <Qt3DCore/private/aspectcommanddebugger_p.h>
+#include <Qt3DCore/private/chrometracewriter_p.h>
+
+#include <cstddef>
 
 QT_BEGIN_NAMESPACE
 
@@ -81,6 +84,24 @@ struct FrameHeader
     quint16 frameType; // Submission or worker job
 };
 
+// .qt3d records stop before the fields only used by the Chrome traces
+const qint64 JobRunStatsRecordSize = offsetof(Qt3DCore::QSystemInformationServicePrivate::JobRunStats, nameId);
+
+const int DefaultTraceRingFrameCount = 600;
+
+QString traceFileName(const QString &extension)
+{
+    const QString fileName = QStringLiteral("trace_") + QCoreApplication::applicationName() +
+                             QDateTime::currentDateTime().toString(QStringLiteral("_yyMMdd-hhmmss_")) +
+                             QSysInfo::productType() + QStringLiteral("_") + QSysInfo::buildAbi() + extension;
+#ifdef Q_OS_ANDROID
+    return QStandardPaths::writableLocation(QStandardPaths::DownloadLocation) + QStringLiteral("/") + fileName;
+#else
+    // TODO fix for iOS
+    return fileName;
+#endif
+}
+
 }
 namespace Qt3DCore {
 
@@ -90,8 +111,23 @@ QSystemInformationServicePrivate::QSystemInformationServicePrivate(QAspectEngine
     , m_aspectEngine(aspectEngine)
     , m_submissionStorage(nullptr)
     , m_frameId(0)
+    , m_traceFormat(Qt3DTraceFormat)
+    , m_traceRingFrameCount(0)
+    , m_traceFormatRequested(false)
+    , m_requestedTraceFormat(Qt3DTraceFormat)
+    , m_requestedTraceRingFrameCount(0)
     , m_commandDebugger(nullptr)
 {
+    // Index 0 is reserved for unnamed entries
+    m_traceNames.push_back(QString());
+
+    // QT3D_TRACE_FORMAT=chrome selects Chrome traces, QT3D_TRACE_RING_FRAMES
+    // keeps that many frames in memory instead of streaming them to a file
+    if (qgetenv("QT3D_TRACE_FORMAT") == QByteArrayLiteral("chrome")) {
+        m_traceFormat.storeRelaxed(ChromeTraceFormat);
+        m_traceRingFrameCount = qMax(0, qEnvironmentVariableIntValue("QT3D_TRACE_RING_FRAMES"));
+    }
+
     m_traceEnabled = qEnvironmentVariableIsSet("QT3D_TRACE_ENABLED");
     m_graphicsTraceEnabled = qEnvironmentVariableIsSet("QT3D_GRAPHICS_TRACE_ENABLED");
     if (m_traceEnabled || m_graphicsTraceEnabled)
@@ -106,6 +142,67 @@ QSystemInformationServicePrivate::QSystemInformationServicePrivate(QAspectEngine
 
 QSystemInformationServicePrivate::~QSystemInformationServicePrivate() = default;
 
+void QSystemInformationServicePrivate::setTraceFormat(TraceFormat format, int ringFrameCount)
+{
+    QMutexLocker lock(&m_requestedTraceFormatMutex);
+    m_traceFormatRequested = true;
+    m_requestedTraceFormat = format;
+    m_requestedTraceRingFrameCount = format == ChromeTraceFormat ? qMax(0, ringFrameCount) : 0;
+}
+
+// The trace writers are only used by writeFrameJobLogStats(), replacing them
+// there means no frame is being written with the previous format
+void QSystemInformationServicePrivate::applyRequestedTraceFormat()
+{
+    QMutexLocker lock(&m_requestedTraceFormatMutex);
+    if (!m_traceFormatRequested)
+        return;
+    m_traceFormatRequested = false;
+
+    if (m_requestedTraceFormat == traceFormat() && m_requestedTraceRingFrameCount == m_traceRingFrameCount)
+        return;
+
+    m_traceFormat.storeRelaxed(m_requestedTraceFormat);
+    m_traceRingFrameCount = m_requestedTraceRingFrameCount;
+    m_traceFile.reset();
+    m_chromeTrace.reset();
+}
+
+// Names are only needed by the Chrome traces, the .qt3d records only have ids
+quint32 QSystemInformationServicePrivate::traceNameId(const QString &name)
+{
+    if (traceFormat() != ChromeTraceFormat || name.isEmpty())
+        return 0;
+
+    QMutexLocker lock(&m_traceNamesMutex);
+    const auto it = m_traceNameIds.constFind(name);
+    if (it != m_traceNameIds.cend())
+        return it.value();
+
+    const quint32 id = quint32(m_traceNames.size());
+    m_traceNames.push_back(name);
+    m_traceNameIds.insert(name, id);
+    return id;
+}
+
+QString QSystemInformationServicePrivate::dumpTraceRing()
+{
+    if (!m_chromeTrace || !m_chromeTrace->isRingBuffer())
+        return QLatin1String("No trace ring buffer");
+
+    QStringList names;
+    {
+        QMutexLocker lock(&m_traceNamesMutex);
+        names = m_traceNames;
+    }
+
+    const QString fileName = traceFileName(QStringLiteral(".json"));
+    QFile file(fileName);
+    if (!file.open(QFile::WriteOnly|QFile::Truncate) || !m_chromeTrace->dump(&file, names))
+        return QLatin1String("Failed to write ") + fileName;
+    return fileName;
+}
+
 QSystemInformationServicePrivate *QSystemInformationServicePrivate::get(QSystemInformationService *q)
 {
     return q->d_func();
@@ -149,21 +246,20 @@ void QSystemInformationServicePrivate::addSubmissionLogStatsEntry(QSystemInforma
 // Called after jobs have been executed (MainThread QAspectJobManager::enqueueJobs)
 void QSystemInformationServicePrivate::writeFrameJobLogStats()
 {
+    applyRequestedTraceFormat();
+
     if (!m_traceEnabled && !m_graphicsTraceEnabled)
         return;
 
+    if (traceFormat() == ChromeTraceFormat) {
+        writeFrameChromeTrace();
+        return;
+    }
+
     using JobRunStats = QSystemInformationServicePrivate::JobRunStats;
 
     if (!m_traceFile) {
-        const QString fileName = QStringLiteral("trace_") + QCoreApplication::applicationName() +
-                                 QDateTime::currentDateTime().toString(QStringLiteral("_yyMMdd-hhmmss_")) +
-                                 QSysInfo::productType() + QStringLiteral("_") + QSysInfo::buildAbi() + QStringLiteral(".qt3d");
-#ifdef Q_OS_ANDROID
-        m_traceFile.reset(new QFile(QStandardPaths::writableLocation(QStandardPaths::DownloadLocation) + QStringLiteral("/") + fileName));
-#else
-        // TODO fix for iOS
-        m_traceFile.reset(new QFile(fileName));
-#endif
+        m_traceFile.reset(new QFile(traceFileName(QStringLiteral(".qt3d"))));
         if (!m_traceFile->open(QFile::WriteOnly|QFile::Truncate))
             qCritical("Failed to open trace file");
     }
@@ -181,7 +277,7 @@ void QSystemInformationServicePrivate::writeFrameJobLogStats()
 
         for (QVector<JobRunStats> *storage : qAsConst(m_localStorages)) {
             for (const JobRunStats &stat : *storage)
-                m_traceFile->write(reinterpret_cast<const char *>(&stat), sizeof(JobRunStats));
+                m_traceFile->write(reinterpret_cast<const char *>(&stat), JobRunStatsRecordSize);
             storage->clear();
         }
     }
@@ -199,7 +295,7 @@ void QSystemInformationServicePrivate::writeFrameJobLogStats()
             m_traceFile->write(reinterpret_cast<char *>(&header), sizeof(FrameHeader));
 
             for (const JobRunStats &stat : *m_submissionStorage)
-                m_traceFile->write(reinterpret_cast<const char *>(&stat), sizeof(JobRunStats));
+                m_traceFile->write(reinterpret_cast<const char *>(&stat), JobRunStatsRecordSize);
             m_submissionStorage->clear();
         }
     }
@@ -208,6 +304,39 @@ void QSystemInformationServicePrivate::writeFrameJobLogStats()
     ++m_frameId;
 }
 
+void QSystemInformationServicePrivate::writeFrameChromeTrace()
+{
+    if (!m_chromeTrace) {
+        m_chromeTrace.reset(new Debug::ChromeTraceWriter(m_traceRingFrameCount));
+        if (!m_chromeTrace->isRingBuffer() && !m_chromeTrace->open(traceFileName(QStringLiteral(".json"))))
+            qCritical("Failed to open trace file");
+    }
+
+    QVector<JobRunStats> jobs;
+    for (QVector<JobRunStats> *storage : qAsConst(m_localStorages)) {
+        jobs += *storage;
+        storage->clear();
+    }
+
+    QVector<JobRunStats> submissions;
+    QStringList names;
+    {
+        QMutexLocker lock(&m_localStoragesMutex);
+        if (m_submissionStorage != nullptr) {
+            submissions = *m_submissionStorage;
+            m_submissionStorage->clear();
+        }
+    }
+    // Ring buffers resolve names when dumped
+    if (!m_chromeTrace->isRingBuffer()) {
+        QMutexLocker lock(&m_traceNamesMutex);
+        names = m_traceNames;
+    }
+
+    m_chromeTrace->addFrame(m_frameId, m_jobsStatTimer.nsecsElapsed(), jobs, submissions, names);
+    ++m_frameId;
+}
+
 void QSystemInformationServicePrivate::updateTracing()
 {
     if (m_traceEnabled || m_graphicsTraceEnabled) {
@@ -215,6 +344,7 @@ void QSystemInformationServicePrivate::updateTracing()
             m_jobsStatTimer.start();
     } else {
         m_traceFile.reset();
+        m_chromeTrace.reset();
     }
 }
 
@@ -269,6 +399,12 @@ qint64 QTaskLogger::restart()
     return m_stats.startTime;
 }
 
+void QTaskLogger::setName(const QString &name)
+{
+    if (m_service)
+        m_stats.nameId = QSystemInformationServicePrivate::get(m_service)->traceNameId(name);
+}
+
 
 /* !\internal
     \class Qt3DCore::QSystemInformationService
@@ -395,10 +531,31 @@ QVariant QSystemInformationService::executeCommand(const QString &command)
     Q_D(QSystemInformationService);
 
     if (command == QLatin1String("tracing on")) {
+        d->setTraceFormat(QSystemInformationServicePrivate::Qt3DTraceFormat);
+        setTraceEnabled(true);
+        return  {isTraceEnabled()};
+    }
+
+    // tracing on chrome: stream Chrome JSON traces to a file
+    // tracing on ring [frames]: keep the last frames in memory for tracing dump
+    if (command == QLatin1String("tracing on chrome")
+            || command.startsWith(QLatin1String("tracing on ring"))) {
+        int ringFrameCount = 0;
+        if (command != QLatin1String("tracing on chrome")) {
+            const QStringList args = command.split(QLatin1Char(' '), Qt::SkipEmptyParts);
+            bool ok = args.size() > 3;
+            ringFrameCount = ok ? args.at(3).toInt(&ok) : 0;
+            if (!ok || ringFrameCount <= 0)
+                ringFrameCount = DefaultTraceRingFrameCount;
+        }
+        d->setTraceFormat(QSystemInformationServicePrivate::ChromeTraceFormat, ringFrameCount);
         setTraceEnabled(true);
         return  {isTraceEnabled()};
     }
 
+    if (command == QLatin1String("tracing dump"))
+        return  {d->dumpTraceRing()};
+
     if (command == QLatin1String("tracing off")) {
         setTraceEnabled(false);
         return  {isTraceEnabled()};
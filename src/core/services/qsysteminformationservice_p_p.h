@@ -55,6 +55,9 @@
 #include <QtCore/QElapsedTimer>
 #include <QtCore/QFile>
 #include <QtCore/QMutex>
+#include <QtCore/QAtomicInt>
+#include <QtCore/QHash>
+#include <QtCore/QStringList>
 
 #include <Qt3DCore/qt3dcore_global.h>
 #include <Qt3DCore/private/qt3dcore_global_p.h>
@@ -68,6 +71,7 @@ namespace Qt3DCore {
 
 namespace Debug {
 class AspectCommandDebugger;
+class ChromeTraceWriter;
 } // Debug
 
 union Q_3DCORE_PRIVATE_EXPORT JobId
@@ -84,12 +88,19 @@ class Q_3DCORE_PRIVATE_EXPORT QSystemInformationServicePrivate : public QAbstrac
 public:
     struct JobRunStats
     {
-        JobRunStats() { jobId.id = 0; startTime = 0L; endTime = 0L; }
+        JobRunStats() { jobId.id = 0; startTime = 0L; endTime = 0L; threadId = 0; nameId = 0; }
 
         qint64 startTime;
         qint64 endTime;
         JobId jobId; // QAspectJob subclasses should properly populate the jobId
         quint64 threadId;
+        // Not part of the .qt3d records, index in m_traceNames when set
+        quint32 nameId;
+    };
+
+    enum TraceFormat {
+        Qt3DTraceFormat,    // Binary .qt3d files
+        ChromeTraceFormat   // Chrome Trace Event JSON, streamed or in a ring buffer
     };
 
     QSystemInformationServicePrivate(QAspectEngine *aspectEngine, const QString &description);
@@ -104,8 +115,16 @@ public:
     void addSubmissionLogStatsEntry(JobRunStats &stats);
 
     void writeFrameJobLogStats();
+    void writeFrameChromeTrace();
     void updateTracing();
 
+    // Applied by writeFrameJobLogStats(), between frames
+    void setTraceFormat(TraceFormat format, int ringFrameCount = 0);
+    void applyRequestedTraceFormat();
+    TraceFormat traceFormat() const { return TraceFormat(m_traceFormat.loadRelaxed()); }
+    quint32 traceNameId(const QString &name);
+    QString dumpTraceRing();
+
     QAspectEngine *m_aspectEngine;
     bool m_traceEnabled;
     bool m_graphicsTraceEnabled;
@@ -121,6 +140,17 @@ public:
     QScopedPointer<QFile> m_traceFile;
     quint32 m_frameId;
 
+    QAtomicInt m_traceFormat; // TraceFormat, read from the job threads
+    int m_traceRingFrameCount;
+    QMutex m_requestedTraceFormatMutex;
+    bool m_traceFormatRequested;
+    TraceFormat m_requestedTraceFormat;
+    int m_requestedTraceRingFrameCount;
+    QScopedPointer<Debug::ChromeTraceWriter> m_chromeTrace;
+    QStringList m_traceNames;
+    QHash<QString, quint32> m_traceNameIds;
+    QMutex m_traceNamesMutex;
+
     Debug::AspectCommandDebugger *m_commandDebugger;
 
     Q_DECLARE_PUBLIC(QSystemInformationService)
@@ -140,6 +170,7 @@ public:
 
     void end(qint64 t = 0L);
     qint64 restart();
+    void setName(const QString &name);
 
 private:
     QSystemInformationService *m_service;
@@ -7,7 +7,8 @@ SOURCES += \
     $$PWD/qabstractframeadvanceservice.cpp \
     $$PWD/qeventfilterservice.cpp \
     $$PWD/qdownloadhelperservice.cpp \
-    $$PWD/qdownloadnetworkworker.cpp
+    $$PWD/qdownloadnetworkworker.cpp \
+    $$PWD/chrometracewriter.cpp
 
 HEADERS += \
     $$PWD/qservicelocator_p.h \
@@ -22,6 +23,7 @@ HEADERS += \
     $$PWD/qabstractframeadvanceservice_p_p.h \
     $$PWD/qeventfilterservice_p.h \
     $$PWD/qdownloadhelperservice_p.h \
-    $$PWD/qdownloadnetworkworker_p.h
+    $$PWD/qdownloadnetworkworker_p.h \
+    $$PWD/chrometracewriter_p.h
 
 INCLUDEPATH += $$PWD
@@ -39,6 +39,7 @@
 
 #include "assignkeyboardfocusjob_p.h"
 #include <Qt3DCore/private/qaspectmanager_p.h>
+#include <Qt3DCore/private/qnodebatchlookup_p.h>
 #include <Qt3DInput/qkeyboardhandler.h>
 #include <Qt3DInput/private/inputhandler_p.h>
 #include <Qt3DInput/private/inputmanagers_p.h>
@@ -98,14 +99,26 @@ void AssignKeyboardFocusJob::run()
 
 void AssignKeyboardFocusJobPrivate::postFrame(Qt3DCore::QAspectManager *manager)
 {
-    for (const auto &data: qAsConst(updates)) {
-        QKeyboardHandler *node = qobject_cast<QKeyboardHandler *>(manager->lookupNode(data.first));
+    if (updates.isEmpty())
+        return;
+
+    QVector<Qt3DCore::QNodeId> ids;
+    ids.reserve(updates.size());
+    for (const auto &data: qAsConst(updates))
+        ids.push_back(data.first);
+    // focusChanged handlers may delete the handlers that follow
+    Qt3DCore::QNodeBatchLookup nodes(manager, ids);
+
+    for (int i = 0, m = updates.size(); i < m; ++i) {
+        QKeyboardHandler *node = qobject_cast<QKeyboardHandler *>(nodes.node(i));
         if (!node)
             continue;
 
         const bool b = node->blockNotifications(true);
-        node->setFocus(data.second);
-        node->blockNotifications(b);
+        node->setFocus(updates.at(i).second);
+        // setFocus() emits focusChanged, which may have destroyed the handler
+        if (nodes.node(i))
+            node->blockNotifications(b);
     }
 
     updates.clear();
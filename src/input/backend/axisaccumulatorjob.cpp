@@ -39,6 +39,7 @@
 
 #include "axisaccumulatorjob_p.h"
 #include <Qt3DCore/private/qaspectmanager_p.h>
+#include <Qt3DCore/private/qnodebatchlookup_p.h>
 #include <Qt3DInput/qaxisaccumulator.h>
 #include <Qt3DInput/private/qaxisaccumulator_p.h>
 #include <Qt3DInput/private/axisaccumulator_p.h>
@@ -89,13 +90,29 @@ void AxisAccumulatorJob::run()
 
 void AxisAccumulatorJobPrivate::postFrame(Qt3DCore::QAspectManager *manager)
 {
-    for (auto backend: qAsConst(updates)) {
-        QAxisAccumulator *node = qobject_cast<QAxisAccumulator *>(manager->lookupNode(backend->peerId()));
+    if (updates.isEmpty())
+        return;
+
+    QVector<Qt3DCore::QNodeId> ids;
+    ids.reserve(updates.size());
+    for (auto backend: qAsConst(updates))
+        ids.push_back(backend->peerId());
+    // valueChanged/velocityChanged handlers may delete other accumulators
+    Qt3DCore::QNodeBatchLookup nodes(manager, ids);
+
+    for (int i = 0, m = nodes.size(); i < m; ++i) {
+        QAxisAccumulator *node = qobject_cast<QAxisAccumulator *>(nodes.node(i));
         if (!node)
             continue;
 
+        AxisAccumulator *backend = updates.at(i);
         QAxisAccumulatorPrivate *dnode = static_cast<QAxisAccumulatorPrivate *>(QAxisAccumulatorPrivate::get(node));
         dnode->setValue(backend->value());
+        // The valueChanged handlers may have destroyed this accumulator
+        node = qobject_cast<QAxisAccumulator *>(nodes.node(i));
+        if (!node)
+            continue;
+        dnode = static_cast<QAxisAccumulatorPrivate *>(QAxisAccumulatorPrivate::get(node));
         dnode->setVelocity(backend->velocity());
     }
 }
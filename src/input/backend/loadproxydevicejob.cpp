@@ -39,6 +39,7 @@
 
 #include "loadproxydevicejob_p.h"
 #include <Qt3DCore/private/qaspectmanager_p.h>
+#include <Qt3DCore/private/qnodebatchlookup_p.h>
 #include <Qt3DInput/private/qabstractphysicaldeviceproxy_p.h>
 #include <Qt3DInput/private/qabstractphysicaldeviceproxy_p_p.h>
 #include <Qt3DInput/private/inputhandler_p.h>
@@ -108,12 +109,22 @@ void LoadProxyDeviceJob::run()
 
 void LoadProxyDeviceJobPrivate::postFrame(Qt3DCore::QAspectManager *manager)
 {
-    for (const auto &res : qAsConst(updates)) {
-        QAbstractPhysicalDeviceProxy *node = qobject_cast<QAbstractPhysicalDeviceProxy *>(manager->lookupNode(res.first));
+    if (updates.isEmpty())
+        return;
+
+    QVector<Qt3DCore::QNodeId> ids;
+    ids.reserve(updates.size());
+    for (const auto &res : qAsConst(updates))
+        ids.push_back(res.first);
+    // deviceChanged handlers may delete the proxies that follow
+    Qt3DCore::QNodeBatchLookup nodes(manager, ids);
+
+    for (int i = 0, m = updates.size(); i < m; ++i) {
+        QAbstractPhysicalDeviceProxy *node = qobject_cast<QAbstractPhysicalDeviceProxy *>(nodes.node(i));
         if (!node)
             continue;
 
-        auto *device = res.second;
+        auto *device = updates.at(i).second;
         QAbstractPhysicalDeviceProxyPrivate *dnode = static_cast<QAbstractPhysicalDeviceProxyPrivate *>(QAbstractPhysicalDeviceProxyPrivate::get(node));
         QAbstractPhysicalDevice *oldDevice = dnode->m_device;
         dnode->setDevice(device);
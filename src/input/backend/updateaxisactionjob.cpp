@@ -39,6 +39,7 @@
 
 #include "updateaxisactionjob_p.h"
 #include <Qt3DCore/private/qaspectmanager_p.h>
+#include <Qt3DCore/private/qnodebatchlookup_p.h>
 #include <Qt3DInput/qaction.h>
 #include <Qt3DInput/qaxis.h>
 #include <Qt3DInput/private/qaction_p.h>
@@ -155,22 +156,37 @@ float UpdateAxisActionJob::processAxisInput(const Qt3DCore::QNodeId axisInputId)
 
 void UpdateAxisActionJobPrivate::postFrame(Qt3DCore::QAspectManager *manager)
 {
-    for (const auto &data: qAsConst(m_triggeredActions)) {
-        Qt3DInput::QAction *action = qobject_cast<Qt3DInput::QAction *>(manager->lookupNode(data.first));
+    const int actionCount = m_triggeredActions.size();
+    const int axisCount = m_triggeredAxis.size();
+    if (actionCount + axisCount == 0)
+        return;
+
+    // Resolve actions and axes with a single lookup, activeChanged/valueChanged
+    // handlers may delete actions or axes we are yet to update
+    QVector<Qt3DCore::QNodeId> ids;
+    ids.reserve(actionCount + axisCount);
+    for (const auto &data: qAsConst(m_triggeredActions))
+        ids.push_back(data.first);
+    for (const auto &data: qAsConst(m_triggeredAxis))
+        ids.push_back(data.first);
+    Qt3DCore::QNodeBatchLookup nodes(manager, ids);
+
+    for (int i = 0; i < actionCount; ++i) {
+        Qt3DInput::QAction *action = qobject_cast<Qt3DInput::QAction *>(nodes.node(i));
         if (!action)
             continue;
 
         Qt3DInput::QActionPrivate *daction = static_cast<Qt3DInput::QActionPrivate *>(Qt3DCore::QNodePrivate::get(action));
-        daction->setActive(data.second);
+        daction->setActive(m_triggeredActions.at(i).second);
     }
 
-    for (const auto &data: qAsConst(m_triggeredAxis)) {
-        Qt3DInput::QAxis *axis = qobject_cast<Qt3DInput::QAxis *>(manager->lookupNode(data.first));
+    for (int i = 0; i < axisCount; ++i) {
+        Qt3DInput::QAxis *axis = qobject_cast<Qt3DInput::QAxis *>(nodes.node(actionCount + i));
         if (!axis)
             continue;
 
         Qt3DInput::QAxisPrivate *daxis = static_cast<Qt3DInput::QAxisPrivate *>(Qt3DCore::QNodePrivate::get(axis));
-        daxis->setValue(data.second);
+        daxis->setValue(m_triggeredAxis.at(i).second);
     }
 
     m_triggeredActions.clear();
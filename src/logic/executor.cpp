@@ -43,6 +43,7 @@
 #include <Qt3DCore/qnode.h>
 #include <QtCore/qsemaphore.h>
 
+#include <Qt3DCore/private/qnodebatchlookup_p.h>
 #include <Qt3DCore/private/qscene_p.h>
 
 QT_BEGIN_NAMESPACE
@@ -92,9 +93,10 @@ void Executor::processLogicFrameUpdates(float dt)
     if (!m_scene || m_nodeIds.isEmpty())
         return;
 
-    const QVector<QNode *> nodes = m_scene->lookupNodes(m_nodeIds);
-    for (QNode *node : nodes) {
-        QFrameAction *frameAction = qobject_cast<QFrameAction *>(node);
+    // onTriggered handlers may delete other frame actions
+    QNodeBatchLookup nodes(m_scene, m_nodeIds);
+    for (int i = 0, m = nodes.size(); i < m; ++i) {
+        QFrameAction *frameAction = qobject_cast<QFrameAction *>(nodes.node(i));
         if (frameAction && frameAction->isEnabled())
             frameAction->onTriggered(dt);
     }
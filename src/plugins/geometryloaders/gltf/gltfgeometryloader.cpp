@@ -105,7 +105,7 @@ bool GLTFGeometryLoader::load(QIODevice *ioDev, const QString &subMesh)
 {
     Q_UNUSED(subMesh);
 
-    if (Q_UNLIKELY(!setJSON(qLoadGLTF(ioDev->readAll())))) {
+    if (Q_UNLIKELY(!setJSON(qLoadGLTF(ioDev->readAll(), &m_binaryChunk)))) {
         qCWarning(GLTFGeometryLoaderLog, "not a JSON document");
         return false;
     }
@@ -558,8 +558,11 @@ void GLTFGeometryLoader::unloadBufferData()
 void GLTFGeometryLoader::loadBufferDataV2()
 {
     for (auto &bufferData : m_gltf2.m_bufferDatas) {
-        if (!bufferData.data)
-            bufferData.data = new QByteArray(resolveLocalData(bufferData.path));
+        if (!bufferData.data) {
+            // Shares the BIN chunk rather than copying it
+            bufferData.data = new QByteArray(bufferData.path.isEmpty() ? m_binaryChunk
+                                                                       : resolveLocalData(bufferData.path));
+        }
     }
 }
 
@@ -569,6 +572,7 @@ void GLTFGeometryLoader::unloadBufferDataV2()
         QByteArray *data = bufferData.data;
         delete data;
     }
+    m_binaryChunk.clear();
 }
 
 QByteArray GLTFGeometryLoader::resolveLocalData(const QString &path) const
@@ -70,6 +70,7 @@ namespace Qt3DRender {
 #define GLTFGEOMETRYLOADER_EXT QLatin1String("gltf")
 #define JSONGEOMETRYLOADER_EXT QLatin1String("json")
 #define QGLTFGEOMETRYLOADER_EXT QLatin1String("qgltf")
+#define GLBGEOMETRYLOADER_EXT QLatin1String("glb")
 
 class QCamera;
 class QCameraLens;
@@ -180,6 +181,8 @@ private:
     QJsonDocument m_json;
     QString m_basePath;
     QString m_mesh;
+    // BIN chunk of a .glb file, the data of its buffer without uri
+    QByteArray m_binaryChunk;
 
     Gltf1 m_gltf1;
     Gltf2 m_gltf2;
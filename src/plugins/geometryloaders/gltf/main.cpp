@@ -53,14 +53,16 @@ public:
     {
         return QStringList() << GLTFGEOMETRYLOADER_EXT
                              << JSONGEOMETRYLOADER_EXT
-                             << QGLTFGEOMETRYLOADER_EXT;
+                             << QGLTFGEOMETRYLOADER_EXT
+                             << GLBGEOMETRYLOADER_EXT;
     }
 
     Qt3DRender::QGeometryLoaderInterface *create(const QString &ext) override
     {
         if ((ext.compare(GLTFGEOMETRYLOADER_EXT, Qt::CaseInsensitive) == 0) ||
             (ext.compare(JSONGEOMETRYLOADER_EXT, Qt::CaseInsensitive) == 0) ||
-            (ext.compare(QGLTFGEOMETRYLOADER_EXT, Qt::CaseInsensitive) == 0))
+            (ext.compare(QGLTFGEOMETRYLOADER_EXT, Qt::CaseInsensitive) == 0) ||
+            (ext.compare(GLBGEOMETRYLOADER_EXT, Qt::CaseInsensitive) == 0))
             return new Qt3DRender::GLTFGeometryLoader;
         return nullptr;
     }
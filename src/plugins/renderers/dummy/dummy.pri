@@ -0,0 +1,9 @@
+INCLUDEPATH += $$PWD
+
+SOURCES += \
+    $$PWD/glslintrospection.cpp \
+    $$PWD/nullrenderer.cpp
+
+HEADERS += \
+    $$PWD/glslintrospection_p.h \
+    $$PWD/nullrenderer_p.h
@@ -0,0 +1,18 @@
+TARGET = nullrenderer
+
+# We use QT_AUTOTEST_EXPORT to test the plug-ins, which needs QT_BUILDING_QT
+DEFINES += QT_BUILDING_QT
+
+# The null renderer runs the CPU side of the OpenGL renderer
+include(../opengl/opengl.pri)
+include(dummy.pri)
+
+DISTFILES += \
+    nullrenderer.json
+
+SOURCES += \
+    main.cpp
+
+PLUGIN_TYPE = renderers
+PLUGIN_CLASS_NAME = NullRendererPlugin
+load(qt_plugin)
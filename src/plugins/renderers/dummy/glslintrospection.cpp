@@ -0,0 +1,1025 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "glslintrospection_p.h"
+#include <Qt3DRender/qshaderprogram.h>
+#include <QHash>
+#include <QSet>
+#include <cctype>
+#include <cstring>
+
+#ifndef GL_SAMPLER_BUFFER
+#define GL_SAMPLER_BUFFER                 0x8DC2
+#endif
+#ifndef GL_SAMPLER_2D_RECT
+#define GL_SAMPLER_2D_RECT                0x8B63
+#endif
+#ifndef GL_SAMPLER_1D_ARRAY
+#define GL_SAMPLER_1D_ARRAY               0x8DC0
+#endif
+#ifndef GL_SAMPLER_2D_ARRAY
+#define GL_SAMPLER_2D_ARRAY               0x8DC1
+#endif
+#ifndef GL_SAMPLER_2D_ARRAY_SHADOW
+#define GL_SAMPLER_2D_ARRAY_SHADOW        0x8DC4
+#endif
+#ifndef GL_SAMPLER_CUBE_SHADOW
+#define GL_SAMPLER_CUBE_SHADOW            0x8DC5
+#endif
+#ifndef GL_SAMPLER_CUBE_MAP_ARRAY
+#define GL_SAMPLER_CUBE_MAP_ARRAY         0x900C
+#endif
+#ifndef GL_SAMPLER_2D_MULTISAMPLE
+#define GL_SAMPLER_2D_MULTISAMPLE         0x9108
+#endif
+#ifndef GL_INT_SAMPLER_2D
+#define GL_INT_SAMPLER_2D                 0x8DCA
+#endif
+#ifndef GL_INT_SAMPLER_3D
+#define GL_INT_SAMPLER_3D                 0x8DCB
+#endif
+#ifndef GL_INT_SAMPLER_CUBE
+#define GL_INT_SAMPLER_CUBE               0x8DCC
+#endif
+#ifndef GL_UNSIGNED_INT_SAMPLER_2D
+#define GL_UNSIGNED_INT_SAMPLER_2D        0x8DD2
+#endif
+#ifndef GL_UNSIGNED_INT_SAMPLER_3D
+#define GL_UNSIGNED_INT_SAMPLER_3D        0x8DD3
+#endif
+#ifndef GL_UNSIGNED_INT_SAMPLER_CUBE
+#define GL_UNSIGNED_INT_SAMPLER_CUBE      0x8DD4
+#endif
+#ifndef GL_UNSIGNED_INT
+#define GL_UNSIGNED_INT                   0x1405
+#endif
+#ifndef GL_UNSIGNED_INT_VEC2
+#define GL_UNSIGNED_INT_VEC2              0x8DC6
+#endif
+#ifndef GL_UNSIGNED_INT_VEC3
+#define GL_UNSIGNED_INT_VEC3              0x8DC7
+#endif
+#ifndef GL_UNSIGNED_INT_VEC4
+#define GL_UNSIGNED_INT_VEC4              0x8DC8
+#endif
+#ifndef GL_FLOAT_MAT2x3
+#define GL_FLOAT_MAT2x3                   0x8B65
+#endif
+#ifndef GL_FLOAT_MAT2x4
+#define GL_FLOAT_MAT2x4                   0x8B66
+#endif
+#ifndef GL_FLOAT_MAT3x2
+#define GL_FLOAT_MAT3x2                   0x8B67
+#endif
+#ifndef GL_FLOAT_MAT3x4
+#define GL_FLOAT_MAT3x4                   0x8B68
+#endif
+#ifndef GL_FLOAT_MAT4x2
+#define GL_FLOAT_MAT4x2                   0x8B69
+#endif
+#ifndef GL_FLOAT_MAT4x3
+#define GL_FLOAT_MAT4x3                   0x8B6A
+#endif
+#ifndef GL_SAMPLER_1D
+#define GL_SAMPLER_1D                     0x8B5D
+#endif
+#ifndef GL_SAMPLER_3D
+#define GL_SAMPLER_3D                     0x8B5F
+#endif
+#ifndef GL_SAMPLER_1D_SHADOW
+#define GL_SAMPLER_1D_SHADOW              0x8B61
+#endif
+#ifndef GL_SAMPLER_2D_SHADOW
+#define GL_SAMPLER_2D_SHADOW              0x8B62
+#endif
+#ifndef GL_IMAGE_2D
+#define GL_IMAGE_2D                       0x904D
+#endif
+#ifndef GL_IMAGE_3D
+#define GL_IMAGE_3D                       0x904E
+#endif
+#ifndef GL_IMAGE_CUBE
+#define GL_IMAGE_CUBE                     0x9050
+#endif
+#ifndef GL_IMAGE_2D_ARRAY
+#define GL_IMAGE_2D_ARRAY                 0x9053
+#endif
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DRender {
+
+namespace Render {
+
+namespace Null {
+
+using namespace OpenGL;
+
+namespace {
+
+struct GLSLType
+{
+    const char *name;
+    GLenum type;
+    int columns;    // 1 for scalars and vectors
+    int rows;       // vector size for vectors, column size for matrices
+    bool opaque;    // samplers and images, not allowed in blocks
+};
+
+const GLSLType glslTypes[] = {
+    { "float", GL_FLOAT, 1, 1, false },
+    { "vec2", GL_FLOAT_VEC2, 1, 2, false },
+    { "vec3", GL_FLOAT_VEC3, 1, 3, false },
+    { "vec4", GL_FLOAT_VEC4, 1, 4, false },
+    { "int", GL_INT, 1, 1, false },
+    { "ivec2", GL_INT_VEC2, 1, 2, false },
+    { "ivec3", GL_INT_VEC3, 1, 3, false },
+    { "ivec4", GL_INT_VEC4, 1, 4, false },
+    { "uint", GL_UNSIGNED_INT, 1, 1, false },
+    { "uvec2", GL_UNSIGNED_INT_VEC2, 1, 2, false },
+    { "uvec3", GL_UNSIGNED_INT_VEC3, 1, 3, false },
+    { "uvec4", GL_UNSIGNED_INT_VEC4, 1, 4, false },
+    { "bool", GL_BOOL, 1, 1, false },
+    { "bvec2", GL_BOOL_VEC2, 1, 2, false },
+    { "bvec3", GL_BOOL_VEC3, 1, 3, false },
+    { "bvec4", GL_BOOL_VEC4, 1, 4, false },
+    { "mat2", GL_FLOAT_MAT2, 2, 2, false },
+    { "mat3", GL_FLOAT_MAT3, 3, 3, false },
+    { "mat4", GL_FLOAT_MAT4, 4, 4, false },
+    { "mat2x2", GL_FLOAT_MAT2, 2, 2, false },
+    { "mat2x3", GL_FLOAT_MAT2x3, 2, 3, false },
+    { "mat2x4", GL_FLOAT_MAT2x4, 2, 4, false },
+    { "mat3x2", GL_FLOAT_MAT3x2, 3, 2, false },
+    { "mat3x3", GL_FLOAT_MAT3, 3, 3, false },
+    { "mat3x4", GL_FLOAT_MAT3x4, 3, 4, false },
+    { "mat4x2", GL_FLOAT_MAT4x2, 4, 2, false },
+    { "mat4x3", GL_FLOAT_MAT4x3, 4, 3, false },
+    { "mat4x4", GL_FLOAT_MAT4, 4, 4, false },
+    { "sampler1D", GL_SAMPLER_1D, 1, 1, true },
+    { "sampler2D", GL_SAMPLER_2D, 1, 1, true },
+    { "sampler3D", GL_SAMPLER_3D, 1, 1, true },
+    { "samplerCube", GL_SAMPLER_CUBE, 1, 1, true },
+    { "sampler2DRect", GL_SAMPLER_2D_RECT, 1, 1, true },
+    { "samplerBuffer", GL_SAMPLER_BUFFER, 1, 1, true },
+    { "sampler1DArray", GL_SAMPLER_1D_ARRAY, 1, 1, true },
+    { "sampler2DArray", GL_SAMPLER_2D_ARRAY, 1, 1, true },
+    { "samplerCubeArray", GL_SAMPLER_CUBE_MAP_ARRAY, 1, 1, true },
+    { "sampler2DMS", GL_SAMPLER_2D_MULTISAMPLE, 1, 1, true },
+    { "sampler1DShadow", GL_SAMPLER_1D_SHADOW, 1, 1, true },
+    { "sampler2DShadow", GL_SAMPLER_2D_SHADOW, 1, 1, true },
+    { "samplerCubeShadow", GL_SAMPLER_CUBE_SHADOW, 1, 1, true },
+    { "sampler2DArrayShadow", GL_SAMPLER_2D_ARRAY_SHADOW, 1, 1, true },
+    { "isampler2D", GL_INT_SAMPLER_2D, 1, 1, true },
+    { "isampler3D", GL_INT_SAMPLER_3D, 1, 1, true },
+    { "isamplerCube", GL_INT_SAMPLER_CUBE, 1, 1, true },
+    { "usampler2D", GL_UNSIGNED_INT_SAMPLER_2D, 1, 1, true },
+    { "usampler3D", GL_UNSIGNED_INT_SAMPLER_3D, 1, 1, true },
+    { "usamplerCube", GL_UNSIGNED_INT_SAMPLER_CUBE, 1, 1, true },
+    { "image2D", GL_IMAGE_2D, 1, 1, true },
+    { "image3D", GL_IMAGE_3D, 1, 1, true },
+    { "imageCube", GL_IMAGE_CUBE, 1, 1, true },
+    { "image2DArray", GL_IMAGE_2D_ARRAY, 1, 1, true },
+};
+
+const GLSLType *findType(const QByteArray &name)
+{
+    for (const GLSLType &t : glslTypes) {
+        if (name == t.name)
+            return &t;
+    }
+    return nullptr;
+}
+
+// Same computation as GraphicsHelperGL3_3::uniformByteSize so that the
+// parameter packs we build match the ones built against a real context
+uint uniformByteSize(const GLSLType *type, int arrayStride, int matrixStride)
+{
+    uint rawByteSize = 0;
+    if (type->opaque)
+        rawByteSize = 4;
+    else if (type->columns > 1)
+        rawByteSize = matrixStride ? type->columns * matrixStride : type->columns * type->rows * 4;
+    else if (type->type == GL_BOOL || type->type == GL_BOOL_VEC2
+             || type->type == GL_BOOL_VEC3 || type->type == GL_BOOL_VEC4)
+        rawByteSize = type->rows;
+    else
+        rawByteSize = type->rows * 4;
+    return arrayStride ? rawByteSize * arrayStride : rawByteSize;
+}
+
+int roundUp(int value, int alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+int integerLiteral(QByteArray text)
+{
+    if (text.endsWith('u') || text.endsWith('U'))
+        text.chop(1);
+    return text.toInt(nullptr, 0);
+}
+
+struct Token
+{
+    enum Kind {
+        Identifier,
+        Number,
+        Symbol
+    };
+    Kind kind;
+    QByteArray text;
+};
+
+struct Declaration
+{
+    QByteArray typeName;
+    QByteArray name;
+    int arraySize = 0; // 0 means not an array
+};
+
+struct StructDefinition
+{
+    QVector<Declaration> members;
+};
+
+struct LayoutQualifiers
+{
+    int location = -1;
+    int binding = -1;
+};
+
+bool isQualifier(const QByteArray &word)
+{
+    static const QSet<QByteArray> qualifiers = {
+        "highp", "mediump", "lowp", "flat", "smooth", "noperspective",
+        "centroid", "sample", "patch", "invariant", "precise", "readonly",
+        "writeonly", "coherent", "restrict", "volatile"
+    };
+    return qualifiers.contains(word);
+}
+
+bool isStorageQualifier(const QByteArray &word)
+{
+    return word == "uniform" || word == "in" || word == "out" || word == "attribute"
+            || word == "varying" || word == "buffer" || word == "const" || word == "shared";
+}
+
+class Parser
+{
+public:
+    explicit Parser(GLSLInterface *result)
+        : m_result(result)
+    {}
+
+    void parse(const QByteArray &source, bool isVertexStage)
+    {
+        m_isVertexStage = isVertexStage;
+        // Each stage is preprocessed on its own
+        m_constants.clear();
+        m_defines.clear();
+        m_conditionals.clear();
+        tokenize(stripComments(source));
+
+        int pos = 0;
+        while (pos < m_tokens.size())
+            pos = parseStatement(pos);
+    }
+
+private:
+    struct ConditionalBlock
+    {
+        bool parentActive;
+        bool branchTaken;
+        bool active;
+    };
+
+    GLSLInterface *m_result;
+    QVector<Token> m_tokens;
+    bool m_isVertexStage = false;
+    QHash<QByteArray, int> m_constants;
+    QSet<QByteArray> m_defines;
+    QVector<ConditionalBlock> m_conditionals;
+    QHash<QByteArray, StructDefinition> m_structs;
+    QSet<QString> m_seenUniforms;
+    QSet<QString> m_seenBlocks;
+    QSet<QString> m_seenAttributes;
+    int m_nextUniformLocation = 0;
+    int m_nextAttributeLocation = 0;
+
+    static QByteArray stripComments(const QByteArray &source)
+    {
+        QByteArray out;
+        out.reserve(source.size());
+        for (int i = 0, m = source.size(); i < m; ++i) {
+            const char c = source.at(i);
+            if (c == '/' && i + 1 < m && source.at(i + 1) == '/') {
+                while (i < m && source.at(i) != '\n')
+                    ++i;
+                out.append('\n');
+            } else if (c == '/' && i + 1 < m && source.at(i + 1) == '*') {
+                i += 2;
+                while (i + 1 < m && !(source.at(i) == '*' && source.at(i + 1) == '/'))
+                    ++i;
+                ++i;
+                out.append(' ');
+            } else if (c == '\\' && i + 1 < m && source.at(i + 1) == '\n') {
+                ++i;
+            } else {
+                out.append(c);
+            }
+        }
+        return out;
+    }
+
+    void tokenize(const QByteArray &source)
+    {
+        m_tokens.clear();
+        const QList<QByteArray> lines = source.split('\n');
+        for (const QByteArray &rawLine : lines) {
+            const QByteArray line = rawLine.trimmed();
+            if (line.startsWith('#')) {
+                parseDirective(line);
+                continue;
+            }
+            if (!isActive())
+                continue;
+            for (int i = 0, m = line.size(); i < m;) {
+                const char c = line.at(i);
+                if (isspace(uchar(c))) {
+                    ++i;
+                } else if (isalpha(uchar(c)) || c == '_') {
+                    const int start = i;
+                    while (i < m && (isalnum(uchar(line.at(i))) || line.at(i) == '_'))
+                        ++i;
+                    m_tokens.push_back({ Token::Identifier, line.mid(start, i - start) });
+                } else if (isdigit(uchar(c))) {
+                    const int start = i;
+                    while (i < m && (isalnum(uchar(line.at(i))) || line.at(i) == '.'))
+                        ++i;
+                    m_tokens.push_back({ Token::Number, line.mid(start, i - start) });
+                } else {
+                    m_tokens.push_back({ Token::Symbol, QByteArray(1, c) });
+                    ++i;
+                }
+            }
+        }
+    }
+
+    bool isActive() const
+    {
+        return m_conditionals.isEmpty() || m_conditionals.constLast().active;
+    }
+
+    void parseDirective(const QByteArray &line)
+    {
+        const QByteArray directive = line.mid(1).trimmed();
+        int nameEnd = 0;
+        while (nameEnd < directive.size() && isalpha(uchar(directive.at(nameEnd))))
+            ++nameEnd;
+        const QByteArray name = directive.left(nameEnd);
+        const QByteArray arguments = directive.mid(nameEnd).simplified();
+
+        if (name == "ifdef" || name == "ifndef" || name == "if") {
+            const bool parentActive = isActive();
+            bool taken = false;
+            if (parentActive) {
+                if (name == "if")
+                    taken = evaluateCondition(arguments);
+                else
+                    taken = m_defines.contains(arguments) == (name == "ifdef");
+            }
+            m_conditionals.push_back({ parentActive, taken, taken });
+            return;
+        }
+        if (name == "elif" || name == "else" || name == "endif") {
+            if (m_conditionals.isEmpty())
+                return;
+            if (name == "endif") {
+                m_conditionals.removeLast();
+                return;
+            }
+            ConditionalBlock &block = m_conditionals.last();
+            block.active = block.parentActive && !block.branchTaken
+                    && (name == "else" || evaluateCondition(arguments));
+            block.branchTaken = block.branchTaken || block.active;
+            return;
+        }
+        if (!isActive())
+            return;
+
+        const QList<QByteArray> parts = arguments.split(' ');
+        if (name == "define" && !parts.first().isEmpty()) {
+            // Only integer object-like macros get a value, they are what
+            // array sizes are usually expressed with
+            const QByteArray macro = parts.first();
+            const int parenthesis = macro.indexOf('(');
+            m_defines.insert(parenthesis < 0 ? macro : macro.left(parenthesis));
+            if (parenthesis < 0 && parts.size() == 2) {
+                bool ok = false;
+                const int value = parts.at(1).toInt(&ok, 0);
+                if (ok)
+                    m_constants.insert(macro, value);
+            }
+        } else if (name == "undef") {
+            m_defines.remove(parts.first());
+            m_constants.remove(parts.first());
+        } else if (name == "version") {
+            m_defines.insert(QByteArrayLiteral("__VERSION__"));
+            m_constants.insert(QByteArrayLiteral("__VERSION__"), parts.first().toInt());
+        }
+    }
+
+    // Evaluates an #if / #elif expression. Expressions that can't be
+    // evaluated (macros with non integer values, function-like macros...)
+    // are considered true, so that their declarations stay reported
+    bool evaluateCondition(const QByteArray &expression) const
+    {
+        ConditionEvaluator evaluator(this, expression);
+        const int value = evaluator.evaluate();
+        return !evaluator.isValid() || value != 0;
+    }
+
+    class ConditionEvaluator
+    {
+    public:
+        ConditionEvaluator(const Parser *parser, const QByteArray &expression)
+            : m_parser(parser)
+        {
+            for (int i = 0, m = expression.size(); i < m;) {
+                const char c = expression.at(i);
+                int start = i;
+                if (isspace(uchar(c))) {
+                    ++i;
+                    continue;
+                } else if (isalnum(uchar(c)) || c == '_') {
+                    while (i < m && (isalnum(uchar(expression.at(i))) || expression.at(i) == '_'))
+                        ++i;
+                } else if (i + 1 < m && strchr("&|=!<>", c) && strchr("&|=", expression.at(i + 1))) {
+                    i += 2;
+                } else {
+                    ++i;
+                }
+                m_tokens.push_back(expression.mid(start, i - start));
+            }
+        }
+
+        int evaluate()
+        {
+            const int value = parseBinary(0);
+            if (m_pos != m_tokens.size())
+                m_valid = false;
+            return value;
+        }
+
+        bool isValid() const { return m_valid; }
+
+    private:
+        const Parser *m_parser;
+        QList<QByteArray> m_tokens;
+        int m_pos = 0;
+        bool m_valid = true;
+
+        QByteArray peek() const
+        {
+            return m_pos < m_tokens.size() ? m_tokens.at(m_pos) : QByteArray();
+        }
+
+        bool accept(const char *token)
+        {
+            if (peek() != token)
+                return false;
+            ++m_pos;
+            return true;
+        }
+
+        static int precedence(const QByteArray &op)
+        {
+            static const char *const levels[][4] = {
+                { "||" }, { "&&" }, { "|" }, { "^" }, { "&" },
+                { "==", "!=" }, { "<", ">", "<=", ">=" }, { "+", "-" }, { "*", "/", "%" }
+            };
+            for (int level = 0; level < int(sizeof(levels) / sizeof(levels[0])); ++level) {
+                for (const char *candidate : levels[level]) {
+                    if (candidate != nullptr && op == candidate)
+                        return level;
+                }
+            }
+            return -1;
+        }
+
+        static int apply(const QByteArray &op, int lhs, int rhs, bool *valid)
+        {
+            if (op == "||") return lhs || rhs;
+            if (op == "&&") return lhs && rhs;
+            if (op == "|") return lhs | rhs;
+            if (op == "^") return lhs ^ rhs;
+            if (op == "&") return lhs & rhs;
+            if (op == "==") return lhs == rhs;
+            if (op == "!=") return lhs != rhs;
+            if (op == "<") return lhs < rhs;
+            if (op == ">") return lhs > rhs;
+            if (op == "<=") return lhs <= rhs;
+            if (op == ">=") return lhs >= rhs;
+            if (op == "+") return lhs + rhs;
+            if (op == "-") return lhs - rhs;
+            if (op == "*") return lhs * rhs;
+            if (rhs == 0) {
+                *valid = false;
+                return 0;
+            }
+            return op == "/" ? lhs / rhs : lhs % rhs;
+        }
+
+        int parseBinary(int minPrecedence)
+        {
+            int lhs = parseUnary();
+            while (m_valid) {
+                const QByteArray op = peek();
+                const int level = precedence(op);
+                if (level < minPrecedence)
+                    break;
+                ++m_pos;
+                const int rhs = parseBinary(level + 1);
+                lhs = apply(op, lhs, rhs, &m_valid);
+            }
+            return lhs;
+        }
+
+        int parseUnary()
+        {
+            if (accept("!"))
+                return !parseUnary();
+            if (accept("-"))
+                return -parseUnary();
+            if (accept("+"))
+                return parseUnary();
+            if (accept("~"))
+                return ~parseUnary();
+            return parsePrimary();
+        }
+
+        int parsePrimary()
+        {
+            const QByteArray token = peek();
+            ++m_pos;
+            if (token == "(") {
+                const int value = parseBinary(0);
+                if (!accept(")"))
+                    m_valid = false;
+                return value;
+            }
+            if (token == "defined") {
+                const bool parenthesized = accept("(");
+                const QByteArray macro = peek();
+                ++m_pos;
+                if (parenthesized && !accept(")"))
+                    m_valid = false;
+                return m_parser->m_defines.contains(macro);
+            }
+            if (!token.isEmpty() && isdigit(uchar(token.at(0))))
+                return integerLiteral(token);
+            if (!token.isEmpty() && (isalpha(uchar(token.at(0))) || token.at(0) == '_')) {
+                // Undefined identifiers evaluate to 0, like in C
+                if (!m_parser->m_defines.contains(token))
+                    return 0;
+                const auto it = m_parser->m_constants.constFind(token);
+                if (it != m_parser->m_constants.cend())
+                    return it.value();
+            }
+            m_valid = false;
+            return 0;
+        }
+    };
+
+    bool isSymbol(int pos, char c) const
+    {
+        return pos < m_tokens.size() && m_tokens.at(pos).kind == Token::Symbol
+                && m_tokens.at(pos).text.at(0) == c;
+    }
+
+    // Returns the index of the token following the matching closing bracket
+    int skipBalanced(int pos, char open, char close) const
+    {
+        int depth = 0;
+        for (; pos < m_tokens.size(); ++pos) {
+            if (isSymbol(pos, open)) {
+                ++depth;
+            } else if (isSymbol(pos, close)) {
+                if (--depth == 0)
+                    return pos + 1;
+            }
+        }
+        return pos;
+    }
+
+    int evaluateArraySize(int begin, int end) const
+    {
+        // Handles literals, named constants and products of those
+        int value = 1;
+        bool hasTerm = false;
+        for (int i = begin; i < end; ++i) {
+            const Token &t = m_tokens.at(i);
+            if (t.kind == Token::Number) {
+                value *= integerLiteral(t.text);
+                hasTerm = true;
+            } else if (t.kind == Token::Identifier) {
+                value *= m_constants.value(t.text, 1);
+                hasTerm = true;
+            }
+        }
+        return hasTerm ? value : 0;
+    }
+
+    LayoutQualifiers parseLayout(int begin, int end) const
+    {
+        LayoutQualifiers layout;
+        for (int i = begin; i + 2 < end; ++i) {
+            if (m_tokens.at(i).kind != Token::Identifier || !isSymbol(i + 1, '='))
+                continue;
+            const int value = integerLiteral(m_tokens.at(i + 2).text);
+            if (m_tokens.at(i).text == "location")
+                layout.location = value;
+            else if (m_tokens.at(i).text == "binding")
+                layout.binding = value;
+        }
+        return layout;
+    }
+
+    // Parses "type name[size], name[size]" lists up to end, qualifiers excluded
+    QVector<Declaration> parseDeclarators(int pos, int end) const
+    {
+        QVector<Declaration> declarations;
+        while (pos < end && m_tokens.at(pos).kind == Token::Identifier && isQualifier(m_tokens.at(pos).text))
+            ++pos;
+        if (pos >= end || m_tokens.at(pos).kind != Token::Identifier)
+            return declarations;
+
+        const QByteArray typeName = m_tokens.at(pos++).text;
+        while (pos < end) {
+            if (m_tokens.at(pos).kind != Token::Identifier)
+                break;
+            Declaration decl;
+            decl.typeName = typeName;
+            decl.name = m_tokens.at(pos++).text;
+            if (isSymbol(pos, '[')) {
+                const int next = skipBalanced(pos, '[', ']');
+                decl.arraySize = evaluateArraySize(pos + 1, next - 1);
+                pos = next;
+            }
+            // Skip initializers
+            while (pos < end && !isSymbol(pos, ','))
+                ++pos;
+            ++pos;
+            declarations.push_back(decl);
+        }
+        return declarations;
+    }
+
+    QVector<Declaration> parseMembers(int begin, int end) const
+    {
+        QVector<Declaration> members;
+        int statementStart = begin;
+        for (int i = begin; i < end; ++i) {
+            if (!isSymbol(i, ';'))
+                continue;
+            int pos = statementStart;
+            if (pos < i && m_tokens.at(pos).text == "layout" && isSymbol(pos + 1, '('))
+                pos = skipBalanced(pos + 1, '(', ')');
+            members += parseDeclarators(pos, i);
+            statementStart = i + 1;
+        }
+        return members;
+    }
+
+    // Returns the index of the first token after the statement
+    int parseStatement(int pos)
+    {
+        const int begin = pos;
+        int bodyBegin = -1;
+        int bodyEnd = -1;
+        while (pos < m_tokens.size() && !isSymbol(pos, ';')) {
+            if (isSymbol(pos, '(')) {
+                pos = skipBalanced(pos, '(', ')');
+            } else if (isSymbol(pos, '{')) {
+                const int next = skipBalanced(pos, '{', '}');
+                // Function definition, nothing to introspect in there
+                if (pos > begin && isSymbol(pos - 1, ')'))
+                    return next;
+                bodyBegin = pos + 1;
+                bodyEnd = next - 1;
+                pos = next;
+            } else {
+                ++pos;
+            }
+        }
+        const int end = pos;
+        handleStatement(begin, end, bodyBegin, bodyEnd);
+        return end + 1;
+    }
+
+    void handleStatement(int pos, int end, int bodyBegin, int bodyEnd)
+    {
+        LayoutQualifiers layout;
+        QByteArray storage;
+        while (pos < end && m_tokens.at(pos).kind == Token::Identifier) {
+            const QByteArray &word = m_tokens.at(pos).text;
+            if (word == "layout" && isSymbol(pos + 1, '(')) {
+                const int next = skipBalanced(pos + 1, '(', ')');
+                layout = parseLayout(pos + 2, next - 1);
+                pos = next;
+            } else if (isStorageQualifier(word)) {
+                storage = word;
+                ++pos;
+            } else if (isQualifier(word)) {
+                ++pos;
+            } else {
+                break;
+            }
+        }
+        if (pos >= end || m_tokens.at(pos).kind != Token::Identifier)
+            return;
+
+        if (m_tokens.at(pos).text == "struct" && pos + 1 < end && bodyBegin >= 0) {
+            m_structs.insert(m_tokens.at(pos + 1).text, { parseMembers(bodyBegin, bodyEnd) });
+            return;
+        }
+
+        if (storage == "const") {
+            // Record "const int NAME = value;" for array sizes
+            if (end - pos == 4 && (m_tokens.at(pos).text == "int" || m_tokens.at(pos).text == "uint")
+                    && isSymbol(pos + 2, '=') && m_tokens.at(pos + 3).kind == Token::Number)
+                m_constants.insert(m_tokens.at(pos + 1).text, integerLiteral(m_tokens.at(pos + 3).text));
+            return;
+        }
+
+        if ((storage == "uniform" || storage == "buffer") && bodyBegin >= 0) {
+            const QByteArray blockName = m_tokens.at(pos).text;
+            const bool hasInstanceName = bodyEnd + 1 < end
+                    && m_tokens.at(bodyEnd + 1).kind == Token::Identifier;
+            addBlock(blockName, hasInstanceName, parseMembers(bodyBegin, bodyEnd),
+                     layout, storage == "buffer");
+            return;
+        }
+
+        if (storage == "uniform") {
+            const QVector<Declaration> decls = parseDeclarators(pos, end);
+            for (const Declaration &decl : decls)
+                addDefaultBlockUniform(decl, QByteArray());
+            return;
+        }
+
+        if (m_isVertexStage && (storage == "in" || storage == "attribute")) {
+            const QVector<Declaration> decls = parseDeclarators(pos, end);
+            for (const Declaration &decl : decls)
+                addAttribute(decl, layout);
+        }
+    }
+
+    void addDefaultBlockUniform(const Declaration &decl, const QByteArray &prefix)
+    {
+        const QByteArray name = prefix + decl.name;
+        const auto structIt = m_structs.constFind(decl.typeName);
+        if (structIt != m_structs.cend()) {
+            const int count = qMax(decl.arraySize, 1);
+            for (int i = 0; i < count; ++i) {
+                const QByteArray elementPrefix = decl.arraySize > 0
+                        ? name + '[' + QByteArray::number(i) + "]."
+                        : name + '.';
+                for (const Declaration &member : structIt->members)
+                    addDefaultBlockUniform(member, elementPrefix);
+            }
+            return;
+        }
+
+        const GLSLType *type = findType(decl.typeName);
+        if (!type)
+            return;
+
+        ShaderUniform uniform;
+        uniform.m_name = QString::fromLatin1(name);
+        uniform.m_size = qMax(decl.arraySize, 1);
+        if (uniform.m_size > 1)
+            uniform.m_name.append(QLatin1String("[0]"));
+        if (m_seenUniforms.contains(uniform.m_name))
+            return;
+        m_seenUniforms.insert(uniform.m_name);
+        uniform.m_type = type->type;
+        uniform.m_location = m_nextUniformLocation;
+        uniform.m_rawByteSize = uniformByteSize(type, 0, 0);
+        m_nextUniformLocation += uniform.m_size * type->columns;
+        m_result->uniforms.push_back(uniform);
+    }
+
+    // std140 base alignment and size of a declaration, arrays included
+    void std140Layout(const Declaration &decl, int *alignment, int *size, int *elementStride) const
+    {
+        const int count = qMax(decl.arraySize, 1);
+        const auto structIt = m_structs.constFind(decl.typeName);
+        if (structIt != m_structs.cend()) {
+            int offset = 0;
+            int structAlignment = 16;
+            for (const Declaration &member : structIt->members) {
+                int memberAlignment = 0, memberSize = 0, memberStride = 0;
+                std140Layout(member, &memberAlignment, &memberSize, &memberStride);
+                offset = roundUp(offset, memberAlignment) + memberSize;
+                structAlignment = qMax(structAlignment, memberAlignment);
+            }
+            *alignment = structAlignment;
+            *elementStride = roundUp(offset, structAlignment);
+            *size = *elementStride * count;
+            return;
+        }
+
+        const GLSLType *type = findType(decl.typeName);
+        if (!type) {
+            *alignment = 4;
+            *size = *elementStride = 0;
+            return;
+        }
+
+        int baseAlignment = 0;
+        int baseSize = 0;
+        if (type->columns > 1) {
+            // Matrices are laid out as arrays of column vectors
+            baseAlignment = 16;
+            baseSize = type->columns * 16;
+        } else {
+            baseAlignment = type->rows == 1 ? 4 : (type->rows == 2 ? 8 : 16);
+            baseSize = type->rows * 4;
+        }
+
+        if (decl.arraySize > 0) {
+            *alignment = 16;
+            *elementStride = roundUp(baseSize, 16);
+            *size = *elementStride * count;
+        } else {
+            *alignment = baseAlignment;
+            *elementStride = 0;
+            *size = baseSize;
+        }
+    }
+
+    void addBlockMember(const Declaration &decl, const QByteArray &prefix, int blockIndex,
+                        int *offset, QVector<ShaderUniform> *members)
+    {
+        int alignment = 0, size = 0, elementStride = 0;
+        std140Layout(decl, &alignment, &size, &elementStride);
+        *offset = roundUp(*offset, alignment);
+        const QByteArray name = prefix + decl.name;
+
+        const auto structIt = m_structs.constFind(decl.typeName);
+        if (structIt != m_structs.cend()) {
+            const int count = qMax(decl.arraySize, 1);
+            for (int i = 0; i < count; ++i) {
+                const QByteArray elementPrefix = decl.arraySize > 0
+                        ? name + '[' + QByteArray::number(i) + "]."
+                        : name + '.';
+                int memberOffset = *offset + i * elementStride;
+                for (const Declaration &member : structIt->members)
+                    addBlockMember(member, elementPrefix, blockIndex, &memberOffset, members);
+            }
+            *offset += size;
+            return;
+        }
+
+        const GLSLType *type = findType(decl.typeName);
+        if (!type)
+            return;
+
+        ShaderUniform uniform;
+        uniform.m_name = QString::fromLatin1(name);
+        uniform.m_size = qMax(decl.arraySize, 1);
+        if (decl.arraySize > 0)
+            uniform.m_name.append(QLatin1String("[0]"));
+        uniform.m_type = type->type;
+        uniform.m_blockIndex = blockIndex;
+        uniform.m_offset = *offset;
+        uniform.m_arrayStride = decl.arraySize > 0 ? elementStride : 0;
+        uniform.m_matrixStride = type->columns > 1 ? 16 : 0;
+        uniform.m_rawByteSize = uniformByteSize(type, uniform.m_arrayStride, uniform.m_matrixStride);
+        members->push_back(uniform);
+        *offset += size;
+    }
+
+    void addBlock(const QByteArray &blockName, bool hasInstanceName,
+                  const QVector<Declaration> &members, const LayoutQualifiers &layout,
+                  bool isStorageBlock)
+    {
+        const QString name = QString::fromLatin1(blockName);
+        if (m_seenBlocks.contains(name))
+            return;
+        m_seenBlocks.insert(name);
+
+        // Members of a block with an instance name are reported with the block
+        // name as prefix, as glGetActiveUniform does
+        const QByteArray prefix = hasInstanceName ? blockName + '.' : QByteArray();
+        const int binding = layout.binding >= 0 ? layout.binding : 0;
+        QVector<ShaderUniform> activeMembers;
+        int offset = 0;
+
+        if (isStorageBlock) {
+            // Storage block members are buffer variables and not reported as
+            // uniforms, only their count and the block size matter
+            for (const Declaration &member : members)
+                addBlockMember(member, prefix, -1, &offset, &activeMembers);
+
+            ShaderStorageBlock block;
+            block.m_name = name;
+            block.m_index = m_result->storageBlocks.size();
+            block.m_binding = binding;
+            block.m_size = roundUp(offset, 16);
+            block.m_activeVariablesCount = activeMembers.size();
+            m_result->storageBlocks.push_back(block);
+            return;
+        }
+
+        const int blockIndex = m_result->uniformBlocks.size();
+        for (const Declaration &member : members)
+            addBlockMember(member, prefix, blockIndex, &offset, &activeMembers);
+
+        ShaderUniformBlock block;
+        block.m_name = name;
+        block.m_index = blockIndex;
+        block.m_binding = binding;
+        block.m_activeUniformsCount = activeMembers.size();
+        block.m_size = roundUp(offset, 16);
+        m_result->uniformBlocks.push_back(block);
+        m_result->uniforms += activeMembers;
+    }
+
+    void addAttribute(const Declaration &decl, const LayoutQualifiers &layout)
+    {
+        const GLSLType *type = findType(decl.typeName);
+        if (!type || type->opaque)
+            return;
+
+        ShaderAttribute attribute;
+        attribute.m_name = QString::fromLatin1(decl.name);
+        if (m_seenAttributes.contains(attribute.m_name))
+            return;
+        m_seenAttributes.insert(attribute.m_name);
+        attribute.m_type = type->type;
+        attribute.m_size = qMax(decl.arraySize, 1);
+        attribute.m_location = layout.location >= 0 ? layout.location : m_nextAttributeLocation;
+        m_nextAttributeLocation = attribute.m_location + attribute.m_size * type->columns;
+        m_result->attributes.push_back(attribute);
+    }
+};
+
+} // anonymous
+
+GLSLInterface introspectGLSL(const QVector<QByteArray> &shaderCode)
+{
+    GLSLInterface result;
+    Parser parser(&result);
+    for (int i = 0, m = shaderCode.size(); i < m; ++i) {
+        if (shaderCode.at(i).isEmpty())
+            continue;
+        parser.parse(shaderCode.at(i), i == QShaderProgram::Vertex);
+    }
+    return result;
+}
+
+} // namespace Null
+
+} // namespace Render
+
+} // namespace Qt3DRender
+
+QT_END_NAMESPACE
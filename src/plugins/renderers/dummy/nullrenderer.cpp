@@ -0,0 +1,465 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "nullrenderer_p.h"
+#include "glslintrospection_p.h"
+
+#include <Qt3DRender/qshaderprogram.h>
+#include <Qt3DRender/private/attribute_p.h>
+#include <Qt3DRender/private/buffermanager_p.h>
+#include <Qt3DRender/private/geometryrenderermanager_p.h>
+#include <Qt3DRender/private/job_common_p.h>
+#include <Qt3DRender/private/managers_p.h>
+#include <Qt3DRender/private/nodemanagers_p.h>
+#include <Qt3DRender/private/renderthread_p.h>
+#include <Qt3DRender/private/shader_p.h>
+#include <Qt3DRender/private/vsyncframeadvanceservice_p.h>
+#include <Qt3DCore/private/qsysteminformationservice_p.h>
+#include <Qt3DCore/private/qsysteminformationservice_p_p.h>
+#include <commandexecuter_p.h>
+#include <glresourcemanagers_p.h>
+#include <glshader_p.h>
+#include <renderqueue_p.h>
+#include <renderview_p.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DRender {
+
+namespace Render {
+
+namespace Null {
+
+using namespace OpenGL;
+
+namespace {
+
+const int defaultMaxRecordedFrames = 1;
+
+// Reported to the RenderViews as the texture unit used for unbound
+// samplers, any value past the ones assigned to actual textures would do
+const int nullMaxTextureUnits = 32;
+
+int maxRecordedFramesFromEnvironment()
+{
+    bool ok = false;
+    const int count = qEnvironmentVariableIntValue("QT3D_NULL_RENDERER_RECORDED_FRAMES", &ok);
+    return ok ? qMax(count, 0) : defaultMaxRecordedFrames;
+}
+
+} // anonymous
+
+/*!
+    \internal
+
+    The NullRenderer is always created as a synchronous OpenGL::Renderer so
+    that no RenderThread calls into it before it is fully constructed; the
+    RenderThread, when requested, is started once construction is complete.
+ */
+NullRenderer::NullRenderer(QRenderAspect::RenderType type)
+    : Renderer(QRenderAspect::Synchronous)
+    , m_initialized(0)
+    , m_maxRecordedFrames(maxRecordedFramesFromEnvironment())
+    , m_renderedFrameCount(0)
+{
+    if (type == QRenderAspect::Threaded) {
+        m_vsyncFrameAdvanceService.reset(new VSyncFrameAdvanceService(true));
+        m_renderThread.reset(new RenderThread(this));
+        m_renderThread->waitForStart();
+    }
+}
+
+NullRenderer::~NullRenderer()
+{
+}
+
+// Called in RenderThread context by the run method of RenderThread
+void NullRenderer::initialize()
+{
+    QMutexLocker lock(&m_hasBeenInitializedMutex);
+
+    // Report the API the application asked for, the techniques selected by
+    // the FilterCompatibleTechniqueJob are then those a real context created
+    // with the default format would have picked
+    m_format = QSurfaceFormat::defaultFormat();
+    m_contextInfo.m_api = m_format.renderableType() == QSurfaceFormat::OpenGLES
+            ? QGraphicsApiFilter::OpenGLES
+            : QGraphicsApiFilter::OpenGL;
+    m_contextInfo.m_profile = static_cast<QGraphicsApiFilter::OpenGLProfile>(m_format.profile());
+    m_contextInfo.m_major = m_format.majorVersion();
+    m_contextInfo.m_minor = m_format.minorVersion();
+    m_initialized.storeRelease(1);
+
+    // Awake setScenegraphRoot in case it was waiting
+    m_waitForInitializationToBeCompleted.release(1);
+    // Allow the aspect manager to proceed
+    m_vsyncFrameAdvanceService->proceedToNextFrame();
+
+    // Force initial refresh
+    markDirty(AllDirty, nullptr);
+}
+
+void NullRenderer::releaseGraphicsResources()
+{
+    if (!m_initialized.fetchAndStoreOrdered(0))
+        return;
+
+    // Only CPU side objects were created, no context needs to be made current
+    if (m_glResourceManagers) {
+        const QVector<GLShader *> shaders = m_glResourceManagers->glShaderManager()->takeActiveResources();
+        qDeleteAll(shaders);
+    }
+    qCDebug(Backend) << Q_FUNC_INFO << "Null renderer properly shutdown";
+}
+
+// Mirrors Renderer::doRender, with the submission replaced by recording the
+// command stream of the frame
+void NullRenderer::doRender(bool swapBuffers)
+{
+    Q_UNUSED(swapBuffers);
+    bool hasCleanedQueueAndProceeded = false;
+
+    // Blocking until RenderQueue is full
+    const bool canSubmit = isReadyToSubmit();
+
+    // Lock the mutex to protect access to the renderQueue while we look for its state
+    QMutexLocker locker(m_renderQueue->mutex());
+    const bool queueIsComplete = m_renderQueue->isFrameQueueComplete();
+    const bool queueIsEmpty = m_renderQueue->targetRenderViewCount() == 0;
+
+    if (canSubmit && (queueIsComplete && !queueIsEmpty)) {
+        const QVector<RenderView *> renderViews = m_renderQueue->nextFrameQueue();
+        QTaskLogger submissionStats(m_services->systemInformation(),
+                                    {JobTypes::FrameSubmissionPart1, 0},
+                                    QTaskLogger::Submission);
+        submissionStats.setName(QStringLiteral("NullFrameSubmission"));
+
+        if (canRender()) {
+            // 1) Consume the dirty resources gathered by the jobs for this frame
+            updateResources();
+
+            // Purge shaders which aren't used any longer
+            static int callCount = 0;
+            ++callCount;
+            const int shaderPurgePeriod = 600;
+            if (callCount % shaderPurgePeriod == 0)
+                m_glResourceManagers->glShaderManager()->purge();
+
+            // 2) Proceed to next frame and start preparing frame n + 1
+            m_renderQueue->reset();
+            locker.unlock(); // Done protecting RenderQueue
+            m_vsyncFrameAdvanceService->proceedToNextFrame();
+            hasCleanedQueueAndProceeded = true;
+
+            // 3) Record the commands for frame n instead of submitting them
+            RecordedFrame frame = recordFrame(renderViews);
+            {
+                QMutexLocker recordLock(&m_recordedFramesMutex);
+                ++m_renderedFrameCount;
+                if (m_maxRecordedFrames > 0) {
+                    if (m_recordedFrames.size() >= m_maxRecordedFrames)
+                        m_recordedFrames.remove(0, m_recordedFrames.size() - m_maxRecordedFrames + 1);
+                    m_recordedFrames.push_back(std::move(frame));
+                }
+            }
+
+            cleanGraphicsResources();
+        }
+
+        // Execute the pending shell commands
+        m_commandExecuter->performAsynchronousCommandExecution(renderViews);
+
+        // Delete all the RenderViews which will clear the allocators
+        // that were used for their allocation
+        qDeleteAll(renderViews);
+    }
+
+    if (!hasCleanedQueueAndProceeded) {
+        // Note: in this case the renderQueue mutex is still locked
+        m_renderQueue->reset();
+        m_vsyncFrameAdvanceService->proceedToNextFrame();
+    }
+}
+
+// Without GL objects to release, only the bookkeeping of Renderer::cleanGraphicsResources remains
+void NullRenderer::cleanGraphicsResources()
+{
+    m_nodesManager->bufferManager()->takeBuffersToRelease();
+    m_textureIdsToCleanup.clear();
+
+    m_abandonedVaosMutex.lock();
+    m_abandonedVaos.clear();
+    m_abandonedVaosMutex.unlock();
+
+    const QVector<Qt3DCore::QNodeId> cleanedUpShaderIds = m_nodesManager->shaderManager()->takeShaderIdsToCleanup();
+    for (const Qt3DCore::QNodeId shaderCleanedUpId: cleanedUpShaderIds) {
+        cleanupShader(m_nodesManager->shaderManager()->lookupResource(shaderCleanedUpId));
+        m_nodesManager->shaderManager()->releaseResource(shaderCleanedUpId);
+    }
+}
+
+QOpenGLContext *NullRenderer::shareContext() const
+{
+    return nullptr;
+}
+
+void NullRenderer::setOpenGLContext(QOpenGLContext *context)
+{
+    Q_UNUSED(context);
+    qCWarning(Backend) << "The null renderer does not render into an OpenGL context";
+}
+
+bool NullRenderer::accessOpenGLTexture(Qt3DCore::QNodeId nodeId,
+                                       QOpenGLTexture **texture,
+                                       QMutex **lock,
+                                       bool readonly)
+{
+    Q_UNUSED(nodeId);
+    Q_UNUSED(texture);
+    Q_UNUSED(lock);
+    Q_UNUSED(readonly);
+    return false;
+}
+
+QSurfaceFormat NullRenderer::format()
+{
+    return m_format;
+}
+
+const GraphicsApiFilterData *NullRenderer::contextInfo() const
+{
+    return &m_contextInfo;
+}
+
+bool NullRenderer::isGraphicsContextInitialized() const
+{
+    return m_initialized.loadAcquire();
+}
+
+int NullRenderer::maxTextureUnitsCount() const
+{
+    return nullMaxTextureUnits;
+}
+
+void NullRenderer::setMaxRecordedFrames(int count)
+{
+    QMutexLocker lock(&m_recordedFramesMutex);
+    m_maxRecordedFrames = qMax(count, 0);
+    if (m_recordedFrames.size() > m_maxRecordedFrames)
+        m_recordedFrames.remove(0, m_recordedFrames.size() - m_maxRecordedFrames);
+}
+
+int NullRenderer::maxRecordedFrames() const
+{
+    QMutexLocker lock(&m_recordedFramesMutex);
+    return m_maxRecordedFrames;
+}
+
+QVector<RecordedFrame> NullRenderer::takeRecordedFrames()
+{
+    QMutexLocker lock(&m_recordedFramesMutex);
+    return std::move(m_recordedFrames);
+}
+
+quint64 NullRenderer::renderedFrameCount() const
+{
+    QMutexLocker lock(&m_recordedFramesMutex);
+    return m_renderedFrameCount;
+}
+
+// Render Thread, the aspect thread is blocked until proceedToNextFrame is called
+void NullRenderer::updateResources()
+{
+    // Nothing to upload, buffers only need their dirtiness consumed
+    const QVector<HBuffer> dirtyBufferHandles = std::move(m_dirtyBuffers);
+    for (const HBuffer &handle: dirtyBufferHandles) {
+        Buffer *buffer = m_nodesManager->bufferManager()->data(handle);
+        if (buffer != nullptr)
+            buffer->unsetDirty();
+    }
+
+    const QVector<HShader> dirtyShaderHandles = std::move(m_dirtyShaders);
+    ShaderManager *shaderManager = m_nodesManager->shaderManager();
+    for (const HShader &handle: dirtyShaderHandles) {
+        Shader *shader = shaderManager->data(handle);
+        if (shader != nullptr)
+            introspectShader(shader);
+    }
+
+    const QVector<HTexture> dirtyTextureHandles = std::move(m_dirtyTextures);
+    for (const HTexture &handle: dirtyTextureHandles) {
+        Texture *texture = m_nodesManager->textureManager()->data(handle);
+        if (texture == nullptr)
+            continue;
+        // Texture data generators are never run, drop what would have been uploaded
+        texture->takePendingTextureDataUpdates();
+        texture->unsetDirty();
+    }
+    m_textureIdsToCleanup += m_nodesManager->textureManager()->takeTexturesIdsToCleanup();
+    m_nodesManager->renderTargetManager()->takeRenderTargetIdsToCleanup();
+
+    // Buffer captures get the content last sent by the frontend
+    const QVector<HBuffer> activeBufferHandles = m_nodesManager->bufferManager()->activeHandles();
+    for (const HBuffer &handle : activeBufferHandles) {
+        Buffer *buffer = m_nodesManager->bufferManager()->data(handle);
+        if (buffer->access() & Qt3DCore::QBuffer::Read)
+            m_sendBufferCaptureJob->addRequest(QPair<Qt3DCore::QNodeId, QByteArray>(buffer->peerId(), buffer->data()));
+    }
+}
+
+// Same sharing logic as GraphicsContext::loadShader, with the program
+// interface extracted from the sources instead of queried from the driver
+void NullRenderer::introspectShader(Shader *shaderNode)
+{
+    GLShaderManager *glShaderManager = m_glResourceManagers->glShaderManager();
+    GLShader *glShader = glShaderManager->lookupResource(shaderNode->peerId());
+
+    if (glShader != nullptr)
+        glShaderManager->abandon(glShader, shaderNode);
+
+    glShader = glShaderManager->createOrAdoptExisting(shaderNode);
+
+    const QVector<Qt3DCore::QNodeId> sharedShaderIds = glShaderManager->shaderIdsForProgram(glShader);
+    if (sharedShaderIds.size() == 1) {
+        if (!glShader->isLoaded()) {
+            glShader->setShaderCode(shaderNode->shaderCode());
+            const GLSLInterface shaderInterface = introspectGLSL(shaderNode->shaderCode());
+            glShader->initializeUniforms(shaderInterface.uniforms);
+            glShader->initializeAttributes(shaderInterface.attributes);
+            glShader->initializeUniformBlocks(shaderInterface.uniformBlocks);
+            glShader->initializeShaderStorageBlocks(shaderInterface.storageBlocks);
+            shaderNode->setStatus(QShaderProgram::Ready);
+            shaderNode->setLog(QString());
+            glShader->setLoaded(true);
+        }
+    } else {
+        for (const Qt3DCore::QNodeId sharedShaderId : sharedShaderIds) {
+            if (sharedShaderId != shaderNode->peerId()) {
+                Shader *refShader = m_nodesManager->shaderManager()->lookupResource(sharedShaderId);
+                shaderNode->initializeFromReference(*refShader);
+                break;
+            }
+        }
+    }
+    shaderNode->unsetDirty();
+    // Ensure we will rebuilt material caches
+    shaderNode->requestCacheRebuild();
+}
+
+RecordedFrame NullRenderer::recordFrame(const QVector<RenderView *> &renderViews)
+{
+    RecordedFrame frame;
+    frame.frameIndex = m_renderedFrameCount;
+    frame.renderViews.reserve(renderViews.size());
+
+    QVector<Geometry *> recordedGeometries;
+
+    for (RenderView *rv : renderViews) {
+        RecordedRenderView recordedView;
+        recordedView.renderTargetId = rv->renderTargetId();
+        recordedView.viewport = rv->viewport();
+        recordedView.surfaceSize = rv->surfaceSize();
+        recordedView.clearBuffers = rv->clearTypes();
+        recordedView.isCompute = rv->isCompute();
+        recordedView.noDraw = rv->noDraw();
+
+        const QVector<RenderCommand> &commands = rv->commands();
+        recordedView.commands.reserve(commands.size());
+        for (const RenderCommand &command : commands) {
+            RecordedCommand recorded;
+            recorded.type = command.m_type;
+            recorded.shaderId = command.m_shaderId;
+            recorded.uniformCount = command.m_parameterPack.uniforms().keys.size();
+            recorded.textureCount = command.m_parameterPack.textures().size();
+            recorded.uniformBufferCount = command.m_parameterPack.uniformBuffers().size();
+            recorded.shaderStorageBufferCount = command.m_parameterPack.shaderStorageBuffers().size();
+            recorded.depth = command.m_depth;
+            recorded.hasRenderStates = !command.m_stateSet.isNull();
+
+            if (command.m_type == RenderCommand::Compute) {
+                std::copy(command.m_workGroups, command.m_workGroups + 3, recorded.workGroups);
+            } else {
+                recorded.primitiveType = command.m_primitiveType;
+                recorded.primitiveCount = command.m_primitiveCount;
+                recorded.instanceCount = command.m_instanceCount;
+                recorded.firstInstance = command.m_firstInstance;
+                recorded.firstVertex = command.m_firstVertex;
+                recorded.indexOffset = command.m_indexOffset;
+                recorded.drawIndexed = command.m_drawIndexed;
+                recorded.drawIndirect = command.m_drawIndirect;
+
+                // Consume the dirtiness prepareCommandsSubmission would
+                // have reset after the VAO upload
+                GeometryRenderer *rGeometryRenderer = m_nodesManager->data<GeometryRenderer, GeometryRendererManager>(command.m_geometryRenderer);
+                if (rGeometryRenderer) {
+                    recorded.geometryRendererId = rGeometryRenderer->peerId();
+                    if (rGeometryRenderer->isDirty())
+                        rGeometryRenderer->unsetDirty();
+                }
+                Geometry *rGeometry = m_nodesManager->data<Geometry, GeometryManager>(command.m_geometry);
+                if (rGeometry && rGeometry->isDirty() && !recordedGeometries.contains(rGeometry))
+                    recordedGeometries.push_back(rGeometry);
+            }
+            recordedView.commands.push_back(recorded);
+        }
+        frame.renderViews.push_back(std::move(recordedView));
+    }
+
+    // Geometries may be shared between commands, only reset them once all
+    // commands have been recorded
+    for (Geometry *geometry : qAsConst(recordedGeometries)) {
+        const QVector<Qt3DCore::QNodeId> attributeIds = geometry->attributes();
+        for (const Qt3DCore::QNodeId attributeId : attributeIds) {
+            Attribute *attribute = m_nodesManager->attributeManager()->lookupResource(attributeId);
+            if (attribute)
+                attribute->unsetDirty();
+        }
+        geometry->unsetDirty();
+    }
+
+    return frame;
+}
+
+} // namespace Null
+
+} // namespace Render
+
+} // namespace Qt3DRender
+
+QT_END_NAMESPACE
@@ -0,0 +1,165 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QT3DRENDER_RENDER_NULL_NULLRENDERER_P_H
+#define QT3DRENDER_RENDER_NULL_NULLRENDERER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of other Qt classes.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <renderer_p.h>
+#include <rendercommand_p.h>
+#include <Qt3DRender/qclearbuffers.h>
+#include <Qt3DRender/private/qgraphicsapifilter_p.h>
+#include <QRectF>
+#include <QSize>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DRender {
+
+namespace Render {
+
+namespace Null {
+
+struct RecordedCommand
+{
+    OpenGL::RenderCommand::CommandType type = OpenGL::RenderCommand::Draw;
+    Qt3DCore::QNodeId shaderId;
+    Qt3DCore::QNodeId geometryRendererId;
+    QGeometryRenderer::PrimitiveType primitiveType = QGeometryRenderer::Triangles;
+    int primitiveCount = 0;
+    int instanceCount = 0;
+    int firstInstance = 0;
+    int firstVertex = 0;
+    int indexOffset = 0;
+    int workGroups[3] = { 0, 0, 0 };
+    int uniformCount = 0;
+    int textureCount = 0;
+    int uniformBufferCount = 0;
+    int shaderStorageBufferCount = 0;
+    float depth = 0.0f;
+    bool drawIndexed = false;
+    bool drawIndirect = false;
+    bool hasRenderStates = false;
+};
+
+struct RecordedRenderView
+{
+    Qt3DCore::QNodeId renderTargetId;
+    QRectF viewport;
+    QSize surfaceSize;
+    QClearBuffers::BufferTypeFlags clearBuffers = QClearBuffers::None;
+    bool isCompute = false;
+    bool noDraw = false;
+    QVector<RecordedCommand> commands;
+};
+
+struct RecordedFrame
+{
+    quint64 frameIndex = 0;
+    QVector<RecordedRenderView> renderViews;
+};
+
+// Runs the CPU side of the OpenGL renderer (frame graph traversal, culling,
+// layer filtering, material gathering, sorting and uniform packing) without
+// a graphics context. Instead of being submitted, the command stream of each
+// frame is recorded so that it can be inspected or discarded.
+class Q_AUTOTEST_EXPORT NullRenderer : public OpenGL::Renderer
+{
+public:
+    explicit NullRenderer(QRenderAspect::RenderType type);
+    ~NullRenderer();
+
+    void initialize() override;
+    void releaseGraphicsResources() override;
+    void doRender(bool swapBuffers = true) override;
+    void cleanGraphicsResources() override;
+
+    QOpenGLContext *shareContext() const override;
+    void setOpenGLContext(QOpenGLContext *context) override;
+    bool accessOpenGLTexture(Qt3DCore::QNodeId nodeId,
+                             QOpenGLTexture **texture,
+                             QMutex **lock,
+                             bool readonly) override;
+    QSurfaceFormat format() override;
+
+    const GraphicsApiFilterData *contextInfo() const override;
+    bool isGraphicsContextInitialized() const override;
+    int maxTextureUnitsCount() const override;
+
+    // Number of frames kept in memory, older frames are dropped first.
+    // 0 disables recording, only the frame counter is then updated.
+    void setMaxRecordedFrames(int count);
+    int maxRecordedFrames() const;
+
+    QVector<RecordedFrame> takeRecordedFrames();
+    quint64 renderedFrameCount() const;
+
+private:
+    void updateResources();
+    void introspectShader(Shader *shaderNode);
+    RecordedFrame recordFrame(const QVector<OpenGL::RenderView *> &renderViews);
+
+    GraphicsApiFilterData m_contextInfo;
+    QAtomicInt m_initialized;
+
+    mutable QMutex m_recordedFramesMutex;
+    QVector<RecordedFrame> m_recordedFrames;
+    int m_maxRecordedFrames;
+    quint64 m_renderedFrameCount;
+};
+
+} // namespace Null
+
+} // namespace Render
+
+} // namespace Qt3DRender
+
+QT_END_NAMESPACE
+
+#endif // QT3DRENDER_RENDER_NULL_NULLRENDERER_P_H
@@ -1269,13 +1269,18 @@ bool SubmissionContext::setParameters(ShaderParameterPack &parameterPack, GLShad
     }
 
     // Update uniforms in the Default Uniform Block
-    const PackUniformHash values = parameterPack.uniforms();
-    const QVector<int> &activeUniformsIndices = parameterPack.submissionUniformIndices();
+    const PackUniformHash &values = parameterPack.uniforms();
+    const UniformLayout &layout = shader->uniformLayout();
     const QVector<ShaderUniform> &shaderUniforms = shader->uniforms();
 
-    for (const int shaderUniformIndex : activeUniformsIndices) {
-        const ShaderUniform &uniform = shaderUniforms[shaderUniformIndex];
-        const UniformValue &v = values.value(uniform.m_nameId);
+    for (int i = 0, m = values.keys.size(); i < m; ++i) {
+        // Skip values that are not active uniforms of the shader
+        const int slot = layout.slot(values.keys.at(i));
+        if (slot == -1)
+            continue;
+
+        const ShaderUniform &uniform = shaderUniforms.at(slot);
+        const UniformValue &v = values.values.at(i);
 
         // skip invalid textures/images
         if ((v.valueType() == UniformValue::TextureValue ||
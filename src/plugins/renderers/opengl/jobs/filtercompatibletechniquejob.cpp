@@ -80,7 +80,7 @@ Renderer *FilterCompatibleTechniqueJob::renderer() const
 void FilterCompatibleTechniqueJob::run()
 {
     Q_ASSERT(m_manager != nullptr && m_renderer != nullptr);
-    Q_ASSERT(m_renderer->isRunning() && m_renderer->submissionContext()->isInitialized());
+    Q_ASSERT(m_renderer->isRunning() && m_renderer->isGraphicsContextInitialized());
 
     const QVector<Qt3DCore::QNodeId> dirtyTechniqueIds = m_manager->takeDirtyTechniques();
     for (const Qt3DCore::QNodeId techniqueId : dirtyTechniqueIds) {
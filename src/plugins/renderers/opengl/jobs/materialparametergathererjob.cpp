@@ -96,9 +96,10 @@ MaterialParameterGathererJob::MaterialParameterGathererJob()
 
 // Parameters from Material/Effect/Technique
 
-// Note: we could maybe improve that by having a smart update when we detect
-// that a parameter value has changed. That might require way more book keeping
-// which might make this solution a bit too complex
+// Parameter value changes don't require regathering. When only some
+// Materials, or the Parameters, Effects, Techniques and RenderPasses they
+// reference, changed, the handles are restricted to those Materials and
+// SyncMaterialParameterGatherer patches their entries in the cached table.
 
 // The fact that this can now be performed in parallel should already provide a big
 // improvement
@@ -77,6 +77,7 @@ public:
         m_count = count;
         m_entities = entities;
     }
+    inline const QVector<Entity *> &entities() const Q_DECL_NOTHROW { return m_entities; }
     inline EntityRenderCommandData &commandData() { return m_commandData; }
 
     void run() final;
@@ -241,7 +241,7 @@ void CommandExecuter::performAsynchronousCommandExecution(const QVector<Render::
     for (auto *reply : shellCommands) {
         if (reply->commandName() == QLatin1String("glinfo")) {
             QJsonObject replyObj;
-            const GraphicsApiFilterData *contextInfo = m_renderer->submissionContext()->contextInfo();
+            const GraphicsApiFilterData *contextInfo = m_renderer->contextInfo();
             if (contextInfo != nullptr) {
                 replyObj.insert(QLatin1String("api"),
                                 contextInfo->m_api == QGraphicsApiFilter::OpenGL
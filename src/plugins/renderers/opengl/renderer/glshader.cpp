@@ -222,31 +222,6 @@ bool GLShader::hasUniform(int nameId) const noexcept
     return m_uniformsNamesIds.contains(nameId);
 }
 
-void GLShader::prepareUniforms(ShaderParameterPack &pack)
-{
-    const PackUniformHash &values = pack.uniforms();
-
-    auto it = values.keys.cbegin();
-    const auto end = values.keys.cend();
-
-    const int shaderUniformsCount = m_uniforms.size();
-    const auto uIt = m_uniforms.cbegin();
-
-    while (it != end) {
-        // Find if there's a uniform with the same name id
-
-        int i = 0;
-        const int targetNameId = *it;
-        while (i < shaderUniformsCount && (uIt + i)->m_nameId < targetNameId)
-            ++i;
-
-        if (i < shaderUniformsCount && (uIt + i)->m_nameId == targetNameId)
-            pack.setSubmissionUniformIndex(i);
-
-        ++it;
-    }
-}
-
 void GLShader::setFragOutputs(const QHash<QString, int> &fragOutputs)
 {
     {
@@ -329,6 +304,7 @@ void GLShader::initializeUniforms(const QVector<ShaderUniform> &uniformsDescript
               [] (const ShaderUniform &a, const ShaderUniform &b) {
         return a.m_nameId < b.m_nameId;
     });
+    m_uniformLayout.build(m_uniforms);
 }
 
 void GLShader::initializeAttributes(const QVector<ShaderAttribute> &attributesDescription)
@@ -69,6 +69,10 @@ namespace Qt3DRender {
 
 namespace Render {
 
+namespace Null {
+class NullRenderer;
+}
+
 namespace OpenGL {
 
 class Q_AUTOTEST_EXPORT GLShader
@@ -82,8 +86,6 @@ public:
     bool isLoaded() const { return m_isLoaded; }
     void setLoaded(bool loaded) { m_isLoaded = loaded; }
 
-    void prepareUniforms(ShaderParameterPack &pack);
-
     void setFragOutputs(const QHash<QString, int> &fragOutputs);
     const QHash<QString, int> fragOutputs() const;
 
@@ -103,6 +105,7 @@ public:
     inline const QVector<ShaderAttribute> &attributes() const { return m_attributes; }
     inline const QVector<ShaderUniformBlock> &uniformBlocks() const { return m_uniformBlocks; }
     inline const QVector<ShaderStorageBlock> &storageBlocks() const { return m_shaderStorageBlocks; }
+    inline const UniformLayout &uniformLayout() const { return m_uniformLayout; }
 
     QHash<QString, ShaderUniform> activeUniformsForUniformBlock(int blockIndex) const;
 
@@ -141,6 +144,7 @@ private:
     QVector<int> m_lightUniformsNamesIds;
     QVector<int> m_standardUniformNamesIds;
     QVector<ShaderUniform> m_uniforms;
+    UniformLayout m_uniformLayout;
 
     QVector<QString> m_attributesNames;
     QVector<int> m_attributeNamesIds;
@@ -168,6 +172,7 @@ private:
     void initializeShaderStorageBlocks(const QVector<ShaderStorageBlock> &shaderStorageBlockDescription);
 
     friend class GraphicsContext;
+    friend class Null::NullRenderer;
 #ifdef QT_BUILD_INTERNAL
     friend class ::tst_BenchShaderParameterPack;
 #endif
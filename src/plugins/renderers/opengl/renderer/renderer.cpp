@@ -120,6 +120,7 @@
 #include <QOffscreenSurface>
 #include <QWindow>
 #include <QThread>
+#include <QSet>
 #include <QKeyEvent>
 #include <QMouseEvent>
 
@@ -208,6 +209,118 @@ private:
     RendererCache *m_cache;
 };
 
+// Appends to materialIds the ids of the Materials which reference, directly or
+// through their Effect, Techniques and RenderPasses, one of the nodes in
+// sortedNodeIds (Parameters, Effects, Techniques or RenderPasses)
+void appendMaterialsReferencingNodes(NodeManagers *managers,
+                                     const QVector<Qt3DCore::QNodeId> &sortedNodeIds,
+                                     QVector<Qt3DCore::QNodeId> &materialIds)
+{
+    if (sortedNodeIds.isEmpty())
+        return;
+
+    const auto isDirty = [&sortedNodeIds] (Qt3DCore::QNodeId id) {
+        return std::binary_search(sortedNodeIds.cbegin(), sortedNodeIds.cend(), id);
+    };
+    const auto anyDirty = [&isDirty] (const QVector<Qt3DCore::QNodeId> &ids) {
+        return std::any_of(ids.cbegin(), ids.cend(), isDirty);
+    };
+
+    // Effects are usually shared by many Materials
+    QHash<Qt3DCore::QNodeId, bool> dirtyEffects;
+    const auto isEffectDirty = [&] (Qt3DCore::QNodeId effectId) {
+        const auto it = dirtyEffects.constFind(effectId);
+        if (it != dirtyEffects.cend())
+            return it.value();
+
+        bool dirty = isDirty(effectId);
+        const Effect *effect = managers->effectManager()->lookupResource(effectId);
+        if (!dirty && effect != nullptr) {
+            dirty = anyDirty(effect->parameters()) || anyDirty(effect->techniques());
+            const QVector<Qt3DCore::QNodeId> techniqueIds = effect->techniques();
+            for (int i = 0, m = techniqueIds.size(); !dirty && i < m; ++i) {
+                const Technique *technique = managers->techniqueManager()->lookupResource(techniqueIds.at(i));
+                if (technique == nullptr)
+                    continue;
+                dirty = anyDirty(technique->parameters()) || anyDirty(technique->renderPasses());
+                const QVector<Qt3DCore::QNodeId> passIds = technique->renderPasses();
+                for (int j = 0, n = passIds.size(); !dirty && j < n; ++j) {
+                    const RenderPass *pass = managers->renderPassManager()->lookupResource(passIds.at(j));
+                    dirty = pass != nullptr && anyDirty(pass->parameters());
+                }
+            }
+        }
+        dirtyEffects.insert(effectId, dirty);
+        return dirty;
+    };
+
+    MaterialManager *materialManager = managers->materialManager();
+    const QVector<HMaterial> &materialHandles = materialManager->activeHandles();
+    for (const HMaterial &handle : materialHandles) {
+        const Material *material = materialManager->data(handle);
+        if (anyDirty(material->parameters()) || isEffectDirty(material->effect()))
+            materialIds.push_back(material->peerId());
+    }
+}
+
+// Returns whether the Parameters among nodeIds are all referenced by a
+// Material, Effect, Technique or RenderPass, and not by the RenderPassFilters
+// or TechniqueFilters above leaves. The Parameters of these filters are
+// gathered into the parameters of every Material.
+bool parametersOnlyReferencedByMaterials(NodeManagers *managers,
+                                         const QVector<FrameGraphNode *> &leaves,
+                                         const QVector<Qt3DCore::QNodeId> &nodeIds)
+{
+    QVector<Qt3DCore::QNodeId> parameterIds;
+    for (const Qt3DCore::QNodeId id : nodeIds) {
+        if (managers->parameterManager()->lookupResource(id) != nullptr)
+            parameterIds.push_back(id);
+    }
+    if (parameterIds.isEmpty())
+        return true;
+    std::sort(parameterIds.begin(), parameterIds.end());
+
+    const auto isDirty = [&parameterIds] (Qt3DCore::QNodeId id) {
+        return std::binary_search(parameterIds.cbegin(), parameterIds.cend(), id);
+    };
+
+    QSet<FrameGraphNode *> visitedNodes;
+    for (FrameGraphNode *leaf : leaves) {
+        for (FrameGraphNode *node = leaf; node != nullptr && !visitedNodes.contains(node); node = node->parent()) {
+            visitedNodes.insert(node);
+            QVector<Qt3DCore::QNodeId> filterParameterIds;
+            if (node->nodeType() == FrameGraphNode::RenderPassFilter)
+                filterParameterIds = static_cast<RenderPassFilter *>(node)->parameters();
+            else if (node->nodeType() == FrameGraphNode::TechniqueFilter)
+                filterParameterIds = static_cast<TechniqueFilter *>(node)->parameters();
+            if (std::any_of(filterParameterIds.cbegin(), filterParameterIds.cend(), isDirty))
+                return false;
+        }
+    }
+
+    QSet<Qt3DCore::QNodeId> referencedIds;
+    const auto reference = [&] (const QVector<Qt3DCore::QNodeId> &ids) {
+        for (const Qt3DCore::QNodeId id : ids) {
+            if (isDirty(id))
+                referencedIds.insert(id);
+        }
+    };
+    MaterialManager *materialManager = managers->materialManager();
+    for (const HMaterial &handle : materialManager->activeHandles())
+        reference(materialManager->data(handle)->parameters());
+    EffectManager *effectManager = managers->effectManager();
+    for (const HEffect &handle : effectManager->activeHandles())
+        reference(effectManager->data(handle)->parameters());
+    TechniqueManager *techniqueManager = managers->techniqueManager();
+    for (const HTechnique &handle : techniqueManager->activeHandles())
+        reference(techniqueManager->data(handle)->parameters());
+    RenderPassManager *renderPassManager = managers->renderPassManager();
+    for (const HRenderPass &handle : renderPassManager->activeHandles())
+        reference(renderPassManager->data(handle)->parameters());
+
+    return referencedIds.size() == parameterIds.size();
+}
+
 } // anonymous
 
 /*!
@@ -747,6 +860,8 @@ void Renderer::doRender(bool swapBuffers)
         QTaskLogger submissionStatsPart2(m_services->systemInformation(),
                                          {JobTypes::FrameSubmissionPart2, 0},
                                          QTaskLogger::Submission);
+        submissionStatsPart1.setName(QStringLiteral("FrameSubmissionPart1"));
+        submissionStatsPart2.setName(QStringLiteral("FrameSubmissionPart2"));
         if (canRender()) {
             { // Scoped to destroy surfaceLock
                 QSurface *surface = nullptr;
@@ -1762,13 +1877,49 @@ Renderer::ViewSubmissionResultData Renderer::submitRenderViews(const QVector<Ren
 
 void Renderer::markDirty(BackendNodeDirtySet changes, BackendNode *node)
 {
-    Q_UNUSED(node)
+    const QMutexLocker lock(&m_markDirtyMutex);
+
+    // Changes coming from an Entity, a GeometryRenderer or a Material only
+    // invalidate the RenderCommands of the entities referencing that node.
+    // Anything else (including destroyed nodes which can no longer be looked
+    // up) requires all RenderCommands to be rebuilt.
+    if (node != nullptr && m_nodesManager != nullptr) {
+        const Qt3DCore::QNodeId id = node->peerId();
+        QVector<Qt3DCore::QNodeId> *scopedIds = nullptr;
+        if (m_nodesManager->renderNodesManager()->lookupResource(id) == node)
+            scopedIds = &m_dirtyBits.entityScopedNodes.entityIds;
+        else if (m_nodesManager->geometryRendererManager()->lookupResource(id) == node)
+            scopedIds = &m_dirtyBits.entityScopedNodes.geometryRendererIds;
+        else if (m_nodesManager->materialManager()->lookupResource(id) == node)
+            scopedIds = &m_dirtyBits.entityScopedNodes.materialIds;
+
+        if (scopedIds != nullptr) {
+            m_dirtyBits.entityScoped |= changes;
+            scopedIds->push_back(id);
+            return;
+        }
+
+        // Structural changes to Parameters, Effects, Techniques and RenderPasses
+        // only invalidate the Materials referencing them. Parameter value
+        // changes don't require anything to be rebuilt. Parameters of filters
+        // are moved back to a full rebuild by renderBinJobs.
+        const bool materialScoped = m_nodesManager->effectManager()->lookupResource(id) == node
+                || m_nodesManager->techniqueManager()->lookupResource(id) == node
+                || m_nodesManager->renderPassManager()->lookupResource(id) == node
+                || ((changes & AbstractRenderer::MaterialDirty)
+                    && m_nodesManager->parameterManager()->lookupResource(id) == node);
+        if (materialScoped) {
+            m_dirtyBits.materialScoped |= changes;
+            m_dirtyBits.materialScopedNodes.push_back(id);
+            return;
+        }
+    }
     m_dirtyBits.marked |= changes;
 }
 
 Renderer::BackendNodeDirtySet Renderer::dirtyBits()
 {
-    return m_dirtyBits.marked;
+    return m_dirtyBits.marked | m_dirtyBits.entityScoped | m_dirtyBits.materialScoped;
 }
 
 #if defined(QT_BUILD_INTERNAL)
@@ -1776,6 +1927,12 @@ void Renderer::clearDirtyBits(BackendNodeDirtySet changes)
 {
     m_dirtyBits.remaining &= ~changes;
     m_dirtyBits.marked &= ~changes;
+    m_dirtyBits.entityScoped &= ~changes;
+    if (!m_dirtyBits.entityScoped)
+        m_dirtyBits.entityScopedNodes.clear();
+    m_dirtyBits.materialScoped &= ~changes;
+    if (!m_dirtyBits.materialScoped)
+        m_dirtyBits.materialScopedNodes.clear();
 }
 #endif
 
@@ -1786,6 +1943,8 @@ bool Renderer::shouldRender() const
     return (m_settings->renderPolicy() == QRenderSettings::Always
             || m_dirtyBits.marked != 0
             || m_dirtyBits.remaining != 0
+            || m_dirtyBits.entityScoped != 0
+            || m_dirtyBits.materialScoped != 0
             || !m_lastFrameCorrect.loadRelaxed());
 }
 
@@ -1847,7 +2006,19 @@ QVector<Qt3DCore::QAspectJobPtr> Renderer::renderBinJobs()
     // Remove previous dependencies
     m_cleanupJob->removeDependency(QWeakPointer<QAspectJob>());
 
-    const BackendNodeDirtySet dirtyBitsForFrame = m_dirtyBits.marked | m_dirtyBits.remaining;
+    // Parameters which aren't only referenced by Materials and their
+    // Effects, Techniques and RenderPasses require all Materials to be gathered
+    if (!m_dirtyBits.materialScopedNodes.isEmpty()
+            && !parametersOnlyReferencedByMaterials(m_nodesManager, m_frameGraphLeaves,
+                                                    m_dirtyBits.materialScopedNodes)) {
+        m_dirtyBits.marked |= AbstractRenderer::MaterialDirty;
+    }
+
+    const BackendNodeDirtySet globalDirtyBitsForFrame = m_dirtyBits.marked | m_dirtyBits.remaining;
+    const BackendNodeDirtySet dirtyBitsForFrame = globalDirtyBitsForFrame
+            | m_dirtyBits.entityScoped
+            | m_dirtyBits.materialScoped;
+    const bool materialScopedDirty = !m_dirtyBits.materialScopedNodes.isEmpty();
     m_dirtyBits.marked = {};
     m_dirtyBits.remaining = {};
     BackendNodeDirtySet notCleared = {};
@@ -1879,9 +2050,27 @@ QVector<Qt3DCore::QAspectJobPtr> Renderer::renderBinJobs()
     const bool lightsDirty = dirtyBitsForFrame & AbstractRenderer::LightsDirty;
     const bool computeableDirty = dirtyBitsForFrame & AbstractRenderer::ComputeDirty;
     const bool renderableDirty = dirtyBitsForFrame & AbstractRenderer::GeometryDirty;
-    const bool materialCacheNeedsToBeRebuilt = shadersDirty || materialDirty || frameGraphDirty;
+    const bool materialCacheNeedsToBeRebuilt = shadersDirty || materialDirty || frameGraphDirty || materialScopedDirty;
     const bool renderCommandsDirty = materialCacheNeedsToBeRebuilt || renderableDirty || computeableDirty;
 
+    // If the gathered material parameters are only dirty because of changes
+    // to some Materials or the Parameters, Effects, Techniques and
+    // RenderPasses they reference, only those Materials need to be gathered
+    const BackendNodeDirtySet materialCacheFullRebuildDirtyBits = AbstractRenderer::ShadersDirty
+            | AbstractRenderer::MaterialDirty
+            | AbstractRenderer::FrameGraphDirty;
+    const bool materialCacheNeedsFullRebuild = globalDirtyBitsForFrame & materialCacheFullRebuildDirtyBits;
+
+    // If the RenderCommands are only dirty because of changes to some
+    // Entities, GeometryRenderers or Materials, only the commands of the
+    // entities referencing them need to be rebuilt
+    const BackendNodeDirtySet fullRebuildDirtyBits = AbstractRenderer::ShadersDirty
+            | AbstractRenderer::MaterialDirty
+            | AbstractRenderer::FrameGraphDirty
+            | AbstractRenderer::GeometryDirty
+            | AbstractRenderer::ComputeDirty;
+    const bool renderCommandsNeedFullRebuild = globalDirtyBitsForFrame & fullRebuildDirtyBits;
+
     if (renderableDirty)
         renderBinJobs.push_back(m_renderableEntityFilterJob);
 
@@ -1893,6 +2082,43 @@ QVector<Qt3DCore::QAspectJobPtr> Renderer::renderBinJobs()
 
     QMutexLocker lock(m_renderQueue->mutex());
     if (m_renderQueue->wasReset()) { // Have we rendered yet? (Scene3D case)
+        // Hand over the nodes which partially invalidate the RenderCommands
+        // to the RenderViewBuilders of this frame
+        {
+            RendererCache::DirtyEntityData dirtyEntities = std::move(m_dirtyBits.entityScopedNodes);
+            QVector<Qt3DCore::QNodeId> materialScopedNodes = std::move(m_dirtyBits.materialScopedNodes);
+            m_dirtyBits.entityScopedNodes = {};
+            m_dirtyBits.entityScoped = {};
+            m_dirtyBits.materialScopedNodes = {};
+            m_dirtyBits.materialScoped = {};
+
+            QVector<Qt3DCore::QNodeId> dirtyMaterialIds;
+            if (!materialCacheNeedsFullRebuild) {
+                std::sort(materialScopedNodes.begin(), materialScopedNodes.end());
+                dirtyMaterialIds = dirtyEntities.materialIds;
+                appendMaterialsReferencingNodes(m_nodesManager, materialScopedNodes, dirtyMaterialIds);
+                std::sort(dirtyMaterialIds.begin(), dirtyMaterialIds.end());
+                dirtyMaterialIds.erase(std::unique(dirtyMaterialIds.begin(), dirtyMaterialIds.end()),
+                                       dirtyMaterialIds.end());
+                // Entities using these Materials need new RenderCommands
+                dirtyEntities.materialIds = dirtyMaterialIds;
+            }
+
+            if (renderCommandsNeedFullRebuild) {
+                dirtyEntities.clear();
+            } else {
+                for (QVector<Qt3DCore::QNodeId> *ids : { &dirtyEntities.entityIds,
+                                                         &dirtyEntities.geometryRendererIds,
+                                                         &dirtyEntities.materialIds }) {
+                    std::sort(ids->begin(), ids->end());
+                    ids->erase(std::unique(ids->begin(), ids->end()), ids->end());
+                }
+            }
+            QMutexLocker cacheLock(m_cache.mutex());
+            m_cache.dirtyEntities = std::move(dirtyEntities);
+            m_cache.dirtyMaterialIds = std::move(dirtyMaterialIds);
+        }
+
         // Traverse the current framegraph. For each leaf node create a
         // RenderView and set its configuration then create a job to
         // populate the RenderView with a set of RenderCommands that get
@@ -1943,7 +2169,9 @@ QVector<Qt3DCore::QAspectJobPtr> Renderer::renderBinJobs()
             const bool isNewRV = !m_cache.leafNodeCache.contains(leaf);
             builder.setLayerCacheNeedsToBeRebuilt(layersCacheNeedsToBeRebuilt || isNewRV);
             builder.setMaterialGathererCacheNeedsToBeRebuilt(materialCacheNeedsToBeRebuilt || isNewRV);
+            builder.setMaterialGathererCacheNeedsPartialRebuild(materialCacheNeedsToBeRebuilt && !materialCacheNeedsFullRebuild && !isNewRV);
             builder.setRenderCommandCacheNeedsToBeRebuilt(renderCommandsDirty || isNewRV);
+            builder.setRenderCommandCacheNeedsPartialRebuild(renderCommandsDirty && !renderCommandsNeedFullRebuild && !isNewRV);
 
             builder.prepareJobs();
             renderBinJobs.append(builder.buildJobHierachy());
@@ -1959,7 +2187,7 @@ QVector<Qt3DCore::QAspectJobPtr> Renderer::renderBinJobs()
         notCleared |= AbstractRenderer::FrameGraphDirty;
     }
 
-    if (isRunning() && m_submissionContext->isInitialized()) {
+    if (isRunning() && isGraphicsContextInitialized()) {
         if (dirtyBitsForFrame & AbstractRenderer::TechniquesDirty )
             renderBinJobs.push_back(m_filterCompatibleTechniqueJob);
         if (dirtyBitsForFrame & AbstractRenderer::ShadersDirty)
@@ -2332,6 +2560,16 @@ SubmissionContext *Renderer::submissionContext() const
     return m_submissionContext.data();
 }
 
+bool Renderer::isGraphicsContextInitialized() const
+{
+    return m_submissionContext && m_submissionContext->isInitialized();
+}
+
+int Renderer::maxTextureUnitsCount() const
+{
+    return m_submissionContext->maxTextureUnitsCount();
+}
+
 } // namespace OpenGL
 } // namespace Render
 } // namespace Qt3DRender
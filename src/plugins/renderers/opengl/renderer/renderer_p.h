@@ -273,6 +273,11 @@ public:
     const GraphicsApiFilterData *contextInfo() const override;
     SubmissionContext *submissionContext() const;
 
+    // Overridden by renderers that run the CPU side of the pipeline without
+    // an OpenGL context (see the null renderer plugin)
+    virtual bool isGraphicsContextInitialized() const;
+    virtual int maxTextureUnitsCount() const;
+
     inline RenderStateSet *defaultRenderState() const { return m_defaultRenderStateSet; }
 
     void enqueueRenderView(RenderView *renderView, int submitOrder);
@@ -303,7 +308,7 @@ public:
 public:
 #else
 
-private:
+protected:
 #endif
     bool canRender() const;
     Profiling::FrameProfiler *activeProfiler() const;
@@ -342,8 +347,13 @@ private:
     struct DirtyBits {
         BackendNodeDirtySet marked; // marked dirty since last job build
         BackendNodeDirtySet remaining; // remaining dirty after jobs have finished
+        BackendNodeDirtySet entityScoped; // marked by Entities, GeometryRenderers or Materials only
+        RendererCache::DirtyEntityData entityScopedNodes; // nodes which marked entityScoped
+        BackendNodeDirtySet materialScoped; // marked by Parameters, Effects, Techniques or RenderPasses only
+        QVector<Qt3DCore::QNodeId> materialScopedNodes; // nodes which marked materialScoped
     };
     DirtyBits m_dirtyBits;
+    QMutex m_markDirtyMutex; // Backend nodes can be synced concurrently
 
     QAtomicInt m_lastFrameCorrect;
     QOpenGLContext *m_glContext;
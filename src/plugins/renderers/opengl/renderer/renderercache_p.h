@@ -57,6 +57,7 @@
 #include <renderviewjobutils_p.h>
 #include <Qt3DRender/private/lightsource_p.h>
 #include <rendercommand_p.h>
+#include <algorithm>
 
 QT_BEGIN_NAMESPACE
 
@@ -68,6 +69,39 @@ namespace OpenGL {
 
 struct RendererCache
 {
+    // Node ids of the Entities, GeometryRenderers and Materials which changed
+    // since the RenderCommands were last built, when none of the changes
+    // requires all RenderCommands to be rebuilt. Each vector is kept sorted.
+    struct DirtyEntityData
+    {
+        QVector<Qt3DCore::QNodeId> entityIds;
+        QVector<Qt3DCore::QNodeId> geometryRendererIds;
+        QVector<Qt3DCore::QNodeId> materialIds;
+
+        bool isEmpty() const
+        {
+            return entityIds.isEmpty() && geometryRendererIds.isEmpty() && materialIds.isEmpty();
+        }
+
+        void clear()
+        {
+            entityIds.clear();
+            geometryRendererIds.clear();
+            materialIds.clear();
+        }
+
+        // Returns true if the RenderCommands of entity have to be rebuilt
+        bool contains(const Entity *entity) const
+        {
+            const auto containsId = [] (const QVector<Qt3DCore::QNodeId> &ids, Qt3DCore::QNodeId id) {
+                return !id.isNull() && std::binary_search(ids.cbegin(), ids.cend(), id);
+            };
+            return containsId(entityIds, entity->peerId())
+                    || containsId(geometryRendererIds, entity->componentUuid<GeometryRenderer>())
+                    || containsId(materialIds, entity->componentUuid<Material>());
+        }
+    };
+
     struct LeafNodeData
     {
         QVector<Entity *> filterEntitiesByLayer;
@@ -80,6 +114,10 @@ struct RendererCache
     QVector<Entity *> computeEntities;
     QVector<LightSource> gatheredLights;
     EnvironmentLight* environmentLight;
+    DirtyEntityData dirtyEntities;
+    // Materials whose gathered parameters are outdated, sorted. Only
+    // meaningful when the material parameter cache is partially rebuilt.
+    QVector<Qt3DCore::QNodeId> dirtyMaterialIds;
 
     // Per RV cache
     QHash<FrameGraphNode *, LeafNodeData> leafNodeCache;
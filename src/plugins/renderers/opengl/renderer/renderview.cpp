@@ -76,6 +76,8 @@
 #include <QtGui/qsurface.h>
 #include <algorithm>
 #include <atomic>
+#include <cstring>
+#include <limits>
 #include <gllights_p.h>
 #include <QDebug>
 #if defined(QT3D_RENDER_VIEW_JOB_TIMINGS)
@@ -259,250 +261,237 @@ RenderView::~RenderView()
 
 namespace {
 
-template<int SortType>
-struct AdjacentSubRangeFinder
+// RenderCommands are sorted through a 64 bit key computed once per command.
+// Each sort policy, in order of priority, contributes a bit field to the key,
+// most significant first. The keys are radix sorted along with the index of
+// their command so that RenderCommands themselves are only moved once, into
+// their final position.
+struct SortKey
 {
-    static bool adjacentSubRange(const RenderCommand &, const RenderCommand &)
-    {
-        Q_UNREACHABLE();
-        return false;
-    }
+    quint64 key;
+    int index;
 };
 
-template<>
-struct AdjacentSubRangeFinder<QSortPolicy::StateChangeCost>
-{
-    static bool adjacentSubRange(const RenderCommand &a, const RenderCommand &b)
-    {
-        return a.m_changeCost == b.m_changeCost;
-    }
-};
+const int MaxSortKeyBits = 64;
+const int MaxDepthKeyBits = 32;
+const int RadixBits = 8;
+const int RadixBucketCount = 1 << RadixBits;
+const int RadixPassCount = MaxSortKeyBits / RadixBits;
+// Below that, building the radix histograms costs more than comparing keys
+const int RadixSortThreshold = 64;
 
-template<>
-struct AdjacentSubRangeFinder<QSortPolicy::BackToFront>
+struct SortKeyField
 {
-    static bool adjacentSubRange(const RenderCommand &a, const RenderCommand &b)
-    {
-        return qFuzzyCompare(a.m_depth, b.m_depth);
-    }
+    std::vector<quint64> values;
+    int bits = 0;
 };
 
-template<>
-struct AdjacentSubRangeFinder<QSortPolicy::Material>
+int bitsForCount(size_t count)
 {
-    static bool adjacentSubRange(const RenderCommand &a, const RenderCommand &b)
-    {
-        return a.m_glShader == b.m_glShader;
-    }
-};
+    int bits = 0;
+    while (bits < MaxSortKeyBits && (quint64(1) << bits) < count)
+        ++bits;
+    return bits;
+}
 
-template<>
-struct AdjacentSubRangeFinder<QSortPolicy::FrontToBack>
+// Replaces each value by its rank amongst the distinct values, ordered by
+// lessThan. Equivalent values therefore end up with the same field value.
+template<typename T, typename LessThan>
+void rankValues(const std::vector<T> &values, LessThan lessThan, SortKeyField &field)
 {
-    static bool adjacentSubRange(const RenderCommand &a, const RenderCommand &b)
-    {
-        return qFuzzyCompare(a.m_depth, b.m_depth);
-    }
-};
+    std::vector<T> distinct(values);
+    std::sort(distinct.begin(), distinct.end(), lessThan);
+    distinct.erase(std::unique(distinct.begin(), distinct.end(),
+                               [lessThan] (const T &a, const T &b) { return !lessThan(a, b); }),
+                   distinct.end());
+
+    field.values.resize(values.size());
+    for (size_t i = 0, m = values.size(); i < m; ++i)
+        field.values[i] = std::lower_bound(distinct.begin(), distinct.end(), values[i], lessThan) - distinct.begin();
+    field.bits = bitsForCount(distinct.size());
+}
 
-template<>
-struct AdjacentSubRangeFinder<QSortPolicy::Texture>
+void buildChangeCostField(const QVector<RenderCommand> &commands, SortKeyField &field)
 {
-    static bool adjacentSubRange(const RenderCommand &a, const RenderCommand &b)
-    {
-        // Two renderCommands are adjacent if one contains all the other command's textures
-        QVector<ShaderParameterPack::NamedResource> texturesA = a.m_parameterPack.textures();
-        QVector<ShaderParameterPack::NamedResource> texturesB = b.m_parameterPack.textures();
-
-        if (texturesB.size() > texturesA.size())
-            qSwap(texturesA, texturesB);
-
-        // textureB.size() is always <= textureA.size()
-        for (const ShaderParameterPack::NamedResource &texB : qAsConst(texturesB)) {
-            if (!texturesA.contains(texB))
-                return false;
-        }
-        return true;
-    }
-};
+    std::vector<int> costs;
+    costs.reserve(commands.size());
+    for (const RenderCommand &command : commands)
+        costs.push_back(command.m_changeCost);
+    // Higher costs first
+    rankValues(costs, std::greater<int>(), field);
+}
 
-template<typename Predicate>
-int advanceUntilNonAdjacent(const QVector<RenderCommand> &commands,
-                            const int beg, const int end, Predicate pred)
+void buildMaterialField(const QVector<RenderCommand> &commands, SortKeyField &field)
 {
-    int i = beg + 1;
-    while (i < end) {
-        if (!pred(*(commands.begin() + beg), *(commands.begin() + i)))
-            break;
-        ++i;
-    }
-    return i;
+    // Groups all same shader DNA together, then all same material together
+    // (same parameters most likely)
+    using ShaderMaterial = std::pair<GLShader *, quintptr>;
+    std::vector<ShaderMaterial> materials;
+    materials.reserve(commands.size());
+    for (const RenderCommand &command : commands)
+        materials.push_back({ command.m_glShader, command.m_material.handle() });
+    rankValues(materials, [] (const ShaderMaterial &a, const ShaderMaterial &b) {
+        if (a.first != b.first)
+            return std::greater<GLShader *>()(a.first, b.first);
+        return a.second < b.second;
+    }, field);
 }
 
-
-using CommandIt = QVector<RenderCommand>::iterator;
-
-template<int SortType>
-struct SubRangeSorter
+void buildTextureField(const QVector<RenderCommand> &commands, SortKeyField &field)
 {
-    static void sortSubRange(CommandIt begin, const CommandIt end)
-    {
-        Q_UNUSED(begin)
-        Q_UNUSED(end)
-        Q_UNREACHABLE();
+    // Commands using the most textures first, then commands using the same
+    // set of textures together. The hash is commutative so that the order in
+    // which textures were set on the pack doesn't matter.
+    using TextureSet = std::pair<int, uint>;
+    std::vector<TextureSet> textureSets;
+    textureSets.reserve(commands.size());
+    for (const RenderCommand &command : commands) {
+        const QVector<ShaderParameterPack::NamedResource> &textures = command.m_parameterPack.textures();
+        uint hash = 0;
+        for (const ShaderParameterPack::NamedResource &texture : textures)
+            hash += qHash(texture.nodeId, uint(texture.glslNameId)) ^ uint(texture.uniformArrayIndex) ^ (uint(texture.type) << 31);
+        textureSets.push_back({ textures.size(), hash });
     }
-};
+    rankValues(textureSets, [] (const TextureSet &a, const TextureSet &b) {
+        if (a.first != b.first)
+            return a.first > b.first;
+        return a.second < b.second;
+    }, field);
+}
 
-template<>
-struct SubRangeSorter<QSortPolicy::StateChangeCost>
+// Maps a float onto an unsigned integer with the same ordering
+inline quint32 orderedFloatBits(float f)
 {
-    static void sortSubRange(CommandIt begin, const CommandIt end)
-    {
-        std::stable_sort(begin, end, [] (const RenderCommand &a, const RenderCommand &b) {
-            return a.m_changeCost > b.m_changeCost;
-        });
-    }
-};
+    quint32 bits;
+    memcpy(&bits, &f, sizeof(bits));
+    return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+}
 
-template<>
-struct SubRangeSorter<QSortPolicy::BackToFront>
+void buildDepthField(const QVector<RenderCommand> &commands, bool backToFront, int bits, SortKeyField &field)
 {
-    static void sortSubRange(CommandIt begin, const CommandIt end)
-    {
-        std::stable_sort(begin, end, [] (const RenderCommand &a, const RenderCommand &b) {
-            return a.m_depth > b.m_depth;
-        });
+    field.bits = bits;
+    field.values.resize(commands.size());
+    quint64 *values = field.values.data();
+
+    if (bits == MaxDepthKeyBits) {
+        // Depths fit exactly in the key
+        for (int i = 0, m = commands.size(); i < m; ++i) {
+            const quint32 depth = orderedFloatBits(commands.at(i).m_depth);
+            values[i] = backToFront ? ~depth : depth;
+        }
+        return;
     }
-};
 
-template<>
-struct SubRangeSorter<QSortPolicy::Material>
-{
-    static void sortSubRange(CommandIt begin, const CommandIt end)
-    {
-        // First we sort by shader
-        std::stable_sort(begin, end, [] (const RenderCommand &a, const RenderCommand &b) {
-            return a.m_glShader > b.m_glShader;
-        });
+    // Quantize depths linearly over the range covered by this RenderView
+    float minDepth = std::numeric_limits<float>::max();
+    float maxDepth = std::numeric_limits<float>::lowest();
+    for (const RenderCommand &command : commands) {
+        minDepth = std::min(minDepth, command.m_depth);
+        maxDepth = std::max(maxDepth, command.m_depth);
     }
-};
-
-template<>
-struct SubRangeSorter<QSortPolicy::FrontToBack>
-{
-    static void sortSubRange(CommandIt begin, const CommandIt end)
-    {
-        std::stable_sort(begin, end, [] (const RenderCommand &a, const RenderCommand &b) {
-            return a.m_depth < b.m_depth;
-        });
+    const quint64 maxValue = (quint64(1) << bits) - 1;
+    const float scale = maxDepth > minDepth ? float(maxValue) / (maxDepth - minDepth) : 0.0f;
+    for (int i = 0, m = commands.size(); i < m; ++i) {
+        const quint64 depth = std::min(quint64((commands.at(i).m_depth - minDepth) * scale), maxValue);
+        values[i] = backToFront ? maxValue - depth : depth;
     }
-};
+}
 
-template<>
-struct SubRangeSorter<QSortPolicy::Texture>
+// Stable LSD radix sort. Passes over digits all keys have in common are
+// skipped, so only the bits actually used by the key cost anything.
+void radixSort(std::vector<SortKey> &keys, std::vector<SortKey> &scratch)
 {
-    static void sortSubRange(CommandIt begin, const CommandIt end)
-    {
-#ifndef Q_OS_WIN
-        std::stable_sort(begin, end, [] (const RenderCommand &a, const RenderCommand &b) {
-            QVector<ShaderParameterPack::NamedResource> texturesA = a.m_parameterPack.textures();
-            QVector<ShaderParameterPack::NamedResource> texturesB = b.m_parameterPack.textures();
-
-            const int originalTextureASize = texturesA.size();
-
-            if (texturesB.size() > texturesA.size())
-                qSwap(texturesA, texturesB);
-
-            int identicalTextureCount = 0;
-
-            for (const ShaderParameterPack::NamedResource &texB : qAsConst(texturesB)) {
-                if (texturesA.contains(texB))
-                    ++identicalTextureCount;
-            }
-
-            return identicalTextureCount < originalTextureASize;
-        });
-#endif
+    const size_t keyCount = keys.size();
+    std::vector<size_t> histograms(RadixPassCount * RadixBucketCount, 0);
+    for (const SortKey &k : keys) {
+        for (int pass = 0; pass < RadixPassCount; ++pass)
+            ++histograms[pass * RadixBucketCount + ((k.key >> (pass * RadixBits)) & (RadixBucketCount - 1))];
     }
-};
 
-int findSubRange(const QVector<RenderCommand> &commands,
-                 const int begin, const int end,
-                 const QSortPolicy::SortType sortType)
-{
-    switch (sortType) {
-    case QSortPolicy::StateChangeCost:
-        return advanceUntilNonAdjacent(commands, begin, end, AdjacentSubRangeFinder<QSortPolicy::StateChangeCost>::adjacentSubRange);
-    case QSortPolicy::BackToFront:
-        return advanceUntilNonAdjacent(commands, begin, end, AdjacentSubRangeFinder<QSortPolicy::BackToFront>::adjacentSubRange);
-    case QSortPolicy::Material:
-        return advanceUntilNonAdjacent(commands, begin, end, AdjacentSubRangeFinder<QSortPolicy::Material>::adjacentSubRange);
-    case QSortPolicy::FrontToBack:
-        return advanceUntilNonAdjacent(commands, begin, end, AdjacentSubRangeFinder<QSortPolicy::FrontToBack>::adjacentSubRange);
-    case QSortPolicy::Texture:
-        return advanceUntilNonAdjacent(commands, begin, end, AdjacentSubRangeFinder<QSortPolicy::Texture>::adjacentSubRange);
-    case QSortPolicy::Uniform:
-        return end;
-    default:
-        Q_UNREACHABLE();
-        return end;
+    scratch.resize(keyCount);
+    for (int pass = 0; pass < RadixPassCount; ++pass) {
+        size_t *offsets = histograms.data() + pass * RadixBucketCount;
+        const int shift = pass * RadixBits;
+        if (offsets[(keys.front().key >> shift) & (RadixBucketCount - 1)] == keyCount)
+            continue;
+
+        size_t offset = 0;
+        for (int bucket = 0; bucket < RadixBucketCount; ++bucket) {
+            const size_t count = offsets[bucket];
+            offsets[bucket] = offset;
+            offset += count;
+        }
+        for (const SortKey &k : keys)
+            scratch[offsets[(k.key >> shift) & (RadixBucketCount - 1)]++] = k;
+        keys.swap(scratch);
     }
 }
 
-void sortByMaterial(QVector<RenderCommand> &commands, int begin, const int end)
+// Returns false if none of the sorting types affects the order of commands
+bool buildSortKeys(const QVector<RenderCommand> &commands,
+                   const QVector<QSortPolicy::SortType> &sortingTypes,
+                   std::vector<SortKey> &keys)
 {
-    // We try to arrange elements so that their rendering cost is minimized for a given shader
-    int rangeEnd = advanceUntilNonAdjacent(commands, begin, end, AdjacentSubRangeFinder<QSortPolicy::Material>::adjacentSubRange);
-    while (begin != end) {
-        if (begin + 1 < rangeEnd) {
-            std::stable_sort(commands.begin() + begin + 1, commands.begin() + rangeEnd, [] (const RenderCommand &a, const RenderCommand &b){
-                return a.m_material.handle() < b.m_material.handle();
-            });
+    std::vector<SortKeyField> fields(sortingTypes.size());
+    int usedTypes = 0;
+    int depthLevel = -1;
+    int fieldBits = 0;
+
+    for (int level = 0, m = sortingTypes.size(); level < m; ++level) {
+        const QSortPolicy::SortType sortType = sortingTypes.at(level);
+        // Sorting twice by the same criteria doesn't change anything
+        const bool sortsByDepth = sortType == QSortPolicy::BackToFront || sortType == QSortPolicy::FrontToBack;
+        if ((usedTypes & sortType) || (sortsByDepth && depthLevel != -1))
+            continue;
+        usedTypes |= sortType;
+
+        switch (sortType) {
+        case QSortPolicy::StateChangeCost:
+            buildChangeCostField(commands, fields[level]);
+            break;
+        case QSortPolicy::Material:
+            buildMaterialField(commands, fields[level]);
+            break;
+        case QSortPolicy::Texture:
+            buildTextureField(commands, fields[level]);
+            break;
+        case QSortPolicy::BackToFront:
+        case QSortPolicy::FrontToBack:
+            // Built once we know how many bits are left
+            depthLevel = level;
+            break;
+        case QSortPolicy::Uniform:
+            // Handled after sorting
+            break;
+        default:
+            Q_UNREACHABLE();
         }
-        begin = rangeEnd;
-        rangeEnd = advanceUntilNonAdjacent(commands, begin, end, AdjacentSubRangeFinder<QSortPolicy::Material>::adjacentSubRange);
+        fieldBits += fields[level].bits;
     }
-}
-
-void sortCommandRange(QVector<RenderCommand> &commands, int begin, const int end, const int level,
-                      const QVector<Qt3DRender::QSortPolicy::SortType> &sortingTypes)
-{
-    if (level >= sortingTypes.size())
-        return;
 
-    switch (sortingTypes.at(level)) {
-    case QSortPolicy::StateChangeCost:
-        SubRangeSorter<QSortPolicy::StateChangeCost>::sortSubRange(commands.begin() + begin, commands.begin() + end);
-        break;
-    case QSortPolicy::BackToFront:
-        SubRangeSorter<QSortPolicy::BackToFront>::sortSubRange(commands.begin() + begin, commands.begin() + end);
-        break;
-    case QSortPolicy::Material:
-        // Groups all same shader DNA together
-        SubRangeSorter<QSortPolicy::Material>::sortSubRange(commands.begin() + begin, commands.begin() + end);
-        // Group all same material together (same parameters most likely)
-        sortByMaterial(commands, begin, end);
-        break;
-    case QSortPolicy::FrontToBack:
-        SubRangeSorter<QSortPolicy::FrontToBack>::sortSubRange(commands.begin() + begin, commands.begin() + end);
-        break;
-    case QSortPolicy::Texture:
-        SubRangeSorter<QSortPolicy::Texture>::sortSubRange(commands.begin() + begin, commands.begin() + end);
-        break;
-    case QSortPolicy::Uniform:
-        break;
-    default:
-        Q_UNREACHABLE();
+    if (depthLevel != -1) {
+        const int depthBits = qBound(0, MaxSortKeyBits - fieldBits, MaxDepthKeyBits);
+        buildDepthField(commands, sortingTypes.at(depthLevel) == QSortPolicy::BackToFront,
+                        depthBits, fields[depthLevel]);
     }
 
-    // For all sub ranges of adjacent item for sortType[i]
-    // Perform filtering with sortType[i + 1]
-    int rangeEnd = findSubRange(commands, begin, end, sortingTypes.at(level));
-    while (begin != end) {
-        sortCommandRange(commands, begin, rangeEnd, level + 1, sortingTypes);
-        begin = rangeEnd;
-        rangeEnd = findSubRange(commands, begin, end, sortingTypes.at(level));
+    keys.resize(commands.size());
+    for (int i = 0, m = commands.size(); i < m; ++i)
+        keys[i] = { 0, i };
+
+    // Pack the fields by decreasing priority. If they don't all fit, the
+    // lowest priority ones lose their least significant bits.
+    int keyBits = 0;
+    for (const SortKeyField &field : fields) {
+        const int bits = std::min(field.bits, MaxSortKeyBits - keyBits);
+        if (bits == 0)
+            continue;
+        const int droppedBits = field.bits - bits;
+        for (int i = 0, m = commands.size(); i < m; ++i)
+            keys[i].key = (bits == MaxSortKeyBits ? 0 : keys[i].key << bits) | (field.values[i] >> droppedBits);
+        keyBits += bits;
     }
+    return keyBits > 0;
 }
 
 } // anonymous
@@ -511,7 +500,25 @@ void RenderView::sort()
 {
     // Compares the bitsetKey of the RenderCommands
     // Key[Depth | StateCost | Shader]
-    sortCommandRange(m_commands, 0, m_commands.size(), 0, m_data.m_sortingTypes);
+    std::vector<SortKey> keys;
+    if (m_commands.size() > 1 && buildSortKeys(m_commands, m_data.m_sortingTypes, keys)) {
+        if (keys.size() < RadixSortThreshold) {
+            std::stable_sort(keys.begin(), keys.end(), [] (const SortKey &a, const SortKey &b) {
+                return a.key < b.key;
+            });
+        } else {
+            std::vector<SortKey> scratch;
+            radixSort(keys, scratch);
+        }
+
+        // Move the commands once, following the sorted indices
+        RenderCommand *commands = m_commands.data();
+        QVector<RenderCommand> sortedCommands;
+        sortedCommands.reserve(m_commands.size());
+        for (const SortKey &k : keys)
+            sortedCommands.push_back(std::move(commands[k.index]));
+        m_commands = std::move(sortedCommands);
+    }
 
     // For RenderCommand with the same shader
     // We compute the adjacent change cost
@@ -572,6 +579,13 @@ void RenderView::setRenderer(Renderer *renderer)
     m_manager = renderer->nodeManagers();
 }
 
+void RenderView::setLightSources(const QVector<LightSource> &lightSources)
+{
+    m_lightSources = lightSources;
+    // Built once here, then queried concurrently by the command updaters
+    m_lightGrid.build(lightSources, m_manager ? m_manager->shaderDataManager() : nullptr);
+}
+
 void RenderView::addClearBuffers(const ClearBuffers *cb) {
     QClearBuffers::BufferTypeFlags type = cb->type();
 
@@ -821,7 +835,6 @@ void RenderView::updateRenderCommand(EntityRenderCommandData *renderCommandData,
         // Pick which lights to take in to account.
         // For now decide based on the distance by taking the MAX_LIGHTS closest lights.
         // Replace with more sophisticated mechanisms later.
-        // Copy vector so that we can sort it concurrently and we only want to sort the one for the current command
         QVector<LightSource> lightSources;
         EnvironmentLight *environmentLight = nullptr;
 
@@ -832,18 +845,7 @@ void RenderView::updateRenderCommand(EntityRenderCommandData *renderCommandData,
             command.m_depth = Vector3D::dotProduct(entity->worldBoundingVolume()->center() - m_data.m_eyePos, m_data.m_eyeViewDir);
 
             environmentLight = m_environmentLight;
-            lightSources = m_lightSources;
-
-            if (lightSources.size() > 1) {
-                const Vector3D entityCenter = entity->worldBoundingVolume()->center();
-                std::sort(lightSources.begin(), lightSources.end(),
-                          [&] (const LightSource &a, const LightSource &b) {
-                    const float distA = entityCenter.distanceToPoint(a.entity->worldBoundingVolume()->center());
-                    const float distB = entityCenter.distanceToPoint(b.entity->worldBoundingVolume()->center());
-                    return distA < distB;
-                });
-            }
-            lightSources = lightSources.mid(0, std::max(lightSources.size(), MAX_LIGHTS));
+            lightSources = m_lightGrid.closestLightSources(entity->worldBoundingVolume()->center(), MAX_LIGHTS);
         } else { // Compute
             // Note: if frameCount has reached 0 in the previous frame, isEnabled
             // would be false
@@ -1077,7 +1079,8 @@ void RenderView::setShaderAndUniforms(RenderCommand *command,
 
         if (shader->hasActiveVariables()) {
 
-            // Reserve amount of uniforms we are going to need
+            // Store uniforms by slot of the shader and reserve amount of uniforms we are going to need
+            command->m_parameterPack.setUniformLayout(&shader->uniformLayout());
             command->m_parameterPack.reserve(shader->parameterPackSize());
 
             const QVector<int> &standardUniformNamesIds = shader->standardUniformNameIds();
@@ -1172,14 +1175,11 @@ void RenderView::setShaderAndUniforms(RenderCommand *command,
                 // they may not be actually used, otherwise draw calls can fail
                 static const int irradianceId = StringToInt::lookupId(QLatin1String("envLight.irradiance"));
                 static const int specularId = StringToInt::lookupId(QLatin1String("envLight.specular"));
-                setUniformValue(command->m_parameterPack, irradianceId, m_renderer->submissionContext()->maxTextureUnitsCount());
-                setUniformValue(command->m_parameterPack, specularId, m_renderer->submissionContext()->maxTextureUnitsCount());
+                setUniformValue(command->m_parameterPack, irradianceId, m_renderer->maxTextureUnitsCount());
+                setUniformValue(command->m_parameterPack, specularId, m_renderer->maxTextureUnitsCount());
             }
             setUniformValue(command->m_parameterPack, StringToInt::lookupId(QStringLiteral("envLightCount")), envLightCount);
         }
-
-        // Prepare the ShaderParameterPack based on the active uniforms of the shader
-        shader->prepareUniforms(command->m_parameterPack);
     }
 }
 
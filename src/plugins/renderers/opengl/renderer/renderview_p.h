@@ -61,6 +61,7 @@
 #include <Qt3DRender/private/handle_types_p.h>
 #include <Qt3DRender/private/qsortpolicy_p.h>
 #include <Qt3DRender/private/lightsource_p.h>
+#include <Qt3DRender/private/lightgrid_p.h>
 #include <Qt3DRender/private/qmemorybarrier_p.h>
 #include <Qt3DRender/private/qrendercapture_p.h>
 #include <Qt3DRender/private/qblitframebuffer_p.h>
@@ -229,6 +230,7 @@ public:
 
 
     void setCommands(const QVector<RenderCommand> &commands) Q_DECL_NOTHROW { m_commands = commands; }
+    void setCommands(QVector<RenderCommand> &&commands) Q_DECL_NOTHROW { m_commands = std::move(commands); }
     QVector<RenderCommand> &commands() { return m_commands; }
     QVector<RenderCommand> commands() const { return m_commands; }
 
@@ -243,7 +245,7 @@ public:
     void setSurface(QSurface *surface) { m_surface = surface; }
     QSurface *surface() const { return m_surface; }
 
-    void setLightSources(const QVector<LightSource> &lightSources) Q_DECL_NOTHROW { m_lightSources = lightSources; }
+    void setLightSources(const QVector<LightSource> &lightSources);
     void setEnvironmentLight(EnvironmentLight *environmentLight) Q_DECL_NOTHROW { m_environmentLight = environmentLight; }
 
     void updateMatrices();
@@ -335,6 +337,7 @@ private:
 
     QVector<RenderCommand> m_commands;
     mutable QVector<LightSource> m_lightSources;
+    LightGrid m_lightGrid;
     EnvironmentLight *m_environmentLight;
 
     MaterialParameterGathererData m_parameters;
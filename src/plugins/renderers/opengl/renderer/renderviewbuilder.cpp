@@ -65,11 +65,13 @@ public:
     explicit SyncPreCommandBuilding(RenderViewInitializerJobPtr renderViewInitializerJob,
                                     const QVector<RenderViewCommandBuilderJobPtr> &renderViewCommandBuilderJobs,
                                     Renderer *renderer,
-                                    FrameGraphNode *leafNode)
+                                    FrameGraphNode *leafNode,
+                                    bool partialCommandRebuild)
         : m_renderViewInitializer(renderViewInitializerJob)
         , m_renderViewCommandBuilderJobs(renderViewCommandBuilderJobs)
         , m_renderer(renderer)
         , m_leafNode(leafNode)
+        , m_partialRebuild(partialCommandRebuild)
     {
     }
 
@@ -81,12 +83,24 @@ public:
         RendererCache *cache = m_renderer->cache();
         const RendererCache::LeafNodeData &dataCacheForLeaf = cache->leafNodeCache[m_leafNode];
         RenderView *rv = m_renderViewInitializer->renderView();
-        const auto entities = !rv->isCompute() ? cache->renderableEntities : cache->computeEntities;
+        QVector<Entity *> entities = !rv->isCompute() ? cache->renderableEntities : cache->computeEntities;
+        const RendererCache::DirtyEntityData dirtyEntities = cache->dirtyEntities;
 
         rv->setMaterialParameterTable(dataCacheForLeaf.materialParameterGatherer);
 
         lock.unlock();
 
+        // Only rebuild the RenderCommands of the entities affected by the
+        // changes, SyncRenderViewPreCommandUpdate splices them into the cache
+        if (m_partialRebuild) {
+            QVector<Entity *> dirtySubset;
+            for (Entity *entity : qAsConst(entities)) {
+                if (dirtyEntities.contains(entity))
+                    dirtySubset.push_back(entity);
+            }
+            entities = std::move(dirtySubset);
+        }
+
         // Split among the ideal number of command builders
         const int jobCount = m_renderViewCommandBuilderJobs.size();
         const int idealPacketSize = std::min(std::max(10, entities.size() / jobCount), entities.size());
@@ -105,6 +119,7 @@ private:
     QVector<RenderViewCommandBuilderJobPtr> m_renderViewCommandBuilderJobs;
     Renderer *m_renderer;
     FrameGraphNode *m_leafNode;
+    bool m_partialRebuild;
 };
 
 class SyncRenderViewPostCommandUpdate
@@ -126,8 +141,8 @@ public:
         const EntityRenderCommandDataPtr commandData = m_renderViewCommandUpdaterJobs.first()->renderables();
 
         if (commandData) {
-            const QVector<RenderCommand> commands = std::move(commandData->commands);
-            rv->setCommands(commands);
+            // Moved rather than shared so that sorting doesn't detach a copy
+            rv->setCommands(std::move(commandData->commands));
 
             // TO DO: Find way to store commands once or at least only when required
             // Sort the commands
@@ -236,7 +251,8 @@ public:
                                             const QVector<RenderViewCommandBuilderJobPtr> &renderViewCommandBuilderJobs,
                                             Renderer *renderer,
                                             FrameGraphNode *leafNode,
-                                            bool fullCommandRebuild)
+                                            bool commandRebuild,
+                                            bool partialCommandRebuild)
         : m_renderViewJob(renderViewJob)
         , m_frustumCullingJob(frustumCullingJob)
         , m_filterProximityJob(filterProximityJob)
@@ -245,7 +261,8 @@ public:
         , m_renderViewCommandBuilderJobs(renderViewCommandBuilderJobs)
         , m_renderer(renderer)
         , m_leafNode(leafNode)
-        , m_fullRebuild(fullCommandRebuild)
+        , m_rebuild(commandRebuild)
+        , m_partialRebuild(partialCommandRebuild)
     {}
 
     void operator()()
@@ -267,7 +284,7 @@ public:
             // Rebuild RenderCommands if required
             // This should happen fairly infrequently (FrameGraph Change, Geometry/Material change)
             // and allow to skip that step most of the time
-            if (m_fullRebuild) {
+            if (m_rebuild) {
                 EntityRenderCommandData commandData;
                 // Reduction
                 {
@@ -282,7 +299,14 @@ public:
 
                 // Store new cache
                 RendererCache::LeafNodeData &writableCacheForLeaf = cache->leafNodeCache[m_leafNode];
-                writableCacheForLeaf.renderCommandData = std::move(commandData);
+                if (m_partialRebuild) {
+                    // Only the commands of the dirty entities were rebuilt
+                    RenderViewBuilder::spliceRenderCommandData(writableCacheForLeaf.renderCommandData,
+                                                               m_renderViewCommandBuilderJobs.first()->entities(),
+                                                               std::move(commandData));
+                } else {
+                    writableCacheForLeaf.renderCommandData = std::move(commandData);
+                }
             }
             const EntityRenderCommandData commandData = dataCacheForLeaf.renderCommandData;
             const QVector<Entity *> filteredEntities = dataCacheForLeaf.filterEntitiesByLayer;
@@ -369,7 +393,8 @@ private:
     QVector<RenderViewCommandBuilderJobPtr> m_renderViewCommandBuilderJobs;
     Renderer *m_renderer;
     FrameGraphNode *m_leafNode;
-    bool m_fullRebuild;
+    bool m_rebuild;
+    bool m_partialRebuild;
 };
 
 class SetClearDrawBufferIndex
@@ -425,10 +450,14 @@ class SyncMaterialParameterGatherer
 public:
     explicit SyncMaterialParameterGatherer(const QVector<MaterialParameterGathererJobPtr> &materialParameterGathererJobs,
                                            Renderer *renderer,
-                                           FrameGraphNode *leafNode)
+                                           FrameGraphNode *leafNode,
+                                           bool partialRebuild,
+                                           const QVector<Qt3DCore::QNodeId> &rebuiltMaterialIds)
         : m_materialParameterGathererJobs(materialParameterGathererJobs)
         , m_renderer(renderer)
         , m_leafNode(leafNode)
+        , m_partialRebuild(partialRebuild)
+        , m_rebuiltMaterialIds(rebuiltMaterialIds)
     {
     }
 
@@ -436,7 +465,14 @@ public:
     {
         QMutexLocker lock(m_renderer->cache()->mutex());
         RendererCache::LeafNodeData &dataCacheForLeaf = m_renderer->cache()->leafNodeCache[m_leafNode];
-        dataCacheForLeaf.materialParameterGatherer.clear();
+        if (m_partialRebuild) {
+            // Patch the table in place: regathered Materials may no longer
+            // yield any pass (disabled, no compatible technique...)
+            for (const Qt3DCore::QNodeId &materialId : qAsConst(m_rebuiltMaterialIds))
+                dataCacheForLeaf.materialParameterGatherer.remove(materialId);
+        } else {
+            dataCacheForLeaf.materialParameterGatherer.clear();
+        }
 
         for (const auto &materialGatherer : qAsConst(m_materialParameterGathererJobs)) {
             const MaterialParameterGathererData &source = materialGatherer->materialToPassAndParameter();
@@ -451,6 +487,8 @@ private:
     QVector<MaterialParameterGathererJobPtr> m_materialParameterGathererJobs;
     Renderer *m_renderer;
     FrameGraphNode *m_leafNode;
+    bool m_partialRebuild;
+    QVector<Qt3DCore::QNodeId> m_rebuiltMaterialIds;
 };
 
 } // anonymous
@@ -461,7 +499,9 @@ RenderViewBuilder::RenderViewBuilder(Render::FrameGraphNode *leafNode, int rende
     , m_renderer(renderer)
     , m_layerCacheNeedsToBeRebuilt(false)
     , m_materialGathererCacheNeedsToBeRebuilt(false)
+    , m_materialGathererCacheNeedsPartialRebuild(false)
     , m_renderCommandCacheNeedsToBeRebuilt(false)
+    , m_renderCommandCacheNeedsPartialRebuild(false)
     , m_renderViewJob(RenderViewInitializerJobPtr::create())
     , m_filterEntityByLayerJob()
     , m_frustumCullingJob(new Render::FrustumCullingJob())
@@ -556,6 +596,7 @@ void RenderViewBuilder::prepareJobs()
     // Init what we can here
     m_filterProximityJob->setManager(m_renderer->nodeManagers());
     m_frustumCullingJob->setRoot(m_renderer->sceneRoot());
+    m_frustumCullingJob->setManagers(m_renderer->nodeManagers());
 
     if (m_renderCommandCacheNeedsToBeRebuilt) {
         m_renderViewCommandBuilderJobs.reserve(m_optimalParallelJobCount);
@@ -566,7 +607,8 @@ void RenderViewBuilder::prepareJobs()
         m_syncRenderViewPreCommandBuildingJob = CreateSynchronizerJobPtr(SyncPreCommandBuilding(m_renderViewJob,
                                                                                                 m_renderViewCommandBuilderJobs,
                                                                                                 m_renderer,
-                                                                                                m_leafNode),
+                                                                                                m_leafNode,
+                                                                                                m_renderCommandCacheNeedsPartialRebuild),
                                                                          JobTypes::SyncRenderViewPreCommandBuilding);
     }
 
@@ -584,8 +626,26 @@ void RenderViewBuilder::prepareJobs()
     }
 
     if (m_materialGathererCacheNeedsToBeRebuilt) {
+        // Only gather the Materials affected by the changes when possible
+        MaterialManager *materialManager = m_renderer->nodeManagers()->materialManager();
+        QVector<Qt3DCore::QNodeId> rebuiltMaterialIds;
+        QVector<HMaterial> materialHandles;
+        if (m_materialGathererCacheNeedsPartialRebuild) {
+            {
+                QMutexLocker lock(m_renderer->cache()->mutex());
+                rebuiltMaterialIds = m_renderer->cache()->dirtyMaterialIds;
+            }
+            materialHandles.reserve(rebuiltMaterialIds.size());
+            for (const Qt3DCore::QNodeId &materialId : qAsConst(rebuiltMaterialIds)) {
+                const HMaterial handle = materialManager->lookupHandle(materialId);
+                if (!handle.isNull())
+                    materialHandles.push_back(handle);
+            }
+        } else {
+            materialHandles = materialManager->activeHandles();
+        }
+
         // Since Material gathering is an heavy task, we split it
-        const QVector<HMaterial> materialHandles = m_renderer->nodeManagers()->materialManager()->activeHandles();
         if (materialHandles.count()) {
             const int elementsPerJob =  qMax(materialHandles.size() / m_optimalParallelJobCount, 1);
             m_materialGathererJobs.reserve(m_optimalParallelJobCount);
@@ -601,7 +661,9 @@ void RenderViewBuilder::prepareJobs()
         }
         m_syncMaterialGathererJob = CreateSynchronizerJobPtr(SyncMaterialParameterGatherer(m_materialGathererJobs,
                                                                                            m_renderer,
-                                                                                           m_leafNode),
+                                                                                           m_leafNode,
+                                                                                           m_materialGathererCacheNeedsPartialRebuild,
+                                                                                           rebuiltMaterialIds),
                                                              JobTypes::SyncMaterialGatherer);
     }
 
@@ -622,7 +684,8 @@ void RenderViewBuilder::prepareJobs()
                                                                                                   m_renderViewCommandBuilderJobs,
                                                                                                   m_renderer,
                                                                                                   m_leafNode,
-                                                                                                  m_renderCommandCacheNeedsToBeRebuilt),
+                                                                                                  m_renderCommandCacheNeedsToBeRebuilt,
+                                                                                                  m_renderCommandCacheNeedsPartialRebuild),
                                                                    JobTypes::SyncRenderViewPreCommandUpdate);
 
     m_syncRenderViewPostCommandUpdateJob = CreateSynchronizerJobPtr(SyncRenderViewPostCommandUpdate(m_renderViewJob,
@@ -783,6 +846,16 @@ bool RenderViewBuilder::materialGathererCacheNeedsToBeRebuilt() const
     return m_materialGathererCacheNeedsToBeRebuilt;
 }
 
+void RenderViewBuilder::setMaterialGathererCacheNeedsPartialRebuild(bool needsPartialRebuild)
+{
+    m_materialGathererCacheNeedsPartialRebuild = needsPartialRebuild;
+}
+
+bool RenderViewBuilder::materialGathererCacheNeedsPartialRebuild() const
+{
+    return m_materialGathererCacheNeedsPartialRebuild;
+}
+
 void RenderViewBuilder::setRenderCommandCacheNeedsToBeRebuilt(bool needsToBeRebuilt)
 {
     m_renderCommandCacheNeedsToBeRebuilt = needsToBeRebuilt;
@@ -793,6 +866,16 @@ bool RenderViewBuilder::renderCommandCacheNeedsToBeRebuilt() const
     return m_renderCommandCacheNeedsToBeRebuilt;
 }
 
+void RenderViewBuilder::setRenderCommandCacheNeedsPartialRebuild(bool needsPartialRebuild)
+{
+    m_renderCommandCacheNeedsPartialRebuild = needsPartialRebuild;
+}
+
+bool RenderViewBuilder::renderCommandCacheNeedsPartialRebuild() const
+{
+    return m_renderCommandCacheNeedsPartialRebuild;
+}
+
 int RenderViewBuilder::defaultJobCount()
 {
     static int jobCount = 0;
@@ -834,6 +917,59 @@ QVector<Entity *> RenderViewBuilder::entitiesInSubset(const QVector<Entity *> &e
     return intersection;
 }
 
+// Replaces the commands of rebuiltEntities in cachedData by rebuiltData.
+// cachedData, rebuiltEntities and rebuiltData are all sorted by Entity and
+// every entity referenced by rebuiltData is part of rebuiltEntities.
+void RenderViewBuilder::spliceRenderCommandData(EntityRenderCommandData &cachedData,
+                                                const QVector<Entity *> &rebuiltEntities,
+                                                EntityRenderCommandData &&rebuiltData)
+{
+    Q_ASSERT(!rebuiltEntities.isEmpty() || rebuiltData.size() == 0);
+    if (rebuiltEntities.isEmpty())
+        return;
+
+    EntityRenderCommandData splicedData;
+    splicedData.reserve(cachedData.size() + rebuiltData.size());
+
+    auto rebuiltEntityIt = rebuiltEntities.cbegin();
+    const auto rebuiltEntityEnd = rebuiltEntities.cend();
+    int rIt = 0;
+    const int rEnd = rebuiltData.size();
+    int cIt = 0;
+    const int cEnd = cachedData.size();
+
+    while (cIt != cEnd) {
+        Entity *cachedEntity = cachedData.entities.at(cIt);
+
+        // Insert the rebuilt commands of entities with a lower address
+        while (rIt != rEnd && rebuiltData.entities.at(rIt) < cachedEntity) {
+            splicedData.push_back(rebuiltData.entities.at(rIt),
+                                  std::move(rebuiltData.commands[rIt]),
+                                  std::move(rebuiltData.passesData[rIt]));
+            ++rIt;
+        }
+
+        // Drop the cached commands of the entities that were rebuilt
+        while (rebuiltEntityIt != rebuiltEntityEnd && *rebuiltEntityIt < cachedEntity)
+            ++rebuiltEntityIt;
+        const bool wasRebuilt = rebuiltEntityIt != rebuiltEntityEnd && *rebuiltEntityIt == cachedEntity;
+        if (!wasRebuilt)
+            splicedData.push_back(cachedEntity,
+                                  std::move(cachedData.commands[cIt]),
+                                  std::move(cachedData.passesData[cIt]));
+        ++cIt;
+    }
+
+    while (rIt != rEnd) {
+        splicedData.push_back(rebuiltData.entities.at(rIt),
+                              std::move(rebuiltData.commands[rIt]),
+                              std::move(rebuiltData.passesData[rIt]));
+        ++rIt;
+    }
+
+    cachedData = std::move(splicedData);
+}
+
 } // OpenGL
 
 } // Render
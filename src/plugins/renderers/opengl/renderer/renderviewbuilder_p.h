@@ -108,14 +108,21 @@ public:
     bool layerCacheNeedsToBeRebuilt() const;
     void setMaterialGathererCacheNeedsToBeRebuilt(bool needsToBeRebuilt);
     bool materialGathererCacheNeedsToBeRebuilt() const;
+    void setMaterialGathererCacheNeedsPartialRebuild(bool needsPartialRebuild);
+    bool materialGathererCacheNeedsPartialRebuild() const;
     void setRenderCommandCacheNeedsToBeRebuilt(bool needsToBeRebuilt);
     bool renderCommandCacheNeedsToBeRebuilt() const;
+    void setRenderCommandCacheNeedsPartialRebuild(bool needsPartialRebuild);
+    bool renderCommandCacheNeedsPartialRebuild() const;
 
     static int defaultJobCount();
     int optimalJobCount() const;
     void setOptimalJobCount(int v);
 
     static QVector<Entity *> entitiesInSubset(const QVector<Entity *> &entities, const QVector<Entity *> &subset);
+    static void spliceRenderCommandData(EntityRenderCommandData &cachedData,
+                                        const QVector<Entity *> &rebuiltEntities,
+                                        EntityRenderCommandData &&rebuiltData);
 
 private:
     Render::FrameGraphNode *m_leafNode;
@@ -123,7 +130,9 @@ private:
     Renderer *m_renderer;
     bool m_layerCacheNeedsToBeRebuilt;
     bool m_materialGathererCacheNeedsToBeRebuilt;
+    bool m_materialGathererCacheNeedsPartialRebuild;
     bool m_renderCommandCacheNeedsToBeRebuilt;
+    bool m_renderCommandCacheNeedsPartialRebuild;
 
     RenderViewInitializerJobPtr m_renderViewJob;
     FilterLayerEntityJobPtr m_filterEntityByLayerJob;
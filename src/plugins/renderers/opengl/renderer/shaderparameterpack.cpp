@@ -54,6 +54,38 @@ namespace Qt3DRender {
 namespace Render {
 namespace OpenGL {
 
+namespace {
+
+// Largest range of name ids for which UniformLayout uses a direct lookup table
+const int MaxDirectSlotTableSize = 16384;
+
+} // anonymous
+
+void UniformLayout::build(const QVector<ShaderUniform> &uniforms)
+{
+    m_nameIds.clear();
+    m_slotsByNameId.clear();
+    m_firstNameId = 0;
+
+    m_nameIds.reserve(uniforms.size());
+    for (const ShaderUniform &uniform : uniforms)
+        m_nameIds.push_back(uniform.m_nameId);
+    Q_ASSERT(std::is_sorted(m_nameIds.cbegin(), m_nameIds.cend()));
+
+    if (m_nameIds.isEmpty())
+        return;
+
+    const int firstNameId = m_nameIds.first();
+    const qint64 range = qint64(m_nameIds.last()) - firstNameId + 1;
+    if (range > MaxDirectSlotTableSize)
+        return;
+
+    m_firstNameId = firstNameId;
+    m_slotsByNameId.fill(-1, int(range));
+    for (int slot = 0, m = m_nameIds.size(); slot < m; ++slot)
+        m_slotsByNameId[m_nameIds.at(slot) - firstNameId] = slot;
+}
+
 ShaderParameterPack::~ShaderParameterPack()
 {
 }
@@ -61,7 +93,6 @@ ShaderParameterPack::~ShaderParameterPack()
 void ShaderParameterPack::reserve(int uniformCount)
 {
     m_uniforms.reserve(uniformCount);
-    m_submissionUniformIndices.reserve(uniformCount);
 }
 
 void ShaderParameterPack::setUniform(const int glslNameId, const UniformValue &val)
@@ -106,9 +137,11 @@ void ShaderParameterPack::setShaderStorageBuffer(BlockToSSBO blockToSSBO)
     m_shaderStorageBuffers.push_back(std::move(blockToSSBO));
 }
 
-void ShaderParameterPack::setSubmissionUniformIndex(const int uniformIdx)
+// Lets uniforms of the shader be stored and retrieved by slot, the layout
+// must outlive the pack
+void ShaderParameterPack::setUniformLayout(const UniformLayout *layout)
 {
-    m_submissionUniformIndices.push_back(uniformIdx);
+    m_uniforms.setLayout(layout);
 }
 
 } // namespace OpenGL
@@ -59,6 +59,7 @@
 #include <Qt3DRender/private/renderlogging_p.h>
 #include <Qt3DRender/private/uniform_p.h>
 #include <shadervariables_p.h>
+#include <algorithm>
 
 QT_BEGIN_NAMESPACE
 
@@ -86,27 +87,89 @@ struct BlockToSSBO {
 QT3D_DECLARE_TYPEINFO_3(Qt3DRender, Render, OpenGL, BlockToSSBO, Q_PRIMITIVE_TYPE)
 
 
+// Maps the name id of each active uniform of a GLShader to its slot, the index
+// of the uniform in GLShader::uniforms(). Compiled once from the introspection
+// data so that packs and submission never have to search uniforms by name id.
+class Q_AUTOTEST_EXPORT UniformLayout
+{
+public:
+    // uniforms must be sorted by ascending name id
+    void build(const QVector<ShaderUniform> &uniforms);
+
+    int slotCount() const noexcept { return m_nameIds.size(); }
+
+    int slot(int nameId) const noexcept
+    {
+        if (!m_slotsByNameId.isEmpty()) {
+            const uint i = uint(nameId - m_firstNameId);
+            return i < uint(m_slotsByNameId.size()) ? m_slotsByNameId.at(i) : -1;
+        }
+        const auto it = std::lower_bound(m_nameIds.cbegin(), m_nameIds.cend(), nameId);
+        return (it != m_nameIds.cend() && *it == nameId) ? int(it - m_nameIds.cbegin()) : -1;
+    }
+
+private:
+    QVector<int> m_nameIds;
+    // Direct name id to slot table, only built when the range of name ids
+    // used by the shader is small enough, otherwise m_nameIds is searched
+    QVector<int> m_slotsByNameId;
+    int m_firstNameId = 0;
+};
+
 struct PackUniformHash
 {
     QVector<int> keys;
     QVector<UniformValue> values;
 
+    // When a layout is set, indexBySlot holds the index in keys/values of the
+    // uniform stored for each slot of the layout, or -1. Keys that are not
+    // part of the layout are still stored but searched linearly.
+    const UniformLayout *layout = nullptr;
+    QVector<int> indexBySlot;
+
     PackUniformHash()
     {
     }
 
+    void setLayout(const UniformLayout *uniformLayout)
+    {
+        layout = uniformLayout;
+        indexBySlot.clear();
+        if (layout == nullptr)
+            return;
+        indexBySlot.fill(-1, layout->slotCount());
+        for (int i = 0, m = keys.size(); i < m; ++i) {
+            const int slot = layout->slot(keys.at(i));
+            if (slot != -1)
+                indexBySlot[slot] = i;
+        }
+    }
+
     void reserve(int count)
     {
         keys.reserve(count);
         values.reserve(count);
     }
 
+    int indexOf(int key) const
+    {
+        if (layout != nullptr) {
+            const int slot = layout->slot(key);
+            if (slot != -1)
+                return indexBySlot.at(slot);
+        }
+        return keys.indexOf(key);
+    }
+
     void insert(int key, const UniformValue &value)
     {
-        const int idx = keys.indexOf(key);
+        const int slot = layout != nullptr ? layout->slot(key) : -1;
+        const int idx = slot != -1 ? indexBySlot.at(slot) : keys.indexOf(key);
         if (idx != -1) {
             values[idx] = value;
         } else {
+            if (slot != -1)
+                indexBySlot[slot] = keys.size();
             keys.push_back(key);
             values.push_back(value);
         }
@@ -114,7 +177,7 @@ struct PackUniformHash
 
     UniformValue value(int key) const
     {
-        const int idx = keys.indexOf(key);
+        const int idx = indexOf(key);
         if (idx != -1)
             return values.at(idx);
         return UniformValue();
@@ -122,22 +185,35 @@ struct PackUniformHash
 
     UniformValue& value(int key)
     {
-        const int idx = keys.indexOf(key);
+        const int idx = indexOf(key);
         if (idx != -1)
             return values[idx];
         insert(key, UniformValue());
-        return value(key);
+        return values.last();
     }
 
+    // Moves the last uniform in place of the erased one, so that only the
+    // slots of these two uniforms need to be updated
     void erase(int idx)
     {
-        keys.removeAt(idx);
-        values.removeAt(idx);
+        const int last = keys.size() - 1;
+        const int slot = layout != nullptr ? layout->slot(keys.at(idx)) : -1;
+        if (slot != -1)
+            indexBySlot[slot] = -1;
+        if (idx != last) {
+            keys[idx] = keys.at(last);
+            values[idx] = values.at(last);
+            const int movedSlot = layout != nullptr ? layout->slot(keys.at(idx)) : -1;
+            if (movedSlot != -1)
+                indexBySlot[movedSlot] = idx;
+        }
+        keys.removeLast();
+        values.removeLast();
     }
 
     bool contains(int key) const
     {
-        return keys.contains(key);
+        return indexOf(key) != -1;
     }
 };
 
@@ -153,7 +229,7 @@ public:
 
     void setUniformBuffer(BlockToUBO blockToUBO);
     void setShaderStorageBuffer(BlockToSSBO blockToSSBO);
-    void setSubmissionUniformIndex(const int shaderUniformIndex);
+    void setUniformLayout(const UniformLayout *layout);
 
     inline PackUniformHash &uniforms() { return m_uniforms; }
     inline const PackUniformHash &uniforms() const { return m_uniforms; }
@@ -199,7 +275,6 @@ public:
     inline QVector<NamedResource> images() const { return m_images; }
     inline QVector<BlockToUBO> uniformBuffers() const { return m_uniformBuffers; }
     inline QVector<BlockToSSBO> shaderStorageBuffers() const { return m_shaderStorageBuffers; }
-    inline QVector<int> submissionUniformIndices() const { return m_submissionUniformIndices; }
 private:
     PackUniformHash m_uniforms;
 
@@ -207,7 +282,6 @@ private:
     QVector<NamedResource> m_images;
     QVector<BlockToUBO> m_uniformBuffers;
     QVector<BlockToSSBO> m_shaderStorageBuffers;
-    QVector<int> m_submissionUniformIndices;
 
     friend class RenderView;
 };
@@ -4,9 +4,8 @@ TEMPLATE = subdirs
 include($$OUT_PWD/../../render/qt3drender-config.pri)
 QT_FOR_CONFIG += 3drender-private
 
-#SUBDIRS += dummy
-
-qtConfig(qt3d-opengl-renderer): SUBDIRS += opengl
+# The null renderer builds on top of the OpenGL renderer sources
+qtConfig(qt3d-opengl-renderer): SUBDIRS += opengl dummy
 
 qtConfig(qt3d-rhi-renderer): {
     qtHaveModule(shadertools): SUBDIRS += rhi
@@ -707,6 +707,8 @@ void Renderer::doRender(bool swapBuffers)
         QTaskLogger submissionStatsPart2(m_services->systemInformation(),
                                          { JobTypes::FrameSubmissionPart2, 0 },
                                          QTaskLogger::Submission);
+        submissionStatsPart1.setName(QStringLiteral("FrameSubmissionPart1"));
+        submissionStatsPart2.setName(QStringLiteral("FrameSubmissionPart2"));
 
         QVector<RHIPassInfo> rhiPassesInfo;
 
@@ -1881,6 +1883,7 @@ Renderer::submitRenderViews(const QVector<RHIPassInfo> &rhiPassesInfo)
 void Renderer::markDirty(BackendNodeDirtySet changes, BackendNode *node)
 {
     Q_UNUSED(node)
+    const QMutexLocker lock(&m_markDirtyMutex);
     m_dirtyBits.marked |= changes;
 }
 
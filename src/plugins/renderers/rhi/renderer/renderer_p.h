@@ -351,6 +351,7 @@ private:
         BackendNodeDirtySet remaining; // remaining dirty after jobs have finished
     };
     DirtyBits m_dirtyBits;
+    QMutex m_markDirtyMutex; // Backend nodes can be synced concurrently
 
     QAtomicInt m_lastFrameCorrect;
     QOpenGLContext *m_glContext;
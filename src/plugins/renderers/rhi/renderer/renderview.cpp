@@ -512,6 +512,13 @@ void RenderView::setRenderer(Renderer *renderer)
     m_manager = renderer->nodeManagers();
 }
 
+void RenderView::setLightSources(const QVector<LightSource> &lightSources)
+{
+    m_lightSources = lightSources;
+    // Built once here, then queried concurrently by the command updaters
+    m_lightGrid.build(lightSources, m_manager ? m_manager->shaderDataManager() : nullptr);
+}
+
 void RenderView::addClearBuffers(const ClearBuffers *cb)
 {
     QClearBuffers::BufferTypeFlags type = cb->type();
@@ -814,8 +821,6 @@ void RenderView::updateRenderCommand(EntityRenderCommandData *renderCommandData,
         // Pick which lights to take in to account.
         // For now decide based on the distance by taking the MAX_LIGHTS closest lights.
         // Replace with more sophisticated mechanisms later.
-        // Copy vector so that we can sort it concurrently and we only want to sort the one for the
-        // current command
         QVector<LightSource> lightSources;
         EnvironmentLight *environmentLight = nullptr;
 
@@ -827,20 +832,7 @@ void RenderView::updateRenderCommand(EntityRenderCommandData *renderCommandData,
                     entity->worldBoundingVolume()->center() - m_data.m_eyePos, m_data.m_eyeViewDir);
 
             environmentLight = m_environmentLight;
-            lightSources = m_lightSources;
-
-            if (lightSources.size() > 1) {
-                const Vector3D entityCenter = entity->worldBoundingVolume()->center();
-                std::sort(lightSources.begin(), lightSources.end(),
-                          [&](const LightSource &a, const LightSource &b) {
-                              const float distA = entityCenter.distanceToPoint(
-                                      a.entity->worldBoundingVolume()->center());
-                              const float distB = entityCenter.distanceToPoint(
-                                      b.entity->worldBoundingVolume()->center());
-                              return distA < distB;
-                          });
-            }
-            lightSources = lightSources.mid(0, std::max(lightSources.size(), MAX_LIGHTS));
+            lightSources = m_lightGrid.closestLightSources(entity->worldBoundingVolume()->center(), MAX_LIGHTS);
         } else { // Compute
             // Note: if frameCount has reached 0 in the previous frame, isEnabled
             // would be false
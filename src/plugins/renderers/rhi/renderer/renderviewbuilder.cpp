@@ -580,6 +580,7 @@ void RenderViewBuilder::prepareJobs()
     // Init what we can here
     m_filterProximityJob->setManager(m_renderer->nodeManagers());
     m_frustumCullingJob->setRoot(m_renderer->sceneRoot());
+    m_frustumCullingJob->setManagers(m_renderer->nodeManagers());
 
     if (m_renderCommandCacheNeedsToBeRebuilt) {
 
@@ -411,11 +411,13 @@ void GLTFImporter::setSource(const QUrl &source)
     QFile f(path);
     f.open(QIODevice::ReadOnly);
 
-    if (Q_UNLIKELY(!setJSON(qLoadGLTF(f.readAll())))) {
+    QByteArray binaryChunk;
+    if (Q_UNLIKELY(!setJSON(qLoadGLTF(f.readAll(), &binaryChunk)))) {
         qCWarning(GLTFImporterLog, "not a JSON document");
         return;
     }
 
+    m_binaryChunk = binaryChunk;
     setBasePath(finfo.dir().absolutePath());
 }
 
@@ -426,11 +428,13 @@ void GLTFImporter::setSource(const QUrl &source)
  */
 void GLTFImporter::setData(const QByteArray& data, const QString &basePath)
 {
-    if (Q_UNLIKELY(!setJSON(qLoadGLTF(data)))) {
+    QByteArray binaryChunk;
+    if (Q_UNLIKELY(!setJSON(qLoadGLTF(data, &binaryChunk)))) {
         qCWarning(GLTFImporterLog, "not a JSON document");
         return;
     }
 
+    m_binaryChunk = binaryChunk;
     setBasePath(basePath);
 }
 
@@ -755,7 +759,8 @@ bool GLTFImporter::isGLTFSupported(const QStringList &extensions)
 {
     for (auto suffix: qAsConst(extensions)) {
         suffix = suffix.toLower();
-        if (suffix == QLatin1String("json") || suffix == QLatin1String("gltf") || suffix == QLatin1String("qgltf"))
+        if (suffix == QLatin1String("json") || suffix == QLatin1String("gltf") || suffix == QLatin1String("qgltf")
+                || suffix == QLatin1String("glb"))
             return true;
     }
     return false;
@@ -1890,6 +1895,20 @@ void GLTFImporter::processJSONMesh(const QString &id, const QJsonObject &json)
 
 void GLTFImporter::processJSONImage(const QString &id, const QJsonObject &jsonObject)
 {
+    // Images of .glb files are usually stored in a buffer view
+    const QJsonValue bufferView = jsonObject.value(KEY_BUFFER_VIEW);
+    if (m_majorVersion > 1 && !bufferView.isUndefined()) {
+        const Qt3DCore::QBuffer *buffer = m_buffers.value(QString::number(bufferView.toInt()));
+        QImage image;
+        if (Q_UNLIKELY(buffer == nullptr || !image.loadFromData(buffer->data()))) {
+            qCWarning(GLTFImporterLog, "can't load image %ls from buffer view %d",
+                      qUtf16PrintableImpl(id), bufferView.toInt());
+            return;
+        }
+        m_imageData[id] = image;
+        return;
+    }
+
     QString path = jsonObject.value(KEY_URI).toString();
 
     if (!isEmbeddedResource(path)) {
@@ -2071,7 +2090,9 @@ void GLTFImporter::loadBufferData()
 {
     for (auto &bufferData : m_bufferDatas) {
         if (!bufferData.data) {
-            bufferData.data = new QByteArray(resolveLocalData(bufferData.path));
+            // The buffer without uri of a .glb file is its BIN chunk, shared rather than copied
+            bufferData.data = new QByteArray(bufferData.path.isEmpty() ? m_binaryChunk
+                                                                       : resolveLocalData(bufferData.path));
         }
     }
 }
@@ -2085,6 +2106,7 @@ void GLTFImporter::unloadBufferData()
         QByteArray *data = bufferData.data;
         delete data;
     }
+    m_binaryChunk.clear();
 }
 
 QByteArray GLTFImporter::resolveLocalData(const QString &path) const
@@ -212,6 +212,8 @@ private:
     QHash<QString, QMaterial*> m_materialCache;
 
     QHash<QString, BufferData> m_bufferDatas;
+    // BIN chunk of a .glb file, the data of its buffer without uri
+    QByteArray m_binaryChunk;
     QHash<QString, Qt3DCore::QBuffer*> m_buffers;
 
     QHash<QString, QString> m_shaderPaths;
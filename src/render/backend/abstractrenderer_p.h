@@ -149,6 +149,7 @@ public:
 
     virtual bool isRunning() const = 0;
 
+    // Must be thread-safe, backend nodes can call it while synced concurrently
     virtual void markDirty(BackendNodeDirtySet changes, BackendNode *node) = 0;
     virtual BackendNodeDirtySet dirtyBits() = 0;
 #if defined(QT_BUILD_INTERNAL)
@@ -0,0 +1,108 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "boundingspherearray_p.h"
+
+#include <Qt3DRender/private/entity_p.h>
+#include <Qt3DRender/private/managers_p.h>
+#include <Qt3DRender/private/sphere_p.h>
+
+#include <algorithm>
+#include <limits>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DRender {
+namespace Render {
+
+BoundingSphereArray::BoundingSphereArray()
+    : m_revision(std::numeric_limits<quint64>::max())
+{
+}
+
+bool BoundingSphereArray::updateSlots(EntityManager *manager)
+{
+    // The revision only changes when entities are added or removed, which
+    // spares us from comparing the handles every frame
+    if (manager->activeHandlesRevision() == m_revision)
+        return false;
+
+    m_revision = manager->activeHandlesRevision();
+    const QVector<HEntity> &handles = manager->activeHandles();
+    m_entities.clear();
+    m_entities.reserve(handles.size());
+    for (const HEntity &handle : handles) {
+        Entity *entity = manager->data(handle);
+        if (entity != nullptr)
+            m_entities.push_back(entity);
+    }
+    std::sort(m_entities.begin(), m_entities.end());
+
+    const int count = m_entities.size();
+    m_centersX.resize(count);
+    m_centersY.resize(count);
+    m_centersZ.resize(count);
+    m_radii.resize(count);
+
+    return true;
+}
+
+int BoundingSphereArray::slotOf(const Entity *entity) const
+{
+    const auto it = std::lower_bound(m_entities.cbegin(), m_entities.cend(), entity);
+    if (it == m_entities.cend() || *it != entity)
+        return -1;
+    return int(std::distance(m_entities.cbegin(), it));
+}
+
+void BoundingSphereArray::setSphere(int slot, const Sphere &sphere)
+{
+    if (slot < 0 || slot >= m_entities.size())
+        return;
+    const Vector3D center = sphere.center();
+    m_centersX[slot] = center.x();
+    m_centersY[slot] = center.y();
+    m_centersZ[slot] = center.z();
+    m_radii[slot] = sphere.radius();
+}
+
+} // namespace Render
+} // namespace Qt3DRender
+
+QT_END_NAMESPACE
@@ -0,0 +1,103 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QT3DRENDER_RENDER_BOUNDINGSPHEREARRAY_P_H
+#define QT3DRENDER_RENDER_BOUNDINGSPHEREARRAY_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of other Qt classes.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <Qt3DRender/private/qt3drender_global_p.h>
+#include <Qt3DRender/private/handle_types_p.h>
+#include <QVector>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DRender {
+namespace Render {
+
+class Entity;
+class EntityManager;
+class Sphere;
+
+// Structure of arrays copy of the world bounding spheres (including
+// children) of all entities, filled by UpdateWorldBoundingVolumeJob and
+// ExpandBoundingVolumeJob. Slots are ordered by Entity address so that any
+// list of entities gathered by walking the slots in order is already sorted.
+class Q_3DRENDERSHARED_PRIVATE_EXPORT BoundingSphereArray
+{
+public:
+    BoundingSphereArray();
+
+    // Reassigns the slots if entities were added or removed since the last call
+    bool updateSlots(EntityManager *manager);
+
+    int size() const { return m_entities.size(); }
+    int slotOf(const Entity *entity) const;
+    void setSphere(int slot, const Sphere &sphere);
+
+    const QVector<Entity *> &entities() const { return m_entities; }
+    const float *centersX() const { return m_centersX.constData(); }
+    const float *centersY() const { return m_centersY.constData(); }
+    const float *centersZ() const { return m_centersZ.constData(); }
+    const float *radii() const { return m_radii.constData(); }
+
+private:
+    quint64 m_revision;
+    QVector<Entity *> m_entities;
+    QVector<float> m_centersX;
+    QVector<float> m_centersY;
+    QVector<float> m_centersZ;
+    QVector<float> m_radii;
+};
+
+} // namespace Render
+} // namespace Qt3DRender
+
+QT_END_NAMESPACE
+
+#endif // QT3DRENDER_RENDER_BOUNDINGSPHEREARRAY_P_H
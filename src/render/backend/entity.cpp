@@ -105,6 +105,8 @@ Entity::Entity()
     , m_nodeManagers(nullptr)
     , m_boundingDirty(false)
     , m_treeEnabled(true)
+    , m_worldTransformDirty(0)
+    , m_transformSubtreeDirty(0)
 {
 }
 
@@ -156,6 +158,8 @@ void Entity::cleanup()
     m_worldBoundingVolumeWithChildren.reset();
     m_parentHandle = {};
     m_boundingDirty = false;
+    m_worldTransformDirty.storeRelaxed(0);
+    m_transformSubtreeDirty.storeRelaxed(0);
     QBackendNode::setEnabled(false);
 
     // Ensure we rebuild caches when an Entity gets cleaned up
@@ -176,6 +180,10 @@ void Entity::setParentHandle(HEntity parentHandle)
     auto parent = m_nodeManagers->renderNodesManager()->data(parentHandle);
     if (parent != nullptr && !parent->m_childrenHandles.contains(m_handle))
         parent->m_childrenHandles.append(m_handle);
+
+    // The new ancestors have to be flagged even if this entity already was,
+    // otherwise UpdateWorldTransformJob would prune the branch we moved to
+    markWorldTransformDirty();
 }
 
 void Entity::setNodeManagers(NodeManagers *manager)
@@ -194,7 +202,8 @@ void Entity::syncFromFrontEnd(const QNode *frontEnd, bool firstTime)
     if (!node)
         return;
 
-    if (this->isEnabled() != node->isEnabled()) {
+    const bool enabledChanged = this->isEnabled() != node->isEnabled();
+    if (enabledChanged) {
         markDirty(AbstractRenderer::EntityEnabledDirty);
         // We let QBackendNode::syncFromFrontEnd change the enabled property
     }
@@ -207,12 +216,16 @@ void Entity::syncFromFrontEnd(const QNode *frontEnd, bool firstTime)
     // backend parent at this time
     Q_ASSERT(!node->parentEntity() || (!parentHandle.isNull() && m_nodeManagers->renderNodesManager()->data(parentHandle)));
 
-    if (parentHandle != m_parentHandle) {
+    const bool parentChanged = parentHandle != m_parentHandle;
+    if (parentChanged) {
         markDirty(AbstractRenderer::AllDirty);
     }
 
     setParentHandle(parentHandle);
 
+    if (firstTime || parentChanged || enabledChanged)
+        markWorldTransformDirty();
+
     if (firstTime) {
         m_worldTransform = m_nodeManagers->worldMatrixManager()->getOrAcquireHandle(peerId());
 
@@ -320,6 +333,7 @@ void Entity::addComponent(Qt3DCore::QNodeIdTypePair idAndType)
     qCDebug(Render::RenderNodes) << Q_FUNC_INFO << "id =" << id << type->className();
     if (type->inherits(&Qt3DCore::QTransform::staticMetaObject)) {
         m_transformComponent = id;
+        markWorldTransformDirty();
     } else if (type->inherits(&QCameraLens::staticMetaObject)) {
         m_cameraComponent = id;
     } else if (type->inherits(&QLayer::staticMetaObject)) {
@@ -359,6 +373,7 @@ void Entity::removeComponent(Qt3DCore::QNodeId nodeId)
 {
     if (m_transformComponent == nodeId) {
         m_transformComponent = QNodeId();
+        markWorldTransformDirty();
     } else if (m_cameraComponent == nodeId) {
         m_cameraComponent = QNodeId();
     } else if (m_layerComponents.contains(nodeId)) {
@@ -402,6 +417,25 @@ void Entity::unsetBoundingVolumeDirty()
     m_boundingDirty = false;
 }
 
+void Entity::markWorldTransformDirty()
+{
+    m_worldTransformDirty.storeRelaxed(1);
+    m_transformSubtreeDirty.storeRelaxed(1);
+
+    // Always start from the parent: this entity may have been flagged while
+    // it was attached elsewhere. Stop at the first ancestor already flagged,
+    // the rest of the chain up to the root is flagged as well
+    Entity *entity = m_nodeManagers != nullptr ? parent() : nullptr;
+    while (entity != nullptr && entity->m_transformSubtreeDirty.fetchAndStoreRelaxed(1) == 0)
+        entity = entity->m_nodeManagers != nullptr ? entity->parent() : nullptr;
+}
+
+void Entity::unsetWorldTransformDirty(bool subtreeStillDirty)
+{
+    m_worldTransformDirty.storeRelaxed(0);
+    m_transformSubtreeDirty.storeRelaxed(subtreeStillDirty ? 1 : 0);
+}
+
 void Entity::addRecursiveLayerId(const QNodeId layerId)
 {
     if (!m_recursiveLayerComponents.contains(layerId) && !m_layerComponents.contains(layerId))
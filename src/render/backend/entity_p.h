@@ -57,6 +57,7 @@
 #include <Qt3DRender/private/handle_types_p.h>
 #include <Qt3DCore/private/qentity_p.h>
 #include <Qt3DCore/private/qhandle_p.h>
+#include <QAtomicInt>
 #include <QVector>
 
 QT_BEGIN_NAMESPACE
@@ -119,6 +120,15 @@ public:
     bool isBoundingVolumeDirty() const;
     void unsetBoundingVolumeDirty();
 
+    // Set when the world transform of this entity needs to be recomputed.
+    // Every ancestor of a dirty entity is flagged as having a dirty subtree
+    // so that UpdateWorldTransformJob can prune clean branches. Transforms
+    // synced concurrently may flag the same entities, hence the atomics.
+    void markWorldTransformDirty();
+    bool isWorldTransformDirty() const { return m_worldTransformDirty.loadRelaxed() != 0; }
+    bool isTransformSubtreeDirty() const { return m_transformSubtreeDirty.loadRelaxed() != 0; }
+    void unsetWorldTransformDirty(bool subtreeStillDirty);
+
     void setTreeEnabled(bool enabled) { m_treeEnabled = enabled; }
     bool isTreeEnabled() const { return m_treeEnabled; }
 
@@ -213,6 +223,8 @@ private:
     bool m_boundingDirty;
     // true only if this and all parent nodes are enabled
     bool m_treeEnabled;
+    QAtomicInt m_worldTransformDirty;
+    QAtomicInt m_transformSubtreeDirty;
 };
 
 #define ENTITY_COMPONENT_TEMPLATE_SPECIALIZATION(Type, Handle) \
@@ -0,0 +1,481 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "entityspatialindex_p.h"
+#include <Qt3DRender/private/boundingspherearray_p.h>
+#include <Qt3DRender/private/qray3d_p.h>
+#include <QVarLengthArray>
+
+#include <algorithm>
+#include <limits>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DRender {
+
+using namespace RayCasting;
+
+namespace Render {
+
+namespace {
+
+// Leaves are enlarged by this fraction of the sphere radius
+const float FatMarginRatio = 0.1f;
+
+// Relative enlargement covering the rounding differences with the exact
+// sphere tests done on the candidates
+const float BoxEpsilon = 1.0e-4f;
+
+EntitySpatialIndex::AABB sphereBox(float x, float y, float z, float radius, float margin)
+{
+    const float center[3] = { x, y, z };
+    const float r = qAbs(radius);
+    EntitySpatialIndex::AABB box;
+    for (int axis = 0; axis < 3; ++axis) {
+        const float extent = r + margin * r + BoxEpsilon * (qAbs(center[axis]) + r);
+        box.min[axis] = center[axis] - extent;
+        box.max[axis] = center[axis] + extent;
+    }
+    return box;
+}
+
+bool halfLineIntersectsBox(const Vector3D &origin, const Vector3D &direction,
+                           const EntitySpatialIndex::AABB &box)
+{
+    float tMin = 0.0f;
+    float tMax = std::numeric_limits<float>::max();
+    for (int axis = 0; axis < 3; ++axis) {
+        const float o = origin[axis];
+        const float d = direction[axis];
+
+        if (qAbs(d) < 1.0e-20f) {
+            // Parallel to the slab
+            if (o < box.min[axis] || o > box.max[axis])
+                return false;
+            continue;
+        }
+
+        const float invD = 1.0f / d;
+        float t0 = (box.min[axis] - o) * invD;
+        float t1 = (box.max[axis] - o) * invD;
+        if (t0 > t1)
+            std::swap(t0, t1);
+        tMin = qMax(tMin, t0);
+        tMax = qMin(tMax, t1);
+        if (tMin > tMax)
+            return false;
+    }
+    return true;
+}
+
+} // anonymous
+
+bool EntitySpatialIndex::AABB::contains(const AABB &other) const
+{
+    for (int axis = 0; axis < 3; ++axis) {
+        if (other.min[axis] < min[axis] || other.max[axis] > max[axis])
+            return false;
+    }
+    return true;
+}
+
+bool EntitySpatialIndex::AABB::overlaps(const AABB &other) const
+{
+    for (int axis = 0; axis < 3; ++axis) {
+        if (other.max[axis] < min[axis] || other.min[axis] > max[axis])
+            return false;
+    }
+    return true;
+}
+
+float EntitySpatialIndex::AABB::surfaceArea() const
+{
+    const float dx = max[0] - min[0];
+    const float dy = max[1] - min[1];
+    const float dz = max[2] - min[2];
+    return 2.0f * (dx * dy + dy * dz + dz * dx);
+}
+
+EntitySpatialIndex::AABB EntitySpatialIndex::AABB::merged(const AABB &a, const AABB &b)
+{
+    AABB box;
+    for (int axis = 0; axis < 3; ++axis) {
+        box.min[axis] = qMin(a.min[axis], b.min[axis]);
+        box.max[axis] = qMax(a.max[axis], b.max[axis]);
+    }
+    return box;
+}
+
+EntitySpatialIndex::EntitySpatialIndex()
+    : m_root(-1)
+    , m_freeList(-1)
+    , m_reinsertionCount(0)
+{
+}
+
+void EntitySpatialIndex::update(const BoundingSphereArray *spheres)
+{
+    const QVector<Entity *> &entities = spheres->entities();
+    const int slotCount = entities.size();
+
+    // Match the leaves with the slots when entities were added or removed
+    if (m_syncedEntities != entities) {
+        QHash<const Entity *, int> previousProxies = std::move(m_proxies);
+        m_proxies.clear();
+        m_proxies.reserve(slotCount);
+        m_slotProxies.resize(slotCount);
+        for (int slot = 0; slot < slotCount; ++slot) {
+            Entity *entity = entities.at(slot);
+            const auto it = previousProxies.find(entity);
+            if (it != previousProxies.end()) {
+                m_slotProxies[slot] = it.value();
+                m_proxies.insert(entity, it.value());
+                previousProxies.erase(it);
+            } else {
+                m_slotProxies[slot] = -1;
+            }
+        }
+        for (const int proxy : qAsConst(previousProxies))
+            destroyProxy(proxy);
+        m_syncedEntities = entities;
+    }
+
+    const float *x = spheres->centersX();
+    const float *y = spheres->centersY();
+    const float *z = spheres->centersZ();
+    const float *r = spheres->radii();
+    for (int slot = 0; slot < slotCount; ++slot) {
+        const AABB fatBox = sphereBox(x[slot], y[slot], z[slot], r[slot], FatMarginRatio);
+        const int proxy = m_slotProxies.at(slot);
+        if (proxy == -1) {
+            Entity *entity = entities.at(slot);
+            const int newProxy = createProxy(fatBox, entity);
+            m_slotProxies[slot] = newProxy;
+            m_proxies.insert(entity, newProxy);
+        } else if (!m_nodes.at(proxy).box.contains(sphereBox(x[slot], y[slot], z[slot], r[slot], 0.0f))) {
+            // Only reinsert entities which escaped their enlarged box
+            moveProxy(proxy, fatBox);
+        }
+    }
+}
+
+bool EntitySpatialIndex::isInSync(const BoundingSphereArray *spheres) const
+{
+    return m_syncedEntities == spheres->entities();
+}
+
+QVector<Entity *> EntitySpatialIndex::entitiesAlongRay(const QRay3D &ray) const
+{
+    QVector<Entity *> entities;
+    if (m_root == -1)
+        return entities;
+
+    const Vector3D origin = ray.origin();
+    const Vector3D direction = ray.direction();
+
+    QVarLengthArray<int, 64> stack;
+    stack.push_back(m_root);
+    while (!stack.isEmpty()) {
+        const int nodeIndex = stack.last();
+        stack.removeLast();
+        const Node &node = m_nodes.at(nodeIndex);
+        if (!halfLineIntersectsBox(origin, direction, node.box))
+            continue;
+        if (node.isLeaf()) {
+            entities.push_back(node.entity);
+        } else {
+            stack.push_back(node.children[1]);
+            stack.push_back(node.children[0]);
+        }
+    }
+    return entities;
+}
+
+QVector<Entity *> EntitySpatialIndex::entitiesInBox(const Vector3D &center, float halfExtent) const
+{
+    QVector<Entity *> entities;
+    if (m_root == -1)
+        return entities;
+
+    AABB box;
+    for (int axis = 0; axis < 3; ++axis) {
+        box.min[axis] = center[axis] - halfExtent;
+        box.max[axis] = center[axis] + halfExtent;
+    }
+
+    QVarLengthArray<int, 64> stack;
+    stack.push_back(m_root);
+    while (!stack.isEmpty()) {
+        const int nodeIndex = stack.last();
+        stack.removeLast();
+        const Node &node = m_nodes.at(nodeIndex);
+        if (!node.box.overlaps(box))
+            continue;
+        if (node.isLeaf()) {
+            entities.push_back(node.entity);
+        } else {
+            stack.push_back(node.children[1]);
+            stack.push_back(node.children[0]);
+        }
+    }
+    return entities;
+}
+
+int EntitySpatialIndex::height() const
+{
+    return m_root == -1 ? 0 : m_nodes.at(m_root).height;
+}
+
+int EntitySpatialIndex::allocateNode()
+{
+    if (m_freeList == -1) {
+        m_nodes.push_back(Node());
+        m_freeList = m_nodes.size() - 1;
+        m_nodes[m_freeList].parent = -1;
+    }
+
+    const int nodeIndex = m_freeList;
+    Node &node = m_nodes[nodeIndex];
+    m_freeList = node.parent;
+    node.entity = nullptr;
+    node.parent = -1;
+    node.children[0] = -1;
+    node.children[1] = -1;
+    node.height = 0;
+    return nodeIndex;
+}
+
+void EntitySpatialIndex::freeNode(int nodeIndex)
+{
+    Node &node = m_nodes[nodeIndex];
+    node.entity = nullptr;
+    node.parent = m_freeList;
+    node.height = -1;
+    m_freeList = nodeIndex;
+}
+
+int EntitySpatialIndex::createProxy(const AABB &box, Entity *entity)
+{
+    const int proxy = allocateNode();
+    m_nodes[proxy].box = box;
+    m_nodes[proxy].entity = entity;
+    insertLeaf(proxy);
+    return proxy;
+}
+
+void EntitySpatialIndex::destroyProxy(int proxy)
+{
+    removeLeaf(proxy);
+    freeNode(proxy);
+}
+
+void EntitySpatialIndex::moveProxy(int proxy, const AABB &box)
+{
+    removeLeaf(proxy);
+    m_nodes[proxy].box = box;
+    insertLeaf(proxy);
+    ++m_reinsertionCount;
+}
+
+void EntitySpatialIndex::insertLeaf(int leaf)
+{
+    if (m_root == -1) {
+        m_root = leaf;
+        m_nodes[leaf].parent = -1;
+        return;
+    }
+
+    // Find the sibling minimizing the surface area increase of the tree
+    const AABB leafBox = m_nodes.at(leaf).box;
+    int nodeIndex = m_root;
+    while (!m_nodes.at(nodeIndex).isLeaf()) {
+        const Node &node = m_nodes.at(nodeIndex);
+        const float area = node.box.surfaceArea();
+        const float combinedArea = AABB::merged(node.box, leafBox).surfaceArea();
+
+        // Cost of creating a new parent for this node and the new leaf
+        const float cost = 2.0f * combinedArea;
+        // Minimum cost of pushing the leaf further down the tree
+        const float inheritanceCost = 2.0f * (combinedArea - area);
+
+        float childCosts[2];
+        for (int i = 0; i < 2; ++i) {
+            const Node &child = m_nodes.at(node.children[i]);
+            const float mergedArea = AABB::merged(child.box, leafBox).surfaceArea();
+            childCosts[i] = (child.isLeaf() ? mergedArea : mergedArea - child.box.surfaceArea()) + inheritanceCost;
+        }
+
+        if (cost < childCosts[0] && cost < childCosts[1])
+            break;
+        nodeIndex = node.children[childCosts[0] < childCosts[1] ? 0 : 1];
+    }
+
+    const int sibling = nodeIndex;
+    const int oldParent = m_nodes.at(sibling).parent;
+    const int newParent = allocateNode();
+    {
+        Node &parent = m_nodes[newParent];
+        parent.parent = oldParent;
+        parent.box = AABB::merged(leafBox, m_nodes.at(sibling).box);
+        parent.height = m_nodes.at(sibling).height + 1;
+        parent.children[0] = sibling;
+        parent.children[1] = leaf;
+    }
+    m_nodes[sibling].parent = newParent;
+    m_nodes[leaf].parent = newParent;
+
+    if (oldParent == -1) {
+        m_root = newParent;
+    } else {
+        Node &grandParent = m_nodes[oldParent];
+        grandParent.children[grandParent.children[0] == sibling ? 0 : 1] = newParent;
+    }
+
+    refit(m_nodes.at(leaf).parent);
+}
+
+void EntitySpatialIndex::removeLeaf(int leaf)
+{
+    if (leaf == m_root) {
+        m_root = -1;
+        return;
+    }
+
+    const int parent = m_nodes.at(leaf).parent;
+    const int grandParent = m_nodes.at(parent).parent;
+    const int sibling = m_nodes.at(parent).children[m_nodes.at(parent).children[0] == leaf ? 1 : 0];
+
+    if (grandParent == -1) {
+        m_root = sibling;
+        m_nodes[sibling].parent = -1;
+        freeNode(parent);
+        return;
+    }
+
+    Node &grandParentNode = m_nodes[grandParent];
+    grandParentNode.children[grandParentNode.children[0] == parent ? 0 : 1] = sibling;
+    m_nodes[sibling].parent = grandParent;
+    freeNode(parent);
+
+    refit(grandParent);
+}
+
+// Rebalances and recomputes boxes and heights from nodeIndex up to the root
+void EntitySpatialIndex::refit(int nodeIndex)
+{
+    while (nodeIndex != -1) {
+        nodeIndex = balance(nodeIndex);
+
+        Node &node = m_nodes[nodeIndex];
+        const Node &child0 = m_nodes.at(node.children[0]);
+        const Node &child1 = m_nodes.at(node.children[1]);
+        node.height = 1 + qMax(child0.height, child1.height);
+        node.box = AABB::merged(child0.box, child1.box);
+
+        nodeIndex = node.parent;
+    }
+}
+
+int EntitySpatialIndex::balance(int nodeIndex)
+{
+    const Node &node = m_nodes.at(nodeIndex);
+    if (node.isLeaf() || node.height < 2)
+        return nodeIndex;
+
+    const int heightDifference = m_nodes.at(node.children[1]).height - m_nodes.at(node.children[0]).height;
+    if (heightDifference > 1)
+        return rotate(nodeIndex, 1);
+    if (heightDifference < -1)
+        return rotate(nodeIndex, 0);
+    return nodeIndex;
+}
+
+// Promotes the child on the given side of node A, returns the index of the
+// node now at the place of A
+int EntitySpatialIndex::rotate(int iA, int side)
+{
+    const int iC = m_nodes.at(iA).children[side];
+    const int iB = m_nodes.at(iA).children[1 - side];
+    const int iF = m_nodes.at(iC).children[0];
+    const int iG = m_nodes.at(iC).children[1];
+
+    Node &A = m_nodes[iA];
+    Node &B = m_nodes[iB];
+    Node &C = m_nodes[iC];
+    Node &F = m_nodes[iF];
+    Node &G = m_nodes[iG];
+
+    // Swap A and C
+    C.children[0] = iA;
+    C.parent = A.parent;
+    A.parent = iC;
+
+    if (C.parent == -1) {
+        m_root = iC;
+    } else {
+        Node &parent = m_nodes[C.parent];
+        parent.children[parent.children[0] == iA ? 0 : 1] = iC;
+    }
+
+    // Keep the highest grand child under C
+    if (F.height > G.height) {
+        C.children[1] = iF;
+        A.children[side] = iG;
+        G.parent = iA;
+        A.box = AABB::merged(B.box, G.box);
+        C.box = AABB::merged(A.box, F.box);
+        A.height = 1 + qMax(B.height, G.height);
+        C.height = 1 + qMax(A.height, F.height);
+    } else {
+        C.children[1] = iG;
+        A.children[side] = iF;
+        F.parent = iA;
+        A.box = AABB::merged(B.box, F.box);
+        C.box = AABB::merged(A.box, G.box);
+        A.height = 1 + qMax(B.height, F.height);
+        C.height = 1 + qMax(A.height, G.height);
+    }
+
+    return iC;
+}
+
+} // namespace Render
+} // namespace Qt3DRender
+
+QT_END_NAMESPACE
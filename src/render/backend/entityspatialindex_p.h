@@ -0,0 +1,143 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QT3DRENDER_RENDER_ENTITYSPATIALINDEX_P_H
+#define QT3DRENDER_RENDER_ENTITYSPATIALINDEX_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of other Qt classes.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <Qt3DRender/private/qt3drender_global_p.h>
+#include <Qt3DCore/private/vector3d_p.h>
+#include <QHash>
+#include <QVector>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DRender {
+
+namespace RayCasting {
+class QRay3D;
+}
+
+namespace Render {
+
+class Entity;
+class BoundingSphereArray;
+
+// Dynamic AABB tree over the world bounding volumes (including children) of
+// all entities. Leaves store a box enlarged by a margin so that entities
+// moving a little don't need to be reinserted. It is kept up to date by
+// ExpandBoundingVolumeJob and used as broad phase by picking, ray casting
+// and proximity filtering.
+class Q_3DRENDERSHARED_PRIVATE_EXPORT EntitySpatialIndex
+{
+public:
+    struct AABB
+    {
+        float min[3];
+        float max[3];
+
+        bool contains(const AABB &other) const;
+        bool overlaps(const AABB &other) const;
+        float surfaceArea() const;
+        static AABB merged(const AABB &a, const AABB &b);
+    };
+
+    EntitySpatialIndex();
+
+    // Inserts, moves and removes leaves to match the current spheres
+    void update(const BoundingSphereArray *spheres);
+    bool isInSync(const BoundingSphereArray *spheres) const;
+
+    // Entities whose box is crossed by the half line starting at the ray origin
+    QVector<Entity *> entitiesAlongRay(const RayCasting::QRay3D &ray) const;
+    // Entities whose box overlaps the box centered on center
+    QVector<Entity *> entitiesInBox(const Vector3D &center, float halfExtent) const;
+
+    int entityCount() const { return m_proxies.size(); }
+    int height() const;
+    int reinsertionCount() const { return m_reinsertionCount; }
+
+private:
+    struct Node
+    {
+        AABB box;
+        Entity *entity;
+        int parent;         // Next free node when in the free list
+        int children[2];
+        int height;         // 0 for leaves, -1 for free nodes
+
+        bool isLeaf() const { return children[0] == -1; }
+    };
+
+    int allocateNode();
+    void freeNode(int nodeIndex);
+    int createProxy(const AABB &box, Entity *entity);
+    void destroyProxy(int proxy);
+    void moveProxy(int proxy, const AABB &box);
+    void insertLeaf(int leaf);
+    void removeLeaf(int leaf);
+    void refit(int nodeIndex);
+    int balance(int nodeIndex);
+    int rotate(int nodeIndex, int side);
+
+    QVector<Node> m_nodes;
+    int m_root;
+    int m_freeList;
+    int m_reinsertionCount;
+    QHash<const Entity *, int> m_proxies;
+    QVector<Entity *> m_syncedEntities;
+    QVector<int> m_slotProxies;
+};
+
+} // namespace Render
+} // namespace Qt3DRender
+
+QT_END_NAMESPACE
+
+#endif // QT3DRENDER_RENDER_ENTITYSPATIALINDEX_P_H
@@ -53,6 +53,7 @@ namespace Render {
 Layer::Layer()
     : BackendNode()
     , m_recursive(false)
+    , m_maskIndex(-1)
 {
 }
 
@@ -64,6 +65,7 @@ Layer::~Layer()
 void Layer::cleanup()
 {
     QBackendNode::setEnabled(false);
+    m_maskIndex = -1;
 }
 
 void Layer::syncFromFrontEnd(const Qt3DCore::QNode *frontEnd, bool firstTime)
@@ -78,8 +78,13 @@ public:
 
     void syncFromFrontEnd(const Qt3DCore::QNode *frontEnd, bool firstTime) override;
 
+    // Bit of the Layer in the entities' LayerMask, -1 if none was assigned
+    int maskIndex() const { return m_maskIndex; }
+    void setMaskIndex(int maskIndex) { m_maskIndex = maskIndex; }
+
 private:
     bool m_recursive;
+    int m_maskIndex;
 };
 
 } // namespace Render
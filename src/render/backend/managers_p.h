@@ -85,6 +85,10 @@
 #include <Qt3DRender/private/joint_p.h>
 #include <Qt3DRender/private/shaderimage_p.h>
 #include <Qt3DRender/private/pickingproxy_p.h>
+#include <Qt3DRender/private/boundingspherearray_p.h>
+#include <Qt3DRender/private/layermaskarray_p.h>
+#include <Qt3DRender/private/primitivebvh_p.h>
+#include <Qt3DRender/private/entityspatialindex_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -143,6 +147,15 @@ public:
                 e->setNodeManagers(nullptr);
         });
     }
+
+    BoundingSphereArray *worldBoundingSpheres() { return &m_worldBoundingSpheres; }
+    EntitySpatialIndex *spatialIndex() { return &m_spatialIndex; }
+    LayerMaskArray *layerMasks() { return &m_layerMasks; }
+
+private:
+    BoundingSphereArray m_worldBoundingSpheres;
+    EntitySpatialIndex m_spatialIndex;
+    LayerMaskArray m_layerMasks;
 };
 
 class FrameGraphNode;
@@ -388,6 +401,11 @@ class Q_3DRENDERSHARED_PRIVATE_EXPORT GeometryManager : public Qt3DCore::QResour
         Qt3DCore::QNodeId,
         Qt3DCore::NonLockingPolicy>
 {
+public:
+    PrimitiveBVHCache *pickingBVHCache() { return &m_pickingBVHCache; }
+
+private:
+    PrimitiveBVHCache m_pickingBVHCache;
 };
 
 class Q_3DRENDERSHARED_PRIVATE_EXPORT ObjectPickerManager : public Qt3DCore::QResourceManager<
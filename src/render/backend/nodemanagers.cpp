@@ -46,6 +46,7 @@
 #include <Qt3DRender/private/techniquemanager_p.h>
 #include <Qt3DRender/private/armature_p.h>
 #include <Qt3DRender/private/skeleton_p.h>
+#include <Qt3DRender/private/meshgeometrycache_p.h>
 
 
 QT_BEGIN_NAMESPACE
@@ -92,6 +93,7 @@ NodeManagers::NodeManagers()
     , m_jointManager(new JointManager())
     , m_shaderImageManager(new ShaderImageManager())
     , m_pickingProxyManager(new PickingProxyManager())
+    , m_meshGeometryCache(new MeshGeometryCache())
 {
 }
 
@@ -136,6 +138,7 @@ NodeManagers::~NodeManagers()
     delete m_skeletonManager;
     delete m_jointManager;
     delete m_shaderImageManager;
+    delete m_meshGeometryCache;
 }
 
 template<>
@@ -103,6 +103,7 @@ class SkeletonManager;
 class JointManager;
 class ShaderImageManager;
 class PickingProxyManager;
+class MeshGeometryCache;
 
 class FrameGraphNode;
 class Entity;
@@ -220,6 +221,7 @@ public:
     inline JointManager *jointManager() const noexcept { return m_jointManager; }
     inline ShaderImageManager *shaderImageManager() const noexcept { return m_shaderImageManager; }
     inline PickingProxyManager *pickingProxyManager() const noexcept { return m_pickingProxyManager; }
+    inline MeshGeometryCache *meshGeometryCache() const noexcept { return m_meshGeometryCache; }
 
 private:
     CameraManager *m_cameraManager;
@@ -259,6 +261,7 @@ private:
     JointManager *m_jointManager;
     ShaderImageManager *m_shaderImageManager;
     PickingProxyManager *m_pickingProxyManager;
+    MeshGeometryCache *m_meshGeometryCache;
 };
 
 // Specializations
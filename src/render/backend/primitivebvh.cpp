@@ -0,0 +1,490 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "primitivebvh_p.h"
+#include <Qt3DRender/private/nodemanagers_p.h>
+#include <Qt3DRender/private/managers_p.h>
+#include <Qt3DRender/private/buffermanager_p.h>
+#include <Qt3DRender/private/geometryrenderer_p.h>
+#include <Qt3DRender/private/pickingproxy_p.h>
+#include <Qt3DRender/private/trianglesvisitor_p.h>
+#include <Qt3DRender/private/segmentsvisitor_p.h>
+#include <Qt3DRender/private/pointsvisitor_p.h>
+
+#include <algorithm>
+#include <limits>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DRender {
+
+using namespace RayCasting;
+
+namespace Render {
+
+namespace {
+
+const int MaxLeafSize = 4;
+const int MaxTraversalDepth = 64;
+
+// Relative enlargement of the world space boxes, it covers the rounding
+// differences between transforming the boxes and transforming the vertices
+const float BoxEpsilon = 1.0e-4f;
+
+int verticesPerPrimitive(PrimitiveBVH::PrimitiveType type)
+{
+    switch (type) {
+    case PrimitiveBVH::Triangles:
+        return 3;
+    case PrimitiveBVH::Segments:
+        return 2;
+    default:
+        return 1;
+    }
+}
+
+bool rayIntersectsBox(const Vector3D &origin, const Vector3D &direction,
+                      const float *center, const float *extent,
+                      float tMin, float tMax)
+{
+    for (int axis = 0; axis < 3; ++axis) {
+        const float o = origin[axis];
+        const float d = direction[axis];
+        const float lo = center[axis] - extent[axis];
+        const float hi = center[axis] + extent[axis];
+
+        if (qAbs(d) < 1.0e-20f) {
+            // Parallel to the slab
+            if (o < lo || o > hi)
+                return false;
+            continue;
+        }
+
+        const float invD = 1.0f / d;
+        float t0 = (lo - o) * invD;
+        float t1 = (hi - o) * invD;
+        if (t0 > t1)
+            std::swap(t0, t1);
+        tMin = qMax(tMin, t0);
+        tMax = qMin(tMax, t1);
+        if (tMin > tMax)
+            return false;
+    }
+    return true;
+}
+
+class TriangleCollector : public TrianglesVisitor
+{
+public:
+    explicit TriangleCollector(NodeManagers *manager) : TrianglesVisitor(manager) { }
+
+    QVector<PrimitiveBVH::Primitive> primitives;
+
+    void visit(uint andx, const Vector3D &a,
+               uint bndx, const Vector3D &b,
+               uint cndx, const Vector3D &c) override
+    {
+        primitives.push_back({ uint(primitives.size()), { andx, bndx, cndx }, { a, b, c } });
+    }
+};
+
+class SegmentCollector : public SegmentsVisitor
+{
+public:
+    explicit SegmentCollector(NodeManagers *manager) : SegmentsVisitor(manager) { }
+
+    QVector<PrimitiveBVH::Primitive> primitives;
+
+    void visit(uint andx, const Vector3D &a,
+               uint bndx, const Vector3D &b) override
+    {
+        primitives.push_back({ uint(primitives.size()), { andx, bndx, 0 }, { a, b, Vector3D() } });
+    }
+};
+
+class PointCollector : public PointsVisitor
+{
+public:
+    explicit PointCollector(NodeManagers *manager) : PointsVisitor(manager) { }
+
+    QVector<PrimitiveBVH::Primitive> primitives;
+
+    void visit(uint ndx, const Vector3D &p) override
+    {
+        primitives.push_back({ uint(primitives.size()), { ndx, 0, 0 }, { p, Vector3D(), Vector3D() } });
+    }
+};
+
+template<typename GeometryProvider>
+PrimitiveBVHCache::Signature signatureFor(NodeManagers *manager,
+                                          const GeometryProvider *provider,
+                                          const Geometry *geometry)
+{
+    PrimitiveBVHCache::Signature signature;
+    signature.primitiveType = int(provider->primitiveType());
+    signature.instanceCount = provider->instanceCount();
+    signature.primitiveRestartEnabled = provider->primitiveRestartEnabled();
+    signature.restartIndexValue = provider->restartIndexValue();
+    signature.geometryRevision = geometry->revision();
+
+    // Same attribute selection as Visitor::visitPrimitives
+    Attribute *positionAttribute = manager->lookupResource<Attribute, AttributeManager>(geometry->boundingPositionAttribute());
+    Attribute *indexAttribute = nullptr;
+    const auto attrIds = geometry->attributes();
+    for (const Qt3DCore::QNodeId attrId : attrIds) {
+        Attribute *attribute = manager->lookupResource<Attribute, AttributeManager>(attrId);
+        if (attribute) {
+            if (!positionAttribute && attribute->name() == Qt3DCore::QAttribute::defaultPositionAttributeName())
+                positionAttribute = attribute;
+            else if (attribute->attributeType() == Qt3DCore::QAttribute::IndexAttribute)
+                indexAttribute = attribute;
+        }
+    }
+
+    if (positionAttribute) {
+        signature.positionAttributeId = positionAttribute->peerId();
+        signature.positionAttributeRevision = positionAttribute->revision();
+        const Buffer *buffer = manager->lookupResource<Buffer, BufferManager>(positionAttribute->bufferId());
+        if (buffer) {
+            signature.positionBufferId = buffer->peerId();
+            signature.positionBufferRevision = buffer->revision();
+        }
+    }
+    if (indexAttribute) {
+        signature.indexAttributeId = indexAttribute->peerId();
+        signature.indexAttributeRevision = indexAttribute->revision();
+        const Buffer *buffer = manager->lookupResource<Buffer, BufferManager>(indexAttribute->bufferId());
+        if (buffer) {
+            signature.indexBufferId = buffer->peerId();
+            signature.indexBufferRevision = buffer->revision();
+        }
+    }
+    return signature;
+}
+
+} // anonymous
+
+PrimitiveBVH::PrimitiveBVH(PrimitiveType type)
+    : m_type(type)
+{
+}
+
+void PrimitiveBVH::build(QVector<Primitive> primitives)
+{
+    m_primitives = std::move(primitives);
+    m_nodes.clear();
+
+    const int primitiveCount = m_primitives.size();
+    if (primitiveCount == 0)
+        return;
+
+    // Per primitive bounds (min xyz, max xyz) and centroids
+    const int vertexCount = verticesPerPrimitive(m_type);
+    QVector<float> bounds(primitiveCount * 6);
+    QVector<float> centroids(primitiveCount * 3);
+    QVector<int> order(primitiveCount);
+    float *b = bounds.data();
+    float *c = centroids.data();
+    for (int i = 0; i < primitiveCount; ++i) {
+        const Primitive &primitive = m_primitives.at(i);
+        for (int axis = 0; axis < 3; ++axis) {
+            float lo = primitive.vertices[0][axis];
+            float hi = lo;
+            for (int v = 1; v < vertexCount; ++v) {
+                lo = qMin(lo, primitive.vertices[v][axis]);
+                hi = qMax(hi, primitive.vertices[v][axis]);
+            }
+            b[i * 6 + axis] = lo;
+            b[i * 6 + axis + 3] = hi;
+            c[i * 3 + axis] = 0.5f * (lo + hi);
+        }
+        order[i] = i;
+    }
+
+    m_nodes.reserve(2 * (primitiveCount / MaxLeafSize + 1));
+    buildNode(order, 0, primitiveCount, bounds, centroids);
+
+    // Store the primitives in leaf order
+    QVector<Primitive> sortedPrimitives;
+    sortedPrimitives.reserve(primitiveCount);
+    for (const int i : qAsConst(order))
+        sortedPrimitives.push_back(m_primitives.at(i));
+    m_primitives = std::move(sortedPrimitives);
+}
+
+int PrimitiveBVH::buildNode(QVector<int> &order, int begin, int end,
+                            const QVector<float> &bounds, const QVector<float> &centroids)
+{
+    Node node;
+    float centroidMin[3];
+    float centroidMax[3];
+    for (int axis = 0; axis < 3; ++axis) {
+        node.min[axis] = centroidMin[axis] = std::numeric_limits<float>::max();
+        node.max[axis] = centroidMax[axis] = -std::numeric_limits<float>::max();
+    }
+
+    const float *b = bounds.constData();
+    const float *c = centroids.constData();
+    for (int i = begin; i < end; ++i) {
+        const int primitive = order.at(i);
+        for (int axis = 0; axis < 3; ++axis) {
+            node.min[axis] = qMin(node.min[axis], b[primitive * 6 + axis]);
+            node.max[axis] = qMax(node.max[axis], b[primitive * 6 + axis + 3]);
+            centroidMin[axis] = qMin(centroidMin[axis], c[primitive * 3 + axis]);
+            centroidMax[axis] = qMax(centroidMax[axis], c[primitive * 3 + axis]);
+        }
+    }
+
+    const int nodeIndex = m_nodes.size();
+    node.first = begin;
+    node.count = end - begin;
+    m_nodes.push_back(node);
+
+    if (end - begin <= MaxLeafSize)
+        return nodeIndex;
+
+    // Median split along the axis where the centroids spread the most,
+    // which keeps the depth logarithmic whatever the primitive layout
+    int splitAxis = 0;
+    for (int axis = 1; axis < 3; ++axis) {
+        if (centroidMax[axis] - centroidMin[axis] > centroidMax[splitAxis] - centroidMin[splitAxis])
+            splitAxis = axis;
+    }
+    const int middle = begin + (end - begin) / 2;
+    std::nth_element(order.begin() + begin, order.begin() + middle, order.begin() + end,
+                     [c, splitAxis] (int a, int b) {
+        return c[a * 3 + splitAxis] < c[b * 3 + splitAxis];
+    });
+
+    buildNode(order, begin, middle, bounds, centroids);
+    const int rightChild = buildNode(order, middle, end, bounds, centroids);
+    m_nodes[nodeIndex].first = rightChild;
+    m_nodes[nodeIndex].count = 0;
+    return nodeIndex;
+}
+
+QVector<const PrimitiveBVH::Primitive *> PrimitiveBVH::intersectingPrimitives(const QRay3D &ray,
+                                                                              const Matrix4x4 &worldMatrix,
+                                                                              float tolerance) const
+{
+    QVector<const Primitive *> candidates;
+    if (m_nodes.isEmpty())
+        return candidates;
+
+    // Translation and linear part of the world matrix, a model space box of
+    // center c and half extents e maps to a world space box of center
+    // origin + M * c and half extents |M| * e
+    const Vector3D origin = worldMatrix * Vector3D(0.0f, 0.0f, 0.0f);
+    const Vector3D axes[3] = {
+        worldMatrix * Vector3D(1.0f, 0.0f, 0.0f) - origin,
+        worldMatrix * Vector3D(0.0f, 1.0f, 0.0f) - origin,
+        worldMatrix * Vector3D(0.0f, 0.0f, 1.0f) - origin
+    };
+
+    // Triangles are intersected against the ray segment, lines against the
+    // half line starting at the ray origin and points against the whole line
+    float tMin = -std::numeric_limits<float>::max();
+    float tMax = std::numeric_limits<float>::max();
+    if (m_type != Points)
+        tMin = 0.0f;
+    if (m_type == Triangles)
+        tMax = ray.distance();
+
+    const Vector3D rayOrigin = ray.origin();
+    const Vector3D rayDirection = ray.direction();
+
+    int stack[MaxTraversalDepth];
+    int stackSize = 0;
+    stack[stackSize++] = 0;
+
+    while (stackSize > 0) {
+        const int nodeIndex = stack[--stackSize];
+        const Node &node = m_nodes.at(nodeIndex);
+
+        float modelCenter[3];
+        float modelExtent[3];
+        for (int axis = 0; axis < 3; ++axis) {
+            modelCenter[axis] = 0.5f * (node.min[axis] + node.max[axis]);
+            modelExtent[axis] = 0.5f * (node.max[axis] - node.min[axis]);
+        }
+
+        float center[3];
+        float extent[3];
+        for (int axis = 0; axis < 3; ++axis) {
+            center[axis] = origin[axis]
+                    + axes[0][axis] * modelCenter[0]
+                    + axes[1][axis] * modelCenter[1]
+                    + axes[2][axis] * modelCenter[2];
+            extent[axis] = qAbs(axes[0][axis]) * modelExtent[0]
+                    + qAbs(axes[1][axis]) * modelExtent[1]
+                    + qAbs(axes[2][axis]) * modelExtent[2];
+            extent[axis] += tolerance + BoxEpsilon * (qAbs(center[axis]) + extent[axis]);
+        }
+
+        if (!rayIntersectsBox(rayOrigin, rayDirection, center, extent, tMin, tMax))
+            continue;
+
+        if (node.count > 0) {
+            for (int i = node.first, e = node.first + node.count; i < e; ++i)
+                candidates.push_back(&m_primitives.at(i));
+        } else {
+            Q_ASSERT(stackSize + 2 <= MaxTraversalDepth);
+            stack[stackSize++] = node.first;
+            stack[stackSize++] = nodeIndex + 1;
+        }
+    }
+
+    std::sort(candidates.begin(), candidates.end(),
+              [] (const Primitive *a, const Primitive *b) { return a->index < b->index; });
+    return candidates;
+}
+
+bool PrimitiveBVHCache::Signature::operator==(const Signature &other) const
+{
+    return primitiveType == other.primitiveType
+            && instanceCount == other.instanceCount
+            && primitiveRestartEnabled == other.primitiveRestartEnabled
+            && restartIndexValue == other.restartIndexValue
+            && geometryRevision == other.geometryRevision
+            && positionAttributeId == other.positionAttributeId
+            && positionAttributeRevision == other.positionAttributeRevision
+            && positionBufferId == other.positionBufferId
+            && positionBufferRevision == other.positionBufferRevision
+            && indexAttributeId == other.indexAttributeId
+            && indexAttributeRevision == other.indexAttributeRevision
+            && indexBufferId == other.indexBufferId
+            && indexBufferRevision == other.indexBufferRevision;
+}
+
+PrimitiveBVHCache::PrimitiveBVHCache()
+    : m_buildCount(0)
+{
+}
+
+template<typename GeometryProvider>
+QSharedPointer<const PrimitiveBVH> PrimitiveBVHCache::lookup(NodeManagers *manager,
+                                                             const GeometryProvider *provider,
+                                                             PrimitiveBVH::PrimitiveType type)
+{
+    const Geometry *geometry = manager->lookupResource<Geometry, GeometryManager>(provider->geometryId());
+    if (!geometry)
+        return {};
+
+    const Signature signature = signatureFor(manager, provider, geometry);
+    const EntryKey key(provider->geometryId(), signature.primitiveType);
+    {
+        QMutexLocker lock(&m_mutex);
+        const auto it = m_entries[type].constFind(key);
+        if (it != m_entries[type].cend() && it->signature == signature)
+            return it->bvh;
+    }
+
+    // Built without holding the lock as the picking functors run
+    // concurrently. At worst two threads build the same BVH once.
+    QSharedPointer<PrimitiveBVH> bvh = QSharedPointer<PrimitiveBVH>::create(type);
+    switch (type) {
+    case PrimitiveBVH::Triangles: {
+        TriangleCollector collector(manager);
+        collector.apply(provider, provider->peerId());
+        bvh->build(std::move(collector.primitives));
+        break;
+    }
+    case PrimitiveBVH::Segments: {
+        SegmentCollector collector(manager);
+        collector.apply(provider, provider->peerId());
+        bvh->build(std::move(collector.primitives));
+        break;
+    }
+    case PrimitiveBVH::Points: {
+        PointCollector collector(manager);
+        collector.apply(provider, provider->peerId());
+        bvh->build(std::move(collector.primitives));
+        break;
+    }
+    default:
+        Q_UNREACHABLE();
+        break;
+    }
+    m_buildCount.ref();
+
+    QMutexLocker lock(&m_mutex);
+    m_entries[type].insert(key, { signature, bvh });
+    return bvh;
+}
+
+QSharedPointer<const PrimitiveBVH> PrimitiveBVHCache::bvh(NodeManagers *manager,
+                                                          const GeometryRenderer *renderer,
+                                                          PrimitiveBVH::PrimitiveType type)
+{
+    return lookup(manager, renderer, type);
+}
+
+QSharedPointer<const PrimitiveBVH> PrimitiveBVHCache::bvh(NodeManagers *manager,
+                                                          const PickingProxy *proxy,
+                                                          PrimitiveBVH::PrimitiveType type)
+{
+    return lookup(manager, proxy, type);
+}
+
+void PrimitiveBVHCache::removeStaleEntries(GeometryManager *manager)
+{
+    QMutexLocker lock(&m_mutex);
+    for (auto &entries : m_entries) {
+        for (auto it = entries.begin(); it != entries.end();) {
+            if (manager->lookupResource(it.key().first) == nullptr)
+                it = entries.erase(it);
+            else
+                ++it;
+        }
+    }
+}
+
+int PrimitiveBVHCache::size() const
+{
+    QMutexLocker lock(&m_mutex);
+    int count = 0;
+    for (const auto &entries : m_entries)
+        count += entries.size();
+    return count;
+}
+
+} // namespace Render
+} // namespace Qt3DRender
+
+QT_END_NAMESPACE
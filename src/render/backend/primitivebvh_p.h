@@ -0,0 +1,196 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QT3DRENDER_RENDER_PRIMITIVEBVH_P_H
+#define QT3DRENDER_RENDER_PRIMITIVEBVH_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of other Qt classes.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <Qt3DCore/qnodeid.h>
+#include <Qt3DCore/private/vector3d_p.h>
+#include <Qt3DCore/private/matrix4x4_p.h>
+#include <Qt3DRender/private/qt3drender_global_p.h>
+#include <Qt3DRender/private/qray3d_p.h>
+#include <QtCore/QAtomicInt>
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtCore/QPair>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QVector>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DRender {
+namespace Render {
+
+class NodeManagers;
+class GeometryManager;
+class GeometryRenderer;
+class PickingProxy;
+
+// Bounding volume hierarchy over the primitives of a geometry, expressed in
+// model space. It is used by the picking visitors to only test the
+// primitives whose bounds are crossed by the picking ray.
+class Q_3DRENDERSHARED_PRIVATE_EXPORT PrimitiveBVH
+{
+public:
+    enum PrimitiveType {
+        Triangles = 0,
+        Segments,
+        Points,
+        PrimitiveTypeCount
+    };
+
+    struct Primitive
+    {
+        uint index;             // Order in which the visitor reported it
+        uint vertexIndices[3];
+        Vector3D vertices[3];
+    };
+
+    struct Node
+    {
+        float min[3];
+        float max[3];
+        int first;  // Leaf: first primitive, inner node: right child (left child is the next node)
+        int count;  // Leaf: number of primitives, inner node: 0
+    };
+
+    explicit PrimitiveBVH(PrimitiveType type = Triangles);
+
+    void build(QVector<Primitive> primitives);
+
+    PrimitiveType primitiveType() const { return m_type; }
+    const QVector<Primitive> &primitives() const { return m_primitives; }
+    const QVector<Node> &nodes() const { return m_nodes; }
+
+    // Returns the primitives whose bounds, placed in world space with
+    // worldMatrix and enlarged by tolerance, are crossed by the ray. They
+    // are sorted by index, which is the order a full visit would use.
+    QVector<const Primitive *> intersectingPrimitives(const RayCasting::QRay3D &ray,
+                                                      const Matrix4x4 &worldMatrix,
+                                                      float tolerance) const;
+
+private:
+    int buildNode(QVector<int> &order, int begin, int end,
+                  const QVector<float> &bounds, const QVector<float> &centroids);
+
+    PrimitiveType m_type;
+    QVector<Primitive> m_primitives;
+    QVector<Node> m_nodes;
+};
+
+// Lazily builds and caches one PrimitiveBVH per geometry and primitive type,
+// and per primitive type of the renderers drawing the geometry.
+// Entries are rebuilt when the geometry, its position or index attributes or
+// their buffers changed since the BVH was built.
+class Q_3DRENDERSHARED_PRIVATE_EXPORT PrimitiveBVHCache
+{
+public:
+    PrimitiveBVHCache();
+
+    QSharedPointer<const PrimitiveBVH> bvh(NodeManagers *manager,
+                                           const GeometryRenderer *renderer,
+                                           PrimitiveBVH::PrimitiveType type);
+    QSharedPointer<const PrimitiveBVH> bvh(NodeManagers *manager,
+                                           const PickingProxy *proxy,
+                                           PrimitiveBVH::PrimitiveType type);
+
+    // Drops the entries of geometries which have been destroyed
+    void removeStaleEntries(GeometryManager *manager);
+
+    int size() const;
+    int buildCount() const { return m_buildCount.loadRelaxed(); }
+
+    struct Signature
+    {
+        int primitiveType = -1;
+        int instanceCount = 0;
+        bool primitiveRestartEnabled = false;
+        int restartIndexValue = -1;
+        uint geometryRevision = 0;
+        Qt3DCore::QNodeId positionAttributeId;
+        uint positionAttributeRevision = 0;
+        Qt3DCore::QNodeId positionBufferId;
+        uint positionBufferRevision = 0;
+        Qt3DCore::QNodeId indexAttributeId;
+        uint indexAttributeRevision = 0;
+        Qt3DCore::QNodeId indexBufferId;
+        uint indexBufferRevision = 0;
+
+        bool operator==(const Signature &other) const;
+        bool operator!=(const Signature &other) const { return !(*this == other); }
+    };
+
+private:
+    template<typename GeometryProvider>
+    QSharedPointer<const PrimitiveBVH> lookup(NodeManagers *manager,
+                                              const GeometryProvider *provider,
+                                              PrimitiveBVH::PrimitiveType type);
+
+    struct Entry
+    {
+        Signature signature;
+        QSharedPointer<const PrimitiveBVH> bvh;
+    };
+
+    // Geometry id and QGeometryRenderer::PrimitiveType, so that renderers
+    // drawing a shared geometry differently don't evict each other's BVH
+    using EntryKey = QPair<Qt3DCore::QNodeId, int>;
+
+    mutable QMutex m_mutex;
+    QHash<EntryKey, Entry> m_entries[PrimitiveBVH::PrimitiveTypeCount];
+    QAtomicInt m_buildCount;
+};
+
+} // namespace Render
+} // namespace Qt3DRender
+
+QT_END_NAMESPACE
+
+#endif // QT3DRENDER_RENDER_PRIMITIVEBVH_P_H
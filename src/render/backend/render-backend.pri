@@ -35,7 +35,11 @@ HEADERS += \
     $$PWD/visitorutils_p.h \
     $$PWD/segmentsvisitor_p.h \
     $$PWD/pointsvisitor_p.h \
-    $$PWD/apishadermanager_p.h
+    $$PWD/apishadermanager_p.h \
+    $$PWD/boundingspherearray_p.h \
+    $$PWD/layermaskarray_p.h \
+    $$PWD/primitivebvh_p.h \
+    $$PWD/entityspatialindex_p.h
 
 SOURCES += \
     $$PWD/renderthread.cpp \
@@ -64,4 +68,8 @@ SOURCES += \
     $$PWD/offscreensurfacehelper.cpp \
     $$PWD/resourceaccessor.cpp \
     $$PWD/segmentsvisitor.cpp \
-    $$PWD/pointsvisitor.cpp
+    $$PWD/pointsvisitor.cpp \
+    $$PWD/boundingspherearray.cpp \
+    $$PWD/layermaskarray.cpp \
+    $$PWD/primitivebvh.cpp \
+    $$PWD/entityspatialindex.cpp
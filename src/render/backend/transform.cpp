@@ -40,8 +40,13 @@
 #include "transform_p.h"
 
 #include <Qt3DCore/private/qchangearbiter_p.h>
+#include <Qt3DCore/private/qnode_p.h>
 #include <Qt3DCore/qtransform.h>
 #include <Qt3DCore/private/qtransform_p.h>
+#include <Qt3DCore/qentity.h>
+#include <Qt3DRender/private/entity_p.h>
+#include <Qt3DRender/private/managers_p.h>
+#include <Qt3DRender/private/nodemanagers_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -93,24 +98,52 @@ void Transform::syncFromFrontEnd(const QNode *frontEnd, bool firstTime)
     if (!transform)
         return;
 
-    bool dirty = m_rotation != transform->rotation();
-    m_rotation = transform->rotation();
-    dirty |= m_scale != transform->scale3D();
-    m_scale = transform->scale3D();
-    dirty |= m_translation != transform->translation();
-    m_translation = transform->translation();
+    // Skip reading the components when only QNode or QComponent properties changed
+    static const quint64 componentProperties = QNodePrivate::propertyDirtyMask(
+                Qt3DCore::QTransform::staticMetaObject,
+                { "matrix", "scale", "scale3D", "rotation", "translation",
+                  "rotationX", "rotationY", "rotationZ" });
+
+    bool dirty = false;
+    if (firstTime || QNodePrivate::get(frontEnd)->hasDirtyProperties(componentProperties)) {
+        dirty = m_rotation != transform->rotation();
+        m_rotation = transform->rotation();
+        dirty |= m_scale != transform->scale3D();
+        m_scale = transform->scale3D();
+        dirty |= m_translation != transform->translation();
+        m_translation = transform->translation();
+    }
 
     if (dirty || firstTime) {
         updateMatrix();
         markDirty(AbstractRenderer::TransformDirty);
+        markEntitiesWorldTransformDirty(frontEnd);
     }
 
-    if (transform->isEnabled() != isEnabled())
+    if (transform->isEnabled() != isEnabled()) {
         markDirty(AbstractRenderer::TransformDirty);
+        markEntitiesWorldTransformDirty(frontEnd);
+    }
 
     BackendNode::syncFromFrontEnd(frontEnd, firstTime);
 }
 
+// A transform can be shared, flag every entity referencing it so that
+// UpdateWorldTransformJob only revisits the affected branches
+void Transform::markEntitiesWorldTransformDirty(const QNode *frontEnd)
+{
+    NodeManagers *managers = m_renderer != nullptr ? m_renderer->nodeManagers() : nullptr;
+    if (managers == nullptr)
+        return;
+
+    const auto entities = static_cast<const Qt3DCore::QTransform *>(frontEnd)->entities();
+    for (const Qt3DCore::QEntity *entity : entities) {
+        Entity *backendEntity = managers->renderNodesManager()->lookupResource(entity->id());
+        if (backendEntity != nullptr)
+            backendEntity->markWorldTransformDirty();
+    }
+}
+
 void Transform::updateMatrix()
 {
     QMatrix4x4 m;
@@ -80,6 +80,7 @@ public:
 
 private:
     void updateMatrix();
+    void markEntitiesWorldTransformDirty(const Qt3DCore::QNode *frontEnd);
     Matrix4x4 m_transformMatrix;
     QQuaternion m_rotation;
     QVector3D m_scale;
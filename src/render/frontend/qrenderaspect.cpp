@@ -425,6 +425,7 @@ void QRenderAspectPrivate::registerBackendTypes()
 
     q->registerBackendType<Qt3DCore::QEntity>(QSharedPointer<Render::RenderEntityFunctor>::create(m_renderer, m_nodeManagers));
     q->registerBackendType<Qt3DCore::QTransform>(QSharedPointer<Render::NodeFunctor<Render::Transform, Render::TransformManager> >::create(m_renderer));
+    registerThreadSafeBackendSync(Qt3DCore::QTransform::staticMetaObject);
 
     q->registerBackendType<Qt3DRender::QCameraLens>(QSharedPointer<Render::CameraLensFunctor>::create(m_renderer, q));
     q->registerBackendType<QLayer>(QSharedPointer<Render::NodeFunctor<Render::Layer, Render::LayerManager> >::create(m_renderer));
@@ -670,18 +671,21 @@ QVector<Qt3DCore::QAspectJobPtr> QRenderAspect::jobsToExecute(qint64 time)
         d->m_updateLevelOfDetailJob->setFrameGraphRoot(d->m_renderer->frameGraphRoot());
 
         // Launch skeleton loader jobs once all loading jobs have completed.
+        // Skeleton files are loaded in the background.
         const QVector<Render::HSkeleton> skeletonsToLoad =
                 manager->skeletonManager()->takeDirtySkeletons(Render::SkeletonManager::SkeletonDataDirty);
         for (const auto &skeletonHandle : skeletonsToLoad) {
             auto loadSkeletonJob = Render::LoadSkeletonJobPtr::create(skeletonHandle);
             loadSkeletonJob->setNodeManagers(manager);
+            const Render::Skeleton *skeleton = manager->skeletonManager()->data(skeletonHandle);
+            if (skeleton != nullptr && skeleton->dataType() == Render::Skeleton::File)
+                loadSkeletonJob->setSkeletonFile(skeleton);
             d->m_syncLoadingJobs->addDependency(loadSkeletonJob);
             jobs.append(loadSkeletonJob);
         }
 
-        // TO DO: Have 2 jobs queue
-        // One for urgent jobs that are mandatory for the rendering of a frame
-        // Another for jobs that can span across multiple frames (Scene/Mesh loading)
+        // Scene and mesh file loading jobs run in the background lane of the
+        // scheduler and can span across multiple frames
         const QVector<Render::LoadSceneJobPtr> sceneJobs = manager->sceneManager()->takePendingSceneLoaderJobs();
         for (const Render::LoadSceneJobPtr &job : sceneJobs) {
             job->setNodeManagers(d->m_nodeManagers);
@@ -869,9 +873,11 @@ QVector<Qt3DCore::QAspectJobPtr> QRenderAspectPrivate::createGeometryRendererJob
 
     for (const QNodeId &geoRendererId : dirtyGeometryRenderers) {
         Render::HGeometryRenderer geometryRendererHandle = geomRendererManager->lookupHandle(geoRendererId);
-        if (!geometryRendererHandle.isNull()) {
+        Render::GeometryRenderer *geometryRenderer = geomRendererManager->data(geometryRendererHandle);
+        if (geometryRenderer != nullptr && geometryRenderer->geometryFactory()) {
             auto job = Render::LoadGeometryJobPtr::create(geometryRendererHandle);
             job->setNodeManagers(m_nodeManagers);
+            job->setGeometryFactory(geoRendererId, geometryRenderer->geometryFactoryForLoading());
             dirtyGeometryRendererJobs.push_back(job);
         }
     }
@@ -50,6 +50,7 @@ namespace Render {
 
 Armature::Armature()
     : BackendNode(Qt3DCore::QBackendNode::ReadOnly)
+    , m_skinningPaletteDirty(true)
 {
 }
 
@@ -60,12 +61,17 @@ void Armature::syncFromFrontEnd(const QNode *frontEnd, bool firstTime)
     if (!node)
         return;
 
-    m_skeletonId = node->skeleton() ? node->skeleton()->id() : QNodeId{};
+    const QNodeId skeletonId = node->skeleton() ? node->skeleton()->id() : QNodeId{};
+    if (skeletonId != m_skeletonId) {
+        m_skeletonId = skeletonId;
+        m_skinningPaletteDirty = true;
+    }
 }
 
 void Armature::cleanup()
 {
     m_skeletonId = Qt3DCore::QNodeId();
+    m_skinningPaletteDirty = true;
     setEnabled(false);
 }
 
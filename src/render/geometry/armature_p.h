@@ -72,9 +72,14 @@ public:
     UniformValue &skinningPaletteUniform() { return m_skinningPaletteUniform; }
     const UniformValue &skinningPaletteUniform() const { return m_skinningPaletteUniform; }
 
+    // True if the uniform hasn't been filled from the current skeleton yet
+    bool isSkinningPaletteDirty() const { return m_skinningPaletteDirty; }
+    void unsetSkinningPaletteDirty() { m_skinningPaletteDirty = false; }
+
 private:
     Qt3DCore::QNodeId m_skeletonId;
     UniformValue m_skinningPaletteUniform;
+    bool m_skinningPaletteDirty;
 };
 
 } // namespace Render
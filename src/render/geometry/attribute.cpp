@@ -59,6 +59,7 @@ Attribute::Attribute()
     , m_divisor(0)
     , m_attributeType(QAttribute::VertexAttribute)
     , m_attributeDirty(false)
+    , m_revision(0)
 {
 }
 
@@ -128,6 +129,9 @@ void Attribute::syncFromFrontEnd(const QNode *frontEnd, bool firstTime)
         m_attributeDirty = true;
     }
 
+    if (m_attributeDirty)
+        ++m_revision;
+
     markDirty(AbstractRenderer::AllDirty);
 }
 
@@ -81,6 +81,8 @@ public:
     inline uint divisor() const { return m_divisor; }
     inline Qt3DCore::QAttribute::AttributeType attributeType() const { return m_attributeType; }
     inline bool isDirty() const { return m_attributeDirty; }
+    // Incremented every time the attribute layout changes
+    inline uint revision() const { return m_revision; }
     void unsetDirty();
 
 private:
@@ -95,6 +97,7 @@ private:
     uint m_divisor;
     Qt3DCore::QAttribute::AttributeType m_attributeType;
     bool m_attributeDirty;
+    uint m_revision;
 };
 
 } // namespace Render
@@ -50,6 +50,7 @@ Buffer::Buffer()
     : BackendNode(QBackendNode::ReadWrite)
     , m_usage(Qt3DCore::QBuffer::StaticDraw)
     , m_bufferDirty(false)
+    , m_revision(0)
     , m_access(Qt3DCore::QBuffer::Write)
     , m_manager(nullptr)
 {
@@ -82,6 +83,7 @@ void Buffer::updateDataFromGPUToCPU(QByteArray data)
     // Note: when this is called, data is what's currently in GPU memory
     // so m_data shouldn't be reuploaded
     m_data = data;
+    ++m_revision;
 }
 
 void Buffer::forceDataUpload()
@@ -101,6 +103,9 @@ void Buffer::syncFromFrontEnd(const Qt3DCore::QNode *frontEnd, bool firstTime)
     if (!node)
         return;
 
+    const bool wasDirty = m_bufferDirty;
+    m_bufferDirty = false;
+
     if (firstTime && m_manager != nullptr) {
         m_manager->addBufferReference(peerId());
         m_bufferDirty = true;
@@ -139,6 +144,11 @@ void Buffer::syncFromFrontEnd(const Qt3DCore::QNode *frontEnd, bool firstTime)
             const_cast<Qt3DCore::QBuffer *>(node)->setProperty("QT3D_updateData", {});
         }
     }
+
+    if (m_bufferDirty)
+        ++m_revision;
+    m_bufferDirty |= wasDirty;
+
     markDirty(AbstractRenderer::BuffersDirty);
 }
 
@@ -81,6 +81,8 @@ public:
     inline QByteArray data() const { return m_data; }
     inline QVector<Qt3DCore::QBufferUpdate> &pendingBufferUpdates() { return m_bufferUpdates; }
     inline bool isDirty() const { return m_bufferDirty; }
+    // Incremented every time the CPU side data changes
+    inline uint revision() const { return m_revision; }
     inline Qt3DCore::QBuffer::AccessType access() const { return m_access; }
     void unsetDirty();
 
@@ -91,6 +93,7 @@ private:
     QByteArray m_data;
     QVector<Qt3DCore::QBufferUpdate> m_bufferUpdates;
     bool m_bufferDirty;
+    uint m_revision;
     Qt3DCore::QBuffer::AccessType m_access;
     BufferManager *m_manager;
 };
@@ -54,6 +54,7 @@ namespace Render {
 Geometry::Geometry()
     : BackendNode(ReadWrite)
     , m_geometryDirty(false)
+    , m_revision(0)
 {
 }
 
@@ -82,9 +83,10 @@ void Geometry::syncFromFrontEnd(const QNode *frontEnd, bool firstTime)
 
     QNodeIdVector attribs = qIdsForNodes(node->attributes());
     std::sort(std::begin(attribs), std::end(attribs));
-    if (m_attributes != attribs) {
+    if (firstTime || m_attributes != attribs) {
         m_attributes = attribs;
         m_geometryDirty = true;
+        ++m_revision;
     }
 
     if ((node->boundingVolumePositionAttribute() && node->boundingVolumePositionAttribute()->id() != m_boundingPositionAttribute) ||
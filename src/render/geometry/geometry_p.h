@@ -72,6 +72,8 @@ public:
 
     inline QVector<Qt3DCore::QNodeId> attributes() const { return m_attributes; }
     inline bool isDirty() const { return m_geometryDirty; }
+    // Incremented every time the list of attributes changes
+    inline uint revision() const { return m_revision; }
     inline Qt3DCore::QNodeId boundingPositionAttribute() const { return m_boundingPositionAttribute; }
     void unsetDirty();
 
@@ -83,6 +85,7 @@ public:
 private:
     QVector<Qt3DCore::QNodeId> m_attributes;
     bool m_geometryDirty;
+    uint m_revision;
     Qt3DCore::QNodeId m_boundingPositionAttribute;
     QVector3D m_min;
     QVector3D m_max;
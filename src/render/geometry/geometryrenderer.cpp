@@ -165,14 +165,11 @@ void GeometryRenderer::syncFromFrontEnd(const QNode *frontEnd, bool firstTime)
     markDirty(AbstractRenderer::GeometryDirty);
 }
 
-GeometryFunctorResult GeometryRenderer::executeFunctor()
+// Returns the functor with what it needs to load set up. Called on the aspect
+// thread so that the functor can then be executed while this node is synced
+Qt3DCore::QGeometryFactoryPtr GeometryRenderer::geometryFactoryForLoading() const
 {
-    Q_ASSERT(m_geometryFactory);
-
-    // What kind of functor are we dealing with?
-    const bool isQMeshFunctor = m_geometryFactory->id() == Qt3DCore::functorTypeId<MeshLoaderFunctor>();
-
-    if (isQMeshFunctor) {
+    if (m_geometryFactory && m_geometryFactory->id() == Qt3DCore::functorTypeId<MeshLoaderFunctor>()) {
         QSharedPointer<MeshLoaderFunctor> meshLoader = qSharedPointerCast<MeshLoaderFunctor>(m_geometryFactory);
 
         // Set the aspect engine to allow remote downloads
@@ -184,9 +181,18 @@ GeometryFunctorResult GeometryRenderer::executeFunctor()
             meshLoader->setDownloaderService(services->service<Qt3DCore::QDownloadHelperService>(Qt3DCore::QServiceLocator::DownloadHelperService));
         }
     }
+    return m_geometryFactory;
+}
+
+GeometryFunctorResult GeometryRenderer::executeFunctor(const Qt3DCore::QGeometryFactoryPtr &geometryFactory)
+{
+    Q_ASSERT(geometryFactory);
+
+    // What kind of functor are we dealing with?
+    const bool isQMeshFunctor = geometryFactory->id() == Qt3DCore::functorTypeId<MeshLoaderFunctor>();
 
     // Load geometry
-    QGeometry *geometry = (*m_geometryFactory)();
+    QGeometry *geometry = (*geometryFactory)();
     QMesh::Status meshLoaderStatus = QMesh::None;
 
     // If the geometry is null, then we were either unable to load it (Error)
@@ -200,7 +206,7 @@ GeometryFunctorResult GeometryRenderer::executeFunctor()
 
     // Send Status
     if (isQMeshFunctor) {
-        QSharedPointer<MeshLoaderFunctor> meshLoader = qSharedPointerCast<MeshLoaderFunctor>(m_geometryFactory);
+        QSharedPointer<MeshLoaderFunctor> meshLoader = qSharedPointerCast<MeshLoaderFunctor>(geometryFactory);
         meshLoaderStatus = meshLoader->status();
     }
 
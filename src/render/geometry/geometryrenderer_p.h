@@ -82,7 +82,8 @@ public:
     void cleanup();
     void setManager(GeometryRendererManager *manager);
     void syncFromFrontEnd(const Qt3DCore::QNode *frontEnd, bool firstTime) override;
-    GeometryFunctorResult executeFunctor();
+    Qt3DCore::QGeometryFactoryPtr geometryFactoryForLoading() const;
+    static GeometryFunctorResult executeFunctor(const Qt3DCore::QGeometryFactoryPtr &geometryFactory);
 
     inline Qt3DCore::QNodeId geometryId() const { return m_geometryId; }
     inline int instanceCount() const { return m_instanceCount; }
@@ -319,10 +319,12 @@ GLTFSkeletonLoader::GLTFSkeletonLoader()
 
 bool GLTFSkeletonLoader::load(QIODevice *ioDev)
 {
-    if (Q_UNLIKELY(!setJSON(qLoadGLTF(ioDev->readAll())))) {
+    QByteArray binaryChunk;
+    if (Q_UNLIKELY(!setJSON(qLoadGLTF(ioDev->readAll(), &binaryChunk)))) {
         qCWarning(Jobs, "not a JSON document");
         return false;
     }
+    m_binaryChunk = binaryChunk;
 
     auto file = qobject_cast<QFile*>(ioDev);
     if (file) {
@@ -486,7 +488,8 @@ bool GLTFSkeletonLoader::processJSONBuffer(const QJsonObject &json)
 {
     // Store buffer details and load data into memory
     BufferData buffer(json);
-    buffer.data = resolveLocalData(buffer.path);
+    // The buffer without uri of a .glb file is its BIN chunk
+    buffer.data = buffer.path.isEmpty() ? m_binaryChunk : resolveLocalData(buffer.path);
     if (buffer.data.isEmpty())
         return false;
 
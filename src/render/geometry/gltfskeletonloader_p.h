@@ -170,6 +170,8 @@ private:
 
     QJsonDocument m_json;
     QString m_basePath;
+    // BIN chunk of a .glb file, the data of its buffer without uri
+    QByteArray m_binaryChunk;
     QVector<BufferData> m_bufferDatas;
     QVector<BufferView> m_bufferViews;
     QVector<AccessorData> m_accessors;
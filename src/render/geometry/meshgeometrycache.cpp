@@ -0,0 +1,246 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "meshgeometrycache_p.h"
+
+#include <Qt3DCore/qattribute.h>
+#include <Qt3DCore/qbuffer.h>
+#include <Qt3DCore/qgeometry.h>
+#include <Qt3DRender/private/renderlogging_p.h>
+#include <QVector>
+
+QT_BEGIN_NAMESPACE
+
+using namespace Qt3DCore;
+
+namespace Qt3DRender {
+
+namespace Render {
+
+// What is needed to recreate a loaded QGeometry, the buffer data being
+// implicitly shared with every geometry created from the entry
+struct MeshGeometryCache::Entry
+{
+    struct Attribute
+    {
+        QString name;
+        QAttribute::VertexBaseType vertexBaseType;
+        uint vertexSize;
+        uint count;
+        uint byteStride;
+        uint byteOffset;
+        uint divisor;
+        QAttribute::AttributeType attributeType;
+        int bufferIndex;
+    };
+
+    struct Buffer
+    {
+        QByteArray data;
+        Qt3DCore::QBuffer::UsageType usage;
+        Qt3DCore::QBuffer::AccessType accessType;
+    };
+
+    // Held while loading so that concurrent requests for the same key wait
+    // for the load instead of loading the source again
+    QMutex mutex;
+    bool loaded = false;
+    QVector<Attribute> attributes;
+    QVector<Buffer> buffers;
+    int boundingVolumePositionAttribute = -1;
+
+    void store(const QGeometry *geometry)
+    {
+        QHash<const Qt3DCore::QBuffer *, int> bufferIndices;
+        const QVector<QAttribute *> geometryAttributes = geometry->attributes();
+        attributes.reserve(geometryAttributes.size());
+
+        for (const QAttribute *attribute : geometryAttributes) {
+            int bufferIndex = -1;
+            if (const Qt3DCore::QBuffer *buffer = attribute->buffer()) {
+                auto it = bufferIndices.constFind(buffer);
+                if (it == bufferIndices.cend()) {
+                    it = bufferIndices.insert(buffer, buffers.size());
+                    buffers.push_back({ buffer->data(), buffer->usage(), buffer->accessType() });
+                }
+                bufferIndex = it.value();
+            }
+            if (attribute == geometry->boundingVolumePositionAttribute())
+                boundingVolumePositionAttribute = attributes.size();
+            attributes.push_back({ attribute->name(), attribute->vertexBaseType(),
+                                   attribute->vertexSize(), attribute->count(),
+                                   attribute->byteStride(), attribute->byteOffset(),
+                                   attribute->divisor(), attribute->attributeType(),
+                                   bufferIndex });
+        }
+    }
+
+    QGeometry *instantiate() const
+    {
+        QGeometry *geometry = new QGeometry();
+
+        QVector<Qt3DCore::QBuffer *> geometryBuffers;
+        geometryBuffers.reserve(buffers.size());
+        for (const Buffer &buffer : buffers) {
+            Qt3DCore::QBuffer *geometryBuffer = new Qt3DCore::QBuffer(geometry);
+            geometryBuffer->setUsage(buffer.usage);
+            geometryBuffer->setAccessType(buffer.accessType);
+            geometryBuffer->setData(buffer.data);
+            geometryBuffers.push_back(geometryBuffer);
+        }
+
+        for (int i = 0, m = attributes.size(); i < m; ++i) {
+            const Attribute &attribute = attributes.at(i);
+            QAttribute *geometryAttribute = new QAttribute(geometry);
+            geometryAttribute->setName(attribute.name);
+            geometryAttribute->setVertexBaseType(attribute.vertexBaseType);
+            geometryAttribute->setVertexSize(attribute.vertexSize);
+            geometryAttribute->setCount(attribute.count);
+            geometryAttribute->setByteStride(attribute.byteStride);
+            geometryAttribute->setByteOffset(attribute.byteOffset);
+            geometryAttribute->setDivisor(attribute.divisor);
+            geometryAttribute->setAttributeType(attribute.attributeType);
+            if (attribute.bufferIndex != -1)
+                geometryAttribute->setBuffer(geometryBuffers.at(attribute.bufferIndex));
+            geometry->addAttribute(geometryAttribute);
+            if (i == boundingVolumePositionAttribute)
+                geometry->setBoundingVolumePositionAttribute(geometryAttribute);
+        }
+
+        return geometry;
+    }
+
+    // Data only referenced by the entry means all the geometries sharing it
+    // are gone (or have replaced their data)
+    bool isUsed() const
+    {
+        for (const Buffer &buffer : buffers) {
+            if (!buffer.data.isEmpty() && !buffer.data.isDetached())
+                return true;
+        }
+        return false;
+    }
+};
+
+MeshGeometryCache::MeshGeometryCache()
+{
+}
+
+MeshGeometryCache::~MeshGeometryCache()
+{
+}
+
+QGeometry *MeshGeometryCache::geometry(const Key &key, const Loader &loader)
+{
+    QSharedPointer<Entry> entry;
+    {
+        QMutexLocker lock(&m_mutex);
+        entry = m_entries.value(key);
+        if (entry.isNull()) {
+            removeUnusedEntries();
+            entry.reset(new Entry());
+            m_entries.insert(key, entry);
+        }
+    }
+
+    QMutexLocker entryLock(&entry->mutex);
+    if (entry->loaded) {
+        m_hits.ref();
+        qCDebug(Jobs) << "Mesh geometry cache hit for" << key.source << key.meshName;
+        return entry->instantiate();
+    }
+
+    // Either the first request for key or a previous load failed
+    m_misses.ref();
+    QGeometry *geometry = loader();
+    if (geometry != nullptr) {
+        entry->store(geometry);
+        entry->loaded = true;
+    }
+    return geometry;
+}
+
+// Called with m_mutex locked
+void MeshGeometryCache::removeUnusedEntries()
+{
+    auto it = m_entries.begin();
+    while (it != m_entries.end()) {
+        Entry *entry = it.value().data();
+        // Entries being loaded or instantiated are in use
+        if (entry->mutex.tryLock()) {
+            const bool unused = entry->loaded && !entry->isUsed();
+            entry->mutex.unlock();
+            if (unused) {
+                it = m_entries.erase(it);
+                continue;
+            }
+        }
+        ++it;
+    }
+}
+
+void MeshGeometryCache::clear()
+{
+    QMutexLocker lock(&m_mutex);
+    m_entries.clear();
+    m_hits.storeRelaxed(0);
+    m_misses.storeRelaxed(0);
+}
+
+int MeshGeometryCache::entryCount() const
+{
+    QMutexLocker lock(&m_mutex);
+    return m_entries.size();
+}
+
+int MeshGeometryCache::hitCount() const
+{
+    return m_hits.loadRelaxed();
+}
+
+int MeshGeometryCache::missCount() const
+{
+    return m_misses.loadRelaxed();
+}
+
+} // namespace Render
+
+} // namespace Qt3DRender
+
+QT_END_NAMESPACE
@@ -0,0 +1,138 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QT3DRENDER_RENDER_MESHGEOMETRYCACHE_P_H
+#define QT3DRENDER_RENDER_MESHGEOMETRYCACHE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of other Qt classes.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <Qt3DRender/private/qt3drender_global_p.h>
+#include <QAtomicInt>
+#include <QDateTime>
+#include <QHash>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QString>
+#include <functional>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DCore {
+class QGeometry;
+}
+
+namespace Qt3DRender {
+
+namespace Render {
+
+// Shares the geometry loaded for a QMesh source between all the QMesh
+// instances using the same source and mesh name. Each unique source is
+// loaded once, later requests get a new QGeometry whose buffers share the
+// loaded data. Entries only live as long as some geometry still uses their
+// data. Used concurrently by the geometry loading jobs.
+class Q_3DRENDERSHARED_PRIVATE_EXPORT MeshGeometryCache
+{
+public:
+    struct Key
+    {
+        QString source;
+        QString meshName;
+        // Local files
+        QDateTime lastModified;
+        qint64 size = -1;
+        // Downloaded data
+        QByteArray contentHash;
+
+        bool operator==(const Key &other) const
+        {
+            return source == other.source &&
+                    meshName == other.meshName &&
+                    lastModified == other.lastModified &&
+                    size == other.size &&
+                    contentHash == other.contentHash;
+        }
+    };
+
+    using Loader = std::function<Qt3DCore::QGeometry *()>;
+
+    MeshGeometryCache();
+    ~MeshGeometryCache();
+
+    // Returns the geometry for key, only calling loader if the geometry of key
+    // isn't cached yet. The caller takes ownership of the returned geometry.
+    Qt3DCore::QGeometry *geometry(const Key &key, const Loader &loader);
+
+    void clear();
+
+    int entryCount() const;
+    int hitCount() const;
+    int missCount() const;
+
+private:
+    struct Entry;
+
+    void removeUnusedEntries();
+
+    mutable QMutex m_mutex;
+    QHash<Key, QSharedPointer<Entry>> m_entries;
+    QAtomicInt m_hits;
+    QAtomicInt m_misses;
+};
+
+inline uint qHash(const MeshGeometryCache::Key &key, uint seed = 0)
+{
+    return ::qHash(key.source, seed) ^ ::qHash(key.meshName, seed) ^ ::qHash(key.size, seed);
+}
+
+} // namespace Render
+
+} // namespace Qt3DRender
+
+QT_END_NAMESPACE
+
+#endif // QT3DRENDER_RENDER_MESHGEOMETRYCACHE_P_H
@@ -48,6 +48,7 @@
 #include <QMimeDatabase>
 #include <QMimeType>
 #include <QtCore/QBuffer>
+#include <QCryptographicHash>
 #include <Qt3DRender/QRenderAspect>
 #include <Qt3DCore/QAspectEngine>
 #include <Qt3DCore/private/qscene_p.h>
@@ -55,6 +56,7 @@
 #include <Qt3DCore/private/qurlhelper_p.h>
 #include <Qt3DRender/private/qrenderaspect_p.h>
 #include <Qt3DRender/private/nodemanagers_p.h>
+#include <Qt3DRender/private/meshgeometrycache_p.h>
 #include <Qt3DRender/private/qgeometryloaderinterface_p.h>
 #include <Qt3DRender/private/renderlogging_p.h>
 #include <Qt3DRender/private/qgeometryloaderfactory_p.h>
@@ -339,6 +341,33 @@ Qt3DCore::QGeometry *MeshLoaderFunctor::operator()()
             ext << finfo.suffix();
     }
 
+    // Meshes sharing the same source and mesh name share the loaded geometry
+    Render::MeshGeometryCache *cache = m_nodeManagers != nullptr ? m_nodeManagers->meshGeometryCache() : nullptr;
+    if (cache == nullptr)
+        return loadGeometry(ext);
+
+    Render::MeshGeometryCache::Key key;
+    key.source = m_sourcePath.toString();
+    key.meshName = m_meshName;
+    if (m_sourceData.isEmpty()) {
+        const QFileInfo finfo(Qt3DCore::QUrlHelper::urlToLocalFileOrQrc(m_sourcePath));
+        key.lastModified = finfo.lastModified();
+        key.size = finfo.size();
+    } else {
+        key.contentHash = QCryptographicHash::hash(m_sourceData, QCryptographicHash::Sha1);
+    }
+
+    Qt3DCore::QGeometry *geometry = cache->geometry(key, [this, &ext] { return loadGeometry(ext); });
+    if (geometry != nullptr)
+        m_status = QMesh::Ready;
+    return geometry;
+}
+
+/*!
+ * \internal
+ */
+Qt3DCore::QGeometry *MeshLoaderFunctor::loadGeometry(const QStringList &ext)
+{
     QScopedPointer<QGeometryLoaderInterface> loader;
     for (const QString &e: qAsConst(ext)) {
         loader.reset(qLoadPlugin<QGeometryLoaderInterface, QGeometryLoaderFactory>(geometryLoader(), e));
@@ -123,6 +123,8 @@ public :
     QT3D_FUNCTOR(MeshLoaderFunctor)
 
 private:
+    Qt3DCore::QGeometry *loadGeometry(const QStringList &ext);
+
     Qt3DCore::QNodeId m_mesh;
     QUrl m_sourcePath;
     QString m_meshName;
@@ -48,6 +48,7 @@
 #include <Qt3DCore/private/qskeleton_p.h>
 #include <Qt3DCore/private/qskeletonloader_p.h>
 #include <Qt3DCore/private/qmath3d_p.h>
+#include <Qt3DCore/private/matrix4x4_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -58,6 +59,7 @@ namespace Render {
 
 Skeleton::Skeleton()
     : BackendNode(Qt3DCore::QBackendNode::ReadWrite)
+    , m_skinningPaletteDirty(true)
     , m_status(Qt3DCore::QSkeletonLoader::NotReady)
     , m_createJoints(false)
     , m_dataType(Unknown)
@@ -153,12 +155,14 @@ void Skeleton::clearData()
     m_skeletonData.localPoses.clear();
     m_skeletonData.jointNames.clear();
     m_skeletonData.jointIndices.clear();
+    m_skinningPaletteDirty = true;
 }
 
 void Skeleton::setSkeletonData(const SkeletonData &data)
 {
     m_skeletonData = data;
     m_skinningPalette.resize(m_skeletonData.joints.size());
+    m_skinningPaletteDirty = true;
 }
 
 // Called from UpdateSkinningPaletteJob
@@ -169,24 +173,58 @@ void Skeleton::setLocalPose(HJoint jointHandle, const Qt3DCore::Sqt &localPose)
     const int jointIndex = m_skeletonData.jointIndices.value(jointHandle, -1);
     Q_ASSERT(jointIndex != -1);
     m_skeletonData.localPoses[jointIndex] = localPose;
+    m_skinningPaletteDirty = true;
 }
 
-QVector<QMatrix4x4> Skeleton::calculateSkinningMatrixPalette()
+namespace {
+
+// Same result as Sqt::toMatrix() without the successive QMatrix4x4
+// translate(), rotate() and scale() calls
+Q_ALWAYS_INLINE Matrix4x4 sqtToMatrix(const Sqt &sqt)
+{
+    const float x = sqt.rotation.x();
+    const float y = sqt.rotation.y();
+    const float z = sqt.rotation.z();
+    const float w = sqt.rotation.scalar();
+    const float xx = x * x;
+    const float yy = y * y;
+    const float zz = z * z;
+    const float xy = x * y;
+    const float xz = x * z;
+    const float yz = y * z;
+    const float xw = x * w;
+    const float yw = y * w;
+    const float zw = z * w;
+
+    const QVector3D &s = sqt.scale;
+    const QVector3D &t = sqt.translation;
+    return Matrix4x4((1.0f - 2.0f * (yy + zz)) * s.x(), 2.0f * (xy - zw) * s.y(), 2.0f * (xz + yw) * s.z(), t.x(),
+                     2.0f * (xy + zw) * s.x(), (1.0f - 2.0f * (xx + zz)) * s.y(), 2.0f * (yz - xw) * s.z(), t.y(),
+                     2.0f * (xz - yw) * s.x(), 2.0f * (yz + xw) * s.y(), (1.0f - 2.0f * (xx + yy)) * s.z(), t.z(),
+                     0.0f, 0.0f, 0.0f, 1.0f);
+}
+
+} // anonymous
+
+// Called from UpdateSkinningPaletteJob, possibly concurrently for different
+// skeletons. The palette is written in place.
+const QVector<QMatrix4x4> &Skeleton::calculateSkinningMatrixPalette()
 {
     const QVector<Sqt> &localPoses = m_skeletonData.localPoses;
     QVector<JointInfo> &joints = m_skeletonData.joints;
-    for (int i = 0; i < m_skeletonData.joints.size(); ++i) {
+    m_skinningPalette.resize(joints.size());
+    QMatrix4x4 *palette = m_skinningPalette.data();
+    for (int i = 0; i < joints.size(); ++i) {
         // Calculate the global pose of this joint
         JointInfo &joint = joints[i];
-        if (joint.parentIndex == -1) {
-            joint.globalPose = localPoses[i].toMatrix();
-        } else {
-            JointInfo &parentJoint = joints[joint.parentIndex];
-            joint.globalPose = parentJoint.globalPose * localPoses[i].toMatrix();
-        }
+        Matrix4x4 globalPose = sqtToMatrix(localPoses[i]);
+        if (joint.parentIndex != -1)
+            globalPose = Matrix4x4(joints[joint.parentIndex].globalPose) * globalPose;
+        joint.globalPose = convertToQMatrix4x4(globalPose);
 
-        m_skinningPalette[i] = joint.globalPose * joint.inverseBindPose;
+        palette[i] = convertToQMatrix4x4(globalPose * Matrix4x4(joint.inverseBindPose));
     }
+    m_skinningPaletteDirty = false;
     return m_skinningPalette;
 }
 
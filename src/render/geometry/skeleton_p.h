@@ -110,7 +110,10 @@ public:
 
     // Called from jobs
     void setLocalPose(HJoint jointHandle, const Qt3DCore::Sqt &localPose);
-    QVector<QMatrix4x4> calculateSkinningMatrixPalette();
+    const QVector<QMatrix4x4> &calculateSkinningMatrixPalette();
+    const QVector<QMatrix4x4> &skinningPalette() const { return m_skinningPalette; }
+    // True if the local poses or joints changed since the palette was calculated
+    bool isSkinningPaletteDirty() const { return m_skinningPaletteDirty; }
 
     void clearData();
     void setSkeletonData(const SkeletonData &data);
@@ -125,6 +128,7 @@ public:
 
 private:
     QVector<QMatrix4x4> m_skinningPalette;
+    bool m_skinningPaletteDirty;
 
     // QSkeletonLoader Properties
     QUrl m_source;
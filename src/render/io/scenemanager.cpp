@@ -71,11 +71,13 @@ void SceneManager::addSceneData(const QUrl &source,
         newJob->setData(data);
 
     // We cannot run two jobs that use the same scene loader plugin
-    // in two different threads at the same time
-    if (!m_pendingJobs.isEmpty())
-        newJob->addDependency(m_pendingJobs.last());
+    // in two different threads at the same time. The previous job may
+    // still be loading in the background from an earlier frame.
+    if (!m_lastJob.isNull())
+        newJob->addDependency(m_lastJob);
 
     m_pendingJobs.push_back(newJob);
+    m_lastJob = newJob;
 }
 
 QVector<LoadSceneJobPtr> SceneManager::takePendingSceneLoaderJobs()
@@ -103,6 +103,7 @@ public:
 private:
     Qt3DCore::QDownloadHelperService *m_service;
     QVector<LoadSceneJobPtr> m_pendingJobs;
+    QWeakPointer<Qt3DCore::QAspectJob> m_lastJob;
     QVector<SceneDownloaderPtr> m_pendingDownloads;
 };
 
@@ -43,6 +43,8 @@
 #include <Qt3DCore/qboundingvolume.h>
 #include <Qt3DCore/qabstractfrontendnodemanager.h>
 #include <Qt3DCore/private/qgeometry_p.h>
+#include <Qt3DCore/private/qnodebatchlookup_p.h>
+#include <Qt3DCore/private/boundingvolumekernels_p.h>
 #include <Qt3DRender/private/nodemanagers_p.h>
 #include <Qt3DRender/private/entity_p.h>
 #include <Qt3DRender/private/renderlogging_p.h>
@@ -87,6 +89,29 @@ public:
                bool primitiveRestartEnabled,
                int primitiveRestartIndex)
     {
+        if (!indexAttribute
+                && positionAttribute->vertexBaseType() == QAttribute::Float
+                && positionAttribute->vertexSize() >= 3) {
+            // Non indexed positions, point clouds in particular, are processed
+            // with kernels giving the same results as the visitors below
+            Buffer *buffer = m_manager->lookupResource<Buffer, BufferManager>(positionAttribute->bufferId());
+            if (!buffer)
+                return false;
+            const QByteArray data = buffer->data();
+            const uint byteStride = positionAttribute->byteStride();
+            const float *coordinates = BufferTypeInfo::castToType<QAttribute::Float>(data, positionAttribute->byteOffset());
+            QVector3D center;
+            float radius = -1.f;
+            if (!BoundingVolumeKernels::computeBoundingVolume(coordinates,
+                                                              byteStride ? byteStride / sizeof(float) : 3,
+                                                              uint(drawVertexCount),
+                                                              m_min, m_max, center, radius))
+                return false;
+
+            m_volume = Qt3DRender::Render::Sphere(Vector3D(center), radius);
+            return !m_volume.isNull();
+        }
+
         FindExtremePoints findExtremePoints(m_manager);
         if (!findExtremePoints.apply(positionAttribute, indexAttribute, drawVertexCount,
                                      primitiveRestartEnabled, primitiveRestartIndex))
@@ -471,8 +496,19 @@ void CalculateBoundingVolumeJob::run()
 void CalculateBoundingVolumeJob::postFrame(QAspectEngine *aspectEngine)
 {
     Q_UNUSED(aspectEngine)
-    for (Geometry *backend : qAsConst(m_updatedGeometries)) {
-        Qt3DCore::QGeometry *node = qobject_cast<Qt3DCore::QGeometry *>(m_frontEndNodeManager->lookupNode(backend->peerId()));
+    if (m_updatedGeometries.isEmpty())
+        return;
+
+    QVector<Qt3DCore::QNodeId> ids;
+    ids.reserve(m_updatedGeometries.size());
+    for (Geometry *backend : qAsConst(m_updatedGeometries))
+        ids.push_back(backend->peerId());
+    // Extent change handlers may delete geometries we are yet to update
+    Qt3DCore::QNodeBatchLookup nodes(m_frontEndNodeManager, ids);
+
+    for (int i = 0, m = nodes.size(); i < m; ++i) {
+        Geometry *backend = m_updatedGeometries.at(i);
+        Qt3DCore::QGeometry *node = qobject_cast<Qt3DCore::QGeometry *>(nodes.node(i));
         if (!node)
             continue;
         Qt3DCore::QGeometryPrivate *dNode = static_cast<Qt3DCore::QGeometryPrivate *>(Qt3DCore::QNodePrivate::get(node));
@@ -74,6 +74,9 @@ void expandWorldBoundingVolume(NodeManagers *manager, Entity *node)
             if (c && c->isEnabled())
                 parentBoundingVolume->expandToContain(*c->worldBoundingVolumeWithChildren());
         }
+
+        BoundingSphereArray *worldSpheres = manager->renderNodesManager()->worldBoundingSpheres();
+        worldSpheres->setSphere(worldSpheres->slotOf(node), *parentBoundingVolume);
     }
 }
 
@@ -104,6 +107,11 @@ void ExpandBoundingVolumeJob::run()
     // TODO: Implement this using a parallel_for
     qCDebug(Jobs) << "Entering" << Q_FUNC_INFO << QThread::currentThread();
     expandWorldBoundingVolume(m_manager, m_node);
+
+    // The spheres are final, refresh the broad phase used by picking,
+    // ray casting and proximity filtering
+    EntityManager *entityManager = m_manager->renderNodesManager();
+    entityManager->spatialIndex()->update(entityManager->worldBoundingSpheres());
     qCDebug(Jobs) << "Exiting" << Q_FUNC_INFO << QThread::currentThread();
 }
 
@@ -43,6 +43,13 @@
 #include <Qt3DRender/private/entity_p.h>
 #include <Qt3DRender/private/job_common_p.h>
 #include <Qt3DRender/private/layerfilternode_p.h>
+#include <Qt3DRender/private/layermaskarray_p.h>
+
+#include <algorithm>
+
+#if QT_CONFIG(concurrent)
+#include <QtConcurrent/QtConcurrent>
+#endif
 
 QT_BEGIN_NAMESPACE
 
@@ -52,6 +59,90 @@ namespace Render {
 
 namespace {
 int layerFilterJobCounter = 0;
+
+const int ParallelLayerFilteringThreshold = 16384;
+
+struct CompiledLayerFilter
+{
+    LayerMask mask;
+    QLayerFilter::FilterMode filterMode;
+};
+
+// Evaluates all the LayerFilters at once on each entity, which is the same as
+// chaining the filters one after the other
+void filterEntityRange(const LayerMaskArray *layerMasks,
+                       const QVector<CompiledLayerFilter> &filters,
+                       int begin, int end,
+                       QVector<Entity *> &filteredEntities)
+{
+    const QVector<Entity *> &entities = layerMasks->entities();
+    const LayerMask *masks = layerMasks->layerMasks();
+
+    for (int i = begin; i < end; ++i) {
+        Entity *entity = entities.at(i);
+        if (!entity->isTreeEnabled())
+            continue;
+
+        bool accepted = true;
+        for (const CompiledLayerFilter &filter : filters) {
+            const LayerMask matchingLayers = masks[i] & filter.mask;
+            switch (filter.filterMode) {
+            case QLayerFilter::AcceptAnyMatchingLayers:
+                accepted = matchingLayers.any();
+                break;
+            case QLayerFilter::AcceptAllMatchingLayers:
+                accepted = matchingLayers == filter.mask;
+                break;
+            case QLayerFilter::DiscardAnyMatchingLayers:
+                accepted = matchingLayers.none();
+                break;
+            case QLayerFilter::DiscardAllMatchingLayers:
+                accepted = matchingLayers != filter.mask;
+                break;
+            default:
+                Q_UNREACHABLE();
+            }
+            if (!accepted)
+                break;
+        }
+
+        if (accepted)
+            filteredEntities.push_back(entity);
+    }
+}
+
+#if QT_CONFIG(concurrent)
+struct SlotRange
+{
+    int begin;
+    int end;
+};
+
+struct FilterRangeFunctor
+{
+    const LayerMaskArray *layerMasks;
+    QVector<CompiledLayerFilter> filters;
+
+    // This define is required to work with QtConcurrent
+    typedef QVector<Entity *> result_type;
+    QVector<Entity *> operator ()(const SlotRange &range)
+    {
+        QVector<Entity *> filteredEntities;
+        filteredEntities.reserve(range.end - range.begin);
+        filterEntityRange(layerMasks, filters, range.begin, range.end, filteredEntities);
+        return filteredEntities;
+    }
+};
+
+struct ReduceFilteredEntitiesFunctor
+{
+    void operator ()(QVector<Entity *> &result, const QVector<Entity *> &values)
+    {
+        result += values;
+    }
+};
+#endif
+
 } // anonymous
 
 FilterLayerEntityJob::FilterLayerEntityJob()
@@ -66,6 +157,11 @@ void FilterLayerEntityJob::run()
 {
 
     m_filteredEntities.clear();
+
+    // The layer masks are sorted by Entity address, no need to sort afterwards
+    if (hasLayerFilter() && filterLayerMasks())
+        return;
+
     if (hasLayerFilter()) // LayerFilter set -> filter
         filterLayerAndEntity();
     else // No LayerFilter set -> retrieve all
@@ -75,6 +171,62 @@ void FilterLayerEntityJob::run()
     std::sort(m_filteredEntities.begin(), m_filteredEntities.end());
 }
 
+// Filters using the layer masks computed by UpdateEntityLayersJob. Returns
+// false if these can't be used, either because entities were added or removed
+// since they were computed or because a Layer has no bit assigned.
+bool FilterLayerEntityJob::filterLayerMasks()
+{
+    EntityManager *entityManager = m_manager->renderNodesManager();
+    const LayerMaskArray *layerMasks = entityManager->layerMasks();
+    if (!layerMasks->isUpToDate(entityManager))
+        return false;
+
+    FrameGraphManager *frameGraphManager = m_manager->frameGraphManager();
+    LayerManager *layerManager = m_manager->layerManager();
+
+    QVector<CompiledLayerFilter> filters;
+    filters.reserve(m_layerFilterIds.size());
+    for (const Qt3DCore::QNodeId layerFilterId : qAsConst(m_layerFilterIds)) {
+        LayerFilterNode *layerFilter = static_cast<LayerFilterNode *>(frameGraphManager->lookupNode(layerFilterId));
+        CompiledLayerFilter filter { LayerMask(), layerFilter->filterMode() };
+
+        // Layers which are not active/enabled are left out
+        const Qt3DCore::QNodeIdVector layerIds = layerFilter->layerIds();
+        for (const Qt3DCore::QNodeId layerId : layerIds) {
+            const Layer *backendLayer = layerManager->lookupResource(layerId);
+            if (backendLayer == nullptr || !backendLayer->isEnabled())
+                continue;
+            if (backendLayer->maskIndex() < 0)
+                return false;
+            filter.mask.set(backendLayer->maskIndex());
+        }
+        filters.push_back(filter);
+    }
+
+    const int entityCount = layerMasks->size();
+
+#if QT_CONFIG(concurrent)
+    if (entityCount >= ParallelLayerFilteringThreshold) {
+        const int chunkCount = QThread::idealThreadCount();
+        const int chunkSize = (entityCount + chunkCount - 1) / chunkCount;
+        QVector<SlotRange> ranges;
+        for (int begin = 0; begin < entityCount; begin += chunkSize)
+            ranges.push_back({ begin, qMin(begin + chunkSize, entityCount) });
+
+        FilterRangeFunctor functor { layerMasks, filters };
+        ReduceFilteredEntitiesFunctor reduceFunctor;
+        m_filteredEntities = QtConcurrent::blockingMappedReduced<QVector<Entity *>>(
+                    ranges, functor, reduceFunctor,
+                    QtConcurrent::OrderedReduce | QtConcurrent::SequentialReduce);
+        return true;
+    }
+#endif
+
+    m_filteredEntities.reserve(entityCount);
+    filterEntityRange(layerMasks, filters, 0, entityCount, m_filteredEntities);
+    return true;
+}
+
 // We accept the entity if it contains any of the layers that are in the layer filter
 void FilterLayerEntityJob::filterAcceptAnyMatchingLayers(Entity *entity,
                                                          const Qt3DCore::QNodeIdVector &layerIds)
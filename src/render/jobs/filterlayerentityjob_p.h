@@ -86,6 +86,7 @@ public:
     void filterDiscardAllMatchingLayers(Entity *entity, const Qt3DCore::QNodeIdVector &layerIds);
 
 private:
+    bool filterLayerMasks();
     void filterLayerAndEntity();
     void selectAllEntities();
 
@@ -59,10 +59,10 @@ void FilterProximityDistanceJob::run()
     // otherwise it will be used as the base list of entities to filter
 
     if (hasProximityFilter()) {
-        selectAllEntities();
-        QVector<Entity *> entitiesToFilter = std::move(m_filteredEntities);
+        QVector<Entity *> entitiesToFilter;
         FrameGraphManager *frameGraphManager = m_manager->frameGraphManager();
         EntityManager *entityManager = m_manager->renderNodesManager();
+        bool firstFilter = true;
 
         for (const Qt3DCore::QNodeId proximityFilterId : qAsConst(m_proximityFilterIds)) {
             ProximityFilter *proximityFilter = static_cast<ProximityFilter *>(frameGraphManager->lookupNode(proximityFilterId));
@@ -75,6 +75,14 @@ void FilterProximityDistanceJob::run()
                 m_filteredEntities.clear();
                 return;
             }
+
+            // The first filter selects its base list from the spatial index when possible
+            if (firstFilter) {
+                selectCandidateEntities(proximityFilter->distanceThreshold());
+                entitiesToFilter = std::move(m_filteredEntities);
+                m_filteredEntities.clear();
+                firstFilter = false;
+            }
             // Otherwise we filter
             filterEntities(entitiesToFilter);
 
@@ -101,6 +109,24 @@ void FilterProximityDistanceJob::selectAllEntities()
     }
 }
 
+// Entities whose bounding volume center lies within threshold of the target
+// center are inside the box of half extent threshold around it, so the box
+// query returns a superset of what filterEntities will keep
+void FilterProximityDistanceJob::selectCandidateEntities(float threshold)
+{
+    EntityManager *entityManager = m_manager->renderNodesManager();
+    const BoundingSphereArray *worldSpheres = entityManager->worldBoundingSpheres();
+    const EntitySpatialIndex *spatialIndex = entityManager->spatialIndex();
+
+    if (worldSpheres->size() != entityManager->count() || !spatialIndex->isInSync(worldSpheres)) {
+        selectAllEntities();
+        return;
+    }
+
+    const Sphere *target = m_targetEntity->worldBoundingVolumeWithChildren();
+    m_filteredEntities = spatialIndex->entitiesInBox(target->center(), threshold);
+}
+
 void FilterProximityDistanceJob::filterEntities(const QVector<Entity *> &entitiesToFilter)
 {
     const Sphere *target = m_targetEntity->worldBoundingVolumeWithChildren();
@@ -74,6 +74,7 @@ public:
 
 private:
     void selectAllEntities();
+    void selectCandidateEntities(float threshold);
     void filterEntities(const QVector<Entity *> &entitiesToFilter);
 
     NodeManagers *m_manager;
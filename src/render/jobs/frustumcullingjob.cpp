@@ -44,6 +44,12 @@
 #include <Qt3DRender/private/sphere_p.h>
 #include <Qt3DRender/private/managers_p.h>
 #include <Qt3DRender/private/nodemanagers_p.h>
+#include <Qt3DRender/private/boundingspherearray_p.h>
+
+#include <QThread>
+#if QT_CONFIG(concurrent)
+#include <QtConcurrent/QtConcurrent>
+#endif
 
 QT_BEGIN_NAMESPACE
 
@@ -51,6 +57,127 @@ namespace Qt3DRender {
 
 namespace Render {
 
+namespace {
+
+// Scenes smaller than that are culled on the job's thread only
+const int ParallelCullingSphereThreshold = 16384;
+
+struct CullingPlanes
+{
+    float normalX[6];
+    float normalY[6];
+    float normalZ[6];
+    float d[6];
+};
+
+// Appends the entities of slots [begin, end) whose sphere isn't fully behind one
+// of the planes. Slots are walked in order so the output stays sorted.
+void cullSpheres(const BoundingSphereArray *spheres, const CullingPlanes &planes,
+                 int begin, int end, QVector<Entity *> &visibleEntities)
+{
+    const float *centersX = spheres->centersX();
+    const float *centersY = spheres->centersY();
+    const float *centersZ = spheres->centersZ();
+    const float *radii = spheres->radii();
+    const QVector<Entity *> &entities = spheres->entities();
+
+    int i = begin;
+
+#if QT_CONFIG(qt3d_simd_avx2) && defined(__AVX2__) && defined(QT_COMPILER_SUPPORTS_AVX2)
+    // 8 spheres per iteration
+    for (; i + 8 <= end; i += 8) {
+        const __m256 x = _mm256_loadu_ps(centersX + i);
+        const __m256 y = _mm256_loadu_ps(centersY + i);
+        const __m256 z = _mm256_loadu_ps(centersZ + i);
+        const __m256 negRadius = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(radii + i));
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (int p = 0; p < 6; ++p) {
+            __m256 distance = _mm256_mul_ps(x, _mm256_set1_ps(planes.normalX[p]));
+            distance = _mm256_add_ps(distance, _mm256_mul_ps(y, _mm256_set1_ps(planes.normalY[p])));
+            distance = _mm256_add_ps(distance, _mm256_mul_ps(z, _mm256_set1_ps(planes.normalZ[p])));
+            distance = _mm256_add_ps(distance, _mm256_set1_ps(planes.d[p]));
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, negRadius, _CMP_NLT_UQ));
+        }
+        int mask = _mm256_movemask_ps(inside);
+        while (mask) {
+            const int bit = qCountTrailingZeroBits(quint32(mask));
+            visibleEntities.push_back(entities.at(i + bit));
+            mask &= mask - 1;
+        }
+    }
+#elif QT_CONFIG(qt3d_simd_sse2) && defined(__SSE2__) && defined(QT_COMPILER_SUPPORTS_SSE2)
+    // 4 spheres per iteration
+    for (; i + 4 <= end; i += 4) {
+        const __m128 x = _mm_loadu_ps(centersX + i);
+        const __m128 y = _mm_loadu_ps(centersY + i);
+        const __m128 z = _mm_loadu_ps(centersZ + i);
+        const __m128 negRadius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(radii + i));
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (int p = 0; p < 6; ++p) {
+            __m128 distance = _mm_mul_ps(x, _mm_set1_ps(planes.normalX[p]));
+            distance = _mm_add_ps(distance, _mm_mul_ps(y, _mm_set1_ps(planes.normalY[p])));
+            distance = _mm_add_ps(distance, _mm_mul_ps(z, _mm_set1_ps(planes.normalZ[p])));
+            distance = _mm_add_ps(distance, _mm_set1_ps(planes.d[p]));
+            inside = _mm_and_ps(inside, _mm_cmpnlt_ps(distance, negRadius));
+        }
+        int mask = _mm_movemask_ps(inside);
+        while (mask) {
+            const int bit = qCountTrailingZeroBits(quint32(mask));
+            visibleEntities.push_back(entities.at(i + bit));
+            mask &= mask - 1;
+        }
+    }
+#endif
+
+    // Remainder (or everything when SIMD is disabled)
+    for (; i < end; ++i) {
+        bool inside = true;
+        for (int p = 0; p < 6 && inside; ++p) {
+            const float distance = centersX[i] * planes.normalX[p]
+                    + centersY[i] * planes.normalY[p]
+                    + centersZ[i] * planes.normalZ[p]
+                    + planes.d[p];
+            inside = !(distance < -radii[i]);
+        }
+        if (inside)
+            visibleEntities.push_back(entities.at(i));
+    }
+}
+
+#if QT_CONFIG(concurrent)
+struct SlotRange
+{
+    int begin;
+    int end;
+};
+
+struct CullRangeFunctor
+{
+    const BoundingSphereArray *spheres;
+    CullingPlanes planes;
+
+    // This define is required to work with QtConcurrent
+    typedef QVector<Entity *> result_type;
+    QVector<Entity *> operator ()(const SlotRange &range)
+    {
+        QVector<Entity *> visibleEntities;
+        visibleEntities.reserve(range.end - range.begin);
+        cullSpheres(spheres, planes, range.begin, range.end, visibleEntities);
+        return visibleEntities;
+    }
+};
+
+struct ReduceVisibleEntitiesFunctor
+{
+    void operator ()(QVector<Entity *> &result, const QVector<Entity *> &values)
+    {
+        result += values;
+    }
+};
+#endif
+
+} // anonymous
+
 FrustumCullingJob::FrustumCullingJob()
     : Qt3DCore::QAspectJob()
     , m_root(nullptr)
@@ -77,33 +204,47 @@ void FrustumCullingJob::run()
         Plane(m_viewProjection.row(3) - m_viewProjection.row(2)), // Back
     };
 
-    cullScene(m_root, planes);
-
-    // sort needed for set_intersection in RenderViewBuilder
-    std::sort(m_visibleEntities.begin(), m_visibleEntities.end());
+    cullScene(planes);
 }
 
-void FrustumCullingJob::cullScene(Entity *e, const Plane *planes)
+void FrustumCullingJob::cullScene(const Plane *planes)
 {
-    e->traverse([planes, this](Entity *e) {
-        const Sphere *s = e->worldBoundingVolumeWithChildren();
-
-        // Unrolled loop
-        if (Vector3D::dotProduct(s->center(), planes[0].normal) + planes[0].d < -s->radius())
-            return;
-        if (Vector3D::dotProduct(s->center(), planes[1].normal) + planes[1].d < -s->radius())
-            return;
-        if (Vector3D::dotProduct(s->center(), planes[2].normal) + planes[2].d < -s->radius())
-            return;
-        if (Vector3D::dotProduct(s->center(), planes[3].normal) + planes[3].d < -s->radius())
-            return;
-        if (Vector3D::dotProduct(s->center(), planes[4].normal) + planes[4].d < -s->radius())
-            return;
-        if (Vector3D::dotProduct(s->center(), planes[5].normal) + planes[5].d < -s->radius())
-            return;
-
-        m_visibleEntities.push_back(e);
-    });
+    if (m_root == nullptr || m_manager == nullptr)
+        return;
+
+    CullingPlanes cullingPlanes;
+    for (int p = 0; p < 6; ++p) {
+        cullingPlanes.normalX[p] = planes[p].normal.x();
+        cullingPlanes.normalY[p] = planes[p].normal.y();
+        cullingPlanes.normalZ[p] = planes[p].normal.z();
+        cullingPlanes.d[p] = planes[p].d;
+    }
+
+    // Slots are sorted by Entity address, so the visible entities come out
+    // sorted as needed for set_intersection in RenderViewBuilder
+    const BoundingSphereArray *spheres = m_manager->renderNodesManager()->worldBoundingSpheres();
+    const int sphereCount = spheres->size();
+
+#if QT_CONFIG(concurrent)
+    if (sphereCount >= ParallelCullingSphereThreshold) {
+        // Chunks are multiple of 8 to keep the vectorized loop busy
+        const int chunkCount = QThread::idealThreadCount();
+        const int chunkSize = ((sphereCount / chunkCount) + 7) & ~7;
+        QVector<SlotRange> ranges;
+        for (int begin = 0; begin < sphereCount; begin += chunkSize)
+            ranges.push_back({ begin, qMin(begin + chunkSize, sphereCount) });
+
+        CullRangeFunctor functor { spheres, cullingPlanes };
+        ReduceVisibleEntitiesFunctor reduceFunctor;
+        m_visibleEntities = QtConcurrent::blockingMappedReduced<QVector<Entity *>>(
+                    ranges, functor, reduceFunctor,
+                    QtConcurrent::OrderedReduce | QtConcurrent::SequentialReduce);
+        return;
+    }
+#endif
+
+    m_visibleEntities.reserve(sphereCount);
+    cullSpheres(spheres, cullingPlanes, 0, sphereCount, m_visibleEntities);
 }
 
 } // Render
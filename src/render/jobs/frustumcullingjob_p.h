@@ -101,7 +101,7 @@ private:
         const float d;
     };
 
-    void cullScene(Entity *e, const Plane *planes);
+    void cullScene(const Plane *planes);
     Matrix4x4 m_viewProjection;
     Entity *m_root;
     NodeManagers *m_manager;
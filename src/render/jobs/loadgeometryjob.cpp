@@ -42,7 +42,9 @@
 #include <Qt3DRender/private/geometryrenderermanager_p.h>
 #include <Qt3DRender/private/job_common_p.h>
 #include <Qt3DCore/private/qaspectmanager_p.h>
+#include <Qt3DCore/private/qnodebatchlookup_p.h>
 #include <Qt3DRender/private/qmesh_p.h>
+#include <Qt3DRender/private/qgeometryrenderer_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -56,8 +58,11 @@ public:
     LoadGeometryJobPrivate() {}
     ~LoadGeometryJobPrivate() {}
 
+    bool isBackground() const override;
     void postFrame(Qt3DCore::QAspectManager *manager) override;
 
+    Qt3DCore::QNodeId m_geometryRendererId;
+    Qt3DCore::QGeometryFactoryPtr m_geometryFactory;
     QVector<std::pair<Qt3DCore::QNodeId, GeometryFunctorResult>> m_updates;
 };
 
@@ -73,24 +78,67 @@ LoadGeometryJob::~LoadGeometryJob()
 {
 }
 
+// Captures the functor of the geometry renderer when the job is created, on
+// the aspect thread. The job can then run in the background while the
+// geometry renderer gets synced with its frontend.
+void LoadGeometryJob::setGeometryFactory(Qt3DCore::QNodeId geometryRendererId,
+                                         const Qt3DCore::QGeometryFactoryPtr &geometryFactory)
+{
+    Q_D(LoadGeometryJob);
+    d->m_geometryRendererId = geometryRendererId;
+    d->m_geometryFactory = geometryFactory;
+}
+
 void LoadGeometryJob::run()
 {
     Q_D(LoadGeometryJob);
-    GeometryRenderer *geometryRenderer = m_nodeManagers->geometryRendererManager()->data(m_handle);
-    if (geometryRenderer != nullptr)
-        d->m_updates.push_back({ geometryRenderer->peerId(), geometryRenderer->executeFunctor() });
+    if (!d->m_geometryFactory) {
+        GeometryRenderer *geometryRenderer = m_nodeManagers->geometryRendererManager()->data(m_handle);
+        if (geometryRenderer == nullptr || !geometryRenderer->geometryFactory())
+            return;
+        d->m_geometryRendererId = geometryRenderer->peerId();
+        d->m_geometryFactory = geometryRenderer->geometryFactoryForLoading();
+    }
+    d->m_updates.push_back({ d->m_geometryRendererId, GeometryRenderer::executeFunctor(d->m_geometryFactory) });
+}
+
+// Mesh files are loaded in the background, over as many frames as needed
+bool LoadGeometryJobPrivate::isBackground() const
+{
+    return m_geometryFactory && m_geometryFactory->id() == Qt3DCore::functorTypeId<MeshLoaderFunctor>();
 }
 
 void LoadGeometryJobPrivate::postFrame(Qt3DCore::QAspectManager *manager)
 {
     const auto updates = std::move(m_updates);
-    for (const auto &update : updates) {
-        QGeometryRenderer *gR = static_cast<decltype(gR)>(manager->lookupNode(update.first));
-        const GeometryFunctorResult &result = update.second;
+    if (updates.isEmpty())
+        return;
+
+    QVector<Qt3DCore::QNodeId> ids;
+    ids.reserve(updates.size());
+    for (const auto &update : updates)
+        ids.push_back(update.first);
+    // geometryChanged handlers may delete the renderers that follow
+    Qt3DCore::QNodeBatchLookup nodes(manager, ids);
+
+    for (int i = 0, m = updates.size(); i < m; ++i) {
+        QGeometryRenderer *gR = static_cast<decltype(gR)>(nodes.node(i));
+        const GeometryFunctorResult &result = updates.at(i).second;
+
+        // The node was destroyed or got a different functor while loading,
+        // the job created for the new functor provides the geometry
+        const Qt3DCore::QGeometryFactoryPtr &currentFactory =
+                gR ? static_cast<QGeometryRendererPrivate *>(Qt3DCore::QNodePrivate::get(gR))->m_geometryFactory
+                   : Qt3DCore::QGeometryFactoryPtr();
+        if (!currentFactory || !(*currentFactory == *m_geometryFactory)) {
+            delete result.geometry;
+            continue;
+        }
+
         gR->setGeometry(result.geometry);
 
-        // Set status if gR is a QMesh instance
-        QMesh *mesh = qobject_cast<QMesh *>(gR);
+        // Set status if gR is a QMesh instance still alive
+        QMesh *mesh = qobject_cast<QMesh *>(nodes.node(i));
         if (mesh) {
             QMeshPrivate *dMesh = static_cast<decltype(dMesh)>(Qt3DCore::QNodePrivate::get(mesh));
             dMesh->setStatus(result.status);
@@ -53,6 +53,7 @@
 
 #include <QSharedPointer>
 #include <Qt3DCore/qaspectjob.h>
+#include <Qt3DCore/private/qgeometryfactory_p.h>
 #include <Qt3DRender/private/handle_types_p.h>
 #include <Qt3DRender/private/qt3drender_global_p.h>
 
@@ -72,6 +73,8 @@ public:
     ~LoadGeometryJob();
 
     void setNodeManagers(NodeManagers *nodeManagers) { m_nodeManagers = nodeManagers; }
+    void setGeometryFactory(Qt3DCore::QNodeId geometryRendererId,
+                            const Qt3DCore::QGeometryFactoryPtr &geometryFactory);
 
 protected:
     void run() override;
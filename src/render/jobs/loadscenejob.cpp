@@ -93,10 +93,10 @@ Qt3DCore::QNodeId LoadSceneJob::sceneComponentId() const
 
 void LoadSceneJob::run()
 {
-    // Iterate scene IO handlers until we find one that can handle this file type
+    // Iterate scene IO handlers until we find one that can handle this file type.
+    // This runs in the background: the Scene backend node may be gone already,
+    // postFrame discards the result in that case.
     Qt3DCore::QEntity *sceneSubTree = nullptr;
-    Scene *scene = m_managers->sceneManager()->lookupResource(m_sceneComponent);
-    Q_ASSERT(scene);
 
     // Reset status
     QSceneLoader::Status finalStatus = QSceneLoader::None;
@@ -188,8 +188,14 @@ void LoadSceneJobPrivate::postFrame(Qt3DCore::QAspectManager *manager)
     Q_Q(LoadSceneJob);
     QSceneLoader *node =
             qobject_cast<QSceneLoader *>(manager->lookupNode(q->sceneComponentId()));
-    if (!node)
+
+    // The loader was destroyed or its source changed while the scene was
+    // loading in the background, the job of the new source sets the scene
+    if (!node || node->source() != q->source()) {
+        delete m_sceneSubtree;
+        m_sceneSubtree = nullptr;
         return;
+    }
     Qt3DRender::QSceneLoaderPrivate *dNode =
             static_cast<decltype(dNode)>(Qt3DCore::QNodePrivate::get(node));
 
@@ -79,6 +79,7 @@ public:
     explicit LoadSceneJobPrivate(LoadSceneJob *q): q_ptr(q) {}
     ~LoadSceneJobPrivate() override {}
 
+    bool isBackground() const override { return true; }
     void postFrame(Qt3DCore::QAspectManager *manager) override;
 
     Qt3DCore::QEntity *m_sceneSubtree = nullptr;
@@ -62,10 +62,23 @@ public:
     LoadSkeletonJobPrivate() : m_backendSkeleton(nullptr), m_loadedRootJoint(nullptr) { }
     ~LoadSkeletonJobPrivate() override { }
 
+    bool isBackground() const override { return m_loadsFile; }
     void postFrame(Qt3DCore::QAspectManager *manager) override;
 
     Skeleton *m_backendSkeleton;
     Qt3DCore::QJoint* m_loadedRootJoint;
+
+    // Skeleton file to load, captured on the aspect thread
+    bool m_loadsFile = false;
+    Qt3DCore::QNodeId m_skeletonId;
+    QUrl m_source;
+    QString m_name;
+    bool m_createJoints = false;
+    SkeletonManager *m_skeletonManager = nullptr;
+
+    // Loaded from the file, set on the backend skeleton in postFrame
+    SkeletonData m_skeletonData;
+    Qt3DCore::QSkeletonLoader::Status m_status = Qt3DCore::QSkeletonLoader::NotReady;
 };
 
 LoadSkeletonJob::LoadSkeletonJob(const HSkeleton &handle)
@@ -76,9 +89,30 @@ LoadSkeletonJob::LoadSkeletonJob(const HSkeleton &handle)
     SET_JOB_RUN_STAT_TYPE(this, JobTypes::LoadSkeleton, 0)
 }
 
+// Captures the file of a QSkeletonLoader so that the job loads it in the
+// background, without accessing the backend skeleton until postFrame.
+// Called on the aspect thread.
+void LoadSkeletonJob::setSkeletonFile(const Skeleton *skeleton)
+{
+    Q_D(LoadSkeletonJob);
+    Q_ASSERT(skeleton->dataType() == Skeleton::File);
+    d->m_loadsFile = true;
+    d->m_skeletonId = skeleton->peerId();
+    d->m_source = skeleton->source();
+    d->m_name = skeleton->name();
+    d->m_createJoints = skeleton->createJoints();
+    d->m_skeletonManager = skeleton->skeletonManager();
+    d->m_status = skeleton->status();
+}
+
 void LoadSkeletonJob::run()
 {
     Q_D(LoadSkeletonJob);
+    if (d->m_loadsFile) {
+        loadSkeletonFile();
+        return;
+    }
+
     d->m_backendSkeleton = nullptr;
 
     Skeleton *skeleton = m_nodeManagers->skeletonManager()->data(m_handle);
@@ -90,15 +124,19 @@ void LoadSkeletonJob::run()
 
 void LoadSkeletonJob::loadSkeleton(Skeleton *skeleton)
 {
+    // The data of a file is set on the skeleton in postFrame, as when the
+    // file is loaded in the background
+    if (skeleton->dataType() == Skeleton::File) {
+        setSkeletonFile(skeleton);
+        loadSkeletonFile();
+        return;
+    }
+
     qCDebug(Jobs) << Q_FUNC_INFO << skeleton->source();
     skeleton->clearData();
 
     // Load the data
     switch (skeleton->dataType()) {
-    case Skeleton::File:
-        loadSkeletonFromUrl(skeleton);
-        break;
-
     case Skeleton::Data:
         loadSkeletonFromData(skeleton);
         break;
@@ -107,57 +145,66 @@ void LoadSkeletonJob::loadSkeleton(Skeleton *skeleton)
         Q_UNREACHABLE();
     }
 
+    qCDebug(Jobs) << "Loaded skeleton data:" << *skeleton;
+}
+
+void LoadSkeletonJob::loadSkeletonFile()
+{
+    Q_D(LoadSkeletonJob);
+    qCDebug(Jobs) << Q_FUNC_INFO << d->m_source;
+
+    d->m_skeletonData = SkeletonData();
+    loadSkeletonFromUrl();
+
     // If using a loader inform the frontend of the status change.
     // Don't bother if asked to create frontend joints though. When
     // the backend gets notified of those joints we'll update the
     // status at that point.
-    if (skeleton->dataType() == Skeleton::File && !skeleton->createJoints()) {
-        if (skeleton->jointCount() == 0)
-            skeleton->setStatus(Qt3DCore::QSkeletonLoader::Error);
+    if (!d->m_createJoints) {
+        if (d->m_skeletonData.joints.isEmpty())
+            d->m_status = Qt3DCore::QSkeletonLoader::Error;
         else
-            skeleton->setStatus(Qt3DCore::QSkeletonLoader::Ready);
+            d->m_status = Qt3DCore::QSkeletonLoader::Ready;
     }
-
-    qCDebug(Jobs) << "Loaded skeleton data:" << *skeleton;
 }
 
-void LoadSkeletonJob::loadSkeletonFromUrl(Skeleton *skeleton)
+void LoadSkeletonJob::loadSkeletonFromUrl()
 {
     Q_D(LoadSkeletonJob);
 
     using namespace Qt3DCore;
 
     // TODO: Handle remote files
-    QString filePath = Qt3DCore::QUrlHelper::urlToLocalFileOrQrc(skeleton->source());
+    QString filePath = Qt3DCore::QUrlHelper::urlToLocalFileOrQrc(d->m_source);
     QFileInfo info(filePath);
     if (!info.exists()) {
         qWarning() << "Could not open skeleton file:" << filePath;
-        skeleton->setStatus(Qt3DCore::QSkeletonLoader::Error);
+        d->m_status = QSkeletonLoader::Error;
         return;
     }
 
     QFile file(filePath);
     if (!file.open(QIODevice::ReadOnly)) {
         qWarning() << "Could not open skeleton file:" << filePath;
-        skeleton->setStatus(QSkeletonLoader::Error);
+        d->m_status = QSkeletonLoader::Error;
         return;
     }
 
     // TODO: Make plugin based for more file type support. For now gltf or native
     const QString ext = info.suffix();
     SkeletonData skeletonData;
-    if (ext == QLatin1String("gltf")) {
+    if (ext == QLatin1String("gltf") || ext == QLatin1String("glb")) {
         GLTFSkeletonLoader loader;
         loader.load(&file);
-        skeletonData = loader.createSkeleton(skeleton->name());
+        skeletonData = loader.createSkeleton(d->m_name);
 
         // If the user has requested it, create the frontend nodes for the joints
         // and send them to the (soon to be owning) QSkeletonLoader.
-        if (skeleton->createJoints()) {
+        if (d->m_createJoints) {
             QJoint *rootJoint = createFrontendJoints(skeletonData);
             if (!rootJoint) {
                 qWarning() << "Failed to create frontend joints";
-                skeleton->setStatus(QSkeletonLoader::Error);
+                d->m_status = QSkeletonLoader::Error;
                 return;
             }
 
@@ -178,11 +225,11 @@ void LoadSkeletonJob::loadSkeletonFromUrl(Skeleton *skeleton)
         // TODO: Support native skeleton type
     } else {
         qWarning() << "Unknown skeleton file type:" << ext;
-        skeleton->setStatus(QSkeletonLoader::Error);
+        d->m_status = QSkeletonLoader::Error;
         return;
     }
 
-    skeleton->setSkeletonData(skeletonData);
+    d->m_skeletonData = skeletonData;
 }
 
 void LoadSkeletonJob::loadSkeletonFromData(Skeleton *skeleton)
@@ -271,10 +318,27 @@ void LoadSkeletonJob::processJointHierarchy(Qt3DCore::QNodeId jointId,
 
 void LoadSkeletonJobPrivate::postFrame(Qt3DCore::QAspectManager *manager)
 {
+    using namespace Qt3DCore;
+
+    if (m_loadsFile) {
+        // Drop the loaded data if the skeleton was destroyed, or got a new
+        // source or root joint, while the file was loading
+        Skeleton *skeleton = m_skeletonManager->lookupResource(m_skeletonId);
+        if (!skeleton || skeleton->dataType() != Skeleton::File || skeleton->source() != m_source) {
+            delete m_loadedRootJoint;
+            m_loadedRootJoint = nullptr;
+            return;
+        }
+
+        skeleton->clearData();
+        skeleton->setSkeletonData(m_skeletonData);
+        skeleton->setStatus(m_status);
+        m_backendSkeleton = skeleton;
+        qCDebug(Jobs) << "Loaded skeleton data:" << *skeleton;
+    }
+
     if (!m_backendSkeleton)
         return;
-
-    using namespace Qt3DCore;
     QAbstractSkeleton *node = qobject_cast<QAbstractSkeleton *>(manager->lookupNode(m_backendSkeleton->peerId()));
     if (!node)
         return;
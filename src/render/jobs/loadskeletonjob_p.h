@@ -72,11 +72,13 @@ public:
     explicit LoadSkeletonJob(const HSkeleton &handle);
 
     void setNodeManagers(NodeManagers *nodeManagers) { m_nodeManagers = nodeManagers; }
+    void setSkeletonFile(const Skeleton *skeleton);
 
 protected:
     void run() override;
     void loadSkeleton(Skeleton *skeleton);
-    void loadSkeletonFromUrl(Skeleton *skeleton);
+    void loadSkeletonFile();
+    void loadSkeletonFromUrl();
     void loadSkeletonFromData(Skeleton *skeleton);
     Qt3DCore::QJoint *createFrontendJoints(const SkeletonData &skeletonData) const;
     Qt3DCore::QJoint *createFrontendJoint(const QString &jointName,
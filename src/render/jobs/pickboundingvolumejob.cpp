@@ -42,6 +42,7 @@
 #include "qpicklineevent.h"
 #include "qpickpointevent.h"
 #include <Qt3DCore/private/qaspectmanager_p.h>
+#include <Qt3DCore/private/qnodebatchlookup_p.h>
 #include <Qt3DRender/qobjectpicker.h>
 #include <Qt3DRender/qviewport.h>
 #include <Qt3DRender/qgeometryrenderer.h>
@@ -103,14 +104,25 @@ bool PickBoundingVolumeJobPrivate::isRequired() const
 void PickBoundingVolumeJobPrivate::postFrame(Qt3DCore::QAspectManager *manager)
 {
     using namespace Qt3DCore;
-    QNodeId previousId;
-    QObjectPicker *node = nullptr;
+    if (dispatches.isEmpty())
+        return;
+
+    // Resolve picker, viewport and entity of each dispatch with a single lookup.
+    // The handlers of an event may delete the nodes of the following ones,
+    // which are then resolved again by the batch lookup
+    QVector<QNodeId> ids;
+    ids.reserve(dispatches.size() * 3);
+    for (const auto &res: qAsConst(dispatches)) {
+        QPickEvent *pickEvent = res.resultingEvent.data();
+        ids.push_back(res.pickerId);
+        ids.push_back(res.viewportNodeId);
+        ids.push_back(pickEvent ? QPickEventPrivate::get(pickEvent)->m_entity : QNodeId());
+    }
+    QNodeBatchLookup nodes(manager, ids);
 
-    for (auto res: qAsConst(dispatches)) {
-        if (previousId != res.pickerId) {
-            node = qobject_cast<QObjectPicker *>(manager->lookupNode(res.pickerId));
-            previousId = res.pickerId;
-        }
+    for (int i = 0, m = dispatches.size(); i < m; ++i) {
+        const EventDetails &res = dispatches.at(i);
+        QObjectPicker *node = qobject_cast<QObjectPicker *>(nodes.node(3 * i));
         if (!node)
             continue;
 
@@ -120,8 +132,8 @@ void PickBoundingVolumeJobPrivate::postFrame(Qt3DCore::QAspectManager *manager)
         QPickEvent *pickEvent = res.resultingEvent.data();
         if (pickEvent) {
             QPickEventPrivate *dpickEvent = QPickEventPrivate::get(pickEvent);
-            dpickEvent->m_viewport = static_cast<QViewport *>(manager->lookupNode(res.viewportNodeId));
-            dpickEvent->m_entityPtr = static_cast<QEntity *>(manager->lookupNode(dpickEvent->m_entity));
+            dpickEvent->m_viewport = static_cast<QViewport *>(nodes.node(3 * i + 1));
+            dpickEvent->m_entityPtr = static_cast<QEntity *>(nodes.node(3 * i + 2));
         }
 
         // dispatch event
@@ -140,11 +152,14 @@ void PickBoundingVolumeJobPrivate::postFrame(Qt3DCore::QAspectManager *manager)
             break;
         case QEvent::Enter:
             emit node->entered();
-            dnode->setContainsMouse(true);
+            // The picker may have been destroyed by the entered() handlers
+            if (nodes.node(3 * i))
+                dnode->setContainsMouse(true);
             break;
         case QEvent::Leave:
             dnode->setContainsMouse(false);
-            emit node->exited();
+            if (nodes.node(3 * i))
+                emit node->exited();
             break;
         default: Q_UNREACHABLE();
         }
@@ -305,6 +320,10 @@ bool PickBoundingVolumeJob::runHelper()
             m_renderSettings->faceOrientationPickingMode() != QPickingSettings::FrontFace;
     const float pickWorldSpaceTolerance = m_renderSettings->pickWorldSpaceTolerance();
 
+    // Drop the primitive BVHs of geometries which have been destroyed
+    if (primitivePickingRequested)
+        m_manager->geometryManager()->pickingBVHCache()->removeStaleEntries(m_manager->geometryManager());
+
     // For each mouse event
     for (const auto &event : mouseEvents) {
         m_hoveredPickersToClear = m_hoveredPickers;
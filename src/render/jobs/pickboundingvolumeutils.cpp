@@ -52,6 +52,11 @@
 #include <Qt3DRender/private/segmentsvisitor_p.h>
 #include <Qt3DRender/private/pointsvisitor_p.h>
 #include <Qt3DRender/private/layer_p.h>
+#include <Qt3DRender/private/managers_p.h>
+#include <Qt3DRender/private/primitivebvh_p.h>
+#include <Qt3DRender/private/entityspatialindex_p.h>
+
+#include <QVarLengthArray>
 
 #include <vector>
 #include <algorithm>
@@ -157,6 +162,16 @@ public:
     {
     }
 
+    void visitPrimitives(const QVector<const PrimitiveBVH::Primitive *> &primitives)
+    {
+        for (const PrimitiveBVH::Primitive *p : primitives) {
+            m_triangleIndex = p->index;
+            visit(p->vertexIndices[0], p->vertices[0],
+                  p->vertexIndices[1], p->vertices[1],
+                  p->vertexIndices[2], p->vertices[2]);
+        }
+    }
+
 private:
     const Entity *m_root;
     RayCasting::QRay3D m_ray;
@@ -222,6 +237,15 @@ public:
     {
     }
 
+    void visitPrimitives(const QVector<const PrimitiveBVH::Primitive *> &primitives)
+    {
+        for (const PrimitiveBVH::Primitive *p : primitives) {
+            m_segmentIndex = p->index;
+            visit(p->vertexIndices[0], p->vertices[0],
+                  p->vertexIndices[1], p->vertices[1]);
+        }
+    }
+
 private:
     const Entity *m_root;
     RayCasting::QRay3D m_ray;
@@ -343,6 +367,14 @@ public:
     {
     }
 
+    void visitPrimitives(const QVector<const PrimitiveBVH::Primitive *> &primitives)
+    {
+        for (const PrimitiveBVH::Primitive *p : primitives) {
+            m_pointIndex = p->index;
+            visit(p->vertexIndices[0], p->vertices[0]);
+        }
+    }
+
 private:
     const Entity *m_root;
     RayCasting::QRay3D m_ray;
@@ -382,6 +414,21 @@ void PointCollisionVisitor::visit(uint ndx, const Vector3D &p)
     m_pointIndex++;
 }
 
+// Only visits the primitives whose bounds are crossed by the ray, using the
+// BVH cached for the geometry. Candidates are visited in the same order as a
+// full traversal would, so the hits are identical.
+template<typename CollisionVisitor, typename GeometryProvider>
+void visitIntersectingPrimitives(CollisionVisitor &visitor, NodeManagers *manager,
+                                 const GeometryProvider *provider, const Entity *entity,
+                                 const RayCasting::QRay3D &ray, float tolerance,
+                                 PrimitiveBVH::PrimitiveType type)
+{
+    PrimitiveBVHCache *cache = manager->geometryManager()->pickingBVHCache();
+    const QSharedPointer<const PrimitiveBVH> bvh = cache->bvh(manager, provider, type);
+    if (bvh)
+        visitor.visitPrimitives(bvh->intersectingPrimitives(ray, *entity->worldTransform(), tolerance));
+}
+
 HitList reduceToFirstHit(HitList &result, const HitList &intermediate)
 {
     if (!intermediate.empty()) {
@@ -591,7 +638,7 @@ HitList TriangleCollisionGathererFunctor::pick(const Entity *entity) const
     if (proxy && proxy->isEnabled() && proxy->isValid()) {
         if (rayHitsEntity(entity)) {
             TriangleCollisionVisitor visitor(m_manager, entity, m_ray, m_frontFaceRequested, m_backFaceRequested);
-            visitor.apply(proxy, entity->peerId());
+            visitIntersectingPrimitives(visitor, m_manager, proxy, entity, m_ray, 0.0f, PrimitiveBVH::Triangles);
             result = visitor.hits;
 
             sortHits(result);
@@ -603,7 +650,7 @@ HitList TriangleCollisionGathererFunctor::pick(const Entity *entity) const
 
         if (rayHitsEntity(entity)) {
             TriangleCollisionVisitor visitor(m_manager, entity, m_ray, m_frontFaceRequested, m_backFaceRequested);
-            visitor.apply(gRenderer, entity->peerId());
+            visitIntersectingPrimitives(visitor, m_manager, gRenderer, entity, m_ray, 0.0f, PrimitiveBVH::Triangles);
             result = visitor.hits;
 
             sortHits(result);
@@ -649,7 +696,8 @@ HitList LineCollisionGathererFunctor::pick(const Entity *entity) const
     if (proxy && proxy->isEnabled() && proxy->isValid()) {
         if (rayHitsEntity(entity)) {
             LineCollisionVisitor visitor(m_manager, entity, m_ray, m_pickWorldSpaceTolerance);
-            visitor.apply(proxy, entity->peerId());
+            visitIntersectingPrimitives(visitor, m_manager, proxy, entity, m_ray,
+                                        m_pickWorldSpaceTolerance, PrimitiveBVH::Segments);
             result = visitor.hits;
 
             sortHits(result);
@@ -661,7 +709,8 @@ HitList LineCollisionGathererFunctor::pick(const Entity *entity) const
 
         if (rayHitsEntity(entity)) {
             LineCollisionVisitor visitor(m_manager, entity, m_ray, m_pickWorldSpaceTolerance);
-            visitor.apply(gRenderer, entity->peerId());
+            visitIntersectingPrimitives(visitor, m_manager, gRenderer, entity, m_ray,
+                                        m_pickWorldSpaceTolerance, PrimitiveBVH::Segments);
             result = visitor.hits;
             sortHits(result);
         }
@@ -706,7 +755,8 @@ HitList PointCollisionGathererFunctor::pick(const Entity *entity) const
     if (proxy && proxy->isEnabled() && proxy->isValid() && proxy->primitiveType() != Qt3DCore::QGeometryView::Points) {
         if (rayHitsEntity(entity)) {
             PointCollisionVisitor visitor(m_manager, entity, m_ray, m_pickWorldSpaceTolerance);
-            visitor.apply(proxy, entity->peerId());
+            visitIntersectingPrimitives(visitor, m_manager, proxy, entity, m_ray,
+                                        m_pickWorldSpaceTolerance, PrimitiveBVH::Points);
             result = visitor.hits;
 
             sortHits(result);
@@ -721,7 +771,8 @@ HitList PointCollisionGathererFunctor::pick(const Entity *entity) const
 
         if (rayHitsEntity(entity)) {
             PointCollisionVisitor visitor(m_manager, entity, m_ray, m_pickWorldSpaceTolerance);
-            visitor.apply(gRenderer, entity->peerId());
+            visitIntersectingPrimitives(visitor, m_manager, gRenderer, entity, m_ray,
+                                        m_pickWorldSpaceTolerance, PrimitiveBVH::Points);
             result = visitor.hits;
             sortHits(result);
         }
@@ -751,6 +802,61 @@ bool HierarchicalEntityPicker::collectHits(NodeManagers *manager, Entity *root)
     m_entities.clear();
     m_entityToPriorityTable.clear();
 
+    // Use the scene spatial index as broad phase unless it hasn't caught up
+    // with the entities yet
+    EntityManager *entityManager = manager->renderNodesManager();
+    const BoundingSphereArray *worldSpheres = entityManager->worldBoundingSpheres();
+    if (worldSpheres->size() == entityManager->count()
+            && entityManager->spatialIndex()->isInSync(worldSpheres))
+        collectHitsFromSpatialIndex(manager, root);
+    else
+        collectHitsFromHierarchy(manager, root);
+
+    return !m_hits.empty();
+}
+
+bool HierarchicalEntityPicker::layersAccepted(const Qt3DCore::QNodeIdVector &recursiveLayers,
+                                              const Entity *entity,
+                                              LayerManager *layerManager) const
+{
+    if (m_layerIds.isEmpty())
+        return true;
+
+    // TODO investigate reusing logic from LayerFilter job
+    Qt3DCore::QNodeIdVector filterLayers = recursiveLayers + entity->componentsUuid<Layer>();
+
+    // remove disabled layers
+    filterLayers.erase(std::remove_if(filterLayers.begin(), filterLayers.end(),
+                                      [layerManager](const Qt3DCore::QNodeId layerId) {
+        Layer *layer = layerManager->lookupResource(layerId);
+        return !layer || !layer->isEnabled();
+    }), filterLayers.end());
+
+    std::sort(filterLayers.begin(), filterLayers.end());
+
+    Qt3DCore::QNodeIdVector commonIds;
+    std::set_intersection(m_layerIds.cbegin(), m_layerIds.cend(),
+                          filterLayers.cbegin(), filterLayers.cend(),
+                          std::back_inserter(commonIds));
+
+    switch (m_filterMode) {
+    case QAbstractRayCaster::AcceptAnyMatchingLayers:
+        return !commonIds.empty();
+    case QAbstractRayCaster::AcceptAllMatchingLayers:
+        return commonIds == m_layerIds;
+    case QAbstractRayCaster::DiscardAnyMatchingLayers:
+        return commonIds.empty();
+    case QAbstractRayCaster::DiscardAllMatchingLayers:
+        return !(commonIds == m_layerIds);
+    default:
+        Q_UNREACHABLE();
+        break;
+    }
+    return true;
+}
+
+void HierarchicalEntityPicker::collectHitsFromHierarchy(NodeManagers *manager, Entity *root)
+{
     QRayCastingService rayCasting;
     struct EntityData {
         Entity* entity;
@@ -767,47 +873,7 @@ bool HierarchicalEntityPicker::collectHits(NodeManagers *manager, Entity *root)
         EntityData current = worklist.back();
         worklist.pop_back();
 
-        bool accepted = true;
-        if (m_layerIds.size()) {
-            // TODO investigate reusing logic from LayerFilter job
-            Qt3DCore::QNodeIdVector filterLayers = current.recursiveLayers + current.entity->componentsUuid<Layer>();
-
-            // remove disabled layers
-            filterLayers.erase(std::remove_if(filterLayers.begin(), filterLayers.end(),
-                                              [layerManager](const Qt3DCore::QNodeId layerId) {
-                Layer *layer = layerManager->lookupResource(layerId);
-                return !layer || !layer->isEnabled();
-            }), filterLayers.end());
-
-            std::sort(filterLayers.begin(), filterLayers.end());
-
-            Qt3DCore::QNodeIdVector commonIds;
-            std::set_intersection(m_layerIds.cbegin(), m_layerIds.cend(),
-                                  filterLayers.cbegin(), filterLayers.cend(),
-                                  std::back_inserter(commonIds));
-
-            switch (m_filterMode) {
-            case QAbstractRayCaster::AcceptAnyMatchingLayers: {
-                accepted = !commonIds.empty();
-                break;
-            }
-            case QAbstractRayCaster::AcceptAllMatchingLayers: {
-                accepted = commonIds == m_layerIds;
-                break;
-            }
-            case QAbstractRayCaster::DiscardAnyMatchingLayers: {
-                accepted = commonIds.empty();
-                break;
-            }
-            case QAbstractRayCaster::DiscardAllMatchingLayers: {
-                accepted = !(commonIds == m_layerIds);
-                break;
-            }
-            default:
-                Q_UNREACHABLE();
-                break;
-            }
-        }
+        const bool accepted = layersAccepted(current.recursiveLayers, current.entity, layerManager);
 
         // first pick entry sub-scene-graph
         QCollisionQueryResult::Hit queryResult =
@@ -844,8 +910,74 @@ bool HierarchicalEntityPicker::collectHits(NodeManagers *manager, Entity *root)
             }
         }
     }
+}
 
-    return !m_hits.empty();
+// Same selection as collectHitsFromHierarchy, but only for the entities the
+// spatial index reports along the ray. The state the hierarchy walk carries
+// down (object picker, priority and recursive layers) is rebuilt from the
+// ancestors of each candidate.
+void HierarchicalEntityPicker::collectHitsFromSpatialIndex(NodeManagers *manager, Entity *root)
+{
+    QRayCastingService rayCasting;
+    LayerManager *layerManager = manager->layerManager();
+    const QVector<Entity *> candidates = manager->renderNodesManager()->spatialIndex()->entitiesAlongRay(m_ray);
+
+    QVarLengthArray<Entity *, 16> ancestors;
+    for (Entity *candidate : candidates) {
+        const QCollisionQueryResult::Hit queryResult = rayCasting.query(m_ray, candidate->worldBoundingVolume());
+        if (queryResult.m_distance < 0.f)
+            continue;
+
+        // The walk only reaches entities below root whose ancestors' sub-scene-graph volumes are hit
+        ancestors.clear();
+        Entity *entity = candidate;
+        while (entity != nullptr && entity != root) {
+            ancestors.push_back(entity);
+            entity = entity->parent();
+        }
+        if (entity == nullptr)
+            continue;
+        ancestors.push_back(root);
+
+        bool reachable = true;
+        for (const Entity *ancestor : qAsConst(ancestors)) {
+            if (rayCasting.query(m_ray, ancestor->worldBoundingVolumeWithChildren()).m_distance < 0.f) {
+                reachable = false;
+                break;
+            }
+        }
+        if (!reachable)
+            continue;
+
+        bool hasObjectPicker = !root->componentHandle<ObjectPicker>().isNull();
+        int priority = 0;
+        Qt3DCore::QNodeIdVector recursiveLayers;
+        for (int i = ancestors.size() - 1; i > 0; --i) {
+            if (!m_layerIds.isEmpty()) {
+                const Qt3DCore::QNodeIdVector entityLayers = ancestors.at(i)->componentsUuid<Layer>();
+                for (const Qt3DCore::QNodeId layerId : entityLayers) {
+                    Layer *layer = layerManager->lookupResource(layerId);
+                    if (layer && layer->recursive())
+                        recursiveLayers << layerId;
+                }
+            }
+
+            ObjectPicker *childPicker = ancestors.at(i - 1)->renderComponent<ObjectPicker>();
+            hasObjectPicker |= childPicker != nullptr;
+            if (childPicker)
+                priority = childPicker->priority();
+        }
+
+        if (!(hasObjectPicker || !m_objectPickersRequired))
+            continue;
+        if (!layersAccepted(recursiveLayers, candidate, layerManager))
+            continue;
+
+        m_entities.push_back(candidate);
+        m_hits.push_back(queryResult);
+        // Record entry for entity/priority
+        m_entityToPriorityTable.insert(candidate->peerId(), priority);
+    }
 }
 
 } // PickingUtils
@@ -73,6 +73,7 @@ class Entity;
 class Renderer;
 class FrameGraphNode;
 class NodeManagers;
+class LayerManager;
 
 namespace PickingUtils {
 
@@ -116,6 +117,11 @@ public:
     inline QHash<Qt3DCore::QNodeId, int> entityToPriorityTable() const { return m_entityToPriorityTable; }
 
 private:
+    void collectHitsFromHierarchy(NodeManagers *manager, Entity *root);
+    void collectHitsFromSpatialIndex(NodeManagers *manager, Entity *root);
+    bool layersAccepted(const Qt3DCore::QNodeIdVector &recursiveLayers, const Entity *entity,
+                        LayerManager *layerManager) const;
+
     RayCasting::QRay3D m_ray;
     HitList m_hits;
     QVector<Entity *> m_entities;
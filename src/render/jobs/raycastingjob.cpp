@@ -39,6 +39,7 @@
 
 #include "raycastingjob_p.h"
 #include <Qt3DCore/private/qaspectmanager_p.h>
+#include <Qt3DCore/private/qnodebatchlookup_p.h>
 #include <Qt3DRender/qgeometryrenderer.h>
 #include <Qt3DRender/private/entity_p.h>
 #include <Qt3DRender/private/geometryrenderer_p.h>
@@ -107,14 +108,27 @@ bool RayCastingJobPrivate::isRequired() const
 
 void RayCastingJobPrivate::postFrame(Qt3DCore::QAspectManager *manager)
 {
-    for (auto res: qAsConst(dispatches)) {
-        QAbstractRayCaster *node = qobject_cast<QAbstractRayCaster *>(manager->lookupNode(res.first->peerId()));
+    if (dispatches.isEmpty())
+        return;
+
+    QVector<Qt3DCore::QNodeId> ids;
+    ids.reserve(dispatches.size());
+    for (const auto &res: qAsConst(dispatches))
+        ids.push_back(res.first->peerId());
+    // A hits handler may delete ray casters, including its own
+    Qt3DCore::QNodeBatchLookup nodes(manager, ids);
+
+    for (int i = 0, m = dispatches.size(); i < m; ++i) {
+        const auto &res = dispatches.at(i);
+        QAbstractRayCaster *node = qobject_cast<QAbstractRayCaster *>(nodes.node(i));
         if (!node)
             continue;
 
         QAbstractRayCasterPrivate *d = QAbstractRayCasterPrivate::get(node);
         d->dispatchHits(res.second);
 
+        if (!nodes.node(i))
+            continue;
         if (node->runMode() == QAbstractRayCaster::SingleShot) {
             node->setEnabled(false);
             res.first->setEnabled(false);
@@ -169,6 +183,10 @@ bool RayCastingJob::runHelper()
             m_renderSettings->faceOrientationPickingMode() != QPickingSettings::FrontFace;
     const float pickWorldSpaceTolerance = m_renderSettings->pickWorldSpaceTolerance();
 
+    // Drop the primitive BVHs of geometries which have been destroyed
+    if (primitivePickingRequested)
+        m_manager->geometryManager()->pickingBVHCache()->removeStaleEntries(m_manager->geometryManager());
+
     EntityCasterGatherer gatherer(m_manager);
     gatherer.apply(m_node);
     const EntityCasterGatherer::EntityCasterList &entities = gatherer.m_result;
@@ -44,6 +44,7 @@
 #include <Qt3DRender/private/buffer_p.h>
 #include <Qt3DRender/private/buffermanager_p.h>
 #include <Qt3DCore/private/qaspectmanager_p.h>
+#include <Qt3DCore/private/qnodebatchlookup_p.h>
 #include <Qt3DCore/private/qbuffer_p.h>
 
 QT_BEGIN_NAMESPACE
@@ -111,15 +112,26 @@ void SendBufferCaptureJobPrivate::postFrame(Qt3DCore::QAspectManager *aspectMana
 {
     QMutexLocker locker(&m_mutex);
     const QVector<QPair<Qt3DCore::QNodeId, QByteArray>> pendingSendBufferCaptures = std::move(m_buffersToNotify);
-    for (const auto &bufferDataPair : pendingSendBufferCaptures) {
-        Qt3DCore::QBuffer *frontendBuffer = static_cast<decltype(frontendBuffer)>(aspectManager->lookupNode(bufferDataPair.first));
+    if (pendingSendBufferCaptures.isEmpty())
+        return;
+
+    QVector<Qt3DCore::QNodeId> ids;
+    ids.reserve(pendingSendBufferCaptures.size());
+    for (const auto &bufferDataPair : pendingSendBufferCaptures)
+        ids.push_back(bufferDataPair.first);
+    // dataChanged/dataAvailable handlers may delete buffers
+    Qt3DCore::QNodeBatchLookup nodes(aspectManager, ids);
+
+    for (int i = 0, m = pendingSendBufferCaptures.size(); i < m; ++i) {
+        Qt3DCore::QBuffer *frontendBuffer = static_cast<decltype(frontendBuffer)>(nodes.node(i));
         if (!frontendBuffer)
             continue;
         Qt3DCore::QBufferPrivate *dFrontend = static_cast<decltype(dFrontend)>(Qt3DCore::QNodePrivate::get(frontendBuffer));
         // Calling frontendBuffer->setData would result in forcing a sync against the backend
         // which isn't necessary
-        dFrontend->setData(bufferDataPair.second);
-        Q_EMIT frontendBuffer->dataAvailable();
+        dFrontend->setData(pendingSendBufferCaptures.at(i).second);
+        if (nodes.node(i))
+            Q_EMIT frontendBuffer->dataAvailable();
     }
 }
 
@@ -86,6 +86,31 @@ void UpdateEntityLayersJob::run()
             }
         }
     }
+
+    // Assign a bit to each Layer
+    const QVector<HLayer> layerHandles = layerManager->activeHandles();
+    int maskIndex = 0;
+    for (const HLayer &handle : layerHandles) {
+        Layer *layer = layerManager->data(handle);
+        layer->setMaskIndex(maskIndex < MaxLayerMaskSize ? maskIndex++ : -1);
+    }
+
+    // Compute the layer masks of all entities, layers without a bit are left
+    // out. FilterLayerEntityJob falls back to comparing ids when filtering on
+    // such a layer.
+    LayerMaskArray *layerMasks = entityManager->layerMasks();
+    layerMasks->updateSlots(entityManager);
+    const QVector<Entity *> &entities = layerMasks->entities();
+    for (int i = 0, m = entities.size(); i < m; ++i) {
+        LayerMask mask;
+        const Qt3DCore::QNodeIdVector layerIds = entities.at(i)->layerIds();
+        for (const Qt3DCore::QNodeId layerId : layerIds) {
+            const Layer *layer = layerManager->lookupResource(layerId);
+            if (layer != nullptr && layer->maskIndex() >= 0)
+                mask.set(layer->maskIndex());
+        }
+        layerMasks->setLayerMask(i, mask);
+    }
 }
 
 } // Render
@@ -39,6 +39,7 @@
 
 #include "updatelevelofdetailjob_p.h"
 #include <Qt3DCore/private/qaspectmanager_p.h>
+#include <Qt3DCore/private/qnodebatchlookup_p.h>
 #include <Qt3DRender/QLevelOfDetail>
 #include <Qt3DRender/private/entityvisitor_p.h>
 #include <Qt3DRender/private/job_common_p.h>
@@ -274,12 +275,22 @@ bool UpdateLevelOfDetailJobPrivate::isRequired() const
 
 void UpdateLevelOfDetailJobPrivate::postFrame(Qt3DCore::QAspectManager *manager)
 {
-    for (const auto &updatedNode: qAsConst(m_updatedIndices)) {
-        QLevelOfDetail *node = qobject_cast<QLevelOfDetail *>(manager->lookupNode(updatedNode.first));
+    if (m_updatedIndices.isEmpty())
+        return;
+
+    QVector<Qt3DCore::QNodeId> ids;
+    ids.reserve(m_updatedIndices.size());
+    for (const auto &updatedNode: qAsConst(m_updatedIndices))
+        ids.push_back(updatedNode.first);
+    // currentIndexChanged handlers may delete the nodes that follow
+    Qt3DCore::QNodeBatchLookup nodes(manager, ids);
+
+    for (int i = 0, m = nodes.size(); i < m; ++i) {
+        QLevelOfDetail *node = qobject_cast<QLevelOfDetail *>(nodes.node(i));
         if (!node)
             continue;
 
-        node->setCurrentIndex(updatedNode.second);
+        node->setCurrentIndex(m_updatedIndices.at(i).second);
     }
 }
 
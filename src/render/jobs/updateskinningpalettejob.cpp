@@ -39,12 +39,34 @@
 #include <Qt3DRender/private/managers_p.h>
 #include <Qt3DRender/private/handle_types_p.h>
 #include <Qt3DRender/private/job_common_p.h>
+#if QT_CONFIG(concurrent)
+#include <QtConcurrent/QtConcurrent>
+#endif
+#include <algorithm>
 
 QT_BEGIN_NAMESPACE
 
 namespace Qt3DRender {
 namespace Render {
 
+#if QT_CONFIG(concurrent)
+namespace {
+
+// Below this number of dirty skeletons, dispatching to the thread pool costs
+// more than computing the palettes serially
+const int ParallelSkinningPaletteThreshold = 4;
+
+struct CalculateSkinningPalette
+{
+    void operator()(Skeleton *skeleton) const
+    {
+        skeleton->calculateSkinningMatrixPalette();
+    }
+};
+
+} // anonymous
+#endif
+
 UpdateSkinningPaletteJob::UpdateSkinningPaletteJob()
     : Qt3DCore::QAspectJob()
     , m_nodeManagers(nullptr)
@@ -63,9 +85,6 @@ void UpdateSkinningPaletteJob::run()
     if (armatureManager->count() == 0)
         return;
 
-    // TODO: Decompose this job across several jobs, say one per skeleton so
-    // that it can be done in parallel
-
     // Update the local pose transforms of JointInfo's in Skeletons from
     // the set of dirty joints.
     for (const auto &jointHandle : qAsConst(m_dirtyJoints)) {
@@ -77,26 +96,48 @@ void UpdateSkinningPaletteJob::run()
             skeleton->setLocalPose(jointHandle, joint->localPose());
     }
 
-    // Find all the armature components and update their skinning palettes
-    QVector<HArmature> dirtyArmatures;
-    m_root->traverse([&dirtyArmatures](Entity *entity) {
-        const auto armatureHandle = entity->componentHandle<Armature>();
-        if (!armatureHandle.isNull() && !dirtyArmatures.contains(armatureHandle))
-            dirtyArmatures.push_back(armatureHandle);
-    });
-
-    // Update the skeleton for each dirty armature
+    // The armature manager already knows about every armature, no need to
+    // traverse the scene to find them. Gather the skeletons they reference
+    // whose poses changed since their palette was last computed.
     auto skeletonManager = m_nodeManagers->skeletonManager();
-    for (const auto &armatureHandle : qAsConst(dirtyArmatures)) {
-        auto armature = armatureManager->data(armatureHandle);
-        Q_ASSERT(armature);
+    const QVector<HArmature> &armatureHandles = armatureManager->activeHandles();
+    m_dirtySkeletons.clear();
+    for (const HArmature &armatureHandle : armatureHandles) {
+        Armature *armature = armatureManager->data(armatureHandle);
+        Skeleton *skeleton = skeletonManager->lookupResource(armature->skeletonId());
+        if (skeleton != nullptr && skeleton->isSkinningPaletteDirty())
+            m_dirtySkeletons.push_back(skeleton);
+    }
 
-        auto skeletonId = armature->skeletonId();
-        auto skeleton = skeletonManager->lookupResource(skeletonId);
-        Q_ASSERT(skeleton);
+    // Several armatures can share the same skeleton
+    std::sort(m_dirtySkeletons.begin(), m_dirtySkeletons.end());
+    m_dirtySkeletons.erase(std::unique(m_dirtySkeletons.begin(), m_dirtySkeletons.end()),
+                           m_dirtySkeletons.end());
+
+    // Each skeleton only touches its own joints and palette so they can be
+    // processed concurrently
+#if QT_CONFIG(concurrent)
+    if (m_dirtySkeletons.size() >= ParallelSkinningPaletteThreshold) {
+        QtConcurrent::blockingMap(m_dirtySkeletons, CalculateSkinningPalette());
+    } else
+#endif
+    {
+        for (Skeleton *skeleton : m_dirtySkeletons)
+            skeleton->calculateSkinningMatrixPalette();
+    }
 
-        const QVector<QMatrix4x4> skinningPalette = skeleton->calculateSkinningMatrixPalette();
-        armature->skinningPaletteUniform().setData(skinningPalette);
+    // Only upload the palettes that were recomputed or that an armature
+    // hasn't received yet (new armature or skeleton changed)
+    for (const HArmature &armatureHandle : armatureHandles) {
+        Armature *armature = armatureManager->data(armatureHandle);
+        const Skeleton *skeleton = skeletonManager->lookupResource(armature->skeletonId());
+        if (skeleton == nullptr)
+            continue;
+        if (armature->isSkinningPaletteDirty()
+                || std::binary_search(m_dirtySkeletons.cbegin(), m_dirtySkeletons.cend(), skeleton)) {
+            armature->skinningPaletteUniform().setData(skeleton->skinningPalette());
+            armature->unsetSkinningPaletteDirty();
+        }
     }
 }
 
@@ -52,6 +52,8 @@
 
 #include <QtCore/qsharedpointer.h>
 
+#include <vector>
+
 #include <Qt3DRender/private/handle_types_p.h>
 #include <Qt3DRender/private/qt3drender_global_p.h>
 
@@ -61,6 +63,7 @@ namespace Qt3DRender {
 namespace Render {
 
 class NodeManagers;
+class Skeleton;
 
 class Q_3DRENDERSHARED_PRIVATE_EXPORT UpdateSkinningPaletteJob : public Qt3DCore::QAspectJob
 {
@@ -79,6 +82,10 @@ protected:
     NodeManagers *m_nodeManagers;
     Entity *m_root;
     QVector<HJoint> m_dirtyJoints;
+
+private:
+    // Kept across frames to avoid reallocating
+    std::vector<Skeleton *> m_dirtySkeletons;
 };
 
 typedef QSharedPointer<UpdateSkinningPaletteJob> UpdateSkinningPaletteJobPtr;
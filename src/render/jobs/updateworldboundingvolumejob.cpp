@@ -57,14 +57,20 @@ UpdateWorldBoundingVolumeJob::UpdateWorldBoundingVolumeJob()
 
 void UpdateWorldBoundingVolumeJob::run()
 {
-    const QVector<HEntity> handles = m_manager->activeHandles();
+    BoundingSphereArray *worldSpheres = m_manager->worldBoundingSpheres();
+    worldSpheres->updateSlots(m_manager);
 
-    for (const HEntity &handle : handles) {
-        Entity *node = m_manager->data(handle);
-        if (!node->isEnabled())
-            continue;
-        *(node->worldBoundingVolume()) = node->localBoundingVolume()->transformed(*(node->worldTransform()));
-        *(node->worldBoundingVolumeWithChildren()) = *(node->worldBoundingVolume()); // expanded in UpdateBoundingVolumeJob
+    const QVector<Entity *> &entities = worldSpheres->entities();
+    const int entityCount = entities.size();
+
+    for (int slot = 0; slot < entityCount; ++slot) {
+        Entity *node = entities.at(slot);
+        if (node->isEnabled()) {
+            *(node->worldBoundingVolume()) = node->localBoundingVolume()->transformed(*(node->worldTransform()));
+            *(node->worldBoundingVolumeWithChildren()) = *(node->worldBoundingVolume()); // expanded in UpdateBoundingVolumeJob
+        }
+        // Disabled entities keep their last known volume, as before
+        worldSpheres->setSphere(slot, *(node->worldBoundingVolumeWithChildren()));
     }
 }
 
@@ -42,6 +42,7 @@
 #include <Qt3DCore/qtransform.h>
 #include <Qt3DCore/private/qtransform_p.h>
 #include <Qt3DCore/private/qaspectmanager_p.h>
+#include <Qt3DCore/private/qnodebatchlookup_p.h>
 #include <Qt3DRender/private/entity_p.h>
 #include <Qt3DRender/private/transform_p.h>
 #include <Qt3DRender/private/renderlogging_p.h>
@@ -50,6 +51,9 @@
 #include <Qt3DRender/private/nodemanagers_p.h>
 
 #include <QThread>
+#if QT_CONFIG(concurrent)
+#include <QtConcurrent/QtConcurrent>
+#endif
 
 QT_BEGIN_NAMESPACE
 
@@ -58,37 +62,163 @@ namespace Render {
 
 namespace {
 
+// Below this number of entities the scene is updated on the job's thread only
+const int ParallelUpdateEntityThreshold = 1024;
+// Maximum number of levels walked serially looking for enough subtrees to
+// dispatch to the workers
+const int MaxSerialDepth = 8;
+
 struct TransformUpdate
 {
     Qt3DCore::QNodeId peerId;
     QMatrix4x4 worldTransformMatrix;
 };
 
-void updateWorldTransformAndBounds(NodeManagers *manager, Entity *node, const Matrix4x4 &parentTransform, QVector<TransformUpdate> &updatedTransforms)
+struct SubtreeRoot
+{
+    Entity *entity;
+    bool parentChanged;
+};
+
+Matrix4x4 parentWorldTransform(const Entity *node)
 {
+    const Entity *parent = node->parent();
+    return parent != nullptr ? *(parent->worldTransform()) : Matrix4x4();
+}
+
+// Returns false if the node and its whole subtree can be skipped
+bool updateWorldTransform(Entity *node, const Matrix4x4 &parentTransform, bool parentChanged,
+                          bool &worldChanged, QVector<TransformUpdate> &updatedTransforms)
+{
+    worldChanged = false;
     if (!node->isEnabled())
-        return;
+        return false;
 
-    Matrix4x4 worldTransform(parentTransform);
-    Transform *nodeTransform = node->renderComponent<Transform>();
+    const bool nodeDirty = parentChanged || node->isWorldTransformDirty();
+    if (!nodeDirty && !node->isTransformSubtreeDirty())
+        return false;
 
-    const bool hasTransformComponent = nodeTransform != nullptr && nodeTransform->isEnabled();
-    if (hasTransformComponent)
-        worldTransform = worldTransform * nodeTransform->transformMatrix();
+    if (nodeDirty) {
+        Matrix4x4 worldTransform(parentTransform);
+        Transform *nodeTransform = node->renderComponent<Transform>();
 
-    if (*(node->worldTransform()) != worldTransform) {
-        *(node->worldTransform()) = worldTransform;
+        const bool hasTransformComponent = nodeTransform != nullptr && nodeTransform->isEnabled();
         if (hasTransformComponent)
-            updatedTransforms.push_back({nodeTransform->peerId(), convertToQMatrix4x4(worldTransform)});
+            worldTransform = worldTransform * nodeTransform->transformMatrix();
+
+        if (*(node->worldTransform()) != worldTransform) {
+            *(node->worldTransform()) = worldTransform;
+            worldChanged = true;
+            if (hasTransformComponent)
+                updatedTransforms.push_back({nodeTransform->peerId(), convertToQMatrix4x4(worldTransform)});
+        }
+    }
+    return true;
+}
+
+// A node stays flagged as long as one of its children could not be updated (disabled)
+void unsetWorldTransformDirty(NodeManagers *manager, Entity *node)
+{
+    bool subtreeStillDirty = false;
+    const auto childrenHandles = node->childrenHandles();
+    for (const HEntity &handle : childrenHandles) {
+        Entity *child = manager->renderNodesManager()->data(handle);
+        if (child && child->isTransformSubtreeDirty()) {
+            subtreeStillDirty = true;
+            break;
+        }
     }
+    node->unsetWorldTransformDirty(subtreeStillDirty);
+}
 
+void updateWorldTransformAndBounds(NodeManagers *manager, Entity *node, const Matrix4x4 &parentTransform,
+                                   bool parentChanged, QVector<TransformUpdate> &updatedTransforms)
+{
+    bool worldChanged = false;
+    if (!updateWorldTransform(node, parentTransform, parentChanged, worldChanged, updatedTransforms))
+        return;
+
+    const Matrix4x4 &worldTransform = *(node->worldTransform());
     const auto childrenHandles = node->childrenHandles();
     for (const HEntity &handle : childrenHandles) {
         Entity *child = manager->renderNodesManager()->data(handle);
         if (child)
-            updateWorldTransformAndBounds(manager, child, worldTransform, updatedTransforms);
+            updateWorldTransformAndBounds(manager, child, worldTransform, worldChanged, updatedTransforms);
+    }
+
+    unsetWorldTransformDirty(manager, node);
+}
+
+#if QT_CONFIG(concurrent)
+struct UpdateSubtreeFunctor
+{
+    NodeManagers *manager;
+
+    // This define is required to work with QtConcurrent
+    typedef QVector<TransformUpdate> result_type;
+    QVector<TransformUpdate> operator ()(const SubtreeRoot &root)
+    {
+        QVector<TransformUpdate> updatedTransforms;
+        updateWorldTransformAndBounds(manager, root.entity, parentWorldTransform(root.entity),
+                                      root.parentChanged, updatedTransforms);
+        return updatedTransforms;
+    }
+};
+
+struct ReduceUpdatesFunctor
+{
+    void operator ()(QVector<TransformUpdate> &result, const QVector<TransformUpdate> &values)
+    {
+        result += values;
+    }
+};
+
+// Walks the first levels serially until enough independent subtrees are
+// found, then updates those in parallel. Results are reduced in subtree
+// order so that the list of updates doesn't depend on thread scheduling.
+void updateWorldTransformsParallel(NodeManagers *manager, Entity *root,
+                                   QVector<TransformUpdate> &updatedTransforms)
+{
+    const int minSubtreeCount = QThread::idealThreadCount() * 4;
+    QVector<Entity *> serialNodes;
+    QVector<SubtreeRoot> level = { { root, false } };
+
+    for (int depth = 0; depth < MaxSerialDepth && !level.empty() && level.size() < minSubtreeCount; ++depth) {
+        QVector<SubtreeRoot> nextLevel;
+        for (const SubtreeRoot &subtreeRoot : qAsConst(level)) {
+            Entity *node = subtreeRoot.entity;
+            bool worldChanged = false;
+            if (!updateWorldTransform(node, parentWorldTransform(node), subtreeRoot.parentChanged,
+                                      worldChanged, updatedTransforms))
+                continue;
+            serialNodes.push_back(node);
+
+            const auto childrenHandles = node->childrenHandles();
+            for (const HEntity &handle : childrenHandles) {
+                Entity *child = manager->renderNodesManager()->data(handle);
+                if (child)
+                    nextLevel.push_back({ child, worldChanged });
+            }
+        }
+        level = std::move(nextLevel);
     }
+
+    if (level.size() > 1) {
+        UpdateSubtreeFunctor functor { manager };
+        ReduceUpdatesFunctor reduceFunctor;
+        updatedTransforms += QtConcurrent::blockingMappedReduced<QVector<TransformUpdate>>(
+                    level, functor, reduceFunctor,
+                    QtConcurrent::OrderedReduce | QtConcurrent::SequentialReduce);
+    } else if (level.size() == 1) {
+        UpdateSubtreeFunctor functor { manager };
+        updatedTransforms += functor(level.first());
+    }
+
+    // Children were pushed after their parents, clear the flags bottom-up
+    for (auto it = serialNodes.crbegin(), end = serialNodes.crend(); it != end; ++it)
+        unsetWorldTransformDirty(manager, *it);
 }
+#endif
 
 }
 
@@ -113,6 +243,8 @@ UpdateWorldTransformJob::UpdateWorldTransformJob()
 
 void UpdateWorldTransformJob::setRoot(Entity *root)
 {
+    if (root != m_node && root != nullptr)
+        root->markWorldTransformDirty();
     m_node = root;
 }
 
@@ -125,19 +257,22 @@ void UpdateWorldTransformJob::run()
 {
     // Iterate over each level of hierarchy in our scene
     // and update each node's world transform from its
-    // local transform and its parent's world transform
-
-    // TODO: Parallelise this on each level using a parallel_for
-    // implementation.
+    // local transform and its parent's world transform.
+    // Only branches containing entities flagged with
+    // markWorldTransformDirty() are visited.
 
     Q_D(UpdateWorldTransformJob);
     qCDebug(Jobs) << "Entering" << Q_FUNC_INFO << QThread::currentThread();
 
-    Matrix4x4 parentTransform;
-    Entity *parent = m_node->parent();
-    if (parent != nullptr)
-        parentTransform = *(parent->worldTransform());
-    updateWorldTransformAndBounds(m_manager, m_node, parentTransform, d->m_updatedTransforms);
+#if QT_CONFIG(concurrent)
+    if (m_manager->renderNodesManager()->count() >= ParallelUpdateEntityThreshold) {
+        updateWorldTransformsParallel(m_manager, m_node, d->m_updatedTransforms);
+    } else
+#endif
+    {
+        updateWorldTransformAndBounds(m_manager, m_node, parentWorldTransform(m_node),
+                                      false, d->m_updatedTransforms);
+    }
 
     qCDebug(Jobs) << "Exiting" << Q_FUNC_INFO << QThread::currentThread();
 }
@@ -145,14 +280,28 @@ void UpdateWorldTransformJob::run()
 void UpdateWorldTransformJobPrivate::postFrame(Qt3DCore::QAspectManager *manager)
 {
     const QVector<TransformUpdate> updatedTransforms = std::move(m_updatedTransforms);
-    for (const TransformUpdate &t : updatedTransforms) {
-        Qt3DCore::QTransform *node =
-                qobject_cast<Qt3DCore::QTransform *>(manager->lookupNode(t.peerId));
+    if (updatedTransforms.isEmpty())
+        return;
+
+    // Resolve all the frontend transforms at once rather than
+    // taking the scene lock once per updated transform
+    QVector<Qt3DCore::QNodeId> ids;
+    ids.reserve(updatedTransforms.size());
+    for (const TransformUpdate &t : updatedTransforms)
+        ids.push_back(t.peerId);
+    // worldMatrixChanged handlers may delete transforms updated after theirs,
+    // the lookup then resolves the remaining ones again
+    Qt3DCore::QNodeBatchLookup nodes(manager, ids);
+
+    for (int i = 0, m = nodes.size(); i < m; ++i) {
+        // peerId is the id of a Transform backend, the frontend
+        // node is therefore always a QTransform when still alive
+        Qt3DCore::QTransform *node = static_cast<Qt3DCore::QTransform *>(nodes.node(i));
         if (!node)
             continue;
         Qt3DCore::QTransformPrivate *dNode =
                 static_cast<Qt3DCore::QTransformPrivate *>(Qt3DCore::QNodePrivate::get(node));
-        dNode->setWorldMatrix(t.worldTransformMatrix);
+        dNode->setWorldMatrix(updatedTransforms.at(i).worldTransformMatrix);
     }
 }
 
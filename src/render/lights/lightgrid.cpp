@@ -0,0 +1,285 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "lightgrid_p.h"
+#include <Qt3DRender/private/entity_p.h>
+#include <Qt3DRender/private/light_p.h>
+#include <Qt3DRender/private/managers_p.h>
+#include <Qt3DRender/private/sphere_p.h>
+#include <QVarLengthArray>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DRender {
+
+namespace Render {
+
+namespace {
+
+// Number of light sources per cell aimed for when choosing the resolution
+const float LightSourcesPerCell = 2.0f;
+const int MaxResolution = 32;
+// Fraction of a cell by which distance lower bounds are reduced to absorb
+// the rounding made when assigning light sources to cells
+const float CellBoundMargin = 1e-3f;
+
+struct Candidate
+{
+    float distanceSquared;
+    int index;
+
+    bool operator<(const Candidate &other) const
+    {
+        if (distanceSquared != other.distanceSquared)
+            return distanceSquared < other.distanceSquared;
+        return index < other.index;
+    }
+};
+
+} // anonymous
+
+LightGrid::LightGrid()
+{
+    clear();
+}
+
+void LightGrid::clear()
+{
+    m_lightSources.clear();
+    m_positions.clear();
+    m_usableLightCounts.clear();
+    m_cellStarts.clear();
+    m_cellSources.clear();
+    for (int axis = 0; axis < 3; ++axis) {
+        m_origin[axis] = 0.0f;
+        m_cellSize[axis] = 0.0f;
+        m_inverseCellSize[axis] = 0.0f;
+        m_resolution[axis] = 1;
+    }
+}
+
+void LightGrid::build(const QVector<LightSource> &lightSources,
+                      ShaderDataManager *shaderDataManager)
+{
+    clear();
+
+    const int sourceCount = lightSources.size();
+    if (sourceCount == 0)
+        return;
+
+    m_lightSources = lightSources;
+    m_positions.reserve(sourceCount);
+    m_usableLightCounts.reserve(sourceCount);
+
+    float minPosition[3] = { std::numeric_limits<float>::max(),
+                             std::numeric_limits<float>::max(),
+                             std::numeric_limits<float>::max() };
+    float maxPosition[3] = { std::numeric_limits<float>::lowest(),
+                             std::numeric_limits<float>::lowest(),
+                             std::numeric_limits<float>::lowest() };
+
+    for (const LightSource &source : lightSources) {
+        const Vector3D position = source.entity->worldBoundingVolume()->center();
+        m_positions.push_back(position);
+
+        int usableLightCount = 0;
+        for (const Light *light : source.lights) {
+            if (light->isEnabled()
+                    && (!shaderDataManager || shaderDataManager->lookupResource(light->shaderData())))
+                ++usableLightCount;
+        }
+        m_usableLightCounts.push_back(usableLightCount);
+
+        for (int axis = 0; axis < 3; ++axis) {
+            minPosition[axis] = std::min(minPosition[axis], position[axis]);
+            maxPosition[axis] = std::max(maxPosition[axis], position[axis]);
+        }
+    }
+
+    const int resolution = qBound(1,
+                                  int(std::ceil(std::cbrt(float(sourceCount) / LightSourcesPerCell))),
+                                  MaxResolution);
+    for (int axis = 0; axis < 3; ++axis) {
+        const float extent = maxPosition[axis] - minPosition[axis];
+        // A single cell along flat or degenerate axes
+        if (extent > 0.0f && std::isfinite(extent)) {
+            m_origin[axis] = minPosition[axis];
+            m_resolution[axis] = resolution;
+            m_cellSize[axis] = extent / float(resolution);
+            m_inverseCellSize[axis] = float(resolution) / extent;
+        }
+    }
+
+    // Counting sort of the light sources by cell, preserving their order
+    const int cellCount = this->cellCount();
+    QVector<int> sourceCells(sourceCount);
+    m_cellStarts.fill(0, cellCount + 1);
+    for (int i = 0; i < sourceCount; ++i) {
+        const Vector3D &position = m_positions.at(i);
+        const int cell = cellIndex(cellCoordinate(0, position.x()),
+                                   cellCoordinate(1, position.y()),
+                                   cellCoordinate(2, position.z()));
+        sourceCells[i] = cell;
+        ++m_cellStarts[cell + 1];
+    }
+    for (int cell = 0; cell < cellCount; ++cell)
+        m_cellStarts[cell + 1] += m_cellStarts[cell];
+
+    QVector<int> cellCursors = m_cellStarts;
+    m_cellSources.resize(sourceCount);
+    for (int i = 0; i < sourceCount; ++i)
+        m_cellSources[cellCursors[sourceCells.at(i)]++] = i;
+}
+
+int LightGrid::cellCoordinate(int axis, float value) const
+{
+    const float coordinate = (value - m_origin[axis]) * m_inverseCellSize[axis];
+    // Also takes care of NaN
+    if (!(coordinate > 0.0f))
+        return 0;
+    if (coordinate >= float(m_resolution[axis]))
+        return m_resolution[axis] - 1;
+    return int(coordinate);
+}
+
+QVector<LightSource> LightGrid::closestLightSources(const Vector3D &position, int maxLights) const
+{
+    if (m_lightSources.isEmpty() || maxLights <= 0)
+        return {};
+
+    const float p[3] = { position.x(), position.y(), position.z() };
+    const int center[3] = { cellCoordinate(0, p[0]),
+                            cellCoordinate(1, p[1]),
+                            cellCoordinate(2, p[2]) };
+
+    QVarLengthArray<Candidate, 64> candidates;
+    const auto addCell = [&] (int x, int y, int z) {
+        const int cell = cellIndex(x, y, z);
+        for (int i = m_cellStarts.at(cell), end = m_cellStarts.at(cell + 1); i < end; ++i) {
+            const int sourceIndex = m_cellSources.at(i);
+            float distanceSquared = (m_positions.at(sourceIndex) - position).lengthSquared();
+            // Keeps the ordering strict weak with badly placed lights
+            if (std::isnan(distanceSquared))
+                distanceSquared = std::numeric_limits<float>::infinity();
+            candidates.push_back({ distanceSquared, sourceIndex });
+        }
+    };
+
+    // Visit shells of cells of increasing size around the cell containing
+    // position. Once a shell has been visited, candidates closer than the
+    // distance to the outside of the visited cells are known to come before
+    // any light source that hasn't been visited yet.
+    for (int ring = 0; ; ++ring) {
+        int lo[3];
+        int hi[3];
+        bool coversGrid = true;
+        for (int axis = 0; axis < 3; ++axis) {
+            lo[axis] = std::max(center[axis] - ring, 0);
+            hi[axis] = std::min(center[axis] + ring, m_resolution[axis] - 1);
+            coversGrid &= (lo[axis] == 0 && hi[axis] == m_resolution[axis] - 1);
+        }
+
+        for (int z = lo[2]; z <= hi[2]; ++z) {
+            const bool zOnShell = std::abs(z - center[2]) == ring;
+            for (int y = lo[1]; y <= hi[1]; ++y) {
+                if (zOnShell || std::abs(y - center[1]) == ring) {
+                    for (int x = lo[0]; x <= hi[0]; ++x)
+                        addCell(x, y, z);
+                } else {
+                    // Only the x extremities are part of the shell
+                    if (center[0] - ring >= 0)
+                        addCell(center[0] - ring, y, z);
+                    if (center[0] + ring < m_resolution[0])
+                        addCell(center[0] + ring, y, z);
+                }
+            }
+        }
+
+        float lowerBound = std::numeric_limits<float>::infinity();
+        if (!coversGrid) {
+            for (int axis = 0; axis < 3; ++axis) {
+                const float margin = CellBoundMargin * m_cellSize[axis];
+                if (center[axis] - ring > 0) {
+                    const float boundary = m_origin[axis] + float(center[axis] - ring) * m_cellSize[axis];
+                    lowerBound = std::min(lowerBound, p[axis] - boundary - margin);
+                }
+                if (center[axis] + ring < m_resolution[axis] - 1) {
+                    const float boundary = m_origin[axis] + float(center[axis] + ring + 1) * m_cellSize[axis];
+                    lowerBound = std::min(lowerBound, boundary - p[axis] - margin);
+                }
+            }
+            lowerBound = std::max(lowerBound, 0.0f);
+        }
+        const float lowerBoundSquared = lowerBound * lowerBound;
+
+        std::sort(candidates.begin(), candidates.end());
+
+        int selectedCount = -1;
+        int usableLightCount = 0;
+        for (int i = 0, m = candidates.size(); i < m; ++i) {
+            const Candidate &candidate = candidates.at(i);
+            if (!coversGrid && !(candidate.distanceSquared < lowerBoundSquared))
+                break;
+            usableLightCount += m_usableLightCounts.at(candidate.index);
+            if (usableLightCount >= maxLights) {
+                selectedCount = i + 1;
+                break;
+            }
+        }
+        if (selectedCount < 0 && coversGrid)
+            selectedCount = candidates.size();
+
+        if (selectedCount >= 0) {
+            QVector<LightSource> closest;
+            closest.reserve(selectedCount);
+            for (int i = 0; i < selectedCount; ++i)
+                closest.push_back(m_lightSources.at(candidates.at(i).index));
+            return closest;
+        }
+    }
+}
+
+} // namespace Render
+
+} // namespace Qt3DRender
+
+QT_END_NAMESPACE
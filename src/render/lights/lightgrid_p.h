@@ -0,0 +1,118 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QT3DRENDER_RENDER_LIGHTGRID_P_H
+#define QT3DRENDER_RENDER_LIGHTGRID_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of other Qt classes.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <Qt3DRender/private/qt3drender_global_p.h>
+#include <Qt3DRender/private/lightsource_p.h>
+#include <Qt3DCore/private/vector3d_p.h>
+#include <QVector>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DRender {
+
+namespace Render {
+
+class ShaderDataManager;
+
+// Uniform grid over the world positions of the light sources of a
+// RenderView. It is built once when the light sources are set and then
+// queried concurrently, read only, by the command updater jobs to find the
+// lights closest to each entity without sorting all the lights per command.
+class Q_3DRENDERSHARED_PRIVATE_EXPORT LightGrid
+{
+public:
+    LightGrid();
+
+    // Light sources must have their entity world bounding volume up to date.
+    // When shaderDataManager is provided, lights without ShaderData are not
+    // counted as usable, matching what the renderers do when setting uniforms.
+    void build(const QVector<LightSource> &lightSources,
+               ShaderDataManager *shaderDataManager = nullptr);
+    void clear();
+
+    bool isEmpty() const { return m_lightSources.isEmpty(); }
+    const QVector<LightSource> &lightSources() const { return m_lightSources; }
+
+    // Light sources sorted by increasing distance to position (ties in the
+    // order they were given to build), stopping as soon as the returned
+    // sources provide maxLights enabled lights.
+    QVector<LightSource> closestLightSources(const Vector3D &position, int maxLights) const;
+
+    int cellCount() const { return m_resolution[0] * m_resolution[1] * m_resolution[2]; }
+
+private:
+    int cellCoordinate(int axis, float value) const;
+    int cellIndex(int x, int y, int z) const
+    {
+        return (z * m_resolution[1] + y) * m_resolution[0] + x;
+    }
+
+    QVector<LightSource> m_lightSources;
+    QVector<Vector3D> m_positions;
+    QVector<int> m_usableLightCounts;
+    // Sources of cell i are m_cellSources[m_cellStarts[i] .. m_cellStarts[i + 1][
+    QVector<int> m_cellStarts;
+    QVector<int> m_cellSources;
+    float m_origin[3];
+    float m_cellSize[3];
+    float m_inverseCellSize[3];
+    int m_resolution[3];
+};
+
+} // namespace Render
+
+} // namespace Qt3DRender
+
+QT_END_NAMESPACE
+
+#endif // QT3DRENDER_RENDER_LIGHTGRID_P_H
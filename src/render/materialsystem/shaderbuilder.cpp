@@ -48,9 +48,15 @@
 #include <Qt3DRender/private/qshadergraphloader_p.h>
 #include <Qt3DRender/private/qshadergenerator_p.h>
 #include <Qt3DRender/private/qshadernodesloader_p.h>
+#include <Qt3DRender/private/renderlogging_p.h>
 
+#include <QBuffer>
+#include <QCryptographicHash>
+#include <QDir>
 #include <QFile>
 #include <QFileInfo>
+#include <QMutex>
+#include <QSaveFile>
 #include <QUrl>
 
 static void initResources()
@@ -87,6 +93,12 @@ public:
         return m_prototypes;
     }
 
+    // Hash of the prototypes file contents, part of the generated code cache key
+    QByteArray contentHash() const
+    {
+        return m_contentHash;
+    }
+
 private:
     void load()
     {
@@ -96,6 +108,9 @@ private:
             return;
         }
 
+        m_contentHash = QCryptographicHash::hash(file.readAll(), QCryptographicHash::Sha1);
+        file.seek(0);
+
         Qt3DRender::QShaderNodesLoader loader;
         loader.setDevice(&file);
         loader.load();
@@ -103,11 +118,98 @@ private:
     }
 
     QString m_fileName;
+    QByteArray m_contentHash;
     QHash<QString, Qt3DRender::QShaderNode> m_prototypes;
 };
 
 Q_GLOBAL_STATIC(GlobalShaderPrototypes, qt3dGlobalShaderPrototypes)
 
+// Process-wide cache of generated shader code, keyed by a hash of every input
+// of the generation (graph contents, prototypes, enabled layers and format).
+// When QT3D_SHADERBUILDER_CACHE_DIR is set, generated code is also persisted
+// there so that subsequent runs can skip graph loading and generation.
+class GlobalShaderCodeCache
+{
+public:
+    GlobalShaderCodeCache()
+        : m_cacheDir(qEnvironmentVariable("QT3D_SHADERBUILDER_CACHE_DIR"))
+    {
+        if (!m_cacheDir.isEmpty() && !QDir().mkpath(m_cacheDir)) {
+            qWarning() << "Couldn't create shader builder cache directory:" << m_cacheDir;
+            m_cacheDir.clear();
+        }
+    }
+
+    bool find(const QByteArray &key, const QString &graphPath, QByteArray &code)
+    {
+        {
+            QMutexLocker lock(&m_mutex);
+            const auto it = m_codes.constFind(key);
+            if (it != m_codes.cend()) {
+                code = it.value();
+                m_hits.ref();
+                return true;
+            }
+        }
+
+        // The disk cache stores code before includes are resolved so that
+        // changes to included files are picked up on the next run
+        if (!m_cacheDir.isEmpty()) {
+            QFile file(diskCacheFileName(key));
+            if (file.open(QFile::ReadOnly)) {
+                code = Qt3DRender::QShaderProgramPrivate::deincludify(file.readAll(),
+                                                                     graphPath + QStringLiteral(".glsl"));
+                QMutexLocker lock(&m_mutex);
+                m_codes.insert(key, code);
+                m_hits.ref();
+                return true;
+            }
+        }
+
+        m_misses.ref();
+        return false;
+    }
+
+    void insert(const QByteArray &key, const QByteArray &generatedCode, const QByteArray &code)
+    {
+        {
+            QMutexLocker lock(&m_mutex);
+            m_codes.insert(key, code);
+        }
+
+        if (!m_cacheDir.isEmpty()) {
+            QSaveFile file(diskCacheFileName(key));
+            if (!file.open(QFile::WriteOnly) || file.write(generatedCode) != generatedCode.size() || !file.commit())
+                qCWarning(Qt3DRender::Render::Shaders) << "Couldn't write shader builder cache file:" << file.fileName();
+        }
+    }
+
+    void clear()
+    {
+        QMutexLocker lock(&m_mutex);
+        m_codes.clear();
+        m_hits.storeRelaxed(0);
+        m_misses.storeRelaxed(0);
+    }
+
+    int hitCount() const { return m_hits.loadRelaxed(); }
+    int missCount() const { return m_misses.loadRelaxed(); }
+
+private:
+    QString diskCacheFileName(const QByteArray &key) const
+    {
+        return m_cacheDir + QLatin1Char('/') + QString::fromLatin1(key.toHex()) + QStringLiteral(".glsl");
+    }
+
+    QMutex m_mutex;
+    QHash<QByteArray, QByteArray> m_codes;
+    QAtomicInt m_hits;
+    QAtomicInt m_misses;
+    QString m_cacheDir;
+};
+
+Q_GLOBAL_STATIC(GlobalShaderCodeCache, qt3dGlobalShaderCodeCache)
+
 using namespace Qt3DCore;
 
 namespace Qt3DRender {
@@ -128,6 +230,21 @@ QStringList ShaderBuilder::getPrototypeNames()
     return qt3dGlobalShaderPrototypes->prototypes().keys();
 }
 
+int ShaderBuilder::codeCacheHitCount()
+{
+    return qt3dGlobalShaderCodeCache->hitCount();
+}
+
+int ShaderBuilder::codeCacheMissCount()
+{
+    return qt3dGlobalShaderCodeCache->missCount();
+}
+
+void ShaderBuilder::clearCodeCache()
+{
+    qt3dGlobalShaderCodeCache->clear();
+}
+
 ShaderBuilder::ShaderBuilder()
     : BackendNode(ReadWrite)
 {
@@ -220,15 +337,7 @@ void ShaderBuilder::generateCode(QShaderProgram::ShaderType type)
         return;
     }
 
-    auto graphLoader = QShaderGraphLoader();
-    graphLoader.setPrototypes(qt3dGlobalShaderPrototypes->prototypes());
-    graphLoader.setDevice(&file);
-    graphLoader.load();
-
-    if (graphLoader.status() == QShaderGraphLoader::Error)
-        return;
-
-    const auto graph = graphLoader.graph();
+    const QByteArray graphContents = file.readAll();
 
     auto format = QShaderFormat();
     format.setApi(m_graphicsApi.m_api == QGraphicsApiFilter::OpenGLES ? QShaderFormat::OpenGLES
@@ -241,12 +350,31 @@ void ShaderBuilder::generateCode(QShaderProgram::ShaderType type)
     format.setExtensions(m_graphicsApi.m_extensions);
     format.setVendor(m_graphicsApi.m_vendor);
 
-    auto generator = QShaderGenerator();
-    generator.format = format;
-    generator.graph = graph;
+    const QByteArray cacheKey = codeCacheKey(graphPath, graphContents, format);
+    QByteArray deincludified;
+
+    if (!qt3dGlobalShaderCodeCache->find(cacheKey, graphPath, deincludified)) {
+        QByteArray graphData = graphContents;
+        QBuffer buffer(&graphData);
+        buffer.open(QIODevice::ReadOnly);
+
+        auto graphLoader = QShaderGraphLoader();
+        graphLoader.setPrototypes(qt3dGlobalShaderPrototypes->prototypes());
+        graphLoader.setDevice(&buffer);
+        graphLoader.load();
+
+        if (graphLoader.status() == QShaderGraphLoader::Error)
+            return;
+
+        auto generator = QShaderGenerator();
+        generator.format = format;
+        generator.graph = graphLoader.graph();
+
+        const auto code = generator.createShaderCode(m_enabledLayers);
+        deincludified = QShaderProgramPrivate::deincludify(code, graphPath + QStringLiteral(".glsl"));
+        qt3dGlobalShaderCodeCache->insert(cacheKey, code, deincludified);
+    }
 
-    const auto code = generator.createShaderCode(m_enabledLayers);
-    const auto deincludified = QShaderProgramPrivate::deincludify(code, graphPath + QStringLiteral(".glsl"));
     m_codes.insert(type, deincludified);
     m_dirtyTypes.remove(type);
 
@@ -255,6 +383,32 @@ void ShaderBuilder::generateCode(QShaderProgram::ShaderType type)
                                  m_codes.value(type) });
 }
 
+QByteArray ShaderBuilder::codeCacheKey(const QString &graphPath, const QByteArray &graphContents,
+                                       const QShaderFormat &format) const
+{
+    // Bump when the generator output changes for identical inputs
+    static const QByteArray cacheVersion = QByteArrayLiteral("qt3d-shaderbuilder-1") + QByteArray(qVersion());
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(cacheVersion);
+    // The path matters since includes are resolved relative to it
+    hash.addData(graphPath.toUtf8());
+    hash.addData(QCryptographicHash::hash(graphContents, QCryptographicHash::Sha1));
+    hash.addData(qt3dGlobalShaderPrototypes->contentHash());
+    for (const QString &layer : m_enabledLayers) {
+        hash.addData(layer.toUtf8());
+        hash.addData("\0", 1);
+    }
+    const int formatValues[] = { format.api(), format.version().majorVersion(), format.version().minorVersion() };
+    hash.addData(reinterpret_cast<const char *>(formatValues), sizeof(formatValues));
+    for (const QString &extension : format.extensions()) {
+        hash.addData(extension.toUtf8());
+        hash.addData("\0", 1);
+    }
+    hash.addData(format.vendor().toUtf8());
+    return hash.result();
+}
+
 void ShaderBuilder::syncFromFrontEnd(const QNode *frontEnd, bool firstTime)
 {
     const QShaderProgramBuilder *node = qobject_cast<const QShaderProgramBuilder *>(frontEnd);
@@ -59,6 +59,8 @@ QT_BEGIN_NAMESPACE
 
 namespace Qt3DRender {
 
+class QShaderFormat;
+
 namespace Render {
 
 struct ShaderBuilderUpdate
@@ -75,6 +77,11 @@ public:
     static void setPrototypesFile(const QString &file);
     static QStringList getPrototypeNames();
 
+    // Statistics of the process-wide generated code cache
+    static int codeCacheHitCount();
+    static int codeCacheMissCount();
+    static void clearCodeCache();
+
     ShaderBuilder();
     ~ShaderBuilder();
     void cleanup();
@@ -99,6 +106,8 @@ public:
 
 private:
     void setEnabledLayers(const QStringList &layers);
+    QByteArray codeCacheKey(const QString &graphPath, const QByteArray &graphContents,
+                            const QShaderFormat &format) const;
 
     GraphicsApiFilterData m_graphicsApi;
     Qt3DCore::QNodeId m_shaderProgramId;
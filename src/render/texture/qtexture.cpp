@@ -44,6 +44,7 @@
 #include "qtexturedata.h"
 #include "qtexture.h"
 #include "qtexture_p.h"
+#include <QFile>
 #include <QFileInfo>
 #include <QMimeDatabase>
 #include <QMimeType>
@@ -59,6 +60,8 @@
 #include <Qt3DRender/private/texture_p.h>
 #include <qmath.h>
 
+#include <limits>
+
 QT_BEGIN_NAMESPACE
 
 namespace Qt3DRender {
@@ -489,8 +492,68 @@ quint32 blockSizeForTextureFormat(QOpenGLTexture::TextureFormat format)
     }
 }
 
-QTextureImageDataPtr setKtxFile(QIODevice *source)
+// Reads texture payloads from a device. When constructed with a memory
+// mappable file, payloads reference the mapping instead of being copied and
+// the image data keeps the file (and thus the mapping) alive.
+class TexturePayloadReader
+{
+public:
+    TexturePayloadReader(QIODevice *source, const QSharedPointer<QFile> &mappedFile)
+        : m_source(source)
+        , m_mappedFile(mappedFile)
+        , m_isMapped(false)
+    {
+        Q_ASSERT(!mappedFile || mappedFile.data() == source);
+    }
+
+    QByteArray read(qint64 size)
+    {
+        if (m_mappedFile && size > 0 && size <= std::numeric_limits<int>::max()) {
+            const qint64 offset = m_source->pos();
+            if (offset + size <= m_mappedFile->size()) {
+                const uchar *mapped = m_mappedFile->map(offset, size);
+                if (mapped && m_source->seek(offset + size)) {
+                    m_isMapped = true;
+                    return QByteArray::fromRawData(reinterpret_cast<const char *>(mapped), int(size));
+                }
+            }
+        }
+        return m_source->read(size);
+    }
+
+    QByteArray readAll()
+    {
+        if (m_mappedFile)
+            return read(m_mappedFile->size() - m_source->pos());
+        return m_source->readAll();
+    }
+
+    void setData(const QTextureImageDataPtr &imageData, const QByteArray &data,
+                 int blockSize, bool isCompressed) const
+    {
+        imageData->setData(data, blockSize, isCompressed);
+        if (m_isMapped)
+            QTextureImageDataPrivate::get(imageData.data())->m_mappedFile = m_mappedFile;
+    }
+
+private:
+    QIODevice *m_source;
+    QSharedPointer<QFile> m_mappedFile;
+    bool m_isMapped;
+};
+
+bool isMemoryMappingEnabledByDefault()
+{
+    static const bool enabled = qEnvironmentVariableIntValue("QT3D_TEXTURE_MMAP") > 0;
+    return enabled;
+}
+
+QBasicAtomicInt memoryMappingMode = Q_BASIC_ATOMIC_INITIALIZER(-1);
+
+QTextureImageDataPtr setKtxFile(QIODevice *source, const QSharedPointer<QFile> &mappedFile)
 {
+    TexturePayloadReader reader(source, mappedFile);
+
     static const int KTX_IDENTIFIER_LENGTH = 12;
     static const char ktxIdentifier[KTX_IDENTIFIER_LENGTH] = { '\xAB', 'K', 'T', 'X', ' ', '1', '1', '\xBB', '\r', '\n', '\x1A', '\n' };
     static const quint32 platformEndianIdentifier = 0x04030201;
@@ -576,7 +639,7 @@ QTextureImageDataPtr setKtxFile(QIODevice *source)
     for (auto i = 0; i < mipMapLevels; ++i)
         dataSize += computeMipMapLevelSize(i) * faceCount + 4; // assumes a single layer (per above)
 
-    const QByteArray rawData = source->read(dataSize);
+    const QByteArray rawData = reader.read(dataSize);
     if (rawData.size() < dataSize) {
         qWarning() << "Unexpected end of data in" << source;
         return imageData;
@@ -596,14 +659,15 @@ QTextureImageDataPtr setKtxFile(QIODevice *source)
     imageData->setMipLevels(mipMapLevels);
     imageData->setPixelFormat(QOpenGLTexture::NoSourceFormat);
     imageData->setPixelType(QOpenGLTexture::NoPixelType);
-    imageData->setData(rawData, blockSize, true);
+    reader.setData(imageData, rawData, blockSize, true);
     QTextureImageDataPrivate::get(imageData.data())->m_isKtx = true; // see note in QTextureImageDataPrivate
 
     return imageData;
 }
 
-QTextureImageDataPtr setPkmFile(QIODevice *source)
+QTextureImageDataPtr setPkmFile(QIODevice *source, const QSharedPointer<QFile> &mappedFile)
 {
+    TexturePayloadReader reader(source, mappedFile);
     QTextureImageDataPtr imageData;
 
     PkmHeader header;
@@ -670,7 +734,7 @@ QTextureImageDataPtr setPkmFile(QIODevice *source)
     const int width = qFromBigEndian(header.paddedWidth);
     const int height = qFromBigEndian(header.paddedHeight);
 
-    const QByteArray data = source->readAll();
+    const QByteArray data = reader.readAll();
     if (data.size() != (width / 4) * (height / 4) * blockSize) {
         qWarning() << "Unexpected data size in" << source;
         return imageData;
@@ -687,13 +751,14 @@ QTextureImageDataPtr setPkmFile(QIODevice *source)
     imageData->setMipLevels(1);
     imageData->setPixelFormat(QOpenGLTexture::NoSourceFormat);
     imageData->setPixelType(QOpenGLTexture::NoPixelType);
-    imageData->setData(data, blockSize, true);
+    reader.setData(imageData, data, blockSize, true);
 
     return imageData;
 }
 
-QTextureImageDataPtr setDdsFile(QIODevice *source)
+QTextureImageDataPtr setDdsFile(QIODevice *source, const QSharedPointer<QFile> &mappedFile)
 {
+    TexturePayloadReader reader(source, mappedFile);
     QTextureImageDataPtr imageData;
 
     DdsHeader header;
@@ -802,7 +867,7 @@ QTextureImageDataPtr setDdsFile(QIODevice *source)
     // data
     const int dataSize = layers * layerSize;
 
-    const QByteArray data = source->read(dataSize);
+    const QByteArray data = reader.read(dataSize);
     if (data.size() < dataSize) {
         qWarning() << "Unexpected end of data in" << source;
         return imageData;
@@ -812,7 +877,7 @@ QTextureImageDataPtr setDdsFile(QIODevice *source)
         qWarning() << "Unrecognized data in" << source;
 
     imageData = QTextureImageDataPtr::create();
-    imageData->setData(data,blockSize, isCompressed);
+    reader.setData(imageData, data, blockSize, isCompressed);
 
     // target
     imageData->setTarget(target);
@@ -837,15 +902,18 @@ QTextureImageDataPtr setDdsFile(QIODevice *source)
 
 // Loads Radiance RGBE images into RGBA32F image data. RGBA is chosen over RGB
 // because this allows passing such images to compute shaders (image2D).
-QTextureImageDataPtr setHdrFile(QIODevice *source)
+QTextureImageDataPtr setHdrFile(QIODevice *source, const QSharedPointer<QFile> &mappedFile)
 {
+    // The RGBE data is decoded into a new buffer, the mapping only avoids
+    // copying the encoded file contents
+    TexturePayloadReader reader(source, mappedFile);
     QTextureImageDataPtr imageData;
     char sig[256];
     source->read(sig, 11);
     if (strncmp(sig, "#?RADIANCE\n", 11))
         return imageData;
 
-    QByteArray buf = source->readAll();
+    const QByteArray buf = reader.readAll();
     const char *p = buf.constData();
     const char *pEnd = p + buf.size();
 
@@ -991,43 +1059,24 @@ QTextureImageDataPtr setHdrFile(QIODevice *source)
     return imageData;
 }
 
-} // anonynous
-
-QTextureImageDataPtr TextureLoadingHelper::loadTextureData(const QUrl &url, bool allow3D, bool mirrored)
-{
-    QTextureImageDataPtr textureData;
-    if (url.isLocalFile() || url.scheme() == QLatin1String("qrc")
-#ifdef Q_OS_ANDROID
-            || url.scheme() == QLatin1String("assets")
-#endif
-            ) {
-        const QString source = Qt3DCore::QUrlHelper::urlToLocalFileOrQrc(url);
-        QFile f(source);
-        if (!f.open(QIODevice::ReadOnly))
-            qWarning() << "Failed to open" << source;
-        else
-            textureData = loadTextureData(&f, QFileInfo(source).suffix().toLower(), allow3D, mirrored);
-    }
-    return textureData;
-}
-
-QTextureImageDataPtr TextureLoadingHelper::loadTextureData(QIODevice *data, const QString& suffix,
-                                                           bool allow3D, bool mirrored)
+QTextureImageDataPtr loadTextureDataFromDevice(QIODevice *data, const QString &suffix,
+                                               bool allow3D, bool mirrored,
+                                               const QSharedPointer<QFile> &mappedFile)
 {
     QTextureImageDataPtr textureData;
     ImageFormat fmt = imageFormatFromSuffix(suffix);
     switch (fmt) {
     case DDS:
-        textureData = setDdsFile(data);
+        textureData = setDdsFile(data, mappedFile);
         break;
     case PKM:
-        textureData = setPkmFile(data);
+        textureData = setPkmFile(data, mappedFile);
         break;
     case HDR:
-        textureData = setHdrFile(data);
+        textureData = setHdrFile(data, mappedFile);
         break;
     case KTX: {
-        textureData = setKtxFile(data);
+        textureData = setKtxFile(data, mappedFile);
         break;
     }
     default: {
@@ -1047,6 +1096,50 @@ QTextureImageDataPtr TextureLoadingHelper::loadTextureData(QIODevice *data, cons
     return textureData;
 }
 
+} // anonynous
+
+QTextureImageDataPtr TextureLoadingHelper::loadTextureData(const QUrl &url, bool allow3D, bool mirrored)
+{
+    QTextureImageDataPtr textureData;
+    if (url.isLocalFile() || url.scheme() == QLatin1String("qrc")
+#ifdef Q_OS_ANDROID
+            || url.scheme() == QLatin1String("assets")
+#endif
+            ) {
+        const QString source = Qt3DCore::QUrlHelper::urlToLocalFileOrQrc(url);
+        const QSharedPointer<QFile> f = QSharedPointer<QFile>::create(source);
+        if (!f->open(QIODevice::ReadOnly)) {
+            qWarning() << "Failed to open" << source;
+        } else {
+            const QString suffix = QFileInfo(source).suffix().toLower();
+            // Only the formats parsed by Qt3D itself can reference the mapping
+            const bool canMap = isMemoryMappingEnabled() && imageFormatFromSuffix(suffix) != GenericImageFormat;
+            textureData = loadTextureDataFromDevice(f.data(), suffix, allow3D, mirrored,
+                                                    canMap ? f : QSharedPointer<QFile>());
+        }
+    }
+    return textureData;
+}
+
+QTextureImageDataPtr TextureLoadingHelper::loadTextureData(QIODevice *data, const QString& suffix,
+                                                           bool allow3D, bool mirrored)
+{
+    return loadTextureDataFromDevice(data, suffix, allow3D, mirrored, QSharedPointer<QFile>());
+}
+
+// Memory mapping is disabled by default and can be enabled by setting the
+// QT3D_TEXTURE_MMAP environment variable to 1
+bool TextureLoadingHelper::isMemoryMappingEnabled()
+{
+    const int mode = memoryMappingMode.loadRelaxed();
+    return mode < 0 ? isMemoryMappingEnabledByDefault() : mode > 0;
+}
+
+void TextureLoadingHelper::setMemoryMappingEnabled(bool enabled)
+{
+    memoryMappingMode.storeRelaxed(enabled ? 1 : 0);
+}
+
 QTextureDataPtr QTextureFromSourceGenerator::operator ()()
 {
     QTextureDataPtr generatedData = QTextureDataPtr::create();
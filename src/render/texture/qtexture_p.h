@@ -135,6 +135,11 @@ public:
     static QTextureImageDataPtr loadTextureData(const QUrl &source, bool allow3D, bool mirrored);
     static QTextureImageDataPtr loadTextureData(QIODevice *data, const QString& suffix,
                                                 bool allow3D, bool mirrored);
+
+    // When enabled, DDS, KTX and PKM payloads loaded from files reference a
+    // memory mapping of the file rather than a copy
+    static bool isMemoryMappingEnabled();
+    static void setMemoryMappingEnabled(bool enabled);
 };
 
 } // namespace Qt3DRender
@@ -109,6 +109,7 @@ void QTextureImageDataPrivate::setData(const QByteArray &data,
 {
     m_isCompressed = isCompressed;
     m_data = data;
+    m_mappedFile.reset();
     m_blockSize = blockSize;
 }
 
@@ -190,6 +191,7 @@ void QTextureImageData::cleanup() Q_DECL_NOTHROW
     d->m_blockSize = 0;
     d->m_isCompressed = false;
     d->m_data.clear();
+    d->m_mappedFile.reset();
 }
 
 /*!
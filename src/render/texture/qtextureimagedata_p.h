@@ -53,9 +53,12 @@
 
 #include "qtextureimagedata.h"
 #include <Qt3DRender/private/qt3drender_global_p.h>
+#include <QtCore/qsharedpointer.h>
 
 QT_BEGIN_NAMESPACE
 
+class QFile;
+
 namespace Qt3DRender {
 
 class Q_3DRENDERSHARED_PRIVATE_EXPORT QTextureImageDataPrivate
@@ -89,6 +92,8 @@ public:
     // public API changes. Consider https://codereview.qt-project.org/#/c/178474/ for Qt 6.
     bool m_isKtx;
     QByteArray m_data;
+    // Set when m_data references a memory mapping of the file instead of owning a copy
+    QSharedPointer<QFile> m_mappedFile;
 
     static QTextureImageDataPrivate *get(QTextureImageData *imageData);
 
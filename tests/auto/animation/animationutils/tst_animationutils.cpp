@@ -2656,6 +2656,28 @@ private Q_SLOTS:
             QCOMPARE(actualResults[i], expectedResults[i]);
     }
 
+    void checkFormatClipResultsIntoReusedStorage_data()
+    {
+        checkFormatClipResults_data();
+    }
+
+    void checkFormatClipResultsIntoReusedStorage()
+    {
+        // GIVEN
+        QFETCH(ClipResults, rawClipResults);
+        QFETCH(ComponentIndices, format);
+        QFETCH(ClipResults, expectedResults);
+        ClipResults actualResults(format.size(), -1.0f);
+
+        // WHEN
+        formatClipResults(rawClipResults, format, actualResults);
+
+        // THEN
+        QCOMPARE(actualResults.size(), expectedResults.size());
+        for (int i = 0; i < actualResults.size(); ++i)
+            QCOMPARE(actualResults[i], expectedResults[i]);
+    }
+
     void checkBuildRequiredChannelsAndTypes_data()
     {
         QTest::addColumn<Handler *>("handler");
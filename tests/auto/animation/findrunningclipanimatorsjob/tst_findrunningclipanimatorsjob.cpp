@@ -99,6 +99,20 @@ public:
         return clip;
     }
 
+    // Clip whose file is queued to be loaded in the background
+    AnimationClip *createPendingAnimationClipLoader(Handler *handler,
+                                                    const QUrl &source)
+    {
+        auto clipId = Qt3DCore::QNodeId::createId();
+        AnimationClip *clip = handler->animationClipLoaderManager()->getOrCreateResource(clipId);
+        setPeerId(clip, clipId);
+        clip->setHandler(handler);
+        clip->setDataType(AnimationClip::File);
+        clip->setSource(source);
+        clip->setLoadPending(true);
+        return clip;
+    }
+
     ClipAnimator *createClipAnimator(Handler *handler,
                                      qint64 globalStartTimeNS,
                                      int loops)
@@ -112,6 +126,24 @@ public:
         return animator;
     }
 
+    ClipAnimator *createRunningClipAnimator(Handler *handler,
+                                            AnimationClip *clip)
+    {
+        ClipAnimator *animator = createClipAnimator(handler, 0, 1);
+        animator->setClipId(clip->peerId());
+        auto channelMapping = createChannelMapping(handler,
+                                                   QLatin1String("Location"),
+                                                   Qt3DCore::QNodeId::createId(),
+                                                   "translation",
+                                                   static_cast<int>(QVariant::Vector3D),
+                                                   3);
+        ChannelMapper *channelMapper = createChannelMapper(handler, QVector<Qt3DCore::QNodeId>() << channelMapping->peerId());
+        animator->setMapperId(channelMapper->peerId());
+        animator->setRunning(true);
+        animator->setEnabled(true);
+        return animator;
+    }
+
 private Q_SLOTS:
     void checkJob_data()
     {
@@ -235,6 +267,87 @@ private Q_SLOTS:
             }
         }
     }
+
+    void checkPendingClipDoesNotStopAnimator()
+    {
+        // GIVEN - a running animator whose clip file is being loaded
+        Handler handler;
+        AnimationClip *clip = createPendingAnimationClipLoader(&handler, QUrl("qrc:/clip1.json"));
+        ClipAnimator *animator = createRunningClipAnimator(&handler, clip);
+        const HClipAnimator animatorHandle = handler.clipAnimatorManager()->getOrAcquireHandle(animator->peerId());
+
+        FindRunningClipAnimatorsJob job;
+        job.setHandler(&handler);
+
+        // WHEN
+        job.setDirtyClipAnimators(QVector<HClipAnimator>() << animatorHandle);
+        job.run();
+
+        // THEN - the animator is not evaluated but keeps running
+        QVERIFY(handler.runningClipAnimators().isEmpty());
+        QVERIFY(animator->isRunning());
+        QVERIFY(animator->mappingData().isEmpty());
+
+        // WHEN - the clip finishes loading
+        clip->setAnimationFileData(AnimationClip::loadAnimationFile(clip->source()));
+        job.setDirtyClipAnimators(QVector<HClipAnimator>() << animatorHandle);
+        job.run();
+
+        // THEN
+        QVERIFY(!clip->isLoadPending());
+        QVERIFY(clip->duration() > 0.0f);
+        QCOMPARE(handler.runningClipAnimators().size(), 1);
+        QVERIFY(handler.runningClipAnimators().first() == animatorHandle);
+        QVERIFY(animator->isRunning());
+        QCOMPARE(animator->mappingData().size(), 1);
+    }
+
+    void checkZeroDurationClipRuns()
+    {
+        // GIVEN - a pose clip, with a single keyframe
+        Handler handler;
+        AnimationClip *clip = createAnimationClipLoader(&handler, QUrl("qrc:/pose.json"));
+        ClipAnimator *animator = createRunningClipAnimator(&handler, clip);
+        const HClipAnimator animatorHandle = handler.clipAnimatorManager()->getOrAcquireHandle(animator->peerId());
+
+        FindRunningClipAnimatorsJob job;
+        job.setHandler(&handler);
+
+        // WHEN
+        job.setDirtyClipAnimators(QVector<HClipAnimator>() << animatorHandle);
+        job.run();
+
+        // THEN
+        QCOMPARE(clip->duration(), 0.0f);
+        QCOMPARE(clip->channelCount(), 3);
+        QCOMPARE(handler.runningClipAnimators().size(), 1);
+        QVERIFY(handler.runningClipAnimators().first() == animatorHandle);
+        QCOMPARE(animator->mappingData().size(), 1);
+    }
+
+    void checkFailedClipLoadIsNotPending()
+    {
+        // GIVEN - a running animator whose clip file is being loaded
+        Handler handler;
+        AnimationClip *clip = createPendingAnimationClipLoader(&handler, QUrl("qrc:/missing.json"));
+        ClipAnimator *animator = createRunningClipAnimator(&handler, clip);
+        const HClipAnimator animatorHandle = handler.clipAnimatorManager()->getOrAcquireHandle(animator->peerId());
+
+        FindRunningClipAnimatorsJob job;
+        job.setHandler(&handler);
+
+        // WHEN - the file can't be loaded
+        QTest::ignoreMessage(QtWarningMsg, "Could not find animation clip: \":/missing.json\"");
+        clip->setAnimationFileData(AnimationClip::loadAnimationFile(clip->source()));
+        job.setDirtyClipAnimators(QVector<HClipAnimator>() << animatorHandle);
+        job.run();
+
+        // THEN - the animator isn't left waiting for the clip
+        QVERIFY(!clip->isLoadPending());
+        QCOMPARE(clip->status(), Qt3DAnimation::QAnimationClipLoader::Error);
+        QCOMPARE(handler.runningClipAnimators().size(), 1);
+        QVERIFY(handler.runningClipAnimators().first() == animatorHandle);
+    }
 };
 
 QTEST_APPLESS_MAIN(tst_FindRunningClipAnimatorsJob)
@@ -157,15 +157,45 @@ private Q_SLOTS:
         QFETCH(QVector<float>, needles);
         QFETCH(QVector<int>, lowerBounds);
         FunctionRangeFinder finder(x);
+        FunctionRangeFinder::Cursor cursor;
 
         for (int i = 0; i < needles.size(); ++i) {
             // WHEN
-            int result = finder.findLowerBound(needles[i]);
+            int result = finder.findLowerBound(needles[i], cursor);
 
             // THEN
             QCOMPARE(result, lowerBounds[i]);
+            QCOMPARE(finder.findLowerBound(needles[i]), lowerBounds[i]);
         }
     }
+
+    void checkFindLowerBoundWithSeparateCursors()
+    {
+        // GIVEN
+        QVector<float> x(10000);
+        for (int i = 0; i < 10000; ++i)
+            x[i] = float(i);
+        FunctionRangeFinder finder(x);
+        FunctionRangeFinder::Cursor cursor1;
+        FunctionRangeFinder::Cursor cursor2;
+
+        // WHEN
+        // Two users moving forward through different parts of the range
+        for (int i = 0; i < 100; ++i) {
+            const float x1 = 10.5f + float(i);
+            const float x2 = 8000.5f + float(i);
+
+            // THEN
+            QCOMPARE(finder.findLowerBound(x1, cursor1), 10 + i);
+            QCOMPARE(finder.findLowerBound(x2, cursor2), 8000 + i);
+        }
+
+        // Each cursor only follows its own searches
+        QCOMPARE(cursor1.previousLowerBound, 109);
+        QVERIFY(cursor1.correlated);
+        QCOMPARE(cursor2.previousLowerBound, 8099);
+        QVERIFY(cursor2.correlated);
+    }
 };
 
 QTEST_APPLESS_MAIN(tst_FunctionRangeFinder)
@@ -0,0 +1,12 @@
+TEMPLATE = app
+
+TARGET = tst_handler
+
+QT += core-private 3dcore 3dcore-private 3danimation 3danimation-private testlib
+
+CONFIG += testcase
+
+SOURCES += \
+    tst_handler.cpp
+
+include(../../core/common/common.pri)
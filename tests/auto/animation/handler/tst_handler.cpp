@@ -0,0 +1,132 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QTest>
+#include <Qt3DAnimation/private/clipanimator_p.h>
+#include <Qt3DAnimation/private/handler_p.h>
+#include <Qt3DAnimation/private/managers_p.h>
+#include <qbackendnodetester.h>
+
+using namespace Qt3DAnimation::Animation;
+
+class tst_Handler : public Qt3DCore::QBackendNodeTester
+{
+    Q_OBJECT
+public:
+    HClipAnimator createRunningClipAnimator(Handler *handler, Qt3DCore::QNodeId clipId)
+    {
+        auto animatorId = Qt3DCore::QNodeId::createId();
+        ClipAnimator *animator = handler->clipAnimatorManager()->getOrCreateResource(animatorId);
+        setPeerId(animator, animatorId);
+        animator->setHandler(handler);
+        animator->setClipId(clipId);
+        const HClipAnimator handle = handler->clipAnimatorManager()->lookupHandle(animatorId);
+        handler->setClipAnimatorRunning(handle, true);
+        return handle;
+    }
+
+private Q_SLOTS:
+    void checkBatchSize()
+    {
+        // GIVEN
+        Handler handler;
+
+        // WHEN
+        handler.setClipAnimatorBatchSize(16);
+
+        // THEN
+        QCOMPARE(handler.clipAnimatorBatchSize(), 16);
+
+        // WHEN
+        handler.setClipAnimatorBatchSize(0);
+
+        // THEN
+        QCOMPARE(handler.clipAnimatorBatchSize(), 1);
+    }
+
+    void checkRunningClipAnimatorsBatchedByClip()
+    {
+        // GIVEN
+        Handler handler;
+        handler.setClipAnimatorBatchSize(2);
+        const Qt3DCore::QNodeId clipA = Qt3DCore::QNodeId::createId();
+        const Qt3DCore::QNodeId clipB = Qt3DCore::QNodeId::createId();
+        const HClipAnimator a1 = createRunningClipAnimator(&handler, clipA);
+        const HClipAnimator b1 = createRunningClipAnimator(&handler, clipB);
+        const HClipAnimator a2 = createRunningClipAnimator(&handler, clipA);
+        const HClipAnimator a3 = createRunningClipAnimator(&handler, clipA);
+        const HClipAnimator b2 = createRunningClipAnimator(&handler, clipB);
+
+        // WHEN
+        handler.batchRunningClipAnimators();
+
+        // THEN
+        // Animators playing the same clip share a batch, in the order they
+        // started running, until the batch is full
+        const QVector<QVector<HClipAnimator>> expectedBatches = {
+            { a1, a2 },
+            { a3 },
+            { b1, b2 }
+        };
+        QCOMPARE(handler.m_clipAnimatorBatches, expectedBatches);
+
+        // WHEN
+        handler.setClipAnimatorRunning(a2, false);
+        handler.batchRunningClipAnimators();
+
+        // THEN
+        const QVector<QVector<HClipAnimator>> expectedBatchesAfterStop = {
+            { a1, a3 },
+            { b1, b2 }
+        };
+        QCOMPARE(handler.m_clipAnimatorBatches, expectedBatchesAfterStop);
+    }
+
+    void checkBatchSizeOfOne()
+    {
+        // GIVEN
+        Handler handler;
+        handler.setClipAnimatorBatchSize(1);
+        const Qt3DCore::QNodeId clip = Qt3DCore::QNodeId::createId();
+        const HClipAnimator a1 = createRunningClipAnimator(&handler, clip);
+        const HClipAnimator a2 = createRunningClipAnimator(&handler, clip);
+        const HClipAnimator a3 = createRunningClipAnimator(&handler, Qt3DCore::QNodeId());
+
+        // WHEN
+        handler.batchRunningClipAnimators();
+
+        // THEN
+        const QVector<QVector<HClipAnimator>> expectedBatches = { { a1 }, { a2 }, { a3 } };
+        QCOMPARE(handler.m_clipAnimatorBatches, expectedBatches);
+    }
+};
+
+QTEST_MAIN(tst_Handler)
+
+#include "tst_handler.moc"
@@ -0,0 +1,8 @@
+TARGET = tst_boundingvolumekernels
+CONFIG += testcase
+TEMPLATE = app
+
+QT += testlib 3dcore 3dcore-private
+
+SOURCES += \
+    tst_boundingvolumekernels.cpp
@@ -0,0 +1,312 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QtTest>
+#include <Qt3DCore/qattribute.h>
+#include <Qt3DCore/qbuffer.h>
+#include <Qt3DCore/private/buffervisitor_p.h>
+#include <Qt3DCore/private/boundingvolumekernels_p.h>
+#include <Qt3DCore/private/qgeometryview_p.h>
+#include <Qt3DCore/private/vector3d_p.h>
+#include <QtCore/qrandom.h>
+#include <cstring>
+#include <limits>
+
+using namespace Qt3DCore;
+
+namespace {
+
+// Scalar reference, same visitors as the BoundingVolumeCalculators
+class FindExtremePoints : public Buffer3fVisitor
+{
+public:
+    float xMin = 0.0f, xMax = 0.0f, yMin = 0.0f, yMax = 0.0f, zMin = 0.0f, zMax = 0.0f;
+
+    void visit(uint ndx, float x, float y, float z) override
+    {
+        if (ndx) {
+            if (x < xMin)
+                xMin = x;
+            if (x > xMax)
+                xMax = x;
+            if (y < yMin)
+                yMin = y;
+            if (y > yMax)
+                yMax = y;
+            if (z < zMin)
+                zMin = z;
+            if (z > zMax)
+                zMax = z;
+        } else {
+            xMin = xMax = x;
+            yMin = yMax = y;
+            zMin = zMax = z;
+        }
+    }
+};
+
+class FindMaxDistantPoint : public Buffer3fVisitor
+{
+public:
+    float maxLengthSquared = 0.0f;
+    bool setReferencePoint = false;
+    bool hasNoPoints = true;
+    Vector3D maxDistPt;
+    Vector3D referencePt;
+
+    void visit(uint ndx, float x, float y, float z) override
+    {
+        Q_UNUSED(ndx)
+        const Vector3D p = Vector3D(x, y, z);
+
+        if (hasNoPoints && setReferencePoint) {
+            maxLengthSquared = 0.0f;
+            referencePt = p;
+        }
+        const float lengthSquared = (p - referencePt).lengthSquared();
+        if (lengthSquared >= maxLengthSquared) {
+            maxDistPt = p;
+            maxLengthSquared = lengthSquared;
+        }
+        hasNoPoints = false;
+    }
+};
+
+quint32 bits(float f)
+{
+    quint32 b;
+    std::memcpy(&b, &f, sizeof(float));
+    return b;
+}
+
+// Positions are stored with stride floats per vertex after offset floats
+QByteArray makePositions(const QVector<QVector3D> &points, uint stride, uint offset)
+{
+    QVector<float> rawData(int(offset + stride * (points.size() - 1) + 3), 42.0f);
+    for (int i = 0, m = points.size(); i < m; ++i) {
+        float *p = rawData.data() + offset + i * stride;
+        p[0] = points.at(i).x();
+        p[1] = points.at(i).y();
+        p[2] = points.at(i).z();
+    }
+    return QByteArray(reinterpret_cast<const char *>(rawData.constData()),
+                      rawData.size() * int(sizeof(float)));
+}
+
+} // anonymous
+
+class tst_BoundingVolumeKernels : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void checkSameResultsAsVisitors_data()
+    {
+        QTest::addColumn<QVector<QVector3D>>("points");
+        QTest::addColumn<uint>("stride");
+        QTest::addColumn<uint>("offset");
+
+        QTest::newRow("single point") << QVector<QVector3D>{ { 1.0f, 2.0f, 3.0f } } << 3U << 0U;
+        QTest::newRow("three points") << QVector<QVector3D>{ { -1.0f, 0.0f, 0.0f },
+                                                             { 1.0f, 2.0f, 0.5f },
+                                                             { 0.0f, -4.0f, 8.0f } } << 3U << 0U;
+
+        // Several points at the same distance, the last one should win
+        QVector<QVector3D> ties;
+        for (int i = 0; i < 37; ++i)
+            ties.push_back(QVector3D(float(i % 3 - 1), float(i % 2), float(i % 5 - 2)));
+        QTest::newRow("ties") << ties << 3U << 0U;
+
+        QVector<QVector3D> zeros;
+        for (int i = 0; i < 19; ++i)
+            zeros.push_back(QVector3D(i % 2 ? 0.0f : -0.0f, i % 3 ? -0.0f : 0.0f, 0.0f));
+        QTest::newRow("signed zeros") << zeros << 3U << 0U;
+
+        QRandomGenerator generator(883);
+        const auto randomPoints = [&generator] (int count, float range) {
+            QVector<QVector3D> points;
+            points.reserve(count);
+            for (int i = 0; i < count; ++i)
+                points.push_back(QVector3D(float(generator.bounded(2.0 * range) - range),
+                                           float(generator.bounded(2.0 * range) - range),
+                                           float(generator.bounded(2.0 * range) - range)));
+            return points;
+        };
+        const QVector<QVector3D> cloud = randomPoints(10001, 1000.0f);
+        QTest::newRow("tightly packed") << cloud << 3U << 0U;
+        QTest::newRow("with offset") << cloud << 3U << 1U;
+        QTest::newRow("interleaved normals") << cloud << 6U << 0U;
+        QTest::newRow("interleaved normals and uvs") << cloud << 8U << 3U;
+        QTest::newRow("small values") << randomPoints(1023, 1e-3f) << 4U << 0U;
+
+        QVector<QVector3D> withNaN = randomPoints(515, 10.0f);
+        withNaN[0].setX(std::numeric_limits<float>::quiet_NaN());
+        withNaN[200].setY(std::numeric_limits<float>::quiet_NaN());
+        QTest::newRow("NaN") << withNaN << 3U << 0U;
+    }
+
+    void checkSameResultsAsVisitors()
+    {
+        // GIVEN
+        QFETCH(QVector<QVector3D>, points);
+        QFETCH(uint, stride);
+        QFETCH(uint, offset);
+
+        const QByteArray data = makePositions(points, stride, offset);
+        Qt3DCore::QBuffer buffer;
+        buffer.setData(data);
+        QAttribute attribute(&buffer, QAttribute::defaultPositionAttributeName(),
+                             QAttribute::Float, 3, uint(points.size()),
+                             offset * uint(sizeof(float)), stride * uint(sizeof(float)));
+        const float *coordinates = reinterpret_cast<const float *>(data.constData()) + offset;
+        const uint count = uint(points.size());
+
+        FindExtremePoints findExtremePoints;
+        QVERIFY(findExtremePoints.apply(&attribute, nullptr, int(count), false, -1));
+        FindMaxDistantPoint maxDistantPointY;
+        maxDistantPointY.setReferencePoint = true;
+        QVERIFY(maxDistantPointY.apply(&attribute, nullptr, int(count), false, -1));
+        FindMaxDistantPoint maxDistantPointZ;
+        maxDistantPointZ.referencePt = maxDistantPointY.maxDistPt;
+        QVERIFY(maxDistantPointZ.apply(&attribute, nullptr, int(count), false, -1));
+        const Vector3D expectedCenter = (maxDistantPointY.maxDistPt + maxDistantPointZ.maxDistPt) * .5f;
+        FindMaxDistantPoint maxDistantPointCenter;
+        maxDistantPointCenter.referencePt = expectedCenter;
+        QVERIFY(maxDistantPointCenter.apply(&attribute, nullptr, int(count), false, -1));
+        const float expectedRadius = (expectedCenter - maxDistantPointCenter.maxDistPt).length();
+
+        // WHEN
+        QVector3D min, max, center;
+        float radius = -1.0f;
+        const bool success = BoundingVolumeKernels::computeBoundingVolume(coordinates, stride, count,
+                                                                          min, max, center, radius);
+
+        // THEN
+        QVERIFY(success);
+        QCOMPARE(bits(min.x()), bits(findExtremePoints.xMin));
+        QCOMPARE(bits(min.y()), bits(findExtremePoints.yMin));
+        QCOMPARE(bits(min.z()), bits(findExtremePoints.zMin));
+        QCOMPARE(bits(max.x()), bits(findExtremePoints.xMax));
+        QCOMPARE(bits(max.y()), bits(findExtremePoints.yMax));
+        QCOMPARE(bits(max.z()), bits(findExtremePoints.zMax));
+        QCOMPARE(bits(center.x()), bits(expectedCenter.x()));
+        QCOMPARE(bits(center.y()), bits(expectedCenter.y()));
+        QCOMPARE(bits(center.z()), bits(expectedCenter.z()));
+        QCOMPARE(bits(radius), bits(expectedRadius));
+    }
+
+    void checkFindFurthestPoint()
+    {
+        // GIVEN
+        const QVector<QVector3D> points = { { 0.0f, 0.0f, 0.0f },
+                                            { 5.0f, 0.0f, 0.0f },
+                                            { 0.0f, -5.0f, 0.0f },
+                                            { 1.0f, 1.0f, 1.0f },
+                                            { 0.0f, 0.0f, 5.0f },
+                                            { 2.0f, 0.0f, 0.0f } };
+        const QByteArray data = makePositions(points, 3, 0);
+        const float *coordinates = reinterpret_cast<const float *>(data.constData());
+
+        // THEN
+        QCOMPARE(BoundingVolumeKernels::findFurthestPoint(coordinates, 3, uint(points.size()), QVector3D()), 4);
+        QCOMPARE(BoundingVolumeKernels::findFurthestPoint(coordinates, 3, 4, QVector3D()), 2);
+        QCOMPARE(BoundingVolumeKernels::findFurthestPoint(coordinates, 3, 1, QVector3D()), 0);
+        QCOMPARE(BoundingVolumeKernels::findFurthestPoint(coordinates, 3, uint(points.size()),
+                                                          QVector3D(0.0f, 0.0f, 5.0f)), 2);
+    }
+
+    void checkEmpty()
+    {
+        // GIVEN
+        const float coordinates[3] = { 1.0f, 2.0f, 3.0f };
+        QVector3D min, max, center;
+        float radius = -1.0f;
+
+        // THEN
+        QVERIFY(!BoundingVolumeKernels::computeBoundingVolume(coordinates, 3, 0, min, max, center, radius));
+        QCOMPARE(BoundingVolumeKernels::findFurthestPoint(coordinates, 3, 0, QVector3D()), -1);
+        QCOMPARE(radius, -1.0f);
+    }
+    void checkCalculatorOnlyUsesKernelsForFloat3Positions()
+    {
+        // GIVEN
+        const QVector<QVector3D> points = { { -1.0f, 0.0f, 0.0f },
+                                            { 1.0f, 0.0f, 0.0f },
+                                            { 0.0f, 2.0f, 0.0f } };
+        Qt3DCore::QBuffer buffer;
+        buffer.setData(makePositions(points, 3, 0));
+
+        // WHEN
+        QAttribute positions(&buffer, QAttribute::defaultPositionAttributeName(),
+                             QAttribute::Float, 3, uint(points.size()));
+        BoundingVolumeCalculator calculator;
+
+        // THEN
+        QVERIFY(calculator.apply(&positions, nullptr, points.size(), false, -1));
+        QVERIFY(calculator.isValid());
+        QCOMPARE(calculator.min(), QVector3D(-1.0f, 0.0f, 0.0f));
+        QCOMPARE(calculator.max(), QVector3D(1.0f, 2.0f, 0.0f));
+
+        // WHEN
+        QAttribute vec2Positions(&buffer, QAttribute::defaultPositionAttributeName(),
+                                 QAttribute::Float, 2, uint(points.size()));
+        BoundingVolumeCalculator vec2Calculator;
+
+        // THEN
+        QVERIFY(!vec2Calculator.apply(&vec2Positions, nullptr, points.size(), false, -1));
+        QVERIFY(!vec2Calculator.isValid());
+
+        // WHEN
+        Qt3DCore::QBuffer ushortBuffer;
+        const quint16 ushortData[] = { 0, 0, 0, 1, 1, 1, 2, 2, 2 };
+        ushortBuffer.setData(QByteArray(reinterpret_cast<const char *>(ushortData), sizeof(ushortData)));
+        QAttribute ushortPositions(&ushortBuffer, QAttribute::defaultPositionAttributeName(),
+                                   QAttribute::UnsignedShort, 3, 3);
+        BoundingVolumeCalculator ushortCalculator;
+
+        // THEN
+        QVERIFY(!ushortCalculator.apply(&ushortPositions, nullptr, 3, false, -1));
+        QVERIFY(!ushortCalculator.isValid());
+
+        // WHEN
+        QAttribute noBufferPositions;
+        noBufferPositions.setVertexBaseType(QAttribute::Float);
+        noBufferPositions.setVertexSize(3);
+        noBufferPositions.setCount(3);
+        BoundingVolumeCalculator noBufferCalculator;
+
+        // THEN
+        QVERIFY(!noBufferCalculator.apply(&noBufferPositions, nullptr, 3, false, -1));
+        QVERIFY(!noBufferCalculator.isValid());
+    }
+};
+
+QTEST_MAIN(tst_BoundingVolumeKernels)
+
+#include "tst_boundingvolumekernels.moc"
@@ -0,0 +1,7 @@
+TARGET = tst_chrometracewriter
+CONFIG += testcase
+TEMPLATE = app
+
+SOURCES += tst_chrometracewriter.cpp
+
+QT += testlib 3dcore 3dcore-private core-private
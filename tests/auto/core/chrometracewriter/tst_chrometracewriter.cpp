@@ -0,0 +1,168 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QTest>
+#include <QBuffer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <Qt3DCore/private/chrometracewriter_p.h>
+
+using namespace Qt3DCore::Debug;
+using JobRunStats = Qt3DCore::QSystemInformationServicePrivate::JobRunStats;
+
+namespace {
+
+JobRunStats jobStats(quint32 type, qint64 start, qint64 end, quint32 nameId)
+{
+    JobRunStats stats;
+    stats.jobId.typeAndInstance[0] = type;
+    stats.jobId.typeAndInstance[1] = 0;
+    stats.startTime = start;
+    stats.endTime = end;
+    stats.threadId = 42;
+    stats.nameId = nameId;
+    return stats;
+}
+
+QJsonArray parse(const QByteArray &data)
+{
+    QJsonParseError error;
+    const QJsonDocument document = QJsonDocument::fromJson(data, &error);
+    if (error.error != QJsonParseError::NoError)
+        qWarning() << error.errorString();
+    return document.array();
+}
+
+QStringList frameMarkers(const QJsonArray &events)
+{
+    QStringList markers;
+    for (const QJsonValue &event : events) {
+        if (event.toObject().value(QLatin1String("ph")).toString() == QLatin1String("i"))
+            markers << event.toObject().value(QLatin1String("name")).toString();
+    }
+    return markers;
+}
+
+} // anonymous
+
+class tst_ChromeTraceWriter : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void checkEvents()
+    {
+        // GIVEN
+        ChromeTraceWriter writer(4);
+        const QStringList names = { QString(), QStringLiteral("RenderView") };
+
+        // WHEN
+        writer.addFrame(7, 5000,
+                        { jobStats(11, 1000, 3500, 1), jobStats(4096, 0, 500, 0) },
+                        { jobStats(15, 4000, 4500, 0) },
+                        names);
+        QBuffer buffer;
+        buffer.open(QIODevice::WriteOnly);
+
+        // THEN
+        QVERIFY(writer.dump(&buffer, names));
+        const QJsonArray events = parse(buffer.data());
+        QCOMPARE(events.size(), 4);
+
+        const QJsonObject marker = events.at(0).toObject();
+        QCOMPARE(marker.value(QLatin1String("name")).toString(), QStringLiteral("Frame 7"));
+        QCOMPARE(marker.value(QLatin1String("ts")).toDouble(), 5.0);
+
+        const QJsonObject job = events.at(1).toObject();
+        QCOMPARE(job.value(QLatin1String("name")).toString(), QStringLiteral("RenderView"));
+        QCOMPARE(job.value(QLatin1String("cat")).toString(), QStringLiteral("job"));
+        QCOMPARE(job.value(QLatin1String("ph")).toString(), QStringLiteral("X"));
+        QCOMPARE(job.value(QLatin1String("ts")).toDouble(), 1.0);
+        QCOMPARE(job.value(QLatin1String("dur")).toDouble(), 2.5);
+        QCOMPARE(job.value(QLatin1String("tid")).toInt(), 42);
+        QCOMPARE(job.value(QLatin1String("args")).toObject().value(QLatin1String("frame")).toInt(), 7);
+
+        QCOMPARE(events.at(2).toObject().value(QLatin1String("name")).toString(), QStringLiteral("Job 4096"));
+        QCOMPARE(events.at(3).toObject().value(QLatin1String("name")).toString(), QStringLiteral("Submission 15"));
+        QCOMPARE(events.at(3).toObject().value(QLatin1String("cat")).toString(), QStringLiteral("submission"));
+    }
+
+    void checkRingBufferKeepsLastFrames()
+    {
+        // GIVEN
+        ChromeTraceWriter writer(3);
+        QVERIFY(writer.isRingBuffer());
+
+        // WHEN
+        for (quint32 frame = 0; frame < 5; ++frame)
+            writer.addFrame(frame, frame * 1000, { jobStats(1, frame * 1000, frame * 1000 + 10, 0) }, {}, {});
+        QBuffer buffer;
+        buffer.open(QIODevice::WriteOnly);
+
+        // THEN
+        QCOMPARE(writer.frameCount(), 3);
+        QVERIFY(writer.dump(&buffer, {}));
+        const QJsonArray events = parse(buffer.data());
+        QCOMPARE(events.size(), 6);
+        QCOMPARE(frameMarkers(events), QStringList() << QStringLiteral("Frame 2")
+                                                     << QStringLiteral("Frame 3")
+                                                     << QStringLiteral("Frame 4"));
+    }
+
+    void checkStreaming()
+    {
+        // GIVEN
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString fileName = dir.filePath(QStringLiteral("trace.json"));
+        ChromeTraceWriter writer;
+        QVERIFY(!writer.isRingBuffer());
+
+        // WHEN
+        QVERIFY(writer.open(fileName));
+        writer.addFrame(0, 100, { jobStats(1, 0, 10, 0) }, {}, {});
+        writer.addFrame(1, 200, { jobStats(1, 100, 110, 0) }, {}, {});
+        writer.close();
+
+        // THEN
+        QCOMPARE(writer.frameCount(), 2);
+        QFile file(fileName);
+        QVERIFY(file.open(QFile::ReadOnly));
+        const QJsonArray events = parse(file.readAll());
+        QCOMPARE(events.size(), 4);
+        QCOMPARE(frameMarkers(events), QStringList() << QStringLiteral("Frame 0")
+                                                     << QStringLiteral("Frame 1"));
+    }
+};
+
+QTEST_APPLESS_MAIN(tst_ChromeTraceWriter)
+
+#include "tst_chrometracewriter.moc"
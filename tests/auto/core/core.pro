@@ -19,11 +19,14 @@ qtConfig(private_tests) {
     SUBDIRS += \
         qentity \
         qtransform \
+        boundingvolumekernels \
         threadpooler \
         vector4d_base \
         vector3d_base \
         aspectcommanddebugger \
-        qscheduler
+        qscheduler \
+        chrometracewriter \
+        qloadgltf
 
         QT_FOR_CONFIG += 3dcore-private
         qtConfig(qt3d-simd-sse2) {
@@ -39,6 +39,7 @@
 
 #include <Qt3DCore/private/qnode_p.h>
 #include <Qt3DCore/private/qcomponent_p.h>
+#include <QMutex>
 #include <QSignalSpy>
 #include <testarbiter.h>
 
@@ -99,10 +100,12 @@ private slots:
     void checkDefaultConstruction();
     void checkPropertyChanges();
     void checkEnabledUpdate();
+    void checkDirtyPropertiesUpdate();
     void checkPropertyTrackModeUpdate();
     void checkTrackedPropertyNamesUpdate();
 
     void checkNodeRemovedFromDirtyListOnDestruction();
+    void checkDirtyNodesSyncOrder();
 };
 
 class MyQNode : public Qt3DCore::QNode
@@ -383,6 +386,8 @@ public:
 
     mutable QVector<Event> events;
     mutable QHash<Qt3DCore::QNodeId, Qt3DCore::QNode *> allNodes;
+    mutable QMutex syncedNodesMutex;
+    mutable QVector<Qt3DCore::QNodeId> syncedNodes;
 
 private:
     Q_DECLARE_PRIVATE(TestAspect)
@@ -429,8 +434,12 @@ public:
     {
         Q_UNUSED(backend);
         auto q = q_func();
-        if (firstTime)
+        if (firstTime) {
             q->allNodes.insert(node->id(), node);
+        } else {
+            QMutexLocker lock(&q->syncedNodesMutex);
+            q->syncedNodes.push_back(node->id());
+        }
     }
 
     Q_DECLARE_PUBLIC(TestAspect)
@@ -1662,6 +1671,115 @@ void tst_Nodes::checkEnabledUpdate()
 
 }
 
+void tst_Nodes::checkDirtyPropertiesUpdate()
+{
+    // GIVEN
+    TestArbiter arbiter;
+    MyQNode node;
+    arbiter.setArbiterOnNode(&node);
+    Qt3DCore::QNodePrivate *d = Qt3DCore::QNodePrivate::get(&node);
+    const quint64 enabledMask = Qt3DCore::QNodePrivate::propertyDirtyMask(MyQNode::staticMetaObject, { "enabled" });
+    const quint64 customMask = Qt3DCore::QNodePrivate::propertyDirtyMask(MyQNode::staticMetaObject, { "customProperty" });
+
+    // THEN
+    QVERIFY(enabledMask != customMask);
+    QCOMPARE(d->dirtyProperties(), quint64(0));
+
+    {
+        // WHEN
+        node.setCustomProperty(QStringLiteral("foo"));
+
+        // THEN
+        QCOMPARE(arbiter.dirtyNodes().size(), 1);
+        QVERIFY(d->hasDirtyProperties(customMask));
+        QVERIFY(!d->hasDirtyProperties(enabledMask));
+
+        // WHEN
+        node.setEnabled(false);
+
+        // THEN
+        QCOMPARE(arbiter.dirtyNodes().size(), 1);
+        QCOMPARE(d->dirtyProperties(), customMask | enabledMask);
+
+        arbiter.clear();
+        d->clearDirtyProperties();
+    }
+
+    {
+        // WHEN -> changes not tied to a property mark everything dirty
+        d->update();
+
+        // THEN
+        QCOMPARE(arbiter.dirtyNodes().size(), 1);
+        QCOMPARE(d->dirtyProperties(), Qt3DCore::QNodePrivate::AllPropertiesDirty);
+
+        arbiter.clear();
+        d->clearDirtyProperties();
+    }
+
+    {
+        // WHEN
+        const bool blocked = node.blockNotifications(true);
+        node.setCustomProperty(QStringLiteral("bar"));
+        node.blockNotifications(blocked);
+
+        // THEN
+        QCOMPARE(arbiter.dirtyNodes().size(), 0);
+        QCOMPARE(d->dirtyProperties(), quint64(0));
+    }
+}
+
+void tst_Nodes::checkDirtyNodesSyncOrder()
+{
+    // GIVEN
+    TestAspect aspect;
+    Qt3DCore::QAbstractAspectPrivate *d = Qt3DCore::QAbstractAspectPrivate::get(&aspect);
+    d->registerThreadSafeBackendSync(MyQNode::staticMetaObject);
+    Qt3DCore::QNode root;
+
+    auto createNode = [&] (const QMetaObject &type) -> Qt3DCore::QNode * {
+        Qt3DCore::QNode *node = &type == &MyQNode::staticMetaObject
+                ? static_cast<Qt3DCore::QNode *>(new MyQNode(&root))
+                : static_cast<Qt3DCore::QNode *>(new Qt3DCore::QEntity(&root));
+        Qt3DCore::QNodePrivate::get(node)->m_typeInfo = const_cast<QMetaObject *>(&type);
+        d->m_backendCreatorFunctors.value(&type)->create(node->id());
+        return node;
+    };
+
+    {
+        // WHEN -> few nodes of the thread-safe type
+        const QVector<Qt3DCore::QNode *> nodes = {
+            createNode(MyQNode::staticMetaObject),
+            createNode(Qt3DCore::QEntity::staticMetaObject),
+            createNode(MyQNode::staticMetaObject),
+        };
+        d->syncDirtyFrontEndNodes(nodes);
+
+        // THEN -> synced in place
+        QCOMPARE(aspect.syncedNodes, QVector<Qt3DCore::QNodeId>({ nodes[0]->id(), nodes[1]->id(), nodes[2]->id() }));
+        aspect.syncedNodes.clear();
+    }
+
+    {
+        // WHEN -> enough nodes of the thread-safe type to sync them concurrently
+        QVector<Qt3DCore::QNode *> nodes;
+        for (int i = 0; i < 300; ++i)
+            nodes.push_back(createNode(MyQNode::staticMetaObject));
+        Qt3DCore::QNode *entity = createNode(Qt3DCore::QEntity::staticMetaObject);
+        nodes.push_back(entity);
+        d->syncDirtyFrontEndNodes(nodes);
+
+        // THEN
+        QCOMPARE(aspect.syncedNodes.size(), nodes.size());
+        for (Qt3DCore::QNode *node : qAsConst(nodes))
+            QCOMPARE(aspect.syncedNodes.count(node->id()), 1);
+#if QT_CONFIG(concurrent)
+        // The grouped type is synced after the other nodes
+        QCOMPARE(aspect.syncedNodes.first(), entity->id());
+#endif
+    }
+}
+
 void tst_Nodes::checkPropertyTrackModeUpdate()
 {
     // GIVEN
@@ -0,0 +1,7 @@
+TARGET = tst_qloadgltf
+CONFIG += testcase
+TEMPLATE = app
+
+SOURCES += tst_qloadgltf.cpp
+
+QT += testlib 3dcore 3dcore-private
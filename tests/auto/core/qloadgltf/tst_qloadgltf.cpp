@@ -0,0 +1,259 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QTest>
+#include <QtCore/qendian.h>
+#include <Qt3DCore/private/qloadgltf_p.h>
+
+namespace {
+
+const quint32 jsonChunkType = 0x4E4F534A;
+const quint32 binChunkType = 0x004E4942;
+
+void appendUInt32(QByteArray &data, quint32 value)
+{
+    char bytes[4];
+    qToLittleEndian(value, bytes);
+    data.append(bytes, 4);
+}
+
+void appendChunk(QByteArray &data, quint32 type, const QByteArray &content,
+                 char padding, quint32 length)
+{
+    appendUInt32(data, length);
+    appendUInt32(data, type);
+    data.append(content);
+    while (data.size() % 4)
+        data.append(padding);
+}
+
+void appendChunk(QByteArray &data, quint32 type, const QByteArray &content, char padding)
+{
+    appendChunk(data, type, content, padding, quint32(content.size()));
+}
+
+QByteArray glbHeader(quint32 version = 2)
+{
+    QByteArray data;
+    appendUInt32(data, 0x46546C67); // "glTF"
+    appendUInt32(data, version);
+    appendUInt32(data, 0);
+    return data;
+}
+
+void setTotalLength(QByteArray &data, quint32 length)
+{
+    qToLittleEndian(length, data.data() + 8);
+}
+
+void setTotalLength(QByteArray &data)
+{
+    setTotalLength(data, quint32(data.size()));
+}
+
+const QByteArray json = QByteArrayLiteral("{\"asset\":{\"version\":\"2.0\"},\"buffers\":[{\"byteLength\":5}]}");
+const QByteArray binary = QByteArrayLiteral("\x01\x02\x03\x04\x05");
+
+QByteArray validGLB()
+{
+    QByteArray data = glbHeader();
+    appendChunk(data, jsonChunkType, json, ' ');
+    appendChunk(data, binChunkType, binary, '\0');
+    setTotalLength(data);
+    return data;
+}
+
+} // anonymous
+
+class tst_QLoadGLTF : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+
+    void checkIsGLB()
+    {
+        QVERIFY(qIsGLB(validGLB()));
+        QVERIFY(!qIsGLB(json));
+        QVERIFY(!qIsGLB(QByteArray()));
+        QVERIFY(!qIsGLB(validGLB().left(11)));
+    }
+
+    void checkValidGLB()
+    {
+        // GIVEN
+        const QByteArray data = validGLB();
+        QByteArray jsonChunk;
+        qsizetype binaryOffset = 0;
+        qsizetype binaryLength = 0;
+
+        // THEN
+        QVERIFY(qParseGLB(data, &jsonChunk, &binaryOffset, &binaryLength));
+        QCOMPARE(jsonChunk, json);
+        QVERIFY(binaryOffset > 0);
+        QCOMPARE(binaryLength, binary.size());
+        QCOMPARE(data.mid(binaryOffset, binaryLength), binary);
+
+        // WHEN
+        QByteArray binaryChunk;
+        const QJsonDocument document = qLoadGLTF(data, &binaryChunk);
+
+        // THEN
+        QVERIFY(document.isObject());
+        QCOMPARE(document.object().value(QLatin1String("asset")).toObject()
+                 .value(QLatin1String("version")).toString(), QLatin1String("2.0"));
+        QCOMPARE(binaryChunk, binary);
+        QVERIFY(qLoadGLTF(data).isObject());
+    }
+
+    void checkMissingBinaryChunk()
+    {
+        // GIVEN
+        QByteArray data = glbHeader();
+        appendChunk(data, jsonChunkType, json, ' ');
+        setTotalLength(data);
+        QByteArray jsonChunk;
+        qsizetype binaryOffset = 0;
+        qsizetype binaryLength = 0;
+
+        // THEN
+        QVERIFY(qParseGLB(data, &jsonChunk, &binaryOffset, &binaryLength));
+        QCOMPARE(jsonChunk, json);
+        QCOMPARE(binaryOffset, qsizetype(-1));
+        QCOMPARE(binaryLength, qsizetype(0));
+
+        // WHEN
+        QByteArray binaryChunk = QByteArrayLiteral("stale");
+        const QJsonDocument document = qLoadGLTF(data, &binaryChunk);
+
+        // THEN
+        QVERIFY(document.isObject());
+        QVERIFY(binaryChunk.isEmpty());
+    }
+
+    void checkUnknownChunksAreSkipped()
+    {
+        // GIVEN
+        QByteArray data = glbHeader();
+        appendChunk(data, jsonChunkType, json, ' ');
+        appendChunk(data, 0x12345678, QByteArrayLiteral("extension"), '\0');
+        appendChunk(data, binChunkType, binary, '\0');
+        setTotalLength(data);
+
+        // WHEN
+        QByteArray binaryChunk;
+        const QJsonDocument document = qLoadGLTF(data, &binaryChunk);
+
+        // THEN
+        QVERIFY(document.isObject());
+        QCOMPARE(binaryChunk, binary);
+    }
+
+    void checkInvalidGLB_data()
+    {
+        QTest::addColumn<QByteArray>("data");
+
+        {
+            QByteArray data = validGLB();
+            data.chop(4);
+            QTest::newRow("truncated") << data;
+        }
+        {
+            QByteArray data = glbHeader();
+            appendChunk(data, jsonChunkType, json, ' ');
+            appendChunk(data, binChunkType, binary, '\0', 0xFFFFFFF0);
+            setTotalLength(data);
+            QTest::newRow("oversized chunk length") << data;
+        }
+        {
+            QByteArray data = glbHeader();
+            appendChunk(data, jsonChunkType, json, ' ', 0x80000000);
+            setTotalLength(data);
+            QTest::newRow("chunk length above INT_MAX") << data;
+        }
+        {
+            QByteArray data = validGLB();
+            setTotalLength(data, 0xFFFFFFFF);
+            data.chop(4);
+            QTest::newRow("total length larger than the file") << data;
+        }
+        {
+            QByteArray data = glbHeader();
+            appendChunk(data, binChunkType, binary, '\0');
+            appendChunk(data, jsonChunkType, json, ' ');
+            setTotalLength(data);
+            QTest::newRow("JSON chunk not first") << data;
+        }
+        {
+            QByteArray data = glbHeader();
+            setTotalLength(data);
+            QTest::newRow("no chunk") << data;
+        }
+        {
+            QByteArray data = glbHeader(1);
+            appendChunk(data, jsonChunkType, json, ' ');
+            setTotalLength(data);
+            QTest::newRow("version 1") << data;
+        }
+    }
+
+    void checkInvalidGLB()
+    {
+        // GIVEN
+        QFETCH(QByteArray, data);
+        QByteArray jsonChunk;
+        qsizetype binaryOffset = 0;
+        qsizetype binaryLength = 0;
+
+        // THEN
+        QVERIFY(!qParseGLB(data, &jsonChunk, &binaryOffset, &binaryLength));
+
+        // WHEN
+        QByteArray binaryChunk = QByteArrayLiteral("stale");
+        const QJsonDocument document = qLoadGLTF(data, &binaryChunk);
+
+        // THEN
+        QVERIFY(document.isNull());
+        QVERIFY(binaryChunk.isEmpty());
+    }
+
+    void checkPlainJson()
+    {
+        // WHEN
+        QByteArray binaryChunk = QByteArrayLiteral("stale");
+        const QJsonDocument document = qLoadGLTF(json, &binaryChunk);
+
+        // THEN
+        QVERIFY(document.isObject());
+        QVERIFY(binaryChunk.isEmpty());
+    }
+};
+
+QTEST_APPLESS_MAIN(tst_QLoadGLTF)
+
+#include "tst_qloadgltf.moc"
@@ -50,6 +50,7 @@ private slots:
     void heavyDutyMultiThreadedAccessRelease();
     void collectResources();
     void activeHandles();
+    void releaseKeepsActiveHandlesDense();
     void checkCleanup();
 };
 
@@ -393,6 +394,7 @@ void tst_QResourceManager::activeHandles()
 {
     // GIVEN
     Qt3DCore::QResourceManager<tst_ArrayResource, uint> manager;
+    quint64 revision = manager.activeHandlesRevision();
 
     {
         // WHEN
@@ -400,6 +402,13 @@ void tst_QResourceManager::activeHandles()
         // THEN
         QCOMPARE(manager.activeHandles().size(), 1);
         QCOMPARE(manager.activeHandles().first(), newHandle);
+        QVERIFY(manager.activeHandlesRevision() != revision);
+        revision = manager.activeHandlesRevision();
+
+        // WHEN
+        manager.getOrAcquireHandle(883U);
+        // THEN
+        QCOMPARE(manager.activeHandlesRevision(), revision);
     }
 
     {
@@ -407,6 +416,7 @@ void tst_QResourceManager::activeHandles()
         manager.releaseResource(883U);
         // THEN
         QVERIFY(manager.activeHandles().empty());
+        QVERIFY(manager.activeHandlesRevision() != revision);
     }
 
     {
@@ -423,6 +433,58 @@ void tst_QResourceManager::activeHandles()
     }
 }
 
+void tst_QResourceManager::releaseKeepsActiveHandlesDense()
+{
+    // GIVEN
+    Qt3DCore::QResourceManager<tst_ArrayResource, uint> manager;
+    QVector<tHandle> handles;
+    for (uint i = 0; i < 1024; ++i) {
+        handles << manager.getOrAcquireHandle(i);
+        manager.data(handles.last())->m_value = int(i);
+    }
+
+    // WHEN
+    for (uint i = 0; i < 1024; i += 3)
+        manager.releaseResource(i);
+    // Releasing twice or through a stale handle is a no-op
+    manager.release(handles.first());
+
+    // THEN
+    QVector<tHandle> expected;
+    for (uint i = 0; i < 1024; ++i) {
+        if (i % 3 != 0)
+            expected << handles.at(i);
+    }
+    QVector<tHandle> actual = manager.activeHandles();
+    QCOMPARE(manager.count(), expected.size());
+    std::sort(expected.begin(), expected.end(), [] (const tHandle &a, const tHandle &b) { return a.handle() < b.handle(); });
+    std::sort(actual.begin(), actual.end(), [] (const tHandle &a, const tHandle &b) { return a.handle() < b.handle(); });
+    QCOMPARE(actual, expected);
+
+    // WHEN
+    int visited = 0;
+    int sum = 0;
+    manager.for_each([&] (tst_ArrayResource *r) {
+        ++visited;
+        sum += r->m_value;
+    });
+
+    // THEN -> free slots are skipped
+    int expectedSum = 0;
+    for (const tHandle &h : qAsConst(expected))
+        expectedSum += manager.data(h)->m_value;
+    QCOMPARE(visited, expected.size());
+    QCOMPARE(sum, expectedSum);
+
+    // WHEN
+    for (uint i = 0; i < 1024; ++i)
+        manager.releaseResource(i);
+
+    // THEN
+    QCOMPARE(manager.count(), 0);
+    QVERIFY(manager.activeHandles().empty());
+}
+
 void tst_QResourceManager::checkCleanup()
 {
     // GIVEN
@@ -28,6 +28,7 @@
 
 #include <QtTest/QtTest>
 #include <Qt3DCore/private/qscene_p.h>
+#include <Qt3DCore/private/qnodebatchlookup_p.h>
 #include <Qt3DCore/qnode.h>
 #include <Qt3DCore/qentity.h>
 #include <Qt3DCore/qcomponent.h>
@@ -44,6 +45,10 @@ public:
 private slots:
     void addNodeObservable();
     void removeNodeObservable();
+    void lookupNodes();
+    void destructionGeneration();
+    void batchLookupResolvesAgainAfterRemoval();
+    void batchLookupWithoutRemovalTracking();
     void addChildNode();
     void deleteChildNode();
     void removeChildNode();
@@ -115,6 +120,147 @@ void tst_QScene::removeNodeObservable()
     QVERIFY(scene->lookupNode(node2->id()) == node2);
 }
 
+void tst_QScene::lookupNodes()
+{
+    // GIVEN
+    Qt3DCore::QNode *node1 = new tst_Node();
+    Qt3DCore::QNode *node2 = new tst_Node();
+    Qt3DCore::QNode *node3 = new tst_Node();
+
+    Qt3DCore::QScene *scene = new Qt3DCore::QScene;
+    scene->setArbiter(new TestArbiter);
+
+    scene->addObservable(node1);
+    scene->addObservable(node2);
+    scene->addObservable(node3);
+    scene->removeObservable(node2);
+
+    // WHEN
+    const QVector<Qt3DCore::QNodeId> ids = { node1->id(), node1->id(), node2->id(),
+                                             Qt3DCore::QNodeId(), node3->id(), node1->id() };
+    const QVector<Qt3DCore::QNode *> nodes = scene->lookupNodes(ids);
+
+    // THEN
+    QCOMPARE(nodes.size(), ids.size());
+    QCOMPARE(nodes.at(0), node1);
+    QCOMPARE(nodes.at(1), node1);
+    QVERIFY(nodes.at(2) == nullptr);
+    QVERIFY(nodes.at(3) == nullptr);
+    QCOMPARE(nodes.at(4), node3);
+    QCOMPARE(nodes.at(5), node1);
+
+    // WHEN
+    const QVector<Qt3DCore::QNode *> noNodes = scene->lookupNodes({});
+
+    // THEN
+    QVERIFY(noNodes.isEmpty());
+}
+
+void tst_QScene::destructionGeneration()
+{
+    // GIVEN
+    Qt3DCore::QScene *scene = new Qt3DCore::QScene;
+    scene->setArbiter(new TestArbiter);
+    const int generation = scene->destructionGeneration();
+
+    // WHEN
+    Qt3DCore::QNode *node1 = new tst_Node();
+    Qt3DCore::QNode *node2 = new tst_Node();
+    scene->addObservable(node1);
+    scene->addObservable(node2);
+
+    // THEN
+    QCOMPARE(scene->destructionGeneration(), generation);
+
+    // WHEN
+    scene->removeObservable(node1);
+
+    // THEN
+    QVERIFY(scene->destructionGeneration() != generation);
+}
+
+void tst_QScene::batchLookupResolvesAgainAfterRemoval()
+{
+    // GIVEN
+    Qt3DCore::QNode *node1 = new tst_Node();
+    Qt3DCore::QNode *node2 = new tst_Node();
+    Qt3DCore::QNode *node3 = new tst_Node();
+
+    Qt3DCore::QScene *scene = new Qt3DCore::QScene;
+    scene->setArbiter(new TestArbiter);
+
+    scene->addObservable(node1);
+    scene->addObservable(node2);
+    scene->addObservable(node3);
+
+    // WHEN
+    Qt3DCore::QNodeBatchLookup nodes(scene, { node1->id(), node2->id(), node3->id() });
+
+    // THEN
+    QCOMPARE(nodes.size(), 3);
+    QCOMPARE(nodes.node(0), node1);
+
+    // WHEN
+    // e.g. a slot connected to a signal of node1 destroyed node2
+    scene->removeObservable(node2);
+
+    // THEN
+    QVERIFY(nodes.node(1) == nullptr);
+    QCOMPARE(nodes.node(2), node3);
+    QCOMPARE(nodes.node(0), node1);
+
+    // WHEN
+    Qt3DCore::QNodeBatchLookup noManager(nullptr, { node1->id() });
+
+    // THEN
+    QCOMPARE(noManager.size(), 1);
+    QVERIFY(noManager.node(0) == nullptr);
+}
+
+void tst_QScene::batchLookupWithoutRemovalTracking()
+{
+    // GIVEN
+    class UntrackedNodeManager : public Qt3DCore::QAbstractFrontEndNodeManager
+    {
+    public:
+        Qt3DCore::QNode *lookupNode(Qt3DCore::QNodeId id) const override
+        {
+            ++singleLookups;
+            return m_nodes.value(id);
+        }
+        QVector<Qt3DCore::QNode *> lookupNodes(const QVector<Qt3DCore::QNodeId> &ids) const override
+        {
+            ++batchLookups;
+            QVector<Qt3DCore::QNode *> nodes;
+            for (const Qt3DCore::QNodeId id : ids)
+                nodes.push_back(m_nodes.value(id));
+            return nodes;
+        }
+
+        QHash<Qt3DCore::QNodeId, Qt3DCore::QNode *> m_nodes;
+        mutable int singleLookups = 0;
+        mutable int batchLookups = 0;
+    };
+
+    UntrackedNodeManager manager;
+    tst_Node node1;
+    tst_Node node2;
+    manager.m_nodes.insert(node1.id(), &node1);
+    manager.m_nodes.insert(node2.id(), &node2);
+
+    // WHEN
+    Qt3DCore::QNodeBatchLookup nodes(&manager, { node1.id(), node2.id() });
+    manager.m_nodes.remove(node2.id());
+
+    // THEN
+    // Removals can't be detected, every node gets looked up on its own
+    QCOMPARE(manager.destructionGeneration(), -1);
+    QCOMPARE(nodes.node(0), &node1);
+    QVERIFY(nodes.node(1) == nullptr);
+    QCOMPARE(manager.batchLookups, 0);
+    QCOMPARE(manager.singleLookups, 2);
+}
+
 void tst_QScene::addChildNode()
 {
     // GIVEN
@@ -86,6 +86,58 @@ private:
 };
 using JobPtr = QSharedPointer<Job>;
 
+class BackgroundJobPrivate : public JobPrivate
+{
+public:
+    // QAspectJobPrivate interface
+    bool isBackground() const override
+    {
+        return true;
+    }
+};
+
+class BackgroundJob : public QAspectJob
+{
+    QSemaphore m_started;
+    QSemaphore m_released;
+
+public:
+    BackgroundJob()
+        : QAspectJob(*new BackgroundJobPrivate)
+    {}
+
+    bool waitForStarted()
+    {
+        return m_started.tryAcquire(1, 5000);
+    }
+
+    bool hasStarted() const
+    {
+        return m_started.available() > 0;
+    }
+
+    void release()
+    {
+        m_released.release();
+    }
+
+    bool postFrameCalled() const
+    {
+        Q_D(const BackgroundJob);
+        return d->postFrameCalled();
+    }
+
+    void run() override
+    {
+        m_started.release();
+        m_released.acquire();
+    }
+
+private:
+    Q_DECLARE_PRIVATE(BackgroundJob)
+};
+using BackgroundJobPtr = QSharedPointer<BackgroundJob>;
+
 class AspectPrivate : public QAbstractAspectPrivate
 {
     bool m_jobsDoneCalled = false;
@@ -139,6 +191,47 @@ private:
     Q_DECLARE_PRIVATE(Aspect)
 };
 
+class BackgroundAspect : public QAbstractAspect
+{
+    Q_OBJECT
+
+public:
+    BackgroundAspect()
+        : QAbstractAspect(*new AspectPrivate)
+    {}
+
+    // Jobs returned for the next frame only
+    void setJobs(const QVector<QAspectJobPtr> &jobs) { m_jobs = jobs; }
+
+private:
+    // QAbstractAspect interface
+    QVector<QAspectJobPtr> jobsToExecute(qint64)
+    {
+        return std::move(m_jobs);
+    }
+
+    QVector<QAspectJobPtr> m_jobs;
+};
+
+namespace {
+
+// Runs frames until the postFrame of job is called
+template<typename JobType>
+bool scheduleFramesUntilPostFrame(QScheduler *scheduler, const QSharedPointer<JobType> &job)
+{
+    QElapsedTimer timer;
+    timer.start();
+    while (!timer.hasExpired(5000)) {
+        scheduler->scheduleAndWaitForFrameAspectJobs(0, false);
+        if (job->postFrameCalled())
+            return true;
+        QThread::msleep(1);
+    }
+    return false;
+}
+
+} // anonymous
+
 class tst_QScheduler : public QObject
 {
     Q_OBJECT
@@ -197,6 +290,168 @@ private Q_SLOTS:
 
         engine.unregisterAspect(&aspect);
     }
+
+    void checkBackgroundJobsDontBlockFrames()
+    {
+        // GIVEN
+        Qt3DCore::QAspectEngine engine;
+        auto manager = Qt3DCore::QAspectEnginePrivate::get(&engine)->m_aspectManager;
+        QVERIFY(manager);
+        manager->initialize();
+
+        BackgroundAspect aspect;
+        engine.registerAspect(&aspect);
+
+        QScheduler *scheduler = manager->scheduler();
+        const BackgroundJobPtr backgroundJob = BackgroundJobPtr::create();
+        const JobPtr frameJob = JobPtr::create();
+        aspect.setJobs({ backgroundJob, frameJob });
+
+        // WHEN
+        const int count = scheduler->scheduleAndWaitForFrameAspectJobs(0, false);
+
+        // THEN
+        QCOMPARE(count, 1);
+        QVERIFY(frameJob->wasExecuted());
+        QVERIFY(frameJob->postFrameCalled());
+        QVERIFY(backgroundJob->waitForStarted());
+        QVERIFY(!backgroundJob->postFrameCalled());
+        QCOMPARE(scheduler->pendingBackgroundJobCount(), 1);
+
+        // WHEN
+        scheduler->scheduleAndWaitForFrameAspectJobs(0, false);
+
+        // THEN
+        QVERIFY(!backgroundJob->postFrameCalled());
+        QCOMPARE(scheduler->pendingBackgroundJobCount(), 1);
+
+        // WHEN
+        backgroundJob->release();
+
+        // THEN
+        QVERIFY(scheduleFramesUntilPostFrame(scheduler, backgroundJob));
+        QCOMPARE(scheduler->pendingBackgroundJobCount(), 0);
+
+        engine.unregisterAspect(&aspect);
+    }
+
+    void checkBackgroundJobDependencies()
+    {
+        // GIVEN
+        Qt3DCore::QAspectEngine engine;
+        auto manager = Qt3DCore::QAspectEnginePrivate::get(&engine)->m_aspectManager;
+        QVERIFY(manager);
+        manager->initialize();
+
+        BackgroundAspect aspect;
+        engine.registerAspect(&aspect);
+
+        QScheduler *scheduler = manager->scheduler();
+        const BackgroundJobPtr first = BackgroundJobPtr::create();
+        const BackgroundJobPtr second = BackgroundJobPtr::create();
+        second->addDependency(first);
+
+        // WHEN
+        aspect.setJobs({ first });
+        scheduler->scheduleAndWaitForFrameAspectJobs(0, false);
+        aspect.setJobs({ second });
+        scheduler->scheduleAndWaitForFrameAspectJobs(0, false);
+
+        // THEN
+        QVERIFY(first->waitForStarted());
+        QVERIFY(!second->hasStarted());
+        QCOMPARE(scheduler->pendingBackgroundJobCount(), 2);
+
+        // WHEN
+        first->release();
+
+        // THEN
+        QVERIFY(scheduleFramesUntilPostFrame(scheduler, first));
+        QVERIFY(!second->postFrameCalled());
+
+        // WHEN
+        scheduler->scheduleAndWaitForFrameAspectJobs(0, false);
+
+        // THEN
+        QVERIFY(second->waitForStarted());
+
+        // WHEN
+        second->release();
+
+        // THEN
+        QVERIFY(scheduleFramesUntilPostFrame(scheduler, second));
+        QCOMPARE(scheduler->pendingBackgroundJobCount(), 0);
+
+        engine.unregisterAspect(&aspect);
+    }
+
+    void checkUnregisterAspectCancelsOnlyItsBackgroundJobs()
+    {
+        // GIVEN
+        Qt3DCore::QAspectEngine engine;
+        auto manager = Qt3DCore::QAspectEnginePrivate::get(&engine)->m_aspectManager;
+        QVERIFY(manager);
+        manager->initialize();
+
+        BackgroundAspect otherAspect;
+        BackgroundAspect aspect;
+        engine.registerAspect(&otherAspect);
+        engine.registerAspect(&aspect);
+
+        QScheduler *scheduler = manager->scheduler();
+        scheduler->setMaxBackgroundThreadCount(1);
+        const BackgroundJobPtr otherJob = BackgroundJobPtr::create();
+        const BackgroundJobPtr queuedJob = BackgroundJobPtr::create();
+        otherAspect.setJobs({ otherJob });
+        aspect.setJobs({ queuedJob });
+
+        // WHEN
+        scheduler->scheduleAndWaitForFrameAspectJobs(0, false);
+
+        // THEN
+        QVERIFY(otherJob->waitForStarted());
+        QVERIFY(!queuedJob->hasStarted());
+        QCOMPARE(scheduler->pendingBackgroundJobCount(), 2);
+
+        // WHEN - doesn't wait for the queued job
+        engine.unregisterAspect(&aspect);
+
+        // THEN
+        QCOMPARE(scheduler->pendingBackgroundJobCount(), 1);
+
+        // WHEN
+        otherJob->release();
+
+        // THEN
+        QVERIFY(scheduleFramesUntilPostFrame(scheduler, otherJob));
+        QCOMPARE(scheduler->pendingBackgroundJobCount(), 0);
+        QVERIFY(!queuedJob->hasStarted());
+        QVERIFY(!queuedJob->postFrameCalled());
+
+        engine.unregisterAspect(&otherAspect);
+    }
+
+    void checkMaxBackgroundThreadCount()
+    {
+        // GIVEN
+        QScheduler scheduler;
+
+        // THEN
+        QVERIFY(scheduler.maxBackgroundThreadCount() > 0);
+        QCOMPARE(scheduler.pendingBackgroundJobCount(), 0);
+
+        // WHEN
+        scheduler.setMaxBackgroundThreadCount(1);
+
+        // THEN
+        QCOMPARE(scheduler.maxBackgroundThreadCount(), 1);
+
+        // WHEN
+        scheduler.setMaxBackgroundThreadCount(0);
+
+        // THEN
+        QCOMPARE(scheduler.maxBackgroundThreadCount(), 1);
+    }
 };
 
 QTEST_MAIN(tst_QScheduler)
@@ -33,6 +33,7 @@ QT_WARNING_DISABLE_DEPRECATED
 #include <QtTest/QTest>
 #include <Qt3DRender/qtextureimagedata.h>
 #include <Qt3DRender/private/qtexture_p.h>
+#include <Qt3DRender/private/qtextureimagedata_p.h>
 
 class tst_DdsTextures : public QObject
 {
@@ -40,6 +41,7 @@ class tst_DdsTextures : public QObject
 
 private slots:
     void ddsImageData();
+    void mappedImageDataMatchesCopiedData();
 };
 
 void tst_DdsTextures::ddsImageData()
@@ -95,6 +97,47 @@ void tst_DdsTextures::ddsImageData()
     }
 }
 
+void tst_DdsTextures::mappedImageDataMatchesCopiedData()
+{
+    const char *sources[] = {
+        "data/16x16x1-1-rgb.dds",
+        "data/16x16x1-1-bc3-dx10.dds",
+        "data/16x16x1-6-bc1.dds",
+        "data/16x16x1-6-lumi-nomips.dds",
+        "data/16x16-etc1.pkm",
+    };
+
+    const bool wasEnabled = Qt3DRender::TextureLoadingHelper::isMemoryMappingEnabled();
+
+    for (const char *source : sources) {
+        const QUrl url = QUrl::fromLocalFile(QFINDTESTDATA(source));
+
+        // GIVEN
+        Qt3DRender::TextureLoadingHelper::setMemoryMappingEnabled(false);
+        Qt3DRender::QTextureImageDataPtr copied = Qt3DRender::TextureLoadingHelper::loadTextureData(url, true, false);
+
+        // WHEN
+        Qt3DRender::TextureLoadingHelper::setMemoryMappingEnabled(true);
+        Qt3DRender::QTextureImageDataPtr mapped = Qt3DRender::TextureLoadingHelper::loadTextureData(url, true, false);
+
+        // THEN
+        QVERIFY(copied);
+        QVERIFY(mapped);
+        QVERIFY(Qt3DRender::QTextureImageDataPrivate::get(mapped.data())->m_mappedFile);
+        QVERIFY(!Qt3DRender::QTextureImageDataPrivate::get(copied.data())->m_mappedFile);
+        QCOMPARE(mapped->format(), copied->format());
+        QCOMPARE(mapped->mipLevels(), copied->mipLevels());
+        for (int layer = 0; layer < copied->layers(); ++layer) {
+            for (int face = 0; face < copied->faces(); ++face) {
+                for (int level = 0; level < copied->mipLevels(); ++level)
+                    QCOMPARE(mapped->data(layer, face, level), copied->data(layer, face, level));
+            }
+        }
+    }
+
+    Qt3DRender::TextureLoadingHelper::setMemoryMappingEnabled(wasEnabled);
+}
+
 QTEST_APPLESS_MAIN(tst_DdsTextures)
 
 #include "tst_ddstextures.moc"
@@ -33,6 +33,7 @@
 #include <Qt3DRender/private/managers_p.h>
 #include <Qt3DRender/private/entityvisitor_p.h>
 #include <Qt3DRender/private/entityaccumulator_p.h>
+#include <Qt3DRender/private/updateworldtransformjob_p.h>
 
 #include <Qt3DRender/QCameraLens>
 #include <Qt3DCore/QTransform>
@@ -278,6 +279,68 @@ private slots:
         renderer.resetDirty();
       }
 
+    void checkTransformSubtreeDirtyPruning()
+    {
+        // GIVEN
+        TestRenderer renderer;
+        NodeManagers nodeManagers;
+        // C is declared last so that it is destroyed before its final parent D
+        Qt3DCore::QEntity frontendEntityA, frontendEntityB, frontendEntityD, frontendEntityC;
+        frontendEntityB.setParent(&frontendEntityA);
+        frontendEntityC.setParent(&frontendEntityB);
+        frontendEntityD.setParent(&frontendEntityA);
+
+        auto backendA = createEntity(renderer, nodeManagers, frontendEntityA);
+        auto backendB = createEntity(renderer, nodeManagers, frontendEntityB);
+        auto backendC = createEntity(renderer, nodeManagers, frontendEntityC);
+        auto backendD = createEntity(renderer, nodeManagers, frontendEntityD);
+
+        UpdateWorldTransformJob job;
+        job.setRoot(backendA);
+        job.setManagers(&nodeManagers);
+
+        // THEN
+        QVERIFY(backendA->isTransformSubtreeDirty());
+        QVERIFY(backendD->isWorldTransformDirty());
+
+        // WHEN
+        job.run();
+
+        // THEN
+        for (Entity *e : {backendA, backendB, backendC, backendD}) {
+            QVERIFY(!e->isWorldTransformDirty());
+            QVERIFY(!e->isTransformSubtreeDirty());
+        }
+
+        // WHEN
+        backendC->markWorldTransformDirty();
+
+        // THEN - only the path to the root is flagged
+        QVERIFY(backendC->isWorldTransformDirty());
+        QVERIFY(!backendB->isWorldTransformDirty());
+        QVERIFY(backendB->isTransformSubtreeDirty());
+        QVERIFY(backendA->isTransformSubtreeDirty());
+        QVERIFY(!backendD->isTransformSubtreeDirty());
+
+        // WHEN - reparent the flagged C to the clean D
+        frontendEntityC.setParent(&frontendEntityD);
+        backendC->syncFromFrontEnd(&frontendEntityC, false);
+
+        // THEN
+        QVERIFY(backendC->parent() == backendD);
+        QVERIFY(backendC->isWorldTransformDirty());
+        QVERIFY(backendD->isTransformSubtreeDirty());
+
+        // WHEN
+        job.run();
+
+        // THEN - the branch of C was not pruned
+        for (Entity *e : {backendA, backendB, backendC, backendD}) {
+            QVERIFY(!e->isWorldTransformDirty());
+            QVERIFY(!e->isTransformSubtreeDirty());
+        }
+    }
+
     void checkEntityCleanup()
     {
         // GIVEN
@@ -0,0 +1,12 @@
+TEMPLATE = app
+
+TARGET = entityspatialindex
+
+QT += 3dcore 3dcore-private 3drender 3drender-private testlib
+
+CONFIG += testcase
+
+SOURCES += tst_entityspatialindex.cpp
+
+include(../../core/common/common.pri)
+include(../commons/commons.pri)
@@ -0,0 +1,252 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QTest>
+#include <private/entity_p.h>
+#include <private/managers_p.h>
+#include <private/boundingspherearray_p.h>
+#include <private/entityspatialindex_p.h>
+#include <private/sphere_p.h>
+#include <private/qray3d_p.h>
+#include <QRandomGenerator>
+#include <algorithm>
+
+using namespace Qt3DRender::Render;
+using Qt3DRender::RayCasting::QRay3D;
+
+namespace {
+
+struct Scene
+{
+    EntityManager manager;
+    QVector<Qt3DCore::QNodeId> ids;
+    QHash<Entity *, Sphere> spheres;
+
+    void addEntities(int count, QRandomGenerator &generator)
+    {
+        for (int i = 0; i < count; ++i) {
+            const Qt3DCore::QNodeId id = Qt3DCore::QNodeId::createId();
+            Entity *entity = manager.getOrCreateResource(id);
+            const Vector3D center(float(generator.bounded(200.0) - 100.0),
+                                  float(generator.bounded(200.0) - 100.0),
+                                  float(generator.bounded(200.0) - 100.0));
+            ids.push_back(id);
+            spheres.insert(entity, Sphere(center, float(generator.bounded(4.0)) + 0.1f));
+        }
+    }
+
+    void removeEntity(int i)
+    {
+        spheres.remove(manager.lookupResource(ids.at(i)));
+        manager.releaseResource(ids.takeAt(i));
+    }
+
+    void sync()
+    {
+        BoundingSphereArray *array = manager.worldBoundingSpheres();
+        array->updateSlots(&manager);
+        for (auto it = spheres.cbegin(), end = spheres.cend(); it != end; ++it)
+            array->setSphere(array->slotOf(it.key()), it.value());
+        manager.spatialIndex()->update(array);
+    }
+};
+
+QVector<Entity *> sorted(QVector<Entity *> entities)
+{
+    std::sort(entities.begin(), entities.end());
+    return entities;
+}
+
+bool includes(const QVector<Entity *> &all, const QVector<Entity *> &subset)
+{
+    return std::includes(all.cbegin(), all.cend(), subset.cbegin(), subset.cend());
+}
+
+} // anonymous
+
+class tst_EntitySpatialIndex : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+
+    void checkInitialState()
+    {
+        // GIVEN
+        EntitySpatialIndex index;
+
+        // THEN
+        QCOMPARE(index.entityCount(), 0);
+        QCOMPARE(index.height(), 0);
+        QCOMPARE(index.reinsertionCount(), 0);
+        QVERIFY(index.entitiesAlongRay(QRay3D(Vector3D(), Vector3D(0.0f, 0.0f, 1.0f), 1.0f)).isEmpty());
+        QVERIFY(index.entitiesInBox(Vector3D(), 10.0f).isEmpty());
+    }
+
+    void checkRayQueryMatchesBruteForce()
+    {
+        // GIVEN
+        QRandomGenerator generator(1234);
+        Scene scene;
+        scene.addEntities(2000, generator);
+
+        // WHEN
+        scene.sync();
+
+        // THEN
+        EntitySpatialIndex *index = scene.manager.spatialIndex();
+        QCOMPARE(index->entityCount(), 2000);
+        QVERIFY(index->isInSync(scene.manager.worldBoundingSpheres()));
+        // A balanced tree over 2000 leaves stays well below 2 * log2(2000)
+        QVERIFY(index->height() < 22);
+
+        for (int i = 0; i < 100; ++i) {
+            const Vector3D origin(float(generator.bounded(300.0) - 150.0),
+                                  float(generator.bounded(300.0) - 150.0),
+                                  -150.0f);
+            const Vector3D direction(float(generator.bounded(1.0) - 0.5),
+                                     float(generator.bounded(1.0) - 0.5),
+                                     1.0f);
+            const QRay3D ray(origin, direction.normalized(), 300.0f);
+
+            QVector<Entity *> expected;
+            for (auto it = scene.spheres.cbegin(), end = scene.spheres.cend(); it != end; ++it) {
+                if (it.value().intersects(ray, nullptr))
+                    expected.push_back(it.key());
+            }
+            std::sort(expected.begin(), expected.end());
+
+            const QVector<Entity *> candidates = sorted(index->entitiesAlongRay(ray));
+            QVERIFY(includes(candidates, expected));
+            QVERIFY(candidates.size() < scene.spheres.size() / 4);
+        }
+    }
+
+    void checkBoxQueryMatchesBruteForce()
+    {
+        // GIVEN
+        QRandomGenerator generator(5678);
+        Scene scene;
+        scene.addEntities(2000, generator);
+
+        // WHEN
+        scene.sync();
+
+        // THEN
+        EntitySpatialIndex *index = scene.manager.spatialIndex();
+        for (int i = 0; i < 100; ++i) {
+            const Vector3D center(float(generator.bounded(200.0) - 100.0),
+                                  float(generator.bounded(200.0) - 100.0),
+                                  float(generator.bounded(200.0) - 100.0));
+            const float threshold = float(generator.bounded(30.0));
+
+            QVector<Entity *> expected;
+            for (auto it = scene.spheres.cbegin(), end = scene.spheres.cend(); it != end; ++it) {
+                if ((it.value().center() - center).lengthSquared() <= threshold * threshold)
+                    expected.push_back(it.key());
+            }
+            std::sort(expected.begin(), expected.end());
+
+            QVERIFY(includes(sorted(index->entitiesInBox(center, threshold)), expected));
+        }
+    }
+
+    void checkReinsertsOnlyEscapedEntities()
+    {
+        // GIVEN
+        QRandomGenerator generator(42);
+        Scene scene;
+        scene.addEntities(100, generator);
+        scene.sync();
+        EntitySpatialIndex *index = scene.manager.spatialIndex();
+        QCOMPARE(index->reinsertionCount(), 0);
+
+        // WHEN
+        scene.sync();
+
+        // THEN
+        QCOMPARE(index->reinsertionCount(), 0);
+
+        // WHEN
+        Entity *entity = scene.manager.lookupResource(scene.ids.first());
+        const Sphere sphere = scene.spheres.value(entity);
+        scene.spheres[entity] = Sphere(sphere.center() + Vector3D(sphere.radius() * 0.01f, 0.0f, 0.0f),
+                                       sphere.radius());
+        scene.sync();
+
+        // THEN -> still within the enlarged box
+        QCOMPARE(index->reinsertionCount(), 0);
+
+        // WHEN
+        scene.spheres[entity] = Sphere(Vector3D(500.0f, 500.0f, 500.0f), sphere.radius());
+        scene.sync();
+
+        // THEN
+        QCOMPARE(index->reinsertionCount(), 1);
+        QCOMPARE(index->entitiesInBox(Vector3D(500.0f, 500.0f, 500.0f), 1.0f), QVector<Entity *>() << entity);
+        QVERIFY(!index->entitiesInBox(sphere.center(), 0.0f).contains(entity));
+    }
+
+    void checkRemovedEntitiesAreDropped()
+    {
+        // GIVEN
+        QRandomGenerator generator(7);
+        Scene scene;
+        scene.addEntities(50, generator);
+        scene.sync();
+        EntitySpatialIndex *index = scene.manager.spatialIndex();
+
+        // WHEN
+        for (int i = 0; i < 25; ++i)
+            scene.removeEntity(0);
+        scene.sync();
+
+        // THEN
+        QCOMPARE(index->entityCount(), 25);
+        QVERIFY(index->isInSync(scene.manager.worldBoundingSpheres()));
+        const QVector<Entity *> all = sorted(index->entitiesInBox(Vector3D(), 1000.0f));
+        QVector<Entity *> expected = scene.spheres.keys().toVector();
+        std::sort(expected.begin(), expected.end());
+        QCOMPARE(all, expected);
+
+        // WHEN
+        while (!scene.ids.isEmpty())
+            scene.removeEntity(0);
+        scene.sync();
+
+        // THEN
+        QCOMPARE(index->entityCount(), 0);
+        QCOMPARE(index->height(), 0);
+        QVERIFY(index->entitiesInBox(Vector3D(), 1000.0f).isEmpty());
+    }
+};
+
+QTEST_APPLESS_MAIN(tst_EntitySpatialIndex)
+
+#include "tst_entityspatialindex.moc"
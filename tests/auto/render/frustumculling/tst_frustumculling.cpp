@@ -0,0 +1,210 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QTest>
+#include <private/entity_p.h>
+#include <private/managers_p.h>
+#include <private/nodemanagers_p.h>
+#include <private/boundingspherearray_p.h>
+#include <private/frustumcullingjob_p.h>
+#include <private/sphere_p.h>
+#include <QMatrix4x4>
+#include <QRandomGenerator>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace Qt3DRender::Render;
+
+namespace {
+
+// Reference sphere-plane test, in double precision
+struct ReferenceFrustum
+{
+    double planes[6][4];
+
+    explicit ReferenceFrustum(const QMatrix4x4 &viewProjection)
+    {
+        const QVector4D rows[6] = {
+            viewProjection.row(3) + viewProjection.row(0),
+            viewProjection.row(3) - viewProjection.row(0),
+            viewProjection.row(3) + viewProjection.row(1),
+            viewProjection.row(3) - viewProjection.row(1),
+            viewProjection.row(3) + viewProjection.row(2),
+            viewProjection.row(3) - viewProjection.row(2),
+        };
+        for (int p = 0; p < 6; ++p) {
+            const double x = rows[p].x();
+            const double y = rows[p].y();
+            const double z = rows[p].z();
+            const double length = std::sqrt(x * x + y * y + z * z);
+            planes[p][0] = x / length;
+            planes[p][1] = y / length;
+            planes[p][2] = z / length;
+            planes[p][3] = rows[p].w() / length;
+        }
+    }
+
+    // Signed distance of the sphere surface to the closest plane
+    double margin(const Sphere &sphere) const
+    {
+        double margin = std::numeric_limits<double>::max();
+        for (int p = 0; p < 6; ++p) {
+            const double distance = sphere.center().x() * planes[p][0]
+                    + sphere.center().y() * planes[p][1]
+                    + sphere.center().z() * planes[p][2]
+                    + planes[p][3];
+            margin = std::min(margin, distance + sphere.radius());
+        }
+        return margin;
+    }
+};
+
+QMatrix4x4 viewProjection()
+{
+    QMatrix4x4 projection;
+    projection.perspective(45.0f, 16.0f / 9.0f, 0.1f, 150.0f);
+    QMatrix4x4 view;
+    view.lookAt(QVector3D(10.0f, 20.0f, -80.0f), QVector3D(0.0f, 0.0f, 0.0f), QVector3D(0.0f, 1.0f, 0.0f));
+    return projection * view;
+}
+
+} // anonymous
+
+class tst_FrustumCulling : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+
+    void checkSlotsOnlyRebuiltWhenEntitiesChange()
+    {
+        // GIVEN
+        EntityManager manager;
+        BoundingSphereArray *spheres = manager.worldBoundingSpheres();
+        const Qt3DCore::QNodeId idA = Qt3DCore::QNodeId::createId();
+        manager.getOrCreateResource(idA);
+
+        // THEN
+        QVERIFY(spheres->updateSlots(&manager));
+        QCOMPARE(spheres->size(), 1);
+        QVERIFY(!spheres->updateSlots(&manager));
+
+        // WHEN
+        const Qt3DCore::QNodeId idB = Qt3DCore::QNodeId::createId();
+        manager.getOrCreateResource(idB);
+
+        // THEN
+        QVERIFY(spheres->updateSlots(&manager));
+        QCOMPARE(spheres->size(), 2);
+        QVERIFY(!spheres->updateSlots(&manager));
+
+        // WHEN
+        manager.releaseResource(idA);
+
+        // THEN
+        QVERIFY(spheres->updateSlots(&manager));
+        QCOMPARE(spheres->size(), 1);
+        QCOMPARE(spheres->slotOf(manager.lookupResource(idB)), 0);
+    }
+
+    void checkMatchesScalarSphereTest_data()
+    {
+        QTest::addColumn<int>("entityCount");
+
+        // Counts which leave a scalar remainder after the 4 or 8 wide
+        // loops, and one above the threshold for culling in parallel
+        QTest::newRow("1") << 1;
+        QTest::newRow("7") << 7;
+        QTest::newRow("4099") << 4099;
+        QTest::newRow("20003") << 20003;
+    }
+
+    void checkMatchesScalarSphereTest()
+    {
+        // The render module is built with the SSE2 or AVX2 flags when the
+        // qt3d-simd feature is on, so this compares the vectorized path
+        // against the reference
+
+        // GIVEN
+        QFETCH(int, entityCount);
+        QRandomGenerator generator(4321);
+        NodeManagers nodeManagers;
+        EntityManager *manager = nodeManagers.renderNodesManager();
+        const QMatrix4x4 vp = viewProjection();
+        const ReferenceFrustum reference(vp);
+
+        QHash<Entity *, Sphere> worldSpheres;
+        for (int i = 0; i < entityCount; ++i) {
+            Entity *entity = manager->getOrCreateResource(Qt3DCore::QNodeId::createId());
+            // Keep away from the planes, float and double may disagree there
+            Sphere sphere;
+            do {
+                sphere = Sphere(Vector3D(float(generator.bounded(300.0) - 150.0),
+                                         float(generator.bounded(300.0) - 150.0),
+                                         float(generator.bounded(300.0) - 150.0)),
+                                float(generator.bounded(5.0)));
+            } while (std::abs(reference.margin(sphere)) < 1.0e-3);
+            worldSpheres.insert(entity, sphere);
+        }
+
+        BoundingSphereArray *spheres = manager->worldBoundingSpheres();
+        spheres->updateSlots(manager);
+        for (auto it = worldSpheres.cbegin(), end = worldSpheres.cend(); it != end; ++it)
+            spheres->setSphere(spheres->slotOf(it.key()), it.value());
+
+        QVector<Entity *> expected;
+        for (Entity *entity : spheres->entities()) {
+            if (reference.margin(worldSpheres.value(entity)) >= 0.0)
+                expected.push_back(entity);
+        }
+        // Make sure both outcomes are covered
+        if (entityCount > 100) {
+            QVERIFY(!expected.isEmpty());
+            QVERIFY(expected.size() < entityCount);
+        }
+
+        QScopedPointer<FrustumCullingJob> job(new FrustumCullingJob());
+        job->setRoot(spheres->entities().first());
+        job->setManagers(&nodeManagers);
+        job->setActive(true);
+        job->setViewProjection(Matrix4x4(vp));
+
+        // WHEN
+        job->run();
+
+        // THEN
+        const QVector<Entity *> visibleEntities = job->visibleEntities();
+        QVERIFY(std::is_sorted(visibleEntities.cbegin(), visibleEntities.cend()));
+        QCOMPARE(visibleEntities, expected);
+    }
+};
+
+QTEST_APPLESS_MAIN(tst_FrustumCulling)
+
+#include "tst_frustumculling.moc"
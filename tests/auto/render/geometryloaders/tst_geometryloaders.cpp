@@ -43,6 +43,7 @@
 #include <QtCore/private/qfactoryloader_p.h>
 
 #include <Qt3DCore/qattribute.h>
+#include <Qt3DCore/qbuffer.h>
 #include <Qt3DCore/qgeometry.h>
 
 #include <Qt3DRender/private/qgeometryloaderfactory_p.h>
@@ -66,6 +67,7 @@ private Q_SLOTS:
     void testPLYLoader();
     void testSTLLoader();
     void testGLTFLoader();
+    void testGLBLoader();
 #ifdef QT_3DGEOMETRYLOADERS_FBX
     void testFBXLoader();
 #endif
@@ -236,6 +238,52 @@ void tst_geometryloaders::testGLTFLoader()
     file.close();
 }
 
+void tst_geometryloaders::testGLBLoader()
+{
+    QScopedPointer<QGeometryLoaderInterface> loader;
+    loader.reset(qLoadPlugin<QGeometryLoaderInterface, QGeometryLoaderFactory>(geometryLoader(), QStringLiteral("glb")));
+    QVERIFY(loader);
+    if (!loader)
+        return;
+
+    QFile file(QStringLiteral(":/cube.glb"));
+    if (!file.open(QIODevice::ReadOnly)) {
+        qDebug("Could not open test file for reading");
+        return;
+    }
+
+    // The positions, normals and indices are stored in the BIN chunk
+    bool loaded = loader->load(&file, QStringLiteral("Cube"));
+    QVERIFY(loaded);
+    if (!loaded)
+        return;
+
+    QGeometry *geometry = loader->geometry();
+    QVERIFY(geometry);
+    if (!geometry)
+        return;
+
+    QCOMPARE(geometry->attributes().count(), 3);
+    for (QAttribute *attr : geometry->attributes()) {
+        QVERIFY(attr->buffer());
+        switch (attr->attributeType()) {
+        case QAttribute::IndexAttribute:
+            QCOMPARE(attr->count(), 36u);
+            QCOMPARE(attr->buffer()->data().size(), 72);
+            break;
+        case QAttribute::VertexAttribute:
+            QCOMPARE(attr->count(), 24u);
+            QCOMPARE(attr->buffer()->data().size(), 576);
+            break;
+        default:
+            Q_UNREACHABLE();
+            break;
+        }
+    }
+
+    file.close();
+}
+
 #ifdef QT_3DGEOMETRYLOADERS_FBX
 void tst_geometryloaders::testFBXLoader()
 {
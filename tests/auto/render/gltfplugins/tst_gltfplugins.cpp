@@ -86,6 +86,7 @@
 #include <Qt3DExtras/qgoochmaterial.h>
 #include <Qt3DExtras/qpervertexcolormaterial.h>
 #include <Qt3DExtras/qforwardrenderer.h>
+#include <Qt3DExtras/qmetalroughmaterial.h>
 
 //#define VISUAL_CHECK 5000  // The value indicates the time for visual check in ms
 //#define PRESERVE_EXPORT  // Uncomment to preserve export directory contents for analysis
@@ -101,6 +102,7 @@ private Q_SLOTS:
     void cleanup();
     void exportAndImport_data();
     void exportAndImport();
+    void importGLB();
 
 private:
     void createTestScene();
@@ -144,8 +146,8 @@ private:
     Qt3DExtras::Qt3DWindow *m_view1;
     Qt3DExtras::Qt3DWindow *m_view2;
 #endif
-    Qt3DCore::QEntity *m_sceneRoot1;
-    Qt3DCore::QEntity *m_sceneRoot2;
+    Qt3DCore::QEntity *m_sceneRoot1 = nullptr;
+    Qt3DCore::QEntity *m_sceneRoot2 = nullptr;
     QHash<QString, Qt3DCore::QEntity *> m_entityMap;
 };
 
@@ -172,7 +174,9 @@ void tst_gltfPlugins::init()
 void tst_gltfPlugins::cleanup()
 {
     delete m_sceneRoot1;
+    m_sceneRoot1 = nullptr;
     delete m_sceneRoot2;
+    m_sceneRoot2 = nullptr;
     m_entityMap.clear();
 #ifdef VISUAL_CHECK
     delete m_view1;
@@ -1261,6 +1265,44 @@ void tst_gltfPlugins::exportAndImport()
 #endif
 }
 
+void tst_gltfPlugins::importGLB()
+{
+    Qt3DRender::QSceneImporter *importer =
+            Qt3DRender::QSceneImportFactory::create(QStringLiteral("gltf"), QStringList());
+    QVERIFY(importer != nullptr);
+
+    importer->setSource(QUrl(QStringLiteral("qrc:/cube.glb")));
+    m_sceneRoot1 = importer->scene();
+    QVERIFY(m_sceneRoot1 != nullptr);
+
+    // Geometry read from the BIN chunk
+    const QList<Qt3DRender::QGeometryRenderer *> renderers =
+            m_sceneRoot1->findChildren<Qt3DRender::QGeometryRenderer *>();
+    QCOMPARE(renderers.size(), 1);
+    Qt3DCore::QGeometry *geometry = renderers.first()->geometry();
+    QVERIFY(geometry != nullptr);
+    QCOMPARE(geometry->attributes().size(), 3);
+    for (Qt3DCore::QAttribute *attribute : geometry->attributes()) {
+        QVERIFY(attribute->buffer() != nullptr);
+        if (attribute->attributeType() == Qt3DCore::QAttribute::IndexAttribute) {
+            QCOMPARE(attribute->count(), 36U);
+            QCOMPARE(attribute->buffer()->data().size(), 72);
+        } else {
+            QCOMPARE(attribute->count(), 24U);
+            QCOMPARE(attribute->buffer()->data().size(), 576);
+        }
+    }
+
+    // Base color texture using an image stored in a buffer view
+    const QList<Qt3DExtras::QMetalRoughMaterial *> materials =
+            m_sceneRoot1->findChildren<Qt3DExtras::QMetalRoughMaterial *>();
+    QCOMPARE(materials.size(), 1);
+    Qt3DRender::QAbstractTexture *texture =
+            materials.first()->baseColor().value<Qt3DRender::QAbstractTexture *>();
+    QVERIFY(texture != nullptr);
+    QCOMPARE(texture->textureImages().size(), 1);
+}
+
 QTEST_MAIN(tst_gltfPlugins)
 
 #include "tst_gltfplugins.moc"
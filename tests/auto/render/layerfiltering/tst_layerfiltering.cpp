@@ -618,6 +618,30 @@ private Q_SLOTS:
                                                                                                                     << (Qt3DCore::QNodeIdVector()
                                                                                                                         << childEntity4->id());
         }
+
+        {
+            Qt3DCore::QEntity *rootEntity = new Qt3DCore::QEntity();
+            Qt3DCore::QEntity *childEntity1 = new Qt3DCore::QEntity(rootEntity);
+            Qt3DCore::QEntity *childEntity2 = new Qt3DCore::QEntity(rootEntity);
+            Qt3DCore::QEntity *childEntity3 = new Qt3DCore::QEntity(rootEntity);
+
+            Q_UNUSED(childEntity3)
+
+            // Some of the layers get no bit in the layer masks
+            Qt3DRender::QLayerFilter *layerFilter = new Qt3DRender::QLayerFilter(rootEntity);
+            QVector<Qt3DRender::QLayer *> layers;
+            for (int i = 0; i < Qt3DRender::Render::MaxLayerMaskSize + 2; ++i) {
+                Qt3DRender::QLayer *layer = new Qt3DRender::QLayer(rootEntity);
+                layerFilter->addLayer(layer);
+                layers.push_back(layer);
+            }
+            childEntity1->addComponent(layers.first());
+            childEntity2->addComponent(layers.last());
+
+            QTest::newRow("AcceptAny-MoreLayersThanLayerMaskBits-ShouldSelectChild1And2") << rootEntity
+                                                                                          << (Qt3DCore::QNodeIdVector() << layerFilter->id())
+                                                                                          << (Qt3DCore::QNodeIdVector() << childEntity1->id() << childEntity2->id());
+        }
     }
 
     void filterEntities()
@@ -0,0 +1,171 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QTest>
+#include <private/entity_p.h>
+#include <private/light_p.h>
+#include <private/lightgrid_p.h>
+#include <private/sphere_p.h>
+#include <QRandomGenerator>
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+using namespace Qt3DRender::Render;
+
+namespace {
+
+struct Scene
+{
+    std::vector<std::unique_ptr<Entity>> entities;
+    std::vector<std::unique_ptr<Light>> lights;
+    QVector<LightSource> lightSources;
+
+    void addLightSource(const Vector3D &position, bool enabled = true)
+    {
+        entities.emplace_back(new Entity());
+        Entity *entity = entities.back().get();
+        *entity->worldBoundingVolume() = Sphere(position, 1.0f);
+
+        lights.emplace_back(new Light());
+        Light *light = lights.back().get();
+        light->setEnabled(enabled);
+
+        lightSources.push_back(LightSource(entity, { light }));
+    }
+};
+
+// What RenderView::updateRenderCommand used to do: sort all the light
+// sources by distance to the entity
+QVector<LightSource> sortedByDistance(QVector<LightSource> lightSources, const Vector3D &position)
+{
+    std::stable_sort(lightSources.begin(), lightSources.end(),
+                     [&] (const LightSource &a, const LightSource &b) {
+        return (a.entity->worldBoundingVolume()->center() - position).lengthSquared()
+                < (b.entity->worldBoundingVolume()->center() - position).lengthSquared();
+    });
+    return lightSources;
+}
+
+} // anonymous
+
+class tst_LightGrid : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+
+    void checkInitialState()
+    {
+        // GIVEN
+        LightGrid grid;
+
+        // THEN
+        QVERIFY(grid.isEmpty());
+        QVERIFY(grid.closestLightSources(Vector3D(), 8).isEmpty());
+    }
+
+    void checkSingleLightSource()
+    {
+        // GIVEN
+        Scene scene;
+        scene.addLightSource(Vector3D(1.0f, 2.0f, 3.0f));
+        LightGrid grid;
+
+        // WHEN
+        grid.build(scene.lightSources);
+
+        // THEN
+        QCOMPARE(grid.cellCount(), 1);
+        const QVector<LightSource> closest = grid.closestLightSources(Vector3D(50.0f, 0.0f, 0.0f), 8);
+        QCOMPARE(closest.size(), 1);
+        QCOMPARE(closest.first().entity, scene.lightSources.first().entity);
+    }
+
+    void checkClosestMatchesSortedOrder()
+    {
+        // GIVEN
+        QRandomGenerator generator(1234);
+        Scene scene;
+        for (int i = 0; i < 500; ++i) {
+            const Vector3D position(float(generator.bounded(200.0) - 100.0),
+                                    float(generator.bounded(200.0) - 100.0),
+                                    float(generator.bounded(20.0) - 10.0));
+            scene.addLightSource(position, generator.bounded(4) != 0);
+        }
+        LightGrid grid;
+
+        // WHEN
+        grid.build(scene.lightSources);
+
+        // THEN
+        QVERIFY(grid.cellCount() > 1);
+        for (int i = 0; i < 200; ++i) {
+            const Vector3D position(float(generator.bounded(300.0) - 150.0),
+                                    float(generator.bounded(300.0) - 150.0),
+                                    float(generator.bounded(300.0) - 150.0));
+            const int maxLights = 1 + generator.bounded(8);
+            const QVector<LightSource> closest = grid.closestLightSources(position, maxLights);
+            const QVector<LightSource> expected = sortedByDistance(scene.lightSources, position);
+
+            // The grid returns a prefix of the sorted sources holding maxLights enabled lights
+            QVERIFY(closest.size() <= expected.size());
+            QVERIFY(std::equal(closest.cbegin(), closest.cend(), expected.cbegin(),
+                               [] (const LightSource &a, const LightSource &b) {
+                return a.entity == b.entity;
+            }));
+
+            int enabledLights = 0;
+            for (const LightSource &source : closest)
+                enabledLights += source.lights.first()->isEnabled() ? 1 : 0;
+            QVERIFY(enabledLights == maxLights
+                    || (closest.size() == expected.size() && enabledLights < maxLights));
+        }
+    }
+
+    void checkClear()
+    {
+        // GIVEN
+        Scene scene;
+        scene.addLightSource(Vector3D());
+        scene.addLightSource(Vector3D(10.0f, 0.0f, 0.0f));
+        LightGrid grid;
+        grid.build(scene.lightSources);
+
+        // WHEN
+        grid.clear();
+
+        // THEN
+        QVERIFY(grid.isEmpty());
+        QVERIFY(grid.closestLightSources(Vector3D(), 8).isEmpty());
+    }
+};
+
+QTEST_MAIN(tst_LightGrid)
+
+#include "tst_lightgrid.moc"
@@ -0,0 +1,12 @@
+TEMPLATE = app
+
+TARGET = meshgeometrycache
+
+QT += 3dcore 3dcore-private 3drender 3drender-private testlib
+
+CONFIG += testcase
+
+SOURCES += tst_meshgeometrycache.cpp
+
+include(../../core/common/common.pri)
+include(../commons/commons.pri)
@@ -0,0 +1,199 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QTest>
+#include <Qt3DCore/qattribute.h>
+#include <Qt3DCore/qbuffer.h>
+#include <Qt3DCore/qgeometry.h>
+#include <Qt3DRender/private/meshgeometrycache_p.h>
+#include <QScopedPointer>
+
+using namespace Qt3DRender::Render;
+
+namespace {
+
+Qt3DCore::QGeometry *createGeometry()
+{
+    Qt3DCore::QGeometry *geometry = new Qt3DCore::QGeometry();
+    Qt3DCore::QBuffer *buffer = new Qt3DCore::QBuffer(geometry);
+    buffer->setData(QByteArray(36 * sizeof(float), '\x01'));
+
+    Qt3DCore::QAttribute *positions = new Qt3DCore::QAttribute(geometry);
+    positions->setName(Qt3DCore::QAttribute::defaultPositionAttributeName());
+    positions->setVertexBaseType(Qt3DCore::QAttribute::Float);
+    positions->setVertexSize(3);
+    positions->setCount(6);
+    positions->setByteStride(6 * sizeof(float));
+    positions->setBuffer(buffer);
+    geometry->addAttribute(positions);
+
+    Qt3DCore::QAttribute *normals = new Qt3DCore::QAttribute(geometry);
+    normals->setName(Qt3DCore::QAttribute::defaultNormalAttributeName());
+    normals->setVertexBaseType(Qt3DCore::QAttribute::Float);
+    normals->setVertexSize(3);
+    normals->setCount(6);
+    normals->setByteStride(6 * sizeof(float));
+    normals->setByteOffset(3 * sizeof(float));
+    normals->setBuffer(buffer);
+    geometry->addAttribute(normals);
+
+    geometry->setBoundingVolumePositionAttribute(positions);
+    return geometry;
+}
+
+MeshGeometryCache::Key key(const QString &meshName = QString())
+{
+    MeshGeometryCache::Key k;
+    k.source = QStringLiteral("file:///bolt.obj");
+    k.meshName = meshName;
+    k.size = 1024;
+    return k;
+}
+
+} // anonymous
+
+class tst_MeshGeometryCache : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+
+    void checkInitialState()
+    {
+        // GIVEN
+        MeshGeometryCache cache;
+
+        // THEN
+        QCOMPARE(cache.entryCount(), 0);
+        QCOMPARE(cache.hitCount(), 0);
+        QCOMPARE(cache.missCount(), 0);
+    }
+
+    void checkLoadsOnce()
+    {
+        // GIVEN
+        MeshGeometryCache cache;
+        int loadCount = 0;
+        const auto loader = [&] { ++loadCount; return createGeometry(); };
+
+        // WHEN
+        QScopedPointer<Qt3DCore::QGeometry> first(cache.geometry(key(), loader));
+        QScopedPointer<Qt3DCore::QGeometry> second(cache.geometry(key(), loader));
+
+        // THEN
+        QCOMPARE(loadCount, 1);
+        QCOMPARE(cache.entryCount(), 1);
+        QCOMPARE(cache.missCount(), 1);
+        QCOMPARE(cache.hitCount(), 1);
+
+        QVERIFY(first.data() != second.data());
+        const QVector<Qt3DCore::QAttribute *> firstAttributes = first->attributes();
+        const QVector<Qt3DCore::QAttribute *> secondAttributes = second->attributes();
+        QCOMPARE(secondAttributes.size(), firstAttributes.size());
+        for (int i = 0; i < firstAttributes.size(); ++i) {
+            const Qt3DCore::QAttribute *a = firstAttributes.at(i);
+            const Qt3DCore::QAttribute *b = secondAttributes.at(i);
+            QCOMPARE(b->name(), a->name());
+            QCOMPARE(b->vertexBaseType(), a->vertexBaseType());
+            QCOMPARE(b->vertexSize(), a->vertexSize());
+            QCOMPARE(b->count(), a->count());
+            QCOMPARE(b->byteStride(), a->byteStride());
+            QCOMPARE(b->byteOffset(), a->byteOffset());
+            QVERIFY(b->buffer() != a->buffer());
+            // Data is shared, not copied
+            QVERIFY(b->buffer()->data().constData() == a->buffer()->data().constData());
+        }
+        // Attributes sharing a buffer still do
+        QCOMPARE(secondAttributes.at(0)->buffer(), secondAttributes.at(1)->buffer());
+        QCOMPARE(second->boundingVolumePositionAttribute(), secondAttributes.at(0));
+    }
+
+    void checkKeyIncludesMeshName()
+    {
+        // GIVEN
+        MeshGeometryCache cache;
+        int loadCount = 0;
+        const auto loader = [&] { ++loadCount; return createGeometry(); };
+
+        // WHEN
+        QScopedPointer<Qt3DCore::QGeometry> bolt(cache.geometry(key(QStringLiteral("bolt")), loader));
+        QScopedPointer<Qt3DCore::QGeometry> nut(cache.geometry(key(QStringLiteral("nut")), loader));
+
+        // THEN
+        QCOMPARE(loadCount, 2);
+        QCOMPARE(cache.entryCount(), 2);
+        QCOMPARE(cache.hitCount(), 0);
+    }
+
+    void checkFailedLoadIsRetried()
+    {
+        // GIVEN
+        MeshGeometryCache cache;
+        int loadCount = 0;
+
+        // WHEN
+        Qt3DCore::QGeometry *geometry = cache.geometry(key(), [&] { ++loadCount; return nullptr; });
+
+        // THEN
+        QVERIFY(geometry == nullptr);
+
+        // WHEN
+        QScopedPointer<Qt3DCore::QGeometry> retried(cache.geometry(key(), [&] { ++loadCount; return createGeometry(); }));
+
+        // THEN
+        QVERIFY(!retried.isNull());
+        QCOMPARE(loadCount, 2);
+        QCOMPARE(cache.hitCount(), 0);
+    }
+
+    void checkUnusedEntriesAreReleased()
+    {
+        // GIVEN
+        MeshGeometryCache cache;
+        const auto loader = [] { return createGeometry(); };
+        delete cache.geometry(key(QStringLiteral("bolt")), loader);
+        QCOMPARE(cache.entryCount(), 1);
+
+        // WHEN
+        QScopedPointer<Qt3DCore::QGeometry> nut(cache.geometry(key(QStringLiteral("nut")), loader));
+
+        // THEN
+        // No geometry uses the bolt data anymore
+        QCOMPARE(cache.entryCount(), 1);
+
+        // WHEN
+        QScopedPointer<Qt3DCore::QGeometry> screw(cache.geometry(key(QStringLiteral("screw")), loader));
+
+        // THEN
+        QCOMPARE(cache.entryCount(), 2);
+    }
+};
+
+QTEST_MAIN(tst_MeshGeometryCache)
+
+#include "tst_meshgeometrycache.moc"
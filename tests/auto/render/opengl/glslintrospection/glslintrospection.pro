@@ -0,0 +1,13 @@
+TEMPLATE = app
+
+TARGET = tst_glslintrospection
+
+QT += core-private 3dcore 3dcore-private 3drender 3drender-private testlib
+
+CONFIG += testcase
+
+SOURCES += tst_glslintrospection.cpp
+
+# Link Against OpenGL and Null Renderer Plugins
+include(../opengl_render_plugin.pri)
+include(../../../../../src/plugins/renderers/dummy/dummy.pri)
@@ -0,0 +1,246 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QTest>
+#include <Qt3DRender/qshaderprogram.h>
+#include <glslintrospection_p.h>
+
+using namespace Qt3DRender::Render;
+
+namespace {
+
+QVector<QByteArray> program(const QByteArray &vertex, const QByteArray &fragment)
+{
+    QVector<QByteArray> code(Qt3DRender::QShaderProgram::Compute + 1);
+    code[Qt3DRender::QShaderProgram::Vertex] = vertex;
+    code[Qt3DRender::QShaderProgram::Fragment] = fragment;
+    return code;
+}
+
+const OpenGL::ShaderUniform *findUniform(const Null::GLSLInterface &i, const QString &name)
+{
+    for (const OpenGL::ShaderUniform &u : i.uniforms) {
+        if (u.m_name == name)
+            return &u;
+    }
+    return nullptr;
+}
+
+} // anonymous
+
+class tst_GLSLIntrospection : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void checkDefaultBlockUniforms()
+    {
+        // GIVEN
+        const QByteArray vertex =
+                "#version 330\n"
+                "in vec3 vertexPosition;\n"
+                "layout(location = 4) in vec2 vertexTexCoord;\n"
+                "uniform mat4 mvp; // model view projection\n"
+                "void main() { gl_Position = mvp * vec4(vertexPosition, 1.0); }\n";
+        const QByteArray fragment =
+                "#version 330\n"
+                "#define MAX_LIGHTS 8\n"
+                "struct Light { vec3 position; float intensity; };\n"
+                "uniform Light lights[MAX_LIGHTS];\n"
+                "uniform int lightCount;\n"
+                "uniform mat4 mvp;\n"
+                "/* uniform float commentedOut; */\n"
+                "uniform sampler2D diffuseTexture;\n"
+                "uniform float weights[4];\n"
+                "out vec4 fragColor;\n"
+                "vec4 shade() { float inBody = 1.0; return vec4(inBody); }\n"
+                "void main() { fragColor = shade(); }\n";
+
+        // WHEN
+        const Null::GLSLInterface i = Null::introspectGLSL(program(vertex, fragment));
+
+        // THEN
+        QCOMPARE(i.attributes.size(), 2);
+        QCOMPARE(i.attributes.at(0).m_name, QStringLiteral("vertexPosition"));
+        QCOMPARE(i.attributes.at(0).m_type, GLenum(GL_FLOAT_VEC3));
+        QCOMPARE(i.attributes.at(1).m_name, QStringLiteral("vertexTexCoord"));
+        QCOMPARE(i.attributes.at(1).m_location, 4);
+
+        // mvp is shared by both stages and reported once
+        QCOMPARE(i.uniforms.size(), 1 + 8 * 2 + 3);
+        QVERIFY(findUniform(i, QStringLiteral("mvp")));
+        QVERIFY(findUniform(i, QStringLiteral("lights[0].position")));
+        QVERIFY(findUniform(i, QStringLiteral("lights[7].intensity")));
+        QVERIFY(!findUniform(i, QStringLiteral("commentedOut")));
+        QVERIFY(!findUniform(i, QStringLiteral("inBody")));
+
+        const OpenGL::ShaderUniform *sampler = findUniform(i, QStringLiteral("diffuseTexture"));
+        QVERIFY(sampler);
+        QCOMPARE(sampler->m_type, GLenum(GL_SAMPLER_2D));
+        QCOMPARE(sampler->m_blockIndex, -1);
+
+        const OpenGL::ShaderUniform *weights = findUniform(i, QStringLiteral("weights[0]"));
+        QVERIFY(weights);
+        QCOMPARE(weights->m_size, 4);
+    }
+
+    void checkStd140UniformBlocks()
+    {
+        // GIVEN
+        const QByteArray fragment =
+                "#version 330\n"
+                "layout(std140, binding = 2) uniform Material {\n"
+                "    vec3 ka;\n"
+                "    float shininess;\n"
+                "    vec2 offset;\n"
+                "    mat4 textureTransform;\n"
+                "    float factors[3];\n"
+                "} material;\n"
+                "uniform Anonymous { vec4 color; };\n"
+                "void main() {}\n";
+
+        // WHEN
+        const Null::GLSLInterface i = Null::introspectGLSL(program(QByteArray(), fragment));
+
+        // THEN
+        QCOMPARE(i.uniformBlocks.size(), 2);
+        QCOMPARE(i.uniformBlocks.at(0).m_name, QStringLiteral("Material"));
+        QCOMPARE(i.uniformBlocks.at(0).m_binding, 2);
+        QCOMPARE(i.uniformBlocks.at(0).m_activeUniformsCount, 5);
+        QCOMPARE(i.uniformBlocks.at(0).m_size, 16 + 16 + 64 + 48);
+
+        const OpenGL::ShaderUniform *shininess = findUniform(i, QStringLiteral("Material.shininess"));
+        QVERIFY(shininess);
+        QCOMPARE(shininess->m_offset, 12);
+        QCOMPARE(shininess->m_blockIndex, 0);
+        QCOMPARE(findUniform(i, QStringLiteral("Material.offset"))->m_offset, 16);
+
+        const OpenGL::ShaderUniform *transform = findUniform(i, QStringLiteral("Material.textureTransform"));
+        QVERIFY(transform);
+        QCOMPARE(transform->m_offset, 32);
+        QCOMPARE(transform->m_matrixStride, 16);
+
+        const OpenGL::ShaderUniform *factors = findUniform(i, QStringLiteral("Material.factors[0]"));
+        QVERIFY(factors);
+        QCOMPARE(factors->m_offset, 96);
+        QCOMPARE(factors->m_arrayStride, 16);
+        QCOMPARE(factors->m_size, 3);
+
+        // Members of blocks without instance name are not prefixed
+        const OpenGL::ShaderUniform *color = findUniform(i, QStringLiteral("color"));
+        QVERIFY(color);
+        QCOMPARE(color->m_blockIndex, 1);
+    }
+
+    void checkShaderStorageBlocks()
+    {
+        // GIVEN
+        QVector<QByteArray> code(Qt3DRender::QShaderProgram::Compute + 1);
+        code[Qt3DRender::QShaderProgram::Compute] =
+                "#version 430\n"
+                "layout(local_size_x = 32) in;\n"
+                "layout(std430, binding = 3) buffer Particles { vec4 positions[1024]; } particles;\n"
+                "uniform float deltaT;\n"
+                "void main() {}\n";
+
+        // WHEN
+        const Null::GLSLInterface i = Null::introspectGLSL(code);
+
+        // THEN
+        QCOMPARE(i.attributes.size(), 0);
+        QCOMPARE(i.uniforms.size(), 1);
+        QCOMPARE(i.storageBlocks.size(), 1);
+        QCOMPARE(i.storageBlocks.at(0).m_name, QStringLiteral("Particles"));
+        QCOMPARE(i.storageBlocks.at(0).m_binding, 3);
+        QCOMPARE(i.storageBlocks.at(0).m_activeVariablesCount, 1);
+        QCOMPARE(i.storageBlocks.at(0).m_size, 1024 * 16);
+    }
+    void checkPreprocessorConditionals()
+    {
+        // GIVEN
+        const QByteArray fragment =
+                "#version 330\n"
+                "#define USE_NORMAL_MAP\n"
+                "#define LIGHT_COUNT 2\n"
+                "#ifdef USE_NORMAL_MAP\n"
+                "uniform sampler2D normalTexture;\n"
+                "#else\n"
+                "uniform float flatShading;\n"
+                "#endif\n"
+                "#ifndef USE_NORMAL_MAP\n"
+                "uniform float notNormalMapped;\n"
+                "#endif\n"
+                "#if defined(USE_SHADOWS) && LIGHT_COUNT > 1\n"
+                "uniform sampler2DShadow shadowTexture;\n"
+                "#elif LIGHT_COUNT == 2 && __VERSION__ >= 330\n"
+                "uniform vec3 lightPositions[LIGHT_COUNT];\n"
+                "#  if 0\n"
+                "uniform float nestedDisabled;\n"
+                "#  endif\n"
+                "#else\n"
+                "uniform vec3 lightPosition;\n"
+                "#endif\n"
+                "#undef USE_NORMAL_MAP\n"
+                "#if !defined USE_NORMAL_MAP\n"
+                "uniform float afterUndef;\n"
+                "#endif\n"
+                "#if UNKNOWN_FUNCTION(1)\n"
+                "uniform float unevaluated;\n"
+                "#endif\n"
+                "void main() {}\n";
+        // Defines don't leak into the next stage
+        const QByteArray vertex =
+                "#version 330\n"
+                "#ifdef LIGHT_COUNT\n"
+                "uniform float otherStage;\n"
+                "#endif\n"
+                "void main() {}\n";
+
+        // WHEN
+        const Null::GLSLInterface i = Null::introspectGLSL(program(vertex, fragment));
+
+        // THEN
+        QVERIFY(findUniform(i, QStringLiteral("normalTexture")));
+        QVERIFY(!findUniform(i, QStringLiteral("flatShading")));
+        QVERIFY(!findUniform(i, QStringLiteral("notNormalMapped")));
+        QVERIFY(!findUniform(i, QStringLiteral("shadowTexture")));
+        QVERIFY(findUniform(i, QStringLiteral("lightPositions[0]")));
+        QCOMPARE(findUniform(i, QStringLiteral("lightPositions[0]"))->m_size, 2);
+        QVERIFY(!findUniform(i, QStringLiteral("nestedDisabled")));
+        QVERIFY(!findUniform(i, QStringLiteral("lightPosition")));
+        QVERIFY(findUniform(i, QStringLiteral("afterUndef")));
+        QVERIFY(findUniform(i, QStringLiteral("unevaluated")));
+        QVERIFY(!findUniform(i, QStringLiteral("otherStage")));
+        QCOMPARE(i.uniforms.size(), 4);
+    }
+};
+
+QTEST_APPLESS_MAIN(tst_GLSLIntrospection)
+
+#include "tst_glslintrospection.moc"
@@ -0,0 +1,230 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QTest>
+#include <QColor>
+#include <QSurfaceFormat>
+#include <Qt3DCore/qaspectengine.h>
+#include <Qt3DCore/qattribute.h>
+#include <Qt3DCore/qbuffer.h>
+#include <Qt3DCore/qentity.h>
+#include <Qt3DCore/qgeometry.h>
+#include <Qt3DRender/qcamera.h>
+#include <Qt3DRender/qcameraselector.h>
+#include <Qt3DRender/qclearbuffers.h>
+#include <Qt3DRender/qeffect.h>
+#include <Qt3DRender/qgeometryrenderer.h>
+#include <Qt3DRender/qgraphicsapifilter.h>
+#include <Qt3DRender/qmaterial.h>
+#include <Qt3DRender/qparameter.h>
+#include <Qt3DRender/qrenderaspect.h>
+#include <Qt3DRender/qrenderpass.h>
+#include <Qt3DRender/qrendersettings.h>
+#include <Qt3DRender/qshaderprogram.h>
+#include <Qt3DRender/qtechnique.h>
+#include <Qt3DRender/qviewport.h>
+#include <Qt3DRender/private/qrenderaspect_p.h>
+#include <nullrenderer_p.h>
+
+using namespace Qt3DRender::Render;
+
+namespace {
+
+const char vertexShader[] =
+        "#version 110\n"
+        "attribute vec3 vertexPosition;\n"
+        "uniform mat4 mvp;\n"
+        "void main() { gl_Position = mvp * vec4(vertexPosition, 1.0); }\n";
+
+const char fragmentShader[] =
+        "#version 110\n"
+        "uniform vec4 color;\n"
+        "void main() { gl_FragColor = color; }\n";
+
+Qt3DCore::QEntity *createScene(Qt3DRender::QGeometryRenderer **triangleRenderer,
+                               Qt3DRender::QShaderProgram **shaderProgram)
+{
+    Qt3DCore::QEntity *root = new Qt3DCore::QEntity();
+
+    // Frame graph
+    Qt3DRender::QCamera *camera = new Qt3DRender::QCamera(root);
+    camera->setPosition(QVector3D(0.0f, 0.0f, 10.0f));
+    camera->setViewCenter(QVector3D());
+
+    Qt3DRender::QViewport *viewport = new Qt3DRender::QViewport();
+    Qt3DRender::QClearBuffers *clearBuffers = new Qt3DRender::QClearBuffers(viewport);
+    clearBuffers->setBuffers(Qt3DRender::QClearBuffers::ColorDepthBuffer);
+    Qt3DRender::QCameraSelector *cameraSelector = new Qt3DRender::QCameraSelector(clearBuffers);
+    cameraSelector->setCamera(camera);
+
+    Qt3DRender::QRenderSettings *settings = new Qt3DRender::QRenderSettings();
+    settings->setActiveFrameGraph(viewport);
+    root->addComponent(settings);
+
+    // Triangle
+    Qt3DCore::QGeometry *geometry = new Qt3DCore::QGeometry();
+    const float positions[] = {
+        -1.0f, -1.0f, 0.0f,
+        1.0f, -1.0f, 0.0f,
+        0.0f, 1.0f, 0.0f
+    };
+    Qt3DCore::QBuffer *buffer = new Qt3DCore::QBuffer(geometry);
+    buffer->setData(QByteArray(reinterpret_cast<const char *>(positions), sizeof(positions)));
+    Qt3DCore::QAttribute *positionAttribute = new Qt3DCore::QAttribute();
+    positionAttribute->setName(Qt3DCore::QAttribute::defaultPositionAttributeName());
+    positionAttribute->setBuffer(buffer);
+    positionAttribute->setVertexBaseType(Qt3DCore::QAttribute::Float);
+    positionAttribute->setVertexSize(3);
+    positionAttribute->setByteStride(3 * sizeof(float));
+    positionAttribute->setCount(3);
+    geometry->addAttribute(positionAttribute);
+
+    Qt3DRender::QGeometryRenderer *geometryRenderer = new Qt3DRender::QGeometryRenderer();
+    geometryRenderer->setGeometry(geometry);
+
+    Qt3DRender::QShaderProgram *program = new Qt3DRender::QShaderProgram();
+    program->setVertexShaderCode(vertexShader);
+    program->setFragmentShaderCode(fragmentShader);
+    Qt3DRender::QRenderPass *pass = new Qt3DRender::QRenderPass();
+    pass->setShaderProgram(program);
+    Qt3DRender::QTechnique *technique = new Qt3DRender::QTechnique();
+    technique->graphicsApiFilter()->setApi(Qt3DRender::QGraphicsApiFilter::OpenGL);
+    technique->graphicsApiFilter()->setProfile(Qt3DRender::QGraphicsApiFilter::NoProfile);
+    technique->graphicsApiFilter()->setMajorVersion(2);
+    technique->graphicsApiFilter()->setMinorVersion(0);
+    technique->addRenderPass(pass);
+    Qt3DRender::QEffect *effect = new Qt3DRender::QEffect();
+    effect->addTechnique(technique);
+    Qt3DRender::QMaterial *material = new Qt3DRender::QMaterial();
+    material->setEffect(effect);
+    material->addParameter(new Qt3DRender::QParameter(QStringLiteral("color"), QColor(Qt::red)));
+
+    Qt3DCore::QEntity *triangle = new Qt3DCore::QEntity(root);
+    triangle->addComponent(geometryRenderer);
+    triangle->addComponent(material);
+
+    *triangleRenderer = geometryRenderer;
+    *shaderProgram = program;
+    return root;
+}
+
+} // anonymous
+
+class tst_NullRenderer : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase()
+    {
+        qputenv("QT3D_RENDERER", "null");
+
+        // The null renderer reports the default format as its context
+        QSurfaceFormat format;
+        format.setRenderableType(QSurfaceFormat::OpenGL);
+        format.setVersion(2, 0);
+        format.setProfile(QSurfaceFormat::NoProfile);
+        QSurfaceFormat::setDefaultFormat(format);
+    }
+
+    void checkRecordedCommandStream()
+    {
+        // GIVEN
+        Qt3DRender::QGeometryRenderer *geometryRenderer = nullptr;
+        Qt3DRender::QShaderProgram *shaderProgram = nullptr;
+        Qt3DCore::QEntityPtr root(createScene(&geometryRenderer, &shaderProgram));
+
+        Qt3DCore::QAspectEngine engine;
+        Qt3DRender::QRenderAspect *aspect = new Qt3DRender::QRenderAspect(Qt3DRender::QRenderAspect::Synchronous);
+        engine.registerAspect(aspect);
+        engine.setRunMode(Qt3DCore::QAspectEngine::Manual);
+
+        Qt3DRender::QRenderAspectPrivate *daspect = Qt3DRender::QRenderAspectPrivate::get(aspect);
+        daspect->renderInitialize(nullptr);
+        Null::NullRenderer *renderer = static_cast<Null::NullRenderer *>(daspect->m_renderer);
+        renderer->setMaxRecordedFrames(1);
+
+        engine.setRootEntity(root);
+
+        // WHEN
+        // The shader only gets introspected once the first frame has been
+        // processed, its commands show up in the frames following it
+        const int frameCount = 5;
+        for (int i = 0; i < frameCount; ++i) {
+            engine.processFrame();
+            daspect->renderSynchronous(true);
+        }
+
+        // THEN
+        QCOMPARE(renderer->renderedFrameCount(), quint64(frameCount));
+        const QVector<Null::RecordedFrame> frames = renderer->takeRecordedFrames();
+        QCOMPARE(frames.size(), 1);
+        QVERIFY(renderer->takeRecordedFrames().isEmpty());
+
+        const Null::RecordedFrame &frame = frames.first();
+        QCOMPARE(frame.frameIndex, quint64(frameCount - 1));
+        QCOMPARE(frame.renderViews.size(), 1);
+
+        const Null::RecordedRenderView &view = frame.renderViews.first();
+        QCOMPARE(view.clearBuffers, Qt3DRender::QClearBuffers::BufferTypeFlags(Qt3DRender::QClearBuffers::ColorDepthBuffer));
+        QCOMPARE(view.viewport, QRectF(0.0, 0.0, 1.0, 1.0));
+        QVERIFY(!view.isCompute);
+        QVERIFY(!view.noDraw);
+        QCOMPARE(view.commands.size(), 1);
+
+        const Null::RecordedCommand &command = view.commands.first();
+        QCOMPARE(command.type, OpenGL::RenderCommand::Draw);
+        QCOMPARE(command.geometryRendererId, geometryRenderer->id());
+        QCOMPARE(command.shaderId, shaderProgram->id());
+        QCOMPARE(command.primitiveType, Qt3DRender::QGeometryRenderer::Triangles);
+        QCOMPARE(command.primitiveCount, 3);
+        QCOMPARE(command.instanceCount, 1);
+        QVERIFY(!command.drawIndexed);
+        QVERIFY(!command.drawIndirect);
+        // mvp and color
+        QCOMPARE(command.uniformCount, 2);
+
+        // WHEN
+        renderer->setMaxRecordedFrames(0);
+        engine.processFrame();
+        daspect->renderSynchronous(true);
+
+        // THEN
+        QCOMPARE(renderer->renderedFrameCount(), quint64(frameCount + 1));
+        QVERIFY(renderer->takeRecordedFrames().isEmpty());
+
+        engine.setRootEntity(Qt3DCore::QEntityPtr());
+        engine.unregisterAspect(aspect);
+        delete aspect;
+    }
+};
+
+QTEST_MAIN(tst_NullRenderer)
+
+#include "tst_nullrenderer.moc"
@@ -6,11 +6,14 @@ SUBDIRS += \
         graphicshelpergl3_2 \
         graphicshelpergl2 \
         glshadermanager \
+        glslintrospection \
+        nullrenderer \
         textures \
         renderer \
         renderviewutils \
         renderviews \
         renderqueue \
+        shaderparameterpack \
         renderviewbuilder \
         qgraphicsutils \
         computecommand
@@ -38,6 +38,10 @@
 #include <Qt3DRender/qdispatchcompute.h>
 #include <Qt3DRender/qfrustumculling.h>
 #include <Qt3DRender/qmaterial.h>
+#include <Qt3DRender/qeffect.h>
+#include <Qt3DRender/qtechnique.h>
+#include <Qt3DRender/qrenderpass.h>
+#include <Qt3DRender/qparameter.h>
 #include <Qt3DRender/qspotlight.h>
 #include <Qt3DRender/qpointlight.h>
 #include <Qt3DRender/qenvironmentlight.h>
@@ -670,6 +674,271 @@ private Q_SLOTS:
         }
     }
 
+    void checkSpliceRenderCommandData()
+    {
+        // GIVEN
+        Qt3DRender::Render::Entity entities[4];
+        Qt3DRender::Render::Entity *e0 = &entities[0];
+        Qt3DRender::Render::Entity *e1 = &entities[1];
+        Qt3DRender::Render::Entity *e2 = &entities[2];
+        Qt3DRender::Render::Entity *e3 = &entities[3];
+
+        const auto command = [] (float depth) {
+            Qt3DRender::Render::OpenGL::RenderCommand c;
+            c.m_depth = depth;
+            return c;
+        };
+
+        Qt3DRender::Render::OpenGL::EntityRenderCommandData cachedData;
+        cachedData.push_back(e0, command(0.0f), {});
+        cachedData.push_back(e1, command(1.0f), {});
+        cachedData.push_back(e1, command(2.0f), {});
+        cachedData.push_back(e3, command(3.0f), {});
+
+        {
+            // WHEN
+            Qt3DRender::Render::OpenGL::EntityRenderCommandData rebuiltData;
+            rebuiltData.push_back(e2, command(20.0f), {});
+            Qt3DRender::Render::OpenGL::RenderViewBuilder::spliceRenderCommandData(cachedData, { e1, e2 }, std::move(rebuiltData));
+
+            // THEN
+            QCOMPARE(cachedData.size(), 3);
+            QCOMPARE(cachedData.entities, QVector<Qt3DRender::Render::Entity *>({ e0, e2, e3 }));
+            QCOMPARE(cachedData.commands.at(0).m_depth, 0.0f);
+            QCOMPARE(cachedData.commands.at(1).m_depth, 20.0f);
+            QCOMPARE(cachedData.commands.at(2).m_depth, 3.0f);
+        }
+        {
+            // WHEN
+            Qt3DRender::Render::OpenGL::EntityRenderCommandData rebuiltData;
+            rebuiltData.push_back(e0, command(10.0f), {});
+            rebuiltData.push_back(e0, command(11.0f), {});
+            Qt3DRender::Render::OpenGL::RenderViewBuilder::spliceRenderCommandData(cachedData, { e0 }, std::move(rebuiltData));
+
+            // THEN
+            QCOMPARE(cachedData.size(), 4);
+            QCOMPARE(cachedData.entities, QVector<Qt3DRender::Render::Entity *>({ e0, e0, e2, e3 }));
+            QCOMPARE(cachedData.commands.at(0).m_depth, 10.0f);
+            QCOMPARE(cachedData.commands.at(1).m_depth, 11.0f);
+            QCOMPARE(cachedData.commands.at(2).m_depth, 20.0f);
+            QCOMPARE(cachedData.commands.at(3).m_depth, 3.0f);
+        }
+        {
+            // WHEN
+            Qt3DRender::Render::OpenGL::RenderViewBuilder::spliceRenderCommandData(cachedData, {}, {});
+
+            // THEN
+            QCOMPARE(cachedData.size(), 4);
+        }
+    }
+
+    void checkMarkDirtyTracksEntityScopedChanges()
+    {
+        // GIVEN
+        Qt3DRender::QViewport *viewport = new Qt3DRender::QViewport();
+        Qt3DRender::QClearBuffers *clearBuffer = new Qt3DRender::QClearBuffers(viewport);
+        Qt3DRender::TestAspect testAspect(buildEntityFilterTestScene(viewport, new Qt3DRender::QLayer()));
+        Qt3DRender::Render::OpenGL::Renderer *renderer = testAspect.renderer();
+        Qt3DRender::Render::FrameGraphNode *leafNode = testAspect.nodeManagers()->frameGraphManager()->lookupNode(clearBuffer->id());
+        QVERIFY(leafNode != nullptr);
+
+        renderer->renderableEntityFilterJob()->run();
+        const QVector<Qt3DRender::Render::Entity *> renderableEntities = renderer->cache()->renderableEntities;
+        QCOMPARE(renderableEntities.size(), 200);
+        Qt3DRender::Render::Entity *dirtyEntity = renderableEntities.at(42);
+        Qt3DRender::Render::Material *dirtyMaterial = dirtyEntity->renderComponent<Qt3DRender::Render::Material>();
+        QVERIFY(dirtyMaterial != nullptr);
+
+        // WHEN
+        renderer->clearDirtyBits(Qt3DRender::Render::AbstractRenderer::AllDirty);
+        renderer->markDirty(Qt3DRender::Render::AbstractRenderer::MaterialDirty, dirtyMaterial);
+        renderer->renderBinJobs();
+
+        // THEN
+        const Qt3DRender::Render::OpenGL::RendererCache::DirtyEntityData &dirtyEntities = renderer->cache()->dirtyEntities;
+        QCOMPARE(dirtyEntities.materialIds, QVector<Qt3DCore::QNodeId>({ dirtyMaterial->peerId() }));
+        QVERIFY(dirtyEntities.entityIds.isEmpty());
+        QVERIFY(dirtyEntities.geometryRendererIds.isEmpty());
+        for (Qt3DRender::Render::Entity *entity : renderableEntities)
+            QCOMPARE(dirtyEntities.contains(entity), entity == dirtyEntity);
+
+        // WHEN
+        renderer->markDirty(Qt3DRender::Render::AbstractRenderer::MaterialDirty, dirtyMaterial);
+        renderer->markDirty(Qt3DRender::Render::AbstractRenderer::ShadersDirty, nullptr);
+        renderer->renderBinJobs();
+
+        // THEN
+        QVERIFY(renderer->cache()->dirtyEntities.isEmpty());
+    }
+
+    void checkMaterialScopedChangesPatchMaterialParameters()
+    {
+        // GIVEN
+        Qt3DRender::QViewport *viewport = new Qt3DRender::QViewport();
+        Qt3DRender::QClearBuffers *clearBuffer = new Qt3DRender::QClearBuffers(viewport);
+        Qt3DCore::QEntity *root = buildEntityFilterTestScene(viewport, new Qt3DRender::QLayer());
+
+        const auto buildEffect = [] (Qt3DRender::QTechnique *technique, Qt3DRender::QRenderPass *pass) {
+            Qt3DRender::QEffect *effect = new Qt3DRender::QEffect();
+            technique->addRenderPass(pass);
+            effect->addTechnique(technique);
+            return effect;
+        };
+
+        // Two Materials sharing an Effect and a third one with its own
+        Qt3DRender::QTechnique *sharedTechnique = new Qt3DRender::QTechnique();
+        Qt3DRender::QRenderPass *sharedPass = new Qt3DRender::QRenderPass();
+        Qt3DRender::QParameter *passParameter = new Qt3DRender::QParameter(QStringLiteral("passParameter"), 1.0f);
+        sharedPass->addParameter(passParameter);
+        Qt3DRender::QEffect *sharedEffect = buildEffect(sharedTechnique, sharedPass);
+        Qt3DRender::QTechnique *otherTechnique = new Qt3DRender::QTechnique();
+        Qt3DRender::QEffect *otherEffect = buildEffect(otherTechnique, new Qt3DRender::QRenderPass());
+
+        Qt3DRender::QParameter *materialParameter = new Qt3DRender::QParameter(QStringLiteral("materialParameter"), 2.0f);
+        Qt3DRender::QMaterial *material1 = new Qt3DRender::QMaterial(root);
+        material1->setEffect(sharedEffect);
+        Qt3DRender::QMaterial *material2 = new Qt3DRender::QMaterial(root);
+        material2->setEffect(sharedEffect);
+        material2->addParameter(materialParameter);
+        Qt3DRender::QMaterial *material3 = new Qt3DRender::QMaterial(root);
+        material3->setEffect(otherEffect);
+
+        Qt3DRender::TestAspect testAspect(root);
+        Qt3DRender::Render::NodeManagers *nodeManagers = testAspect.nodeManagers();
+        Qt3DRender::Render::OpenGL::Renderer *renderer = testAspect.renderer();
+        Qt3DRender::Render::FrameGraphNode *leafNode = nodeManagers->frameGraphManager()->lookupNode(clearBuffer->id());
+        QVERIFY(leafNode != nullptr);
+
+        Qt3DRender::Render::Technique *backendSharedTechnique = nodeManagers->techniqueManager()->lookupResource(sharedTechnique->id());
+        backendSharedTechnique->setCompatibleWithRenderer(true);
+        nodeManagers->techniqueManager()->lookupResource(otherTechnique->id())->setCompatibleWithRenderer(true);
+
+        const auto gatherMaterialParameters = [&] (bool partialRebuild) {
+            Qt3DRender::Render::OpenGL::RenderViewBuilder builder(leafNode, 0, renderer);
+            builder.setOptimalJobCount(4);
+            builder.setMaterialGathererCacheNeedsToBeRebuilt(true);
+            builder.setMaterialGathererCacheNeedsPartialRebuild(partialRebuild);
+            builder.prepareJobs();
+            for (const auto &materialGatherer : builder.materialGathererJobs())
+                materialGatherer->run();
+            builder.syncMaterialGathererJob()->run();
+            return builder.materialGathererJobs().size();
+        };
+        const auto gatheredMaterials = [&] () {
+            return renderer->cache()->leafNodeCache.value(leafNode).materialParameterGatherer;
+        };
+
+        gatherMaterialParameters(false);
+        QVERIFY(gatheredMaterials().contains(material1->id()));
+        QVERIFY(gatheredMaterials().contains(material2->id()));
+        QVERIFY(gatheredMaterials().contains(material3->id()));
+
+        QVector<Qt3DCore::QNodeId> sharedEffectMaterialIds = { material1->id(), material2->id() };
+        std::sort(sharedEffectMaterialIds.begin(), sharedEffectMaterialIds.end());
+
+        // WHEN
+        renderer->clearDirtyBits(Qt3DRender::Render::AbstractRenderer::AllDirty);
+        renderer->markDirty(Qt3DRender::Render::AbstractRenderer::ParameterDirty,
+                            nodeManagers->parameterManager()->lookupResource(passParameter->id()));
+        renderer->renderBinJobs();
+
+        // THEN -> value changes don't require anything to be gathered
+        QVERIFY(renderer->cache()->dirtyMaterialIds.isEmpty());
+
+        // WHEN
+        renderer->markDirty(Qt3DRender::Render::AbstractRenderer::AllDirty,
+                            nodeManagers->renderPassManager()->lookupResource(sharedPass->id()));
+        renderer->renderBinJobs();
+
+        // THEN
+        QCOMPARE(renderer->cache()->dirtyMaterialIds, sharedEffectMaterialIds);
+        QCOMPARE(renderer->cache()->dirtyEntities.materialIds, sharedEffectMaterialIds);
+
+        // WHEN
+        renderer->markDirty(Qt3DRender::Render::AbstractRenderer::MaterialDirty | Qt3DRender::Render::AbstractRenderer::ParameterDirty,
+                            nodeManagers->parameterManager()->lookupResource(materialParameter->id()));
+        renderer->renderBinJobs();
+
+        // THEN
+        QCOMPARE(renderer->cache()->dirtyMaterialIds, QVector<Qt3DCore::QNodeId>({ material2->id() }));
+
+        // WHEN
+        backendSharedTechnique->setCompatibleWithRenderer(false);
+        renderer->markDirty(Qt3DRender::Render::AbstractRenderer::TechniquesDirty, backendSharedTechnique);
+        renderer->renderBinJobs();
+        const int gathererJobCount = gatherMaterialParameters(true);
+
+        // THEN -> only the Materials using the technique were gathered again
+        QCOMPARE(renderer->cache()->dirtyMaterialIds, sharedEffectMaterialIds);
+        QCOMPARE(gathererJobCount, 2);
+        QVERIFY(!gatheredMaterials().contains(material1->id()));
+        QVERIFY(!gatheredMaterials().contains(material2->id()));
+        QVERIFY(gatheredMaterials().contains(material3->id()));
+
+        // WHEN
+        renderer->markDirty(Qt3DRender::Render::AbstractRenderer::AllDirty,
+                            nodeManagers->renderPassManager()->lookupResource(sharedPass->id()));
+        renderer->markDirty(Qt3DRender::Render::AbstractRenderer::ShadersDirty, nullptr);
+        renderer->renderBinJobs();
+
+        // THEN -> full rebuild
+        QVERIFY(renderer->cache()->dirtyMaterialIds.isEmpty());
+    }
+
+    void checkFilterParameterChangesRegatherAllMaterials()
+    {
+        // GIVEN
+        Qt3DRender::QViewport *viewport = new Qt3DRender::QViewport();
+        Qt3DRender::QRenderPassFilter *renderPassFilter = new Qt3DRender::QRenderPassFilter(viewport);
+        Qt3DRender::QParameter *filterParameter = new Qt3DRender::QParameter(QStringLiteral("filterParameter"), 1.0f);
+        renderPassFilter->addParameter(filterParameter);
+        new Qt3DRender::QClearBuffers(renderPassFilter);
+        Qt3DCore::QEntity *root = buildEntityFilterTestScene(viewport, new Qt3DRender::QLayer());
+
+        Qt3DRender::QParameter *materialParameter = new Qt3DRender::QParameter(QStringLiteral("materialParameter"), 2.0f);
+        Qt3DRender::QMaterial *material = new Qt3DRender::QMaterial(root);
+        material->addParameter(materialParameter);
+
+        Qt3DRender::TestAspect testAspect(root);
+        Qt3DRender::Render::NodeManagers *nodeManagers = testAspect.nodeManagers();
+        Qt3DRender::Render::OpenGL::Renderer *renderer = testAspect.renderer();
+
+        // Traverses the frame graph
+        renderer->markDirty(Qt3DRender::Render::AbstractRenderer::AllDirty, nullptr);
+        renderer->renderBinJobs();
+        renderer->clearDirtyBits(Qt3DRender::Render::AbstractRenderer::AllDirty);
+
+        // WHEN
+        materialParameter->setName(QStringLiteral("renamedMaterialParameter"));
+        nodeManagers->parameterManager()->lookupResource(materialParameter->id())->syncFromFrontEnd(materialParameter, false);
+        renderer->renderBinJobs();
+
+        // THEN -> only the Material referencing the Parameter is gathered again
+        QCOMPARE(renderer->cache()->dirtyMaterialIds, QVector<Qt3DCore::QNodeId>({ material->id() }));
+        QCOMPARE(renderer->cache()->dirtyEntities.materialIds, QVector<Qt3DCore::QNodeId>({ material->id() }));
+
+        // WHEN
+        filterParameter->setName(QStringLiteral("renamedFilterParameter"));
+        nodeManagers->parameterManager()->lookupResource(filterParameter->id())->syncFromFrontEnd(filterParameter, false);
+        renderer->renderBinJobs();
+
+        // THEN -> the filter Parameter is gathered into every Material, all
+        // the material parameters and RenderCommands are rebuilt
+        QVERIFY(renderer->cache()->dirtyMaterialIds.isEmpty());
+        QVERIFY(renderer->cache()->dirtyEntities.isEmpty());
+
+        // WHEN
+        filterParameter->setEnabled(false);
+        nodeManagers->parameterManager()->lookupResource(filterParameter->id())->syncFromFrontEnd(filterParameter, false);
+        materialParameter->setName(QStringLiteral("materialParameter"));
+        nodeManagers->parameterManager()->lookupResource(materialParameter->id())->syncFromFrontEnd(materialParameter, false);
+        renderer->renderBinJobs();
+
+        // THEN
+        QVERIFY(renderer->cache()->dirtyMaterialIds.isEmpty());
+        QVERIFY(renderer->cache()->dirtyEntities.isEmpty());
+    }
+
 };
 
 QTEST_MAIN(tst_RenderViewBuilder)
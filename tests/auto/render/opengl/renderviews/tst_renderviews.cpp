@@ -530,15 +530,66 @@ private Q_SLOTS:
         // THEN
         const QVector<RenderCommand> sortedCommands = renderView.commands();
         QCOMPARE(rawCommands.size(), sortedCommands.size());
+        // Commands with the most textures first, same texture sets adjacent
         QCOMPARE(sortedCommands.at(0), a);
         QCOMPARE(sortedCommands.at(1), g);
-        QCOMPARE(sortedCommands.at(2), d);
-        QCOMPARE(sortedCommands.at(3), c);
+        QVERIFY((sortedCommands.at(2) == c && sortedCommands.at(3) == d) ||
+                (sortedCommands.at(2) == d && sortedCommands.at(3) == c));
         QCOMPARE(sortedCommands.at(4), e);
         QCOMPARE(sortedCommands.at(5), f);
         QCOMPARE(sortedCommands.at(6), b);
         // RenderCommands are deleted by RenderView dtor
     }
+
+    void checkRenderCommandSortingIsStable()
+    {
+        // GIVEN
+        RenderView renderView;
+        QVector<RenderCommand> rawCommands;
+        QVector<QSortPolicy::SortType> sortTypes;
+
+        sortTypes.push_back(QSortPolicy::Material);
+        sortTypes.push_back(QSortPolicy::FrontToBack);
+
+        GLShader *dnas[3] = {
+            reinterpret_cast<GLShader *>(0x250),
+            reinterpret_cast<GLShader *>(0x500),
+            reinterpret_cast<GLShader *>(0x1000)
+        };
+
+        // Enough commands to go through the radix sort, m_changeCost only
+        // records the original position as it isn't part of the sort policy
+        for (int i = 0; i < 1000; ++i) {
+            RenderCommand c;
+            c.m_glShader = dnas[i % 3];
+            c.m_depth = float(i % 7);
+            c.m_changeCost = i;
+            rawCommands.push_back(c);
+        }
+
+        // WHEN
+        renderView.addSortType(sortTypes);
+        renderView.setCommands(rawCommands);
+        renderView.sort();
+
+        // THEN
+        const QVector<RenderCommand> sortedCommands = renderView.commands();
+        QCOMPARE(rawCommands.size(), sortedCommands.size());
+        for (int j = 1; j < sortedCommands.size(); ++j) {
+            const RenderCommand &previous = sortedCommands.at(j - 1);
+            const RenderCommand &current = sortedCommands.at(j);
+            // Higher shader DNA first
+            QVERIFY(previous.m_glShader >= current.m_glShader);
+            if (previous.m_glShader != current.m_glShader)
+                continue;
+            // Closest first
+            QVERIFY(previous.m_depth <= current.m_depth);
+            if (previous.m_depth != current.m_depth)
+                continue;
+            // Original order preserved for equivalent commands
+            QVERIFY(previous.m_changeCost < current.m_changeCost);
+        }
+    }
 private:
 };
 
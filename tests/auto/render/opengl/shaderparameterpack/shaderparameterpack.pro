@@ -0,0 +1,14 @@
+TEMPLATE = app
+
+TARGET = tst_shaderparameterpack
+
+QT += 3dcore 3dcore-private 3drender 3drender-private testlib
+
+CONFIG += testcase
+
+SOURCES += tst_shaderparameterpack.cpp
+
+include(../../../core/common/common.pri)
+
+# Link Against OpenGL Renderer Plugin
+include(../opengl_render_plugin.pri)
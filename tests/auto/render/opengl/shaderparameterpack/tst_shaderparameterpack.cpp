@@ -0,0 +1,211 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QTest>
+#include <shaderparameterpack_p.h>
+
+using namespace Qt3DRender::Render;
+using namespace Qt3DRender::Render::OpenGL;
+
+namespace {
+
+UniformLayout buildLayout(const QVector<int> &nameIds)
+{
+    QVector<ShaderUniform> uniforms;
+    for (const int nameId : nameIds) {
+        ShaderUniform uniform;
+        uniform.m_nameId = nameId;
+        uniforms.push_back(uniform);
+    }
+    UniformLayout layout;
+    layout.build(uniforms);
+    return layout;
+}
+
+// Checks that the uniforms referenced by slot match their keys
+bool slotIndicesAreConsistent(const PackUniformHash &uniforms)
+{
+    if (uniforms.layout == nullptr)
+        return uniforms.indexBySlot.isEmpty();
+    if (uniforms.indexBySlot.size() != uniforms.layout->slotCount())
+        return false;
+    for (int slot = 0; slot < uniforms.indexBySlot.size(); ++slot) {
+        const int idx = uniforms.indexBySlot.at(slot);
+        if (idx != -1 && uniforms.layout->slot(uniforms.keys.at(idx)) != slot)
+            return false;
+    }
+    for (int i = 0; i < uniforms.keys.size(); ++i) {
+        const int slot = uniforms.layout->slot(uniforms.keys.at(i));
+        if (slot != -1 && uniforms.indexBySlot.at(slot) != i)
+            return false;
+    }
+    return true;
+}
+
+} // anonymous
+
+class tst_ShaderParameterPack : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+
+    void checkUniformLayout()
+    {
+        // GIVEN
+        const UniformLayout directLayout = buildLayout({ 3, 5, 8 });
+        const UniformLayout sparseLayout = buildLayout({ 3, 100000 });
+
+        // THEN
+        QCOMPARE(directLayout.slotCount(), 3);
+        QCOMPARE(directLayout.slot(3), 0);
+        QCOMPARE(directLayout.slot(5), 1);
+        QCOMPARE(directLayout.slot(8), 2);
+        QCOMPARE(directLayout.slot(4), -1);
+        QCOMPARE(directLayout.slot(2), -1);
+        QCOMPARE(directLayout.slot(9), -1);
+        QCOMPARE(sparseLayout.slotCount(), 2);
+        QCOMPARE(sparseLayout.slot(3), 0);
+        QCOMPARE(sparseLayout.slot(100000), 1);
+        QCOMPARE(sparseLayout.slot(50), -1);
+    }
+
+    void checkLayoutChangeWithUniformsSet()
+    {
+        // GIVEN
+        const UniformLayout firstLayout = buildLayout({ 10, 30 });
+        const UniformLayout secondLayout = buildLayout({ 20, 40 });
+        PackUniformHash uniforms;
+        uniforms.insert(10, UniformValue(1.0f));
+        uniforms.insert(20, UniformValue(2.0f));
+        uniforms.insert(30, UniformValue(3.0f));
+
+        // WHEN
+        uniforms.setLayout(&firstLayout);
+
+        // THEN
+        QVERIFY(slotIndicesAreConsistent(uniforms));
+        QCOMPARE(uniforms.indexBySlot, QVector<int>({ 0, 2 }));
+        QVERIFY(uniforms.value(10) == UniformValue(1.0f));
+        QVERIFY(uniforms.value(20) == UniformValue(2.0f));
+        QVERIFY(uniforms.value(30) == UniformValue(3.0f));
+
+        // WHEN
+        uniforms.setLayout(&secondLayout);
+        uniforms.insert(40, UniformValue(4.0f));
+        uniforms.insert(30, UniformValue(5.0f));
+
+        // THEN
+        QVERIFY(slotIndicesAreConsistent(uniforms));
+        QCOMPARE(uniforms.indexBySlot, QVector<int>({ 1, 3 }));
+        QCOMPARE(uniforms.keys.size(), 4);
+        QVERIFY(uniforms.value(30) == UniformValue(5.0f));
+        QVERIFY(uniforms.value(40) == UniformValue(4.0f));
+
+        // WHEN
+        uniforms.setLayout(nullptr);
+
+        // THEN
+        QVERIFY(slotIndicesAreConsistent(uniforms));
+        QCOMPARE(uniforms.indexOf(40), 3);
+        QVERIFY(uniforms.value(20) == UniformValue(2.0f));
+    }
+
+    void checkEraseSlottedUniform()
+    {
+        // GIVEN
+        const UniformLayout layout = buildLayout({ 10, 20, 30 });
+        PackUniformHash uniforms;
+        uniforms.setLayout(&layout);
+        uniforms.insert(10, UniformValue(1.0f));
+        uniforms.insert(20, UniformValue(2.0f));
+        uniforms.insert(99, UniformValue(9.0f));
+        uniforms.insert(30, UniformValue(3.0f));
+
+        // WHEN
+        uniforms.erase(uniforms.indexOf(20));
+
+        // THEN
+        QVERIFY(slotIndicesAreConsistent(uniforms));
+        QVERIFY(!uniforms.contains(20));
+        QCOMPARE(uniforms.indexBySlot.at(1), -1);
+        QCOMPARE(uniforms.keys.size(), 3);
+        QVERIFY(uniforms.value(10) == UniformValue(1.0f));
+        QVERIFY(uniforms.value(30) == UniformValue(3.0f));
+        QVERIFY(uniforms.value(99) == UniformValue(9.0f));
+
+        // WHEN - the last uniform
+        uniforms.erase(uniforms.indexOf(30));
+
+        // THEN
+        QVERIFY(slotIndicesAreConsistent(uniforms));
+        QVERIFY(!uniforms.contains(30));
+        QCOMPARE(uniforms.keys.size(), 2);
+
+        // WHEN - a uniform missing from the layout
+        uniforms.erase(uniforms.indexOf(99));
+
+        // THEN
+        QVERIFY(slotIndicesAreConsistent(uniforms));
+        QVERIFY(!uniforms.contains(99));
+        QCOMPARE(uniforms.keys, QVector<int>({ 10 }));
+
+        // WHEN
+        uniforms.insert(20, UniformValue(4.0f));
+
+        // THEN
+        QVERIFY(slotIndicesAreConsistent(uniforms));
+        QVERIFY(uniforms.value(20) == UniformValue(4.0f));
+    }
+
+    void checkUniformMissingFromLayout()
+    {
+        // GIVEN
+        const UniformLayout layout = buildLayout({ 10 });
+        ShaderParameterPack pack;
+        pack.setUniformLayout(&layout);
+
+        // WHEN
+        pack.setUniform(99, UniformValue(1.0f));
+        pack.setUniform(10, UniformValue(2.0f));
+        pack.setUniform(99, UniformValue(3.0f));
+
+        // THEN
+        const PackUniformHash &uniforms = pack.uniforms();
+        QVERIFY(slotIndicesAreConsistent(uniforms));
+        QCOMPARE(uniforms.keys.size(), 2);
+        QVERIFY(uniforms.contains(99));
+        QVERIFY(pack.uniform(99) == UniformValue(3.0f));
+        QVERIFY(pack.uniform(10) == UniformValue(2.0f));
+        QVERIFY(!uniforms.contains(42));
+        QVERIFY(pack.uniform(42) == UniformValue());
+    }
+};
+
+QTEST_APPLESS_MAIN(tst_ShaderParameterPack)
+
+#include "tst_shaderparameterpack.moc"
@@ -0,0 +1,337 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QTest>
+#include <qbackendnodetester.h>
+#include <Qt3DCore/qbuffer.h>
+#include <Qt3DCore/qattribute.h>
+#include <Qt3DCore/qgeometry.h>
+#include <Qt3DRender/qgeometryrenderer.h>
+#include <private/nodemanagers_p.h>
+#include <private/managers_p.h>
+#include <private/buffermanager_p.h>
+#include <private/geometryrenderer_p.h>
+#include <private/geometryrenderermanager_p.h>
+#include <private/primitivebvh_p.h>
+#include <private/trianglesvisitor_p.h>
+#include <private/triangleboundingvolume_p.h>
+#include <QRandomGenerator>
+#include <cmath>
+#include "testrenderer.h"
+
+using namespace Qt3DRender::Render;
+using Qt3DRender::RayCasting::QRay3D;
+
+namespace {
+
+// Records the index of every triangle crossed by the ray
+class BruteForceVisitor : public TrianglesVisitor
+{
+public:
+    BruteForceVisitor(NodeManagers *manager, const QRay3D &ray, const Matrix4x4 &worldMatrix)
+        : TrianglesVisitor(manager)
+        , m_ray(ray)
+        , m_worldMatrix(worldMatrix)
+    {
+    }
+
+    QVector<uint> hits;
+
+    void visit(uint, const Vector3D &a, uint, const Vector3D &b, uint, const Vector3D &c) override
+    {
+        if (intersects(m_ray, m_worldMatrix * a, m_worldMatrix * b, m_worldMatrix * c))
+            hits.push_back(m_triangleIndex);
+        ++m_triangleIndex;
+    }
+
+    static bool intersects(const QRay3D &ray, const Vector3D &a, const Vector3D &b, const Vector3D &c)
+    {
+        Vector3D uvw;
+        float t = 0.0f;
+        return intersectsSegmentTriangle(ray, c, b, a, uvw, t)
+                || intersectsSegmentTriangle(ray, a, b, c, uvw, t);
+    }
+
+private:
+    QRay3D m_ray;
+    Matrix4x4 m_worldMatrix;
+    uint m_triangleIndex = 0;
+};
+
+} // anonymous
+
+class tst_PrimitiveBVH : public Qt3DCore::QBackendNodeTester
+{
+    Q_OBJECT
+
+public:
+    // Indexed height field of resolution * resolution * 2 triangles
+    GeometryRenderer *createGridMesh(int resolution)
+    {
+        m_managers.reset(new NodeManagers());
+        m_geometryRenderer.reset(new Qt3DRender::QGeometryRenderer());
+
+        auto geometry = new Qt3DCore::QGeometry(m_geometryRenderer.data());
+        m_positionBuffer = new Qt3DCore::QBuffer(geometry);
+        auto indexBuffer = new Qt3DCore::QBuffer(geometry);
+        auto positionAttribute = new Qt3DCore::QAttribute(geometry);
+        auto indexAttribute = new Qt3DCore::QAttribute(geometry);
+
+        const int vertexCount = (resolution + 1) * (resolution + 1);
+        QByteArray positions;
+        positions.resize(vertexCount * 3 * int(sizeof(float)));
+        float *p = reinterpret_cast<float *>(positions.data());
+        for (int z = 0; z <= resolution; ++z) {
+            for (int x = 0; x <= resolution; ++x) {
+                const float fx = 2.0f * x / resolution - 1.0f;
+                const float fz = 2.0f * z / resolution - 1.0f;
+                *p++ = fx;
+                *p++ = 0.25f * std::sin(5.0f * fx) * std::cos(5.0f * fz);
+                *p++ = fz;
+            }
+        }
+
+        QByteArray indices;
+        indices.resize(resolution * resolution * 6 * int(sizeof(uint)));
+        uint *i = reinterpret_cast<uint *>(indices.data());
+        for (int z = 0; z < resolution; ++z) {
+            for (int x = 0; x < resolution; ++x) {
+                const uint v = uint(z * (resolution + 1) + x);
+                const uint below = v + uint(resolution + 1);
+                *i++ = v;
+                *i++ = below;
+                *i++ = v + 1;
+                *i++ = v + 1;
+                *i++ = below;
+                *i++ = below + 1;
+            }
+        }
+
+        m_positionBuffer->setData(positions);
+        indexBuffer->setData(indices);
+
+        positionAttribute->setBuffer(m_positionBuffer);
+        positionAttribute->setName(Qt3DCore::QAttribute::defaultPositionAttributeName());
+        positionAttribute->setVertexBaseType(Qt3DCore::QAttribute::Float);
+        positionAttribute->setVertexSize(3);
+        positionAttribute->setCount(uint(vertexCount));
+        positionAttribute->setAttributeType(Qt3DCore::QAttribute::VertexAttribute);
+
+        indexAttribute->setBuffer(indexBuffer);
+        indexAttribute->setVertexBaseType(Qt3DCore::QAttribute::UnsignedInt);
+        indexAttribute->setVertexSize(1);
+        indexAttribute->setCount(uint(resolution * resolution * 6));
+        indexAttribute->setAttributeType(Qt3DCore::QAttribute::IndexAttribute);
+
+        geometry->addAttribute(positionAttribute);
+        geometry->addAttribute(indexAttribute);
+
+        m_geometryRenderer->setGeometry(geometry);
+        m_geometryRenderer->setPrimitiveType(Qt3DRender::QGeometryRenderer::Triangles);
+
+        for (Qt3DCore::QBuffer *buffer : { m_positionBuffer, indexBuffer }) {
+            Buffer *backendBuffer = m_managers->bufferManager()->getOrCreateResource(buffer->id());
+            backendBuffer->setRenderer(&m_renderer);
+            backendBuffer->setManager(m_managers->bufferManager());
+            simulateInitializationSync(buffer, backendBuffer);
+        }
+        for (Qt3DCore::QAttribute *attribute : { positionAttribute, indexAttribute }) {
+            Attribute *backendAttribute = m_managers->attributeManager()->getOrCreateResource(attribute->id());
+            backendAttribute->setRenderer(&m_renderer);
+            simulateInitializationSync(attribute, backendAttribute);
+        }
+
+        m_geometry = geometry;
+        Geometry *backendGeometry = m_managers->geometryManager()->getOrCreateResource(geometry->id());
+        backendGeometry->setRenderer(&m_renderer);
+        simulateInitializationSync(geometry, backendGeometry);
+
+        GeometryRenderer *backendRenderer = m_managers->geometryRendererManager()->getOrCreateResource(m_geometryRenderer->id());
+        backendRenderer->setRenderer(&m_renderer);
+        backendRenderer->setManager(m_managers->geometryRendererManager());
+        simulateInitializationSync(m_geometryRenderer.data(), backendRenderer);
+
+        return backendRenderer;
+    }
+
+private Q_SLOTS:
+    void checkBuild()
+    {
+        // GIVEN
+        GeometryRenderer *renderer = createGridMesh(16);
+        PrimitiveBVHCache cache;
+
+        // WHEN
+        const auto bvh = cache.bvh(m_managers.data(), renderer, PrimitiveBVH::Triangles);
+
+        // THEN
+        QVERIFY(bvh);
+        QCOMPARE(bvh->primitiveType(), PrimitiveBVH::Triangles);
+        QCOMPARE(bvh->primitives().size(), 16 * 16 * 2);
+        QVERIFY(!bvh->nodes().isEmpty());
+
+        // Every primitive is referenced by exactly one leaf
+        QVector<int> references(bvh->primitives().size(), 0);
+        for (const PrimitiveBVH::Node &node : bvh->nodes()) {
+            for (int i = node.first; i < node.first + node.count; ++i)
+                ++references[i];
+        }
+        for (int count : qAsConst(references))
+            QCOMPARE(count, 1);
+    }
+
+    void checkSameHitsAsFullTraversal_data()
+    {
+        QTest::addColumn<QMatrix4x4>("worldMatrix");
+
+        QMatrix4x4 transformed;
+        transformed.translate(3.0f, -1.0f, 2.0f);
+        transformed.rotate(35.0f, QVector3D(1.0f, 1.0f, 0.0f).normalized());
+        transformed.scale(2.0f, 0.5f, 1.5f);
+
+        QTest::newRow("identity") << QMatrix4x4();
+        QTest::newRow("transformed") << transformed;
+    }
+
+    void checkSameHitsAsFullTraversal()
+    {
+        QFETCH(QMatrix4x4, worldMatrix);
+
+        // GIVEN
+        GeometryRenderer *renderer = createGridMesh(24);
+        PrimitiveBVHCache cache;
+        const Matrix4x4 world(worldMatrix);
+        const auto bvh = cache.bvh(m_managers.data(), renderer, PrimitiveBVH::Triangles);
+        QRandomGenerator generator(1234);
+
+        for (int r = 0; r < 256; ++r) {
+            const Vector3D origin = world * Vector3D(float(generator.bounded(3.0) - 1.5), 4.0f,
+                                                     float(generator.bounded(3.0) - 1.5));
+            const Vector3D target = world * Vector3D(float(generator.bounded(3.0) - 1.5), -1.0f,
+                                                     float(generator.bounded(3.0) - 1.5));
+            const QRay3D ray(origin, (target - origin).normalized(), (target - origin).length());
+
+            // WHEN
+            BruteForceVisitor visitor(m_managers.data(), ray, world);
+            visitor.apply(renderer, Qt3DCore::QNodeId());
+
+            QVector<uint> bvhHits;
+            const auto candidates = bvh->intersectingPrimitives(ray, world, 0.0f);
+            for (const PrimitiveBVH::Primitive *p : candidates) {
+                if (BruteForceVisitor::intersects(ray, world * p->vertices[0],
+                                                  world * p->vertices[1],
+                                                  world * p->vertices[2]))
+                    bvhHits.push_back(p->index);
+            }
+
+            // THEN
+            QCOMPARE(bvhHits, visitor.hits);
+        }
+    }
+
+    void checkCacheInvalidation()
+    {
+        // GIVEN
+        GeometryRenderer *renderer = createGridMesh(8);
+        PrimitiveBVHCache cache;
+        const auto first = cache.bvh(m_managers.data(), renderer, PrimitiveBVH::Triangles);
+
+        // WHEN
+        const auto second = cache.bvh(m_managers.data(), renderer, PrimitiveBVH::Triangles);
+
+        // THEN
+        QVERIFY(second == first);
+        QCOMPARE(cache.buildCount(), 1);
+        QCOMPARE(cache.size(), 1);
+
+        // WHEN
+        QByteArray positions = m_positionBuffer->data();
+        reinterpret_cast<float *>(positions.data())[1] = 10.0f;
+        m_positionBuffer->setData(positions);
+        Buffer *backendBuffer = m_managers->bufferManager()->lookupResource(m_positionBuffer->id());
+        backendBuffer->syncFromFrontEnd(m_positionBuffer, false);
+        const auto third = cache.bvh(m_managers.data(), renderer, PrimitiveBVH::Triangles);
+
+        // THEN
+        QVERIFY(third != first);
+        QCOMPARE(cache.buildCount(), 2);
+        QCOMPARE(cache.size(), 1);
+
+        // WHEN
+        m_managers->geometryManager()->releaseResource(m_geometry->id());
+        cache.removeStaleEntries(m_managers->geometryManager());
+
+        // THEN
+        QCOMPARE(cache.size(), 0);
+    }
+
+    void checkSharedGeometryWithDifferentPrimitiveTypes()
+    {
+        // GIVEN
+        GeometryRenderer *renderer = createGridMesh(8);
+        Qt3DRender::QGeometryRenderer stripRenderer;
+        stripRenderer.setGeometry(m_geometry);
+        stripRenderer.setPrimitiveType(Qt3DRender::QGeometryRenderer::TriangleStrip);
+        GeometryRenderer *backendStripRenderer = m_managers->geometryRendererManager()->getOrCreateResource(stripRenderer.id());
+        backendStripRenderer->setRenderer(&m_renderer);
+        backendStripRenderer->setManager(m_managers->geometryRendererManager());
+        simulateInitializationSync(&stripRenderer, backendStripRenderer);
+        PrimitiveBVHCache cache;
+
+        // WHEN
+        for (int i = 0; i < 3; ++i) {
+            cache.bvh(m_managers.data(), renderer, PrimitiveBVH::Triangles);
+            cache.bvh(m_managers.data(), backendStripRenderer, PrimitiveBVH::Triangles);
+        }
+
+        // THEN - one entry per renderer primitive type, each built once
+        QCOMPARE(cache.buildCount(), 2);
+        QCOMPARE(cache.size(), 2);
+        QVERIFY(cache.bvh(m_managers.data(), renderer, PrimitiveBVH::Triangles)->primitives().size()
+                != cache.bvh(m_managers.data(), backendStripRenderer, PrimitiveBVH::Triangles)->primitives().size());
+
+        // WHEN
+        m_managers->geometryManager()->releaseResource(m_geometry->id());
+        cache.removeStaleEntries(m_managers->geometryManager());
+
+        // THEN
+        QCOMPARE(cache.size(), 0);
+    }
+
+private:
+    QScopedPointer<NodeManagers> m_managers;
+    QScopedPointer<Qt3DRender::QGeometryRenderer> m_geometryRenderer;
+    Qt3DCore::QBuffer *m_positionBuffer = nullptr;
+    Qt3DCore::QGeometry *m_geometry = nullptr;
+    TestRenderer m_renderer;
+};
+
+QTEST_MAIN(tst_PrimitiveBVH)
+
+#include "tst_primitivebvh.moc"
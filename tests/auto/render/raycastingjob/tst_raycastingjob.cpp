@@ -175,11 +175,9 @@ public:
     Qt3DCore::QNode *lookupNode(Qt3DCore::QNodeId id) const override { return  m_frontEndNodes.value(id, nullptr); }
     QVector<Qt3DCore::QNode *> lookupNodes(const QVector<Qt3DCore::QNodeId> &ids) const override {
         QVector<Qt3DCore::QNode *> res;
-        for (const auto &id: ids) {
-            auto node = m_frontEndNodes.value(id, nullptr);
-            if (node)
-                res.push_back(node);
-        }
+        res.reserve(ids.size());
+        for (const auto &id: ids)
+            res.push_back(m_frontEndNodes.value(id, nullptr));
         return  res;
     }
 
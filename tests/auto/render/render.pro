@@ -105,7 +105,12 @@ qtConfig(private_tests) {
         qtexturedataupdate \
         qshaderimage \
         shaderimage \
-        shadergraph
+        shadergraph \
+        primitivebvh \
+        entityspatialindex \
+        frustumculling \
+        lightgrid \
+        meshgeometrycache
 
     QT_FOR_CONFIG = 3dcore-private
     # TO DO: These could be restored to be executed in all cases
@@ -536,6 +536,83 @@ private slots:
         QCOMPARE(backend.shaderCode(type), es2Code);
     }
 
+    void shouldReuseCachedCodeForIdenticalInputs()
+    {
+        // GIVEN
+        Qt3DRender::Render::ShaderBuilder::setPrototypesFile(":/prototypes.json");
+        Qt3DRender::Render::ShaderBuilder::clearCodeCache();
+
+        const auto gl3Api = []{
+            auto api = Qt3DRender::GraphicsApiFilterData();
+            api.m_api = Qt3DRender::QGraphicsApiFilter::OpenGL;
+            api.m_profile = Qt3DRender::QGraphicsApiFilter::CoreProfile;
+            api.m_major = 3;
+            api.m_minor = 2;
+            return api;
+        }();
+
+        const auto es2Api = []{
+            auto api = Qt3DRender::GraphicsApiFilterData();
+            api.m_api = Qt3DRender::QGraphicsApiFilter::OpenGLES;
+            api.m_major = 2;
+            api.m_minor = 0;
+            return api;
+        }();
+
+        const auto type = Qt3DRender::QShaderProgram::Fragment;
+        const auto graphUrl = QUrl::fromEncoded("qrc:/input.json");
+
+        Qt3DRender::Render::ShaderBuilder backend1;
+        backend1.setShaderGraph(type, graphUrl);
+        backend1.setGraphicsApi(gl3Api);
+
+        Qt3DRender::Render::ShaderBuilder backend2;
+        backend2.setShaderGraph(type, graphUrl);
+        backend2.setGraphicsApi(gl3Api);
+
+        // WHEN
+        backend1.generateCode(type);
+
+        // THEN
+        QCOMPARE(Qt3DRender::Render::ShaderBuilder::codeCacheMissCount(), 1);
+        QCOMPARE(Qt3DRender::Render::ShaderBuilder::codeCacheHitCount(), 0);
+
+        // WHEN
+        backend2.generateCode(type);
+
+        // THEN
+        QCOMPARE(Qt3DRender::Render::ShaderBuilder::codeCacheMissCount(), 1);
+        QCOMPARE(Qt3DRender::Render::ShaderBuilder::codeCacheHitCount(), 1);
+        QVERIFY(!backend2.isShaderCodeDirty(type));
+        QCOMPARE(backend2.shaderCode(type), backend1.shaderCode(type));
+        QCOMPARE(backend2.takePendingUpdates().size(), 1);
+
+        // WHEN
+        backend2.setGraphicsApi(es2Api);
+        backend2.generateCode(type);
+
+        // THEN
+        QCOMPARE(Qt3DRender::Render::ShaderBuilder::codeCacheMissCount(), 2);
+        QCOMPARE(Qt3DRender::Render::ShaderBuilder::codeCacheHitCount(), 1);
+        QVERIFY(backend2.shaderCode(type) != backend1.shaderCode(type));
+
+        // WHEN
+        backend2.setGraphicsApi(gl3Api);
+        backend2.generateCode(type);
+
+        // THEN
+        QCOMPARE(Qt3DRender::Render::ShaderBuilder::codeCacheMissCount(), 2);
+        QCOMPARE(Qt3DRender::Render::ShaderBuilder::codeCacheHitCount(), 2);
+        QCOMPARE(backend2.shaderCode(type), backend1.shaderCode(type));
+
+        // WHEN
+        Qt3DRender::Render::ShaderBuilder::clearCodeCache();
+
+        // THEN
+        QCOMPARE(Qt3DRender::Render::ShaderBuilder::codeCacheMissCount(), 0);
+        QCOMPARE(Qt3DRender::Render::ShaderBuilder::codeCacheHitCount(), 0);
+    }
+
     void checkCodeUpdatedNotification_data()
     {
         QTest::addColumn<Qt3DRender::QShaderProgram::ShaderType>("type");
@@ -198,6 +198,56 @@ private Q_SLOTS:
         joint->setName(name);
         QTest::newRow("inverseBind") << m << localPose << name << joint;
     }
+
+    void checkCalculateSkinningMatrixPalette()
+    {
+        // GIVEN
+        Skeleton backendSkeleton;
+        SkeletonData data;
+
+        Qt3DCore::Sqt rootPose;
+        rootPose.translation = QVector3D(1.0f, 2.0f, 3.0f);
+        rootPose.rotation = QQuaternion::fromAxisAndAngle(0.0f, 1.0f, 0.0f, 30.0f);
+        rootPose.scale = QVector3D(2.0f, 2.0f, 2.0f);
+
+        Qt3DCore::Sqt childPose;
+        childPose.translation = QVector3D(0.0f, 4.0f, 0.0f);
+        childPose.rotation = QQuaternion::fromAxisAndAngle(1.0f, 0.0f, 1.0f, 45.0f);
+        childPose.scale = QVector3D(1.0f, 0.5f, 3.0f);
+
+        JointInfo root;
+        root.inverseBindPose.translate(-1.0f, 0.0f, 0.0f);
+        JointInfo child;
+        child.parentIndex = 0;
+        child.inverseBindPose.rotate(90.0f, 0.0f, 0.0f, 1.0f);
+
+        data.joints << root << child;
+        data.localPoses << rootPose << childPose;
+        data.jointNames << QLatin1String("root") << QLatin1String("child");
+
+        // THEN
+        QVERIFY(backendSkeleton.isSkinningPaletteDirty());
+
+        // WHEN
+        backendSkeleton.setSkeletonData(data);
+        const QVector<QMatrix4x4> palette = backendSkeleton.calculateSkinningMatrixPalette();
+
+        // THEN
+        const QMatrix4x4 rootGlobalPose = rootPose.toMatrix();
+        const QMatrix4x4 childGlobalPose = rootGlobalPose * childPose.toMatrix();
+        QCOMPARE(palette.size(), 2);
+        QVERIFY(qFuzzyCompare(palette[0], rootGlobalPose * root.inverseBindPose));
+        QVERIFY(qFuzzyCompare(palette[1], childGlobalPose * child.inverseBindPose));
+        QVERIFY(qFuzzyCompare(backendSkeleton.joints()[1].globalPose, childGlobalPose));
+        QVERIFY(!backendSkeleton.isSkinningPaletteDirty());
+        QCOMPARE(backendSkeleton.skinningPalette(), palette);
+
+        // WHEN
+        backendSkeleton.clearData();
+
+        // THEN
+        QVERIFY(backendSkeleton.isSkinningPaletteDirty());
+    }
 };
 
 QTEST_APPLESS_MAIN(tst_Skeleton)
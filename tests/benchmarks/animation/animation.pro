@@ -0,0 +1,5 @@
+TEMPLATE=subdirs
+
+qtConfig(private_tests) {
+    SUBDIRS += clipanimatorevaluation
+}
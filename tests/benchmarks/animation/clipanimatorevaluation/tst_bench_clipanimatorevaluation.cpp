@@ -0,0 +1,135 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QTest>
+#include <Qt3DAnimation/qclipanimator.h>
+#include <Qt3DAnimation/private/animationclip_p.h>
+#include <Qt3DAnimation/private/channelmapper_p.h>
+#include <Qt3DAnimation/private/channelmapping_p.h>
+#include <Qt3DAnimation/private/clipanimator_p.h>
+#include <Qt3DAnimation/private/handler_p.h>
+#include <Qt3DAnimation/private/managers_p.h>
+#include <qbackendnodetester.h>
+
+using namespace Qt3DAnimation::Animation;
+
+class tst_BenchClipAnimatorEvaluation : public Qt3DCore::QBackendNodeTester
+{
+    Q_OBJECT
+public:
+    // Creates animatorCount running animators all playing the same clip
+    Qt3DCore::QNodeId buildAnimators(Handler *handler, int animatorCount)
+    {
+        const Qt3DCore::QNodeId clipId = Qt3DCore::QNodeId::createId();
+        AnimationClip *clip = handler->animationClipLoaderManager()->getOrCreateResource(clipId);
+        setPeerId(clip, clipId);
+        clip->setHandler(handler);
+        clip->setDataType(AnimationClip::File);
+        clip->setSource(QUrl("qrc:/clip1.json"));
+        clip->loadAnimation();
+
+        for (int i = 0; i < animatorCount; ++i) {
+            // Each animator drives its own target
+            const Qt3DCore::QNodeId channelMappingId = Qt3DCore::QNodeId::createId();
+            ChannelMapping *channelMapping = handler->channelMappingManager()->getOrCreateResource(channelMappingId);
+            setPeerId(channelMapping, channelMappingId);
+            channelMapping->setHandler(handler);
+            channelMapping->setTargetId(Qt3DCore::QNodeId::createId());
+            channelMapping->setPropertyName("translation");
+            channelMapping->setChannelName(QLatin1String("Location"));
+            channelMapping->setType(static_cast<int>(QVariant::Vector3D));
+            channelMapping->setComponentCount(3);
+            channelMapping->setMappingType(ChannelMapping::ChannelMappingType);
+
+            const Qt3DCore::QNodeId channelMapperId = Qt3DCore::QNodeId::createId();
+            ChannelMapper *channelMapper = handler->channelMapperManager()->getOrCreateResource(channelMapperId);
+            setPeerId(channelMapper, channelMapperId);
+            channelMapper->setHandler(handler);
+            channelMapper->setMappingIds({ channelMappingId });
+
+            const Qt3DCore::QNodeId animatorId = Qt3DCore::QNodeId::createId();
+            ClipAnimator *animator = handler->clipAnimatorManager()->getOrCreateResource(animatorId);
+            setPeerId(animator, animatorId);
+            animator->setHandler(handler);
+            animator->setStartTime(0);
+            animator->setLoops(Qt3DAnimation::QClipAnimator::Infinite);
+            animator->setClipId(clipId);
+            animator->setMapperId(channelMapperId);
+            animator->setRunning(true);
+            animator->setEnabled(true);
+        }
+
+        return clipId;
+    }
+
+private Q_SLOTS:
+    void evaluateClipAnimators_data()
+    {
+        QTest::addColumn<int>("animatorCount");
+        QTest::addColumn<int>("batchSize");
+
+        for (const int animatorCount : { 100, 5000 }) {
+            QTest::newRow(qPrintable(QStringLiteral("%1 animators, one job per animator").arg(animatorCount)))
+                    << animatorCount << 1;
+            QTest::newRow(qPrintable(QStringLiteral("%1 animators, batches of 64").arg(animatorCount)))
+                    << animatorCount << 64;
+        }
+    }
+
+    void evaluateClipAnimators()
+    {
+        QFETCH(int, animatorCount);
+        QFETCH(int, batchSize);
+
+        // GIVEN
+        Handler handler;
+        handler.setClipAnimatorBatchSize(batchSize);
+        const Qt3DCore::QNodeId clipId = buildAnimators(&handler, animatorCount);
+
+        // First frame loads the clip, finds the running animators and builds
+        // their mappings
+        handler.setDirty(Handler::AnimationClipDirty, clipId);
+        qint64 time = 0;
+        const QVector<Qt3DCore::QAspectJobPtr> firstFrameJobs = handler.jobsToExecute(time);
+        for (const Qt3DCore::QAspectJobPtr &job : firstFrameJobs)
+            job->run();
+        QCOMPARE(handler.runningClipAnimators().size(), animatorCount);
+
+        // WHEN
+        QBENCHMARK {
+            time += 16 * 1000 * 1000;
+            const QVector<Qt3DCore::QAspectJobPtr> jobs = handler.jobsToExecute(time);
+            for (const Qt3DCore::QAspectJobPtr &job : jobs)
+                job->run();
+        }
+    }
+};
+
+QTEST_MAIN(tst_BenchClipAnimatorEvaluation)
+
+#include "tst_bench_clipanimatorevaluation.moc"
@@ -5,3 +5,4 @@ SUBDIRS = \
 QT_FOR_CONFIG += 3dcore
 
 qtConfig(qt3d-render): SUBDIRS += render
+qtConfig(qt3d-animation): SUBDIRS += animation
@@ -0,0 +1,134 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QtTest>
+#include <Qt3DCore/qaspectjob.h>
+#include <Qt3DCore/private/qabstractaspectjobmanager_p.h>
+#include <Qt3DCore/private/qaspectjobmanager_p.h>
+#include <Qt3DCore/private/qworkstealingjobmanager_p.h>
+
+namespace {
+
+class EmptyJob : public Qt3DCore::QAspectJob
+{
+public:
+    // Only measure scheduling overhead
+    void run() override {}
+};
+
+enum ManagerType {
+    ThreadPool,
+    WorkStealing
+};
+
+enum GraphShape {
+    Wide,
+    Deep
+};
+
+Qt3DCore::QAbstractAspectJobManager *createManager(ManagerType type)
+{
+    if (type == WorkStealing)
+        return new Qt3DCore::QWorkStealingJobManager();
+    return new Qt3DCore::QAspectJobManager();
+}
+
+QVector<Qt3DCore::QAspectJobPtr> buildGraph(GraphShape shape, int jobCount)
+{
+    QVector<Qt3DCore::QAspectJobPtr> jobs;
+    jobs.reserve(jobCount);
+    for (int i = 0; i < jobCount; ++i)
+        jobs.push_back(Qt3DCore::QAspectJobPtr(new EmptyJob));
+
+    if (shape == Wide) {
+        // One root fanning out to all jobs which all feed a single sink
+        for (int i = 1; i < jobCount - 1; ++i) {
+            jobs[i]->addDependency(jobs.first());
+            jobs.last()->addDependency(jobs[i]);
+        }
+    } else {
+        // Eight chains, each job depending on its predecessor
+        const int chainCount = 8;
+        for (int i = chainCount; i < jobCount; ++i)
+            jobs[i]->addDependency(jobs[i - chainCount]);
+    }
+    return jobs;
+}
+
+} // anonymous
+
+Q_DECLARE_METATYPE(ManagerType)
+Q_DECLARE_METATYPE(GraphShape)
+
+class tst_JobManager : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void benchmarkScheduling_data();
+    void benchmarkScheduling();
+};
+
+void tst_JobManager::benchmarkScheduling_data()
+{
+    QTest::addColumn<ManagerType>("managerType");
+    QTest::addColumn<GraphShape>("shape");
+    QTest::addColumn<int>("jobCount");
+
+    for (const int jobCount : {64, 128, 1024}) {
+        QTest::addRow("threadpool-wide-%d", jobCount) << ThreadPool << Wide << jobCount;
+        QTest::addRow("workstealing-wide-%d", jobCount) << WorkStealing << Wide << jobCount;
+        QTest::addRow("threadpool-deep-%d", jobCount) << ThreadPool << Deep << jobCount;
+        QTest::addRow("workstealing-deep-%d", jobCount) << WorkStealing << Deep << jobCount;
+    }
+}
+
+void tst_JobManager::benchmarkScheduling()
+{
+    // GIVEN
+    QFETCH(ManagerType, managerType);
+    QFETCH(GraphShape, shape);
+    QFETCH(int, jobCount);
+
+    QScopedPointer<Qt3DCore::QAbstractAspectJobManager> manager(createManager(managerType));
+    const QVector<Qt3DCore::QAspectJobPtr> jobs = buildGraph(shape, jobCount);
+
+    // WHEN
+    int runJobs = 0;
+    QBENCHMARK {
+        manager->enqueueJobs(jobs);
+        runJobs = manager->waitForAllJobs();
+    }
+
+    // THEN
+    QCOMPARE(runJobs, jobCount);
+}
+
+QTEST_APPLESS_MAIN(tst_JobManager)
+
+#include "tst_bench_jobmanager.moc"
@@ -0,0 +1,6 @@
+TARGET = tst_bench_nodelookup
+
+TEMPLATE = app
+QT += testlib 3dcore 3dcore-private
+
+SOURCES += tst_bench_nodelookup.cpp
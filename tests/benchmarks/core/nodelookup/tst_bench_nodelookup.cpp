@@ -0,0 +1,131 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+
+#include <QtTest/QtTest>
+#include <Qt3DCore/qtransform.h>
+#include <Qt3DCore/private/qtransform_p.h>
+#include <Qt3DCore/private/qscene_p.h>
+#include <Qt3DCore/private/qnodebatchlookup_p.h>
+
+namespace {
+
+// The ways a postFrame() job can resolve the frontend nodes it updates
+enum LookupType {
+    PerNode,        // one lookupNode() call, and scene lock, per node
+    GuardedBatch,   // lookupNodes() results copied into QPointers
+    Batch           // QNodeBatchLookup
+};
+
+void updateTransform(Qt3DCore::QNode *node, const QMatrix4x4 &worldMatrix)
+{
+    Qt3DCore::QTransform *transform = static_cast<Qt3DCore::QTransform *>(node);
+    if (!transform)
+        return;
+    static_cast<Qt3DCore::QTransformPrivate *>(Qt3DCore::QNodePrivate::get(transform))->setWorldMatrix(worldMatrix);
+}
+
+} // anonymous
+
+Q_DECLARE_METATYPE(LookupType)
+
+class tst_NodeLookup : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void benchmarkWorldTransformUpdates_data();
+    void benchmarkWorldTransformUpdates();
+};
+
+void tst_NodeLookup::benchmarkWorldTransformUpdates_data()
+{
+    QTest::addColumn<LookupType>("lookupType");
+    QTest::addColumn<int>("nodeCount");
+
+    for (const int nodeCount : {1000, 10000, 100000}) {
+        QTest::addRow("pernode-%d", nodeCount) << PerNode << nodeCount;
+        QTest::addRow("guardedbatch-%d", nodeCount) << GuardedBatch << nodeCount;
+        QTest::addRow("batch-%d", nodeCount) << Batch << nodeCount;
+    }
+}
+
+void tst_NodeLookup::benchmarkWorldTransformUpdates()
+{
+    // GIVEN
+    QFETCH(LookupType, lookupType);
+    QFETCH(int, nodeCount);
+
+    Qt3DCore::QScene scene;
+    QVector<Qt3DCore::QTransform *> transforms;
+    QVector<Qt3DCore::QNodeId> ids;
+    transforms.reserve(nodeCount);
+    ids.reserve(nodeCount);
+    for (int i = 0; i < nodeCount; ++i) {
+        Qt3DCore::QTransform *transform = new Qt3DCore::QTransform();
+        scene.addObservable(transform);
+        transforms.push_back(transform);
+        ids.push_back(transform->id());
+    }
+    // Each iteration sets a different matrix so that every update emits
+    QMatrix4x4 worldMatrix;
+
+    // WHEN
+    QBENCHMARK {
+        worldMatrix.translate(1.0f, 0.0f, 0.0f);
+
+        switch (lookupType) {
+        case PerNode:
+            for (const Qt3DCore::QNodeId id : qAsConst(ids))
+                updateTransform(scene.lookupNode(id), worldMatrix);
+            break;
+        case GuardedBatch: {
+            const QVector<Qt3DCore::QNode *> resolvedNodes = scene.lookupNodes(ids);
+            const QVector<QPointer<Qt3DCore::QNode>> nodes(resolvedNodes.cbegin(), resolvedNodes.cend());
+            for (const QPointer<Qt3DCore::QNode> &node : nodes)
+                updateTransform(node.data(), worldMatrix);
+            break;
+        }
+        case Batch: {
+            Qt3DCore::QNodeBatchLookup nodes(&scene, ids);
+            for (int i = 0, m = nodes.size(); i < m; ++i)
+                updateTransform(nodes.node(i), worldMatrix);
+            break;
+        }
+        }
+    }
+
+    // THEN
+    QCOMPARE(transforms.last()->worldMatrix(), worldMatrix);
+
+    qDeleteAll(transforms);
+}
+
+QTEST_MAIN(tst_NodeLookup)
+
+#include "tst_bench_nodelookup.moc"
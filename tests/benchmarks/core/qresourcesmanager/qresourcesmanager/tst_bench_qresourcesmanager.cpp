@@ -33,6 +33,7 @@
 #include <ctime>
 #include <cstdlib>
 #include <random>
+#include <numeric>
 
 class tst_QResourceManager : public QObject
 {
@@ -50,6 +51,9 @@ private Q_SLOTS:
     void benchmarkLookupBigResources();
     void benchmarkRandomLookupBigResources();
     void benchmarkReleaseBigResources();
+    void benchmarkBulkReleaseSmallResources();
+    void benchmarkChurnSmallResources();
+    void benchmarkIterateSparseSmallResources();
 };
 
 class tst_SmallArrayResource
@@ -176,6 +180,66 @@ void benchmarkReleaseResources()
     }
 }
 
+template<typename Resource>
+void benchmarkBulkReleaseResources()
+{
+    // Scene swap: every resource is released in the same frame
+    const int max = 50000;
+    Qt3DCore::QResourceManager<Resource, int> manager;
+    for (int i = 0; i < max; i++)
+        manager.getOrCreateResource(i);
+
+    QBENCHMARK_ONCE {
+        for (int i = 0; i < max; i++)
+            manager.releaseResource(i);
+    }
+}
+
+template<typename Resource>
+void benchmarkChurnResources()
+{
+    // Keep 50k resources alive while a random tenth of them is released
+    // and created again every iteration
+    const int max = 50000;
+    Qt3DCore::QResourceManager<Resource, int> manager;
+    for (int i = 0; i < max; i++)
+        manager.getOrCreateResource(i);
+
+    QVector<int> keys(max);
+    std::iota(keys.begin(), keys.end(), 0);
+    std::mt19937 g(1234);
+    int nextKey = max;
+
+    QBENCHMARK {
+        std::shuffle(keys.begin(), keys.end(), g);
+        for (int i = 0; i < max / 10; i++) {
+            manager.releaseResource(keys[i]);
+            keys[i] = nextKey++;
+            manager.getOrCreateResource(keys[i]);
+        }
+    }
+}
+
+template<typename Resource>
+void benchmarkIterateSparseResources()
+{
+    // Only one resource out of 16 is still alive
+    const int max = (1 << 16) - 1;
+    Qt3DCore::QResourceManager<Resource, int> manager;
+    for (int i = 0; i < max; i++)
+        manager.getOrCreateResource(i);
+    for (int i = 0; i < max; i++) {
+        if (i % 16 != 0)
+            manager.releaseResource(i);
+    }
+
+    volatile int sum = 0;
+    QBENCHMARK {
+        manager.for_each([&sum] (Resource *r) { sum += r->m_value; });
+    }
+    Q_UNUSED(sum)
+}
+
 void tst_QResourceManager::benchmarkAllocateSmallResources()
 {
     benchmarkAllocateResources<tst_SmallArrayResource>();
@@ -236,6 +300,21 @@ void tst_QResourceManager::benchmarkReleaseBigResources()
     benchmarkReleaseResources<tst_BigArrayResource>();
 }
 
+void tst_QResourceManager::benchmarkBulkReleaseSmallResources()
+{
+    benchmarkBulkReleaseResources<tst_SmallArrayResource>();
+}
+
+void tst_QResourceManager::benchmarkChurnSmallResources()
+{
+    benchmarkChurnResources<tst_SmallArrayResource>();
+}
+
+void tst_QResourceManager::benchmarkIterateSparseSmallResources()
+{
+    benchmarkIterateSparseResources<tst_SmallArrayResource>();
+}
+
 QTEST_APPLESS_MAIN(tst_QResourceManager)
 
 #include "tst_bench_qresourcesmanager.moc"
@@ -94,6 +94,14 @@ namespace Qt3DRender {
             return QVector<Qt3DCore::QAspectJobPtr>() << daspect->m_worldTransformJob;
         }
 
+        void markAllWorldTransformsDirty()
+        {
+            Render::EntityManager *entityManager = d_func()->m_renderer->nodeManagers()->renderNodesManager();
+            const auto handles = entityManager->activeHandles();
+            for (const Render::HEntity &handle : handles)
+                entityManager->data(handle)->markWorldTransformDirty();
+        }
+
         QVector<Qt3DCore::QAspectJobPtr> updateBoundingJob()
         {
             auto renderer = static_cast<Render::OpenGL::Renderer *>(d_func()->m_renderer);
@@ -235,16 +243,69 @@ Qt3DCore::QEntity *buildBigScene()
     return root;
 }
 
+Qt3DCore::QEntity *createTransformedEntity(Qt3DCore::QEntity *parent, int i)
+{
+    Qt3DCore::QEntity *e = new Qt3DCore::QEntity(parent);
+    Qt3DCore::QTransform *transform = new Qt3DCore::QTransform();
+    transform->setTranslation(QVector3D(1.0f, 0.5f * i, 0.0f));
+    transform->setRotationY(15.0f * i);
+    e->addComponent(transform);
+    return e;
+}
+
+// All entities are direct children of the root
+Qt3DCore::QEntity *buildFlatHierarchy()
+{
+    Qt3DCore::QEntity *root = new Qt3DCore::QEntity();
+    for (int i = 0; i < 20000; ++i)
+        createTransformedEntity(root, i);
+    return root;
+}
+
+// A few long chains of nested entities
+Qt3DCore::QEntity *buildDeepHierarchy()
+{
+    Qt3DCore::QEntity *root = new Qt3DCore::QEntity();
+    for (int chain = 0; chain < 40; ++chain) {
+        Qt3DCore::QEntity *parent = root;
+        for (int i = 0; i < 500; ++i)
+            parent = createTransformedEntity(parent, i);
+    }
+    return root;
+}
+
+// Every entity has 4 children, 7 levels deep
+void buildBalancedLevel(Qt3DCore::QEntity *parent, int depth)
+{
+    if (depth == 0)
+        return;
+    for (int i = 0; i < 4; ++i)
+        buildBalancedLevel(createTransformedEntity(parent, i), depth - 1);
+}
+
+Qt3DCore::QEntity *buildBalancedHierarchy()
+{
+    Qt3DCore::QEntity *root = new Qt3DCore::QEntity();
+    buildBalancedLevel(root, 7);
+    return root;
+}
+
 class tst_benchJobs : public QObject
 {
     Q_OBJECT
 
 private:
     Qt3DCore::QEntity *m_bigSceneRoot;
+    Qt3DCore::QEntity *m_flatSceneRoot;
+    Qt3DCore::QEntity *m_deepSceneRoot;
+    Qt3DCore::QEntity *m_balancedSceneRoot;
 
 public:
     tst_benchJobs()
         : m_bigSceneRoot(buildBigScene())
+        , m_flatSceneRoot(buildFlatHierarchy())
+        , m_deepSceneRoot(buildDeepHierarchy())
+        , m_balancedSceneRoot(buildBalancedHierarchy())
     {}
 
 private Q_SLOTS:
@@ -252,13 +313,22 @@ private Q_SLOTS:
     void updateTransformJob_data()
     {
         QTest::addColumn<Qt3DCore::QEntity*>("rootEntity");
-        QTest::newRow("bigscene") << m_bigSceneRoot;
+        QTest::addColumn<bool>("dirty");
+        QTest::newRow("bigscene") << m_bigSceneRoot << false;
+        QTest::newRow("bigscene-dirty") << m_bigSceneRoot << true;
+        QTest::newRow("flat") << m_flatSceneRoot << false;
+        QTest::newRow("flat-dirty") << m_flatSceneRoot << true;
+        QTest::newRow("deep") << m_deepSceneRoot << false;
+        QTest::newRow("deep-dirty") << m_deepSceneRoot << true;
+        QTest::newRow("balanced") << m_balancedSceneRoot << false;
+        QTest::newRow("balanced-dirty") << m_balancedSceneRoot << true;
     }
 
     void updateTransformJob()
     {
         // GIVEN
         QFETCH(Qt3DCore::QEntity*, rootEntity);
+        QFETCH(bool, dirty);
         QRenderAspectTester aspect;
 
         Qt3DCore::QAbstractAspectPrivate::get(&aspect)->setRootAndCreateNodes(qobject_cast<Qt3DCore::QEntity *>(rootEntity), {});
@@ -266,7 +336,11 @@ private Q_SLOTS:
         // WHEN
         QVector<Qt3DCore::QAspectJobPtr> jobs = aspect.worldTransformJob();
 
+        // Clean rows measure the pruned traversal, dirty rows force every
+        // world transform to be recomputed (flagging cost included)
         QBENCHMARK {
+            if (dirty)
+                aspect.markAllWorldTransformsDirty();
             Qt3DCore::QAbstractAspectPrivate::get(&aspect)->jobManager()->enqueueJobs(jobs);
             Qt3DCore::QAbstractAspectPrivate::get(&aspect)->jobManager()->waitForAllJobs();
         }
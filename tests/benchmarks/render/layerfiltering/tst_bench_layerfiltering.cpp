@@ -38,6 +38,7 @@
 #include <Qt3DRender/qrenderaspect.h>
 #include <Qt3DRender/private/qrenderaspect_p.h>
 #include <Qt3DRender/private/filterlayerentityjob_p.h>
+#include <Qt3DRender/private/updateentitylayersjob_p.h>
 #include <Qt3DRender/qlayer.h>
 #include <Qt3DRender/qlayerfilter.h>
 
@@ -99,7 +100,8 @@ namespace {
 Qt3DCore::QEntity *buildTestScene(int layersCount,
                                   int entityCount,
                                   QVector<Qt3DCore::QNodeId> &layerFilterIds,
-                                  bool alwaysEnabled = true)
+                                  bool alwaysEnabled = true,
+                                  int layerFiltersCount = 1)
 {
     Qt3DCore::QEntity *root = new Qt3DCore::QEntity();
     Qt3DRender::QLayerFilter *layerFilter = new Qt3DRender::QLayerFilter(root);
@@ -115,6 +117,15 @@ Qt3DCore::QEntity *buildTestScene(int layersCount,
         layerFilter->addLayer(layer);
     }
 
+    // Additional filters discard a few of the layers each
+    for (int i = 1; i < layerFiltersCount; ++i) {
+        Qt3DRender::QLayerFilter *discardFilter = new Qt3DRender::QLayerFilter(root);
+        discardFilter->setFilterMode(Qt3DRender::QLayerFilter::DiscardAnyMatchingLayers);
+        for (int j = i; j < layersCount; j += 8)
+            discardFilter->addLayer(layers.at(j));
+        layerFilterIds.push_back(discardFilter->id());
+    }
+
     for (int i = 0; i < entityCount; ++i) {
         Qt3DCore::QEntity *entity = new Qt3DCore::QEntity(root);
 
@@ -139,49 +150,82 @@ private Q_SLOTS:
     {
         QTest::addColumn<Qt3DCore::QEntity *>("entitySubtree");
         QTest::addColumn<Qt3DCore::QNodeIdVector>("layerFilterIds");
-
-
-        {
-            Qt3DCore::QNodeIdVector layerFilterIds;
-            Qt3DCore::QEntity *rootEntity = buildTestScene(0, 5000, layerFilterIds);
-
-            QTest::newRow("Filter-NoLayerFilterAllEnabled") << rootEntity
-                                                            << layerFilterIds;
-        }
-
-        {
-            Qt3DCore::QNodeIdVector layerFilterIds;
-            Qt3DCore::QEntity *rootEntity = buildTestScene(0, 5000, layerFilterIds, false);
-            QTest::newRow("Filter-NoLayerFilterSomeDisabled") << rootEntity
-                                                              << layerFilterIds;
-        }
-
-        {
-            Qt3DCore::QNodeIdVector layerFilterIds;
-            Qt3DCore::QEntity *rootEntity = buildTestScene(10, 5000, layerFilterIds);
-
-            QTest::newRow("FilterLayerFilterAllEnabled") << rootEntity
-                                                         << layerFilterIds;
-        }
-
-        {
-            Qt3DCore::QNodeIdVector layerFilterIds;
-            Qt3DCore::QEntity *rootEntity = buildTestScene(10, 5000, layerFilterIds, false);
-
-            QTest::newRow("FilterLayerFilterSomeDisabled") << rootEntity
-                                                         << layerFilterIds;
+        QTest::addColumn<bool>("layerMasks");
+
+        for (const bool layerMasks : { false, true }) {
+            const QByteArray suffix = layerMasks ? "-LayerMasks" : "-LayerIds";
+
+            {
+                Qt3DCore::QNodeIdVector layerFilterIds;
+                Qt3DCore::QEntity *rootEntity = buildTestScene(0, 5000, layerFilterIds);
+
+                QTest::newRow((QByteArray("Filter-NoLayerFilterAllEnabled") + suffix).constData()) << rootEntity
+                                                                                                   << layerFilterIds
+                                                                                                   << layerMasks;
+            }
+
+            {
+                Qt3DCore::QNodeIdVector layerFilterIds;
+                Qt3DCore::QEntity *rootEntity = buildTestScene(0, 5000, layerFilterIds, false);
+                QTest::newRow((QByteArray("Filter-NoLayerFilterSomeDisabled") + suffix).constData()) << rootEntity
+                                                                                                     << layerFilterIds
+                                                                                                     << layerMasks;
+            }
+
+            {
+                Qt3DCore::QNodeIdVector layerFilterIds;
+                Qt3DCore::QEntity *rootEntity = buildTestScene(10, 5000, layerFilterIds);
+
+                QTest::newRow((QByteArray("FilterLayerFilterAllEnabled") + suffix).constData()) << rootEntity
+                                                                                                << layerFilterIds
+                                                                                                << layerMasks;
+            }
+
+            {
+                Qt3DCore::QNodeIdVector layerFilterIds;
+                Qt3DCore::QEntity *rootEntity = buildTestScene(10, 5000, layerFilterIds, false);
+
+                QTest::newRow((QByteArray("FilterLayerFilterSomeDisabled") + suffix).constData()) << rootEntity
+                                                                                                  << layerFilterIds
+                                                                                                  << layerMasks;
+            }
+
+            {
+                Qt3DCore::QNodeIdVector layerFilterIds;
+                Qt3DCore::QEntity *rootEntity = buildTestScene(40, 50000, layerFilterIds);
+
+                QTest::newRow((QByteArray("Filter40LayersManyEntities") + suffix).constData()) << rootEntity
+                                                                                               << layerFilterIds
+                                                                                               << layerMasks;
+            }
+
+            {
+                Qt3DCore::QNodeIdVector layerFilterIds;
+                Qt3DCore::QEntity *rootEntity = buildTestScene(40, 50000, layerFilterIds, false, 4);
+
+                QTest::newRow((QByteArray("Filter40LayersManyEntities4LayerFilters") + suffix).constData()) << rootEntity
+                                                                                                            << layerFilterIds
+                                                                                                            << layerMasks;
+            }
         }
-
     }
 
     void filterEntities()
     {
         QFETCH(Qt3DCore::QEntity *, entitySubtree);
         QFETCH(Qt3DCore::QNodeIdVector, layerFilterIds);
+        QFETCH(bool, layerMasks);
 
         // GIVEN
         QScopedPointer<Qt3DRender::TestAspect> aspect(new Qt3DRender::TestAspect(entitySubtree));
 
+        // Without the layer masks FilterLayerEntityJob compares the layer ids
+        if (layerMasks) {
+            Qt3DRender::Render::UpdateEntityLayersJob updateLayerEntityJob;
+            updateLayerEntityJob.setManager(aspect->nodeManagers());
+            updateLayerEntityJob.run();
+        }
+
         // WHEN
         Qt3DRender::Render::FilterLayerEntityJob filterJob;
         filterJob.setLayerFilters(layerFilterIds);
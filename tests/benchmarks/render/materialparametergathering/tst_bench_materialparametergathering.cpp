@@ -110,6 +110,8 @@ QT_END_NAMESPACE
 
 namespace {
 
+const int materialCount = 2000;
+
 Qt3DCore::QEntity *buildTestScene(int entityCount)
 {
     Qt3DCore::QEntity *root = new Qt3DCore::QEntity();
@@ -133,7 +135,7 @@ private Q_SLOTS:
     void parameterGathering()
     {
         // GIVEN
-        QScopedPointer<Qt3DRender::TestAspect> aspect(new Qt3DRender::TestAspect(buildTestScene(2000)));
+        QScopedPointer<Qt3DRender::TestAspect> aspect(new Qt3DRender::TestAspect(buildTestScene(materialCount)));
 
         // WHEN
         Qt3DRender::Render::OpenGL::MaterialParameterGathererJobPtr gatheringJob = aspect->materialGathererJob();
@@ -145,6 +147,66 @@ private Q_SLOTS:
 
         QVERIFY(!gatheringJob->materialToPassAndParameter().empty());
     }
+
+    void parameterGatheringWithChurn_data()
+    {
+        QTest::addColumn<int>("changedMaterialCount");
+        QTest::addColumn<bool>("partialRebuild");
+
+        QTest::newRow("full rebuild") << materialCount << false;
+        QTest::newRow("1 changed material") << 1 << true;
+        QTest::newRow("10 changed materials") << 10 << true;
+        QTest::newRow("100 changed materials") << 100 << true;
+        QTest::newRow("1000 changed materials") << 1000 << true;
+    }
+
+    // Simulates the RenderView material cache being updated after some
+    // Materials (or the Parameters, Effects, Techniques and RenderPasses they
+    // reference) changed: either everything is gathered again, or only the
+    // changed Materials are and their entries are patched in the cache
+    void parameterGatheringWithChurn()
+    {
+        // GIVEN
+        QFETCH(int, changedMaterialCount);
+        QFETCH(bool, partialRebuild);
+        QScopedPointer<Qt3DRender::TestAspect> aspect(new Qt3DRender::TestAspect(buildTestScene(materialCount)));
+        Qt3DRender::Render::MaterialManager *materialManager = aspect->nodeManagers()->materialManager();
+        const QVector<Qt3DRender::Render::HMaterial> handles = materialManager->activeHandles();
+
+        Qt3DRender::Render::OpenGL::MaterialParameterGathererJobPtr initialJob = aspect->materialGathererJob();
+        initialJob->setHandles(handles);
+        initialJob->run();
+        Qt3DRender::Render::OpenGL::MaterialParameterGathererData cachedParameters = initialJob->materialToPassAndParameter();
+
+        // Spread the changed materials over the scene
+        QVector<Qt3DRender::Render::HMaterial> changedHandles;
+        QVector<Qt3DCore::QNodeId> changedIds;
+        const int step = handles.size() / changedMaterialCount;
+        for (int i = 0; i < changedMaterialCount; ++i) {
+            changedHandles.push_back(handles.at(i * step));
+            changedIds.push_back(materialManager->data(handles.at(i * step))->peerId());
+        }
+
+        // WHEN
+        QBENCHMARK {
+            Qt3DRender::Render::OpenGL::MaterialParameterGathererJobPtr gatheringJob = aspect->materialGathererJob();
+            gatheringJob->setHandles(changedHandles);
+            gatheringJob->run();
+
+            if (partialRebuild) {
+                for (const Qt3DCore::QNodeId &id : qAsConst(changedIds))
+                    cachedParameters.remove(id);
+            } else {
+                cachedParameters.clear();
+            }
+            const Qt3DRender::Render::OpenGL::MaterialParameterGathererData &gathered = gatheringJob->materialToPassAndParameter();
+            for (auto it = gathered.cbegin(), end = gathered.cend(); it != end; ++it)
+                cachedParameters.insert(it.key(), it.value());
+        }
+
+        // THEN
+        QCOMPARE(cachedParameters.size(), handles.size());
+    }
 };
 
 QTEST_MAIN(tst_BenchMaterialParameterGathering)
@@ -1,4 +1,6 @@
 TEMPLATE = subdirs
 
 SUBDIRS += \
-        shaderparameterpack
+        shaderparameterpack \
+        rendercommandsort \
+        rendercommandcache
@@ -0,0 +1,249 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QTest>
+#include <Qt3DCore/qentity.h>
+#include <Qt3DCore/qgeometry.h>
+#include <Qt3DCore/private/qaspectjobmanager_p.h>
+#include <Qt3DCore/private/qnodevisitor_p.h>
+#include <Qt3DCore/private/qnode_p.h>
+
+#include <Qt3DRender/qviewport.h>
+#include <Qt3DRender/qrendersettings.h>
+#include <Qt3DRender/qgeometryrenderer.h>
+#include <Qt3DRender/private/qrenderaspect_p.h>
+#include <Qt3DRender/private/nodemanagers_p.h>
+#include <Qt3DRender/private/managers_p.h>
+#include <Qt3DRender/private/entity_p.h>
+#include <Qt3DRender/private/technique_p.h>
+#include <Qt3DRender/private/techniquemanager_p.h>
+#include <Qt3DExtras/qphongmaterial.h>
+#include <renderviewbuilder_p.h>
+#include <renderer_p.h>
+#include <glresourcemanagers_p.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DRender {
+
+class TestAspect : public Qt3DRender::QRenderAspect
+{
+public:
+    TestAspect(Qt3DCore::QNode *root)
+        : Qt3DRender::QRenderAspect(Qt3DRender::QRenderAspect::Synchronous)
+        , m_jobManager(new Qt3DCore::QAspectJobManager())
+    {
+        Qt3DCore::QAbstractAspectPrivate::get(this)->m_jobManager = m_jobManager.data();
+        QRenderAspect::onRegistered();
+
+        QVector<Qt3DCore::NodeTreeChange> nodes;
+        Qt3DCore::QNodeVisitor v;
+        v.traverse(root, [&nodes](Qt3DCore::QNode *node) {
+            Qt3DCore::QNodePrivate *d = Qt3DCore::QNodePrivate::get(node);
+            d->m_typeInfo = const_cast<QMetaObject*>(Qt3DCore::QNodePrivate::findStaticMetaObject(node->metaObject()));
+            d->m_hasBackendNode = true;
+            nodes.push_back({
+                node->id(),
+                Qt3DCore::QNodePrivate::get(node)->m_typeInfo,
+                Qt3DCore::NodeTreeChange::Added,
+                node
+            });
+        });
+
+        for (const auto &node: nodes)
+            d_func()->createBackendNode(node);
+
+        const auto techniqueHandles = nodeManagers()->techniqueManager()->activeHandles();
+        for (const auto handle: techniqueHandles) {
+            Render::Technique *technique = nodeManagers()->techniqueManager()->data(handle);
+            technique->setCompatibleWithRenderer(true);
+        }
+
+        // Shaders are never loaded without a GL context, create their
+        // GLShader so that RenderCommands actually get built
+        const auto shaderHandles = nodeManagers()->shaderManager()->activeHandles();
+        for (const auto handle: shaderHandles) {
+            Render::Shader *shader = nodeManagers()->shaderManager()->data(handle);
+            renderer()->glResourceManagers()->glShaderManager()->createOrAdoptExisting(shader);
+        }
+    }
+
+    ~TestAspect()
+    {
+        QRenderAspect::onUnregistered();
+    }
+
+    Qt3DRender::Render::NodeManagers *nodeManagers() const
+    {
+        return d_func()->m_renderer->nodeManagers();
+    }
+
+    Render::OpenGL::Renderer *renderer() const
+    {
+        return static_cast<Render::OpenGL::Renderer *>(d_func()->m_renderer);
+    }
+
+private:
+    QScopedPointer<Qt3DCore::QAspectJobManager> m_jobManager;
+};
+
+} // namespace Qt3DRender
+
+QT_END_NAMESPACE
+
+using namespace Qt3DRender::Render;
+using namespace Qt3DRender::Render::OpenGL;
+
+namespace {
+
+const int entityCount = 20000;
+
+Qt3DCore::QEntity *buildTestScene(Qt3DRender::QFrameGraphNode *fg)
+{
+    Qt3DCore::QEntity *root = new Qt3DCore::QEntity();
+
+    Qt3DRender::QRenderSettings* renderSettings = new Qt3DRender::QRenderSettings();
+    renderSettings->setActiveFrameGraph(fg);
+    root->addComponent(renderSettings);
+
+    Qt3DExtras::QPhongMaterial *material = new Qt3DExtras::QPhongMaterial(root);
+    Qt3DCore::QGeometry *geometry = new Qt3DCore::QGeometry(root);
+
+    for (int i = 0; i < entityCount; ++i) {
+        Qt3DCore::QEntity *entity = new Qt3DCore::QEntity(root);
+        Qt3DRender::QGeometryRenderer *geometryRenderer = new Qt3DRender::QGeometryRenderer();
+        geometryRenderer->setGeometry(geometry);
+        entity->addComponent(material);
+        entity->addComponent(geometryRenderer);
+    }
+
+    return root;
+}
+
+// Runs the part of the RenderView jobs which builds RenderCommands and
+// stores them in the RendererCache
+void buildRenderCommands(RenderViewBuilder &builder)
+{
+    builder.prepareJobs();
+
+    builder.renderViewJob()->run();
+    builder.syncRenderViewPostInitializationJob()->run();
+
+    if (builder.layerCacheNeedsToBeRebuilt()) {
+        builder.filterEntityByLayerJob()->run();
+        builder.syncFilterEntityByLayerJob()->run();
+    }
+
+    if (builder.materialGathererCacheNeedsToBeRebuilt()) {
+        for (const auto &materialGatherer : builder.materialGathererJobs())
+            materialGatherer->run();
+        builder.syncMaterialGathererJob()->run();
+    }
+
+    builder.syncRenderViewPreCommandBuildingJob()->run();
+    for (const auto &renderViewCommandBuilder : builder.renderViewCommandBuilderJobs())
+        renderViewCommandBuilder->run();
+    builder.syncRenderViewPreCommandUpdateJob()->run();
+
+    delete builder.renderViewJob()->renderView();
+}
+
+} // anonymous
+
+class tst_BenchRenderCommandCache : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+
+    void rebuildRenderCommands_data()
+    {
+        QTest::addColumn<int>("changedEntityCount");
+        QTest::addColumn<bool>("partialRebuild");
+
+        QTest::newRow("full rebuild") << entityCount << false;
+        QTest::newRow("1 changed entity") << 1 << true;
+        QTest::newRow("100 changed entities") << 100 << true;
+        QTest::newRow("10000 changed entities") << 10000 << true;
+    }
+
+    void rebuildRenderCommands()
+    {
+        // GIVEN
+        QFETCH(int, changedEntityCount);
+        QFETCH(bool, partialRebuild);
+
+        Qt3DRender::QViewport *viewport = new Qt3DRender::QViewport();
+        QScopedPointer<Qt3DRender::TestAspect> aspect(new Qt3DRender::TestAspect(buildTestScene(viewport)));
+        Renderer *renderer = aspect->renderer();
+        RendererCache *cache = renderer->cache();
+        FrameGraphNode *leafNode = aspect->nodeManagers()->frameGraphManager()->lookupNode(viewport->id());
+        QVERIFY(leafNode != nullptr);
+
+        renderer->renderableEntityFilterJob()->run();
+        const QVector<Entity *> renderableEntities = cache->renderableEntities;
+        QCOMPARE(renderableEntities.size(), entityCount);
+
+        // Fill the caches as the first frame would
+        {
+            RenderViewBuilder builder(leafNode, 0, renderer);
+            builder.setLayerCacheNeedsToBeRebuilt(true);
+            builder.setMaterialGathererCacheNeedsToBeRebuilt(true);
+            builder.setRenderCommandCacheNeedsToBeRebuilt(true);
+            buildRenderCommands(builder);
+        }
+        const int cachedCommandCount = cache->leafNodeCache.value(leafNode).renderCommandData.size();
+        QVERIFY(cachedCommandCount > 0);
+
+        // Spread the changed entities over the whole scene
+        RendererCache::DirtyEntityData dirtyEntities;
+        const int step = entityCount / changedEntityCount;
+        for (int i = 0; i < changedEntityCount; ++i)
+            dirtyEntities.entityIds.push_back(renderableEntities.at(i * step)->peerId());
+        std::sort(dirtyEntities.entityIds.begin(), dirtyEntities.entityIds.end());
+
+        // WHEN
+        QBENCHMARK {
+            {
+                QMutexLocker lock(cache->mutex());
+                cache->dirtyEntities = dirtyEntities;
+            }
+            RenderViewBuilder builder(leafNode, 0, renderer);
+            builder.setRenderCommandCacheNeedsToBeRebuilt(true);
+            builder.setRenderCommandCacheNeedsPartialRebuild(partialRebuild);
+            buildRenderCommands(builder);
+        }
+
+        // THEN
+        QCOMPARE(cache->leafNodeCache.value(leafNode).renderCommandData.size(), cachedCommandCount);
+    }
+};
+
+QTEST_MAIN(tst_BenchRenderCommandCache)
+
+#include "tst_bench_rendercommandcache.moc"
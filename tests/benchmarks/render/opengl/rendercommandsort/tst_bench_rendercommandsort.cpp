@@ -0,0 +1,121 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QTest>
+#include <Qt3DRender/qsortpolicy.h>
+#include <Qt3DCore/qnodeid.h>
+#include <renderview_p.h>
+#include <rendercommand_p.h>
+#include <QRandomGenerator>
+
+using namespace Qt3DRender;
+using namespace Qt3DRender::Render;
+using namespace Qt3DRender::Render::OpenGL;
+
+Q_DECLARE_METATYPE(QVector<Qt3DRender::QSortPolicy::SortType>)
+
+namespace {
+
+const int commandCount = 100000;
+
+QVector<RenderCommand> buildCommands()
+{
+    QRandomGenerator gen;
+
+    QVector<Qt3DCore::QNodeId> textureIds;
+    for (int i = 0; i < 32; ++i)
+        textureIds.push_back(Qt3DCore::QNodeId::createId());
+
+    QVector<RenderCommand> commands;
+    commands.reserve(commandCount);
+    for (int i = 0; i < commandCount; ++i) {
+        RenderCommand c;
+        c.m_glShader = reinterpret_cast<GLShader *>(quintptr(0x100 * (1 + gen.bounded(16))));
+        c.m_depth = float(gen.generateDouble() * 1000.0);
+        c.m_changeCost = gen.bounded(8);
+        const int textureCount = gen.bounded(4);
+        for (int t = 0; t < textureCount; ++t)
+            c.m_parameterPack.setTexture(t, 0, textureIds.at(gen.bounded(textureIds.size())));
+        commands.push_back(c);
+    }
+    return commands;
+}
+
+} // anonymous
+
+class tst_BenchRenderCommandSort : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+
+    void sortCommands_data()
+    {
+        QTest::addColumn<QVector<QSortPolicy::SortType>>("sortTypes");
+
+        QTest::newRow("StateChangeCost") << QVector<QSortPolicy::SortType>{ QSortPolicy::StateChangeCost };
+        QTest::newRow("BackToFront") << QVector<QSortPolicy::SortType>{ QSortPolicy::BackToFront };
+        QTest::newRow("Material") << QVector<QSortPolicy::SortType>{ QSortPolicy::Material };
+        QTest::newRow("FrontToBack") << QVector<QSortPolicy::SortType>{ QSortPolicy::FrontToBack };
+        QTest::newRow("Texture") << QVector<QSortPolicy::SortType>{ QSortPolicy::Texture };
+        QTest::newRow("Uniform") << QVector<QSortPolicy::SortType>{ QSortPolicy::Uniform };
+        QTest::newRow("Material-FrontToBack")
+                << QVector<QSortPolicy::SortType>{ QSortPolicy::Material, QSortPolicy::FrontToBack };
+        QTest::newRow("StateChangeCost-Material-BackToFront")
+                << QVector<QSortPolicy::SortType>{ QSortPolicy::StateChangeCost, QSortPolicy::Material, QSortPolicy::BackToFront };
+        QTest::newRow("Material-Texture")
+                << QVector<QSortPolicy::SortType>{ QSortPolicy::Material, QSortPolicy::Texture };
+        QTest::newRow("Texture-Material-FrontToBack-Uniform")
+                << QVector<QSortPolicy::SortType>{ QSortPolicy::Texture, QSortPolicy::Material, QSortPolicy::FrontToBack, QSortPolicy::Uniform };
+        QTest::newRow("StateChangeCost-Material-Texture-BackToFront")
+                << QVector<QSortPolicy::SortType>{ QSortPolicy::StateChangeCost, QSortPolicy::Material, QSortPolicy::Texture, QSortPolicy::BackToFront };
+    }
+
+    void sortCommands()
+    {
+        // GIVEN
+        QFETCH(QVector<QSortPolicy::SortType>, sortTypes);
+        const QVector<RenderCommand> commands = buildCommands();
+        RenderView renderView;
+        renderView.addSortType(sortTypes);
+
+        // Note: each iteration also includes copying the unsorted commands,
+        // as sorting detaches them from the shared vector
+        QBENCHMARK {
+            renderView.setCommands(commands);
+            renderView.sort();
+        }
+
+        // THEN
+        QCOMPARE(renderView.commands().size(), commandCount);
+    }
+};
+
+QTEST_MAIN(tst_BenchRenderCommandSort)
+
+#include "tst_bench_rendercommandsort.moc"
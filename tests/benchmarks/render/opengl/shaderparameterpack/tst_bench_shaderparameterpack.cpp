@@ -59,7 +59,34 @@ private Q_SLOTS:
         }
     }
 
-    void prepareUniforms()
+    void checkPackUniformInsertWithLayout()
+    {
+        // GIVEN
+        GLShader shader;
+        QVector<ShaderUniform> uniformDescriptions;
+        for (int i = 0; i < 64; i++) {
+            ShaderUniform u;
+            u.m_name = QString::number(i);
+            uniformDescriptions << u;
+        }
+        shader.initializeUniforms(uniformDescriptions);
+
+        PackUniformHash pack;
+        pack.setLayout(&shader.uniformLayout());
+
+        QVector<int> randKeys(64);
+        QRandomGenerator gen;
+
+        for (int i = 0; i < 64; ++i)
+            randKeys[i] = shader.uniforms().at(gen.bounded(64)).m_nameId;
+
+        QBENCHMARK {
+            for (const int key : qAsConst(randKeys))
+                pack.insert(key, UniformValue(key));
+        }
+    }
+
+    void resolveUniformSlots()
     {
         // GIVEN
         GLShader shader;
@@ -73,6 +100,7 @@ private Q_SLOTS:
 
         // THEN
         QCOMPARE(shader.uniforms().size(), 30);
+        QCOMPARE(shader.uniformLayout().slotCount(), 30);
 
         // WHEN
         QVector<int> testNames;
@@ -81,11 +109,23 @@ private Q_SLOTS:
 
         // WHEN
         ShaderParameterPack pack;
+        pack.setUniformLayout(&shader.uniformLayout());
         for (const int nameId : qAsConst(testNames))
             pack.setUniform(nameId, UniformValue(nameId));
 
+        // THEN
+        const PackUniformHash &values = pack.uniforms();
+        const UniformLayout &layout = shader.uniformLayout();
+        for (int i = 0; i < 10; ++i)
+            QCOMPARE(layout.slot(values.keys.at(i)), i * 3);
+
+        // What SubmissionContext::setParameters does to find the
+        // ShaderUniform matching each value of the pack
         QBENCHMARK {
-            shader.prepareUniforms(pack);
+            int slotSum = 0;
+            for (int i = 0, m = values.keys.size(); i < m; ++i)
+                slotSum += layout.slot(values.keys.at(i));
+            QCOMPARE(slotSum, 135);
         }
     }
 };
@@ -0,0 +1,12 @@
+TEMPLATE = app
+
+TARGET = tst_bench_picking
+
+QT += core-private 3dcore 3dcore-private 3drender 3drender-private testlib
+
+CONFIG += testcase
+
+SOURCES += tst_bench_picking.cpp
+
+include(../../../auto/core/common/common.pri)
+include(../../../auto/render/commons/commons.pri)
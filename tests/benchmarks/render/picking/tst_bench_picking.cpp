@@ -0,0 +1,283 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QtTest>
+#include <qbackendnodetester.h>
+#include <Qt3DCore/qbuffer.h>
+#include <Qt3DCore/qattribute.h>
+#include <Qt3DCore/qgeometry.h>
+#include <Qt3DRender/qgeometryrenderer.h>
+#include <Qt3DRender/private/nodemanagers_p.h>
+#include <Qt3DRender/private/managers_p.h>
+#include <Qt3DRender/private/buffermanager_p.h>
+#include <Qt3DRender/private/geometryrenderer_p.h>
+#include <Qt3DRender/private/geometryrenderermanager_p.h>
+#include <Qt3DRender/private/primitivebvh_p.h>
+#include <Qt3DRender/private/trianglesvisitor_p.h>
+#include <Qt3DRender/private/triangleboundingvolume_p.h>
+#include <QRandomGenerator>
+#include <cmath>
+#include "testrenderer.h"
+
+using namespace Qt3DRender;
+using namespace Qt3DRender::Render;
+
+namespace {
+
+// Full traversal of the triangles, as picking did without a BVH
+class BruteForceVisitor : public TrianglesVisitor
+{
+public:
+    BruteForceVisitor(NodeManagers *manager, const RayCasting::QRay3D &ray)
+        : TrianglesVisitor(manager)
+        , m_ray(ray)
+    {
+    }
+
+    int hitCount = 0;
+
+    void visit(uint, const Vector3D &a, uint, const Vector3D &b, uint, const Vector3D &c) override
+    {
+        Vector3D uvw;
+        float t = 0.0f;
+        if (intersectsSegmentTriangle(m_ray, c, b, a, uvw, t)
+                || intersectsSegmentTriangle(m_ray, a, b, c, uvw, t))
+            ++hitCount;
+    }
+
+private:
+    RayCasting::QRay3D m_ray;
+};
+
+int countBVHHits(const PrimitiveBVH &bvh, const RayCasting::QRay3D &ray)
+{
+    const Matrix4x4 identity;
+    int hitCount = 0;
+    const auto candidates = bvh.intersectingPrimitives(ray, identity, 0.0f);
+    for (const PrimitiveBVH::Primitive *p : candidates) {
+        Vector3D uvw;
+        float t = 0.0f;
+        if (intersectsSegmentTriangle(ray, p->vertices[2], p->vertices[1], p->vertices[0], uvw, t)
+                || intersectsSegmentTriangle(ray, p->vertices[0], p->vertices[1], p->vertices[2], uvw, t))
+            ++hitCount;
+    }
+    return hitCount;
+}
+
+QVector<RayCasting::QRay3D> generateRays(int count)
+{
+    QRandomGenerator generator(883);
+    QVector<RayCasting::QRay3D> rays;
+    rays.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        const Vector3D origin(float(generator.bounded(2.0) - 1.0), 10.0f, float(generator.bounded(2.0) - 1.0));
+        const Vector3D target(float(generator.bounded(2.0) - 1.0), 0.0f, float(generator.bounded(2.0) - 1.0));
+        rays.push_back(RayCasting::QRay3D(origin, (target - origin).normalized(), 20.0f));
+    }
+    return rays;
+}
+
+} // anonymous
+
+class tst_BenchPicking : public Qt3DCore::QBackendNodeTester
+{
+    Q_OBJECT
+
+public:
+    // Indexed height field of resolution * resolution * 2 triangles
+    GeometryRenderer *createGridMesh(int resolution)
+    {
+        m_managers.reset(new NodeManagers());
+        m_geometryRenderer.reset(new Qt3DRender::QGeometryRenderer());
+
+        auto geometry = new Qt3DCore::QGeometry(m_geometryRenderer.data());
+        auto positionBuffer = new Qt3DCore::QBuffer(geometry);
+        auto indexBuffer = new Qt3DCore::QBuffer(geometry);
+        auto positionAttribute = new Qt3DCore::QAttribute(geometry);
+        auto indexAttribute = new Qt3DCore::QAttribute(geometry);
+
+        const int vertexCount = (resolution + 1) * (resolution + 1);
+        QByteArray positions;
+        positions.resize(vertexCount * 3 * int(sizeof(float)));
+        float *p = reinterpret_cast<float *>(positions.data());
+        for (int z = 0; z <= resolution; ++z) {
+            for (int x = 0; x <= resolution; ++x) {
+                const float fx = 2.0f * x / resolution - 1.0f;
+                const float fz = 2.0f * z / resolution - 1.0f;
+                *p++ = fx;
+                *p++ = 0.1f * std::sin(8.0f * fx) * std::cos(8.0f * fz);
+                *p++ = fz;
+            }
+        }
+
+        QByteArray indices;
+        indices.resize(resolution * resolution * 6 * int(sizeof(uint)));
+        uint *i = reinterpret_cast<uint *>(indices.data());
+        for (int z = 0; z < resolution; ++z) {
+            for (int x = 0; x < resolution; ++x) {
+                const uint v = uint(z * (resolution + 1) + x);
+                const uint below = v + uint(resolution + 1);
+                *i++ = v;
+                *i++ = below;
+                *i++ = v + 1;
+                *i++ = v + 1;
+                *i++ = below;
+                *i++ = below + 1;
+            }
+        }
+
+        positionBuffer->setData(positions);
+        indexBuffer->setData(indices);
+
+        positionAttribute->setBuffer(positionBuffer);
+        positionAttribute->setName(Qt3DCore::QAttribute::defaultPositionAttributeName());
+        positionAttribute->setVertexBaseType(Qt3DCore::QAttribute::Float);
+        positionAttribute->setVertexSize(3);
+        positionAttribute->setCount(uint(vertexCount));
+        positionAttribute->setAttributeType(Qt3DCore::QAttribute::VertexAttribute);
+
+        indexAttribute->setBuffer(indexBuffer);
+        indexAttribute->setVertexBaseType(Qt3DCore::QAttribute::UnsignedInt);
+        indexAttribute->setVertexSize(1);
+        indexAttribute->setCount(uint(resolution * resolution * 6));
+        indexAttribute->setAttributeType(Qt3DCore::QAttribute::IndexAttribute);
+
+        geometry->addAttribute(positionAttribute);
+        geometry->addAttribute(indexAttribute);
+
+        m_geometryRenderer->setGeometry(geometry);
+        m_geometryRenderer->setPrimitiveType(Qt3DRender::QGeometryRenderer::Triangles);
+
+        for (Qt3DCore::QBuffer *buffer : { positionBuffer, indexBuffer }) {
+            Buffer *backendBuffer = m_managers->bufferManager()->getOrCreateResource(buffer->id());
+            backendBuffer->setRenderer(&m_renderer);
+            backendBuffer->setManager(m_managers->bufferManager());
+            simulateInitializationSync(buffer, backendBuffer);
+        }
+        for (Qt3DCore::QAttribute *attribute : { positionAttribute, indexAttribute }) {
+            Attribute *backendAttribute = m_managers->attributeManager()->getOrCreateResource(attribute->id());
+            backendAttribute->setRenderer(&m_renderer);
+            simulateInitializationSync(attribute, backendAttribute);
+        }
+
+        Geometry *backendGeometry = m_managers->geometryManager()->getOrCreateResource(geometry->id());
+        backendGeometry->setRenderer(&m_renderer);
+        simulateInitializationSync(geometry, backendGeometry);
+
+        GeometryRenderer *backendRenderer = m_managers->geometryRendererManager()->getOrCreateResource(m_geometryRenderer->id());
+        backendRenderer->setRenderer(&m_renderer);
+        backendRenderer->setManager(m_managers->geometryRendererManager());
+        simulateInitializationSync(m_geometryRenderer.data(), backendRenderer);
+
+        return backendRenderer;
+    }
+
+private Q_SLOTS:
+    void buildTriangleBVH_data()
+    {
+        QTest::addColumn<int>("resolution");
+
+        QTest::newRow("2k triangles") << 32;
+        QTest::newRow("32k triangles") << 128;
+        QTest::newRow("512k triangles") << 512;
+    }
+
+    void buildTriangleBVH()
+    {
+        QFETCH(int, resolution);
+
+        // GIVEN
+        GeometryRenderer *renderer = createGridMesh(resolution);
+
+        QBENCHMARK {
+            // WHEN
+            PrimitiveBVHCache cache;
+            const auto bvh = cache.bvh(m_managers.data(), renderer, PrimitiveBVH::Triangles);
+
+            // THEN
+            QCOMPARE(bvh->primitives().size(), resolution * resolution * 2);
+        }
+    }
+
+    void pickTriangles_data()
+    {
+        QTest::addColumn<int>("resolution");
+        QTest::addColumn<bool>("useBVH");
+
+        QTest::newRow("2k triangles - brute force") << 32 << false;
+        QTest::newRow("2k triangles - BVH") << 32 << true;
+        QTest::newRow("32k triangles - brute force") << 128 << false;
+        QTest::newRow("32k triangles - BVH") << 128 << true;
+        QTest::newRow("512k triangles - brute force") << 512 << false;
+        QTest::newRow("512k triangles - BVH") << 512 << true;
+    }
+
+    void pickTriangles()
+    {
+        QFETCH(int, resolution);
+        QFETCH(bool, useBVH);
+
+        // GIVEN
+        GeometryRenderer *renderer = createGridMesh(resolution);
+        const QVector<RayCasting::QRay3D> rays = generateRays(64);
+        PrimitiveBVHCache *cache = m_managers->geometryManager()->pickingBVHCache();
+
+        // Prime the cache, the build isn't part of the measurement
+        cache->bvh(m_managers.data(), renderer, PrimitiveBVH::Triangles);
+
+        int hitCount = 0;
+        QBENCHMARK {
+            // WHEN
+            hitCount = 0;
+            for (const RayCasting::QRay3D &ray : rays) {
+                if (useBVH) {
+                    const auto cached = cache->bvh(m_managers.data(), renderer, PrimitiveBVH::Triangles);
+                    hitCount += countBVHHits(*cached, ray);
+                } else {
+                    BruteForceVisitor visitor(m_managers.data(), ray);
+                    visitor.apply(renderer, Qt3DCore::QNodeId());
+                    hitCount += visitor.hitCount;
+                }
+            }
+        }
+
+        // THEN
+        QCOMPARE(cache->buildCount(), 1);
+        QVERIFY(hitCount >= rays.size());
+    }
+
+private:
+    QScopedPointer<NodeManagers> m_managers;
+    QScopedPointer<Qt3DRender::QGeometryRenderer> m_geometryRenderer;
+    TestRenderer m_renderer;
+};
+
+QTEST_MAIN(tst_BenchPicking)
+
+#include "tst_bench_picking.moc"
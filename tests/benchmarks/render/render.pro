@@ -4,5 +4,7 @@ qtConfig(private_tests) {
     SUBDIRS += jobs \
                layerfiltering \
                materialparametergathering \
-               opengl
+               opengl \
+               picking \
+               textureloading
 }
@@ -0,0 +1,164 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QtTest>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/qendian.h>
+#include <Qt3DRender/qtextureimagedata.h>
+#include <Qt3DRender/private/qtexture_p.h>
+
+namespace {
+
+const int textureSize = 4096;
+const int mipLevelCount = 13;
+const int faceCount = 6;
+
+// Writes a DXT1 compressed cube map with a full mip chain (~64MB)
+bool writeDdsCubeMap(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+
+    quint32 header[32] = {};
+    memcpy(header, "DDS ", 4);
+    header[1] = qToLittleEndian<quint32>(124);                                  // size
+    header[2] = qToLittleEndian<quint32>(0x1 | 0x2 | 0x4 | 0x1000 | 0x20000);  // caps, height, width, pixel format, mip count
+    header[3] = qToLittleEndian<quint32>(textureSize);                          // height
+    header[4] = qToLittleEndian<quint32>(textureSize);                          // width
+    header[7] = qToLittleEndian<quint32>(mipLevelCount);
+    header[19] = qToLittleEndian<quint32>(32);                                  // pixel format size
+    header[20] = qToLittleEndian<quint32>(0x4);                                 // FourCC
+    memcpy(&header[21], "DXT1", 4);
+    header[27] = qToLittleEndian<quint32>(0x1000 | 0x8 | 0x400000);             // texture, complex, mipmap
+    header[28] = qToLittleEndian<quint32>(0x200 | 0xfc00);                      // cube map, all faces
+    if (file.write(reinterpret_cast<const char *>(header), sizeof(header)) != sizeof(header))
+        return false;
+
+    for (int face = 0; face < faceCount; ++face) {
+        for (int level = 0; level < mipLevelCount; ++level) {
+            const int blocks = qMax((textureSize >> level) / 4, 1);
+            const QByteArray levelData(blocks * blocks * 8, char(face + level));
+            if (file.write(levelData) != levelData.size())
+                return false;
+        }
+    }
+    return true;
+}
+
+// Resets the peak resident set size so that it can be measured per load
+void resetPeakMemory()
+{
+#ifdef Q_OS_LINUX
+    QFile clearRefs(QStringLiteral("/proc/self/clear_refs"));
+    if (clearRefs.open(QIODevice::WriteOnly))
+        clearRefs.write("5");
+#endif
+}
+
+qint64 peakMemoryKb()
+{
+#ifdef Q_OS_LINUX
+    QFile status(QStringLiteral("/proc/self/status"));
+    if (status.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        const QList<QByteArray> lines = status.readAll().split('\n');
+        for (const QByteArray &line : lines) {
+            if (line.startsWith("VmHWM:"))
+                return line.mid(6).trimmed().split(' ').first().toLongLong();
+        }
+    }
+#endif
+    return -1;
+}
+
+} // anonymous
+
+class tst_BenchTextureLoading : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase()
+    {
+        QVERIFY(m_dir.isValid());
+        m_fileName = m_dir.filePath(QStringLiteral("cubemap.dds"));
+        QVERIFY(writeDdsCubeMap(m_fileName));
+        m_wasMappingEnabled = Qt3DRender::TextureLoadingHelper::isMemoryMappingEnabled();
+    }
+
+    void cleanupTestCase()
+    {
+        Qt3DRender::TextureLoadingHelper::setMemoryMappingEnabled(m_wasMappingEnabled);
+    }
+
+    void loadDds_data()
+    {
+        QTest::addColumn<bool>("mapped");
+
+        QTest::newRow("copied") << false;
+        QTest::newRow("mapped") << true;
+    }
+
+    void loadDds()
+    {
+        QFETCH(bool, mapped);
+        Qt3DRender::TextureLoadingHelper::setMemoryMappingEnabled(mapped);
+        const QUrl url = QUrl::fromLocalFile(m_fileName);
+
+        resetPeakMemory();
+        const qint64 peakBefore = peakMemoryKb();
+        {
+            // Touch every mip level the way an upload would while the data is alive
+            Qt3DRender::QTextureImageDataPtr data = Qt3DRender::TextureLoadingHelper::loadTextureData(url, false, false);
+            QVERIFY(data);
+            qint64 checksum = 0;
+            for (int face = 0; face < data->faces(); ++face) {
+                for (int level = 0; level < data->mipLevels(); ++level)
+                    checksum += data->data(0, face, level).at(0);
+            }
+            QVERIFY(checksum > 0);
+        }
+        if (peakBefore >= 0)
+            qInfo("Peak RSS increase: %lld kB", peakMemoryKb() - peakBefore);
+
+        QBENCHMARK {
+            Qt3DRender::QTextureImageDataPtr data = Qt3DRender::TextureLoadingHelper::loadTextureData(url, false, false);
+            Q_UNUSED(data);
+        }
+    }
+
+private:
+    QTemporaryDir m_dir;
+    QString m_fileName;
+    bool m_wasMappingEnabled = false;
+};
+
+QTEST_APPLESS_MAIN(tst_BenchTextureLoading)
+
+#include "tst_bench_textureloading.moc"